@@ -0,0 +1,202 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <stdint.h>
+
+
+
+#include "bench.h"
+#include "algos_bench.h"
+
+
+
+
+
+/*
+ * Typed algorithms (DEFINE_LIST_ALGOS, DEFINE_DLIST_ALGOS) versus
+ * the algorithms with a pointer to function (comparators are
+ * in the other translation unit - algos_bench_cmp.c).
+ *
+ * usage: algos_bench [max_pow]   //sizes 10^3 .. 10^max_pow (default 6)
+ */
+
+
+
+
+
+DEFINE_LIST_ALGOS(typed_list, struct tmp_data, list, a->key < b->key,
+                  a->key == *(int64_t *)data)
+
+DEFINE_DLIST_ALGOS(typed_dlist, struct tmp_data, dlist, a->key < b->key,
+                   a->key == *(int64_t *)data)
+
+
+
+
+
+struct algos_bench
+{
+    struct list_head  list;
+    struct dlist_head dlist;
+    struct tmp_data  *nodes;
+    size_t            size;
+    uint64_t          seed;
+    int64_t           key;     //key of the last node (worst case for find)
+    volatile uintptr_t sink;   //result of the algorithm (do not optimize out)
+};
+
+
+
+static void setup(void *data)
+{
+    struct algos_bench *b = data;
+    size_t i;
+
+
+    list_init_head(&b->list);
+    dlist_init_head(&b->dlist);
+
+    for(i = 0; i < b->size; i++)
+    {
+        b->nodes[i].key = (int64_t)(bench_rand(&b->seed) >> 1);
+        dlist_push_back(&b->nodes[i].dlist, &b->dlist);
+    }
+
+    for(i = b->size; i > 0; i--)
+        list_push_front(&b->nodes[i-1].list, &b->list);  //list_push_back is O(n)
+
+    b->key = b->nodes[b->size-1].key;
+}
+
+
+
+static void run_list_min(void *data)
+{
+    struct algos_bench *b = data;
+
+    b->sink = (uintptr_t)list_min(b->list.next, &b->list, list_comp_less);
+}
+
+
+
+static void run_typed_list_min(void *data)
+{
+    struct algos_bench *b = data;
+
+    b->sink = (uintptr_t)typed_list_min(b->list.next, &b->list);
+}
+
+
+
+static void run_list_minmax(void *data)
+{
+    struct algos_bench *b = data;
+    struct list_head *res[2];
+
+    list_minmax(b->list.next, &b->list, list_comp_less, res);
+    b->sink = (uintptr_t)res[0] ^ (uintptr_t)res[1];
+}
+
+
+
+static void run_typed_list_minmax(void *data)
+{
+    struct algos_bench *b = data;
+    struct list_head *res[2];
+
+    typed_list_minmax(b->list.next, &b->list, res);
+    b->sink = (uintptr_t)res[0] ^ (uintptr_t)res[1];
+}
+
+
+
+static void run_list_find2(void *data)
+{
+    struct algos_bench *b = data;
+
+    b->sink = (uintptr_t)list_find2(b->list.next, &b->list, list_pred_key, &b->key);
+}
+
+
+
+static void run_typed_list_find2(void *data)
+{
+    struct algos_bench *b = data;
+
+    b->sink = (uintptr_t)typed_list_find2(b->list.next, &b->list, &b->key);
+}
+
+
+
+static void run_dlist_min(void *data)
+{
+    struct algos_bench *b = data;
+
+    b->sink = (uintptr_t)dlist_min(b->dlist.next, &b->dlist, dlist_comp_less);
+}
+
+
+
+static void run_typed_dlist_min(void *data)
+{
+    struct algos_bench *b = data;
+
+    b->sink = (uintptr_t)typed_dlist_min(b->dlist.next, &b->dlist);
+}
+
+
+
+static void run_dlist_find2(void *data)
+{
+    struct algos_bench *b = data;
+
+    b->sink = (uintptr_t)dlist_find2(b->dlist.next, &b->dlist, dlist_pred_key, &b->key);
+}
+
+
+
+static void run_typed_dlist_find2(void *data)
+{
+    struct algos_bench *b = data;
+
+    b->sink = (uintptr_t)typed_dlist_find2(b->dlist.next, &b->dlist, &b->key);
+}
+
+
+
+int main(int argc, char *argv[])
+{
+    struct algos_bench b;
+    size_t max_pow = 6, pow, reps;
+
+
+    if( argc > 1 )
+        max_pow = strtoul(argv[1], NULL, 10);
+
+
+    b.seed = 0x9E3779B97F4A7C15ull;
+
+    for(pow = 3, b.size = 1000; pow <= max_pow; pow++, b.size *= 10)
+    {
+        b.nodes = malloc(b.size * sizeof(struct tmp_data));
+        if( !b.nodes )
+            return 1;
+
+        reps = bench_reps(b.size);
+
+        bench_run("list_min",            b.size, reps, setup, run_list_min,            &b);
+        bench_run("list_min/typed",      b.size, reps, setup, run_typed_list_min,      &b);
+        bench_run("list_minmax",         b.size, reps, setup, run_list_minmax,         &b);
+        bench_run("list_minmax/typed",   b.size, reps, setup, run_typed_list_minmax,   &b);
+        bench_run("list_find2",          b.size, reps, setup, run_list_find2,          &b);
+        bench_run("list_find2/typed",    b.size, reps, setup, run_typed_list_find2,    &b);
+        bench_run("dlist_min",           b.size, reps, setup, run_dlist_min,           &b);
+        bench_run("dlist_min/typed",     b.size, reps, setup, run_typed_dlist_min,     &b);
+        bench_run("dlist_find2",         b.size, reps, setup, run_dlist_find2,         &b);
+        bench_run("dlist_find2/typed",   b.size, reps, setup, run_typed_dlist_find2,   &b);
+
+        free(b.nodes);
+    }
+
+
+    return 0;
+}
@@ -0,0 +1,45 @@
+#ifndef ALGOS_BENCH_HEADER
+#define ALGOS_BENCH_HEADER
+
+
+#include <stdint.h>
+
+#include "list.h"
+#include "dlist.h"
+
+
+
+
+
+/*
+ * The data and the comparators for algos_bench.c
+ *
+ * The comparators live in algos_bench_cmp.c (other translation unit),
+ * so the compiler can not inline them into list_min, dlist_sort, ...
+ * (it is the usual case for a library code).
+ */
+
+
+
+
+
+struct tmp_data
+{
+    struct list_head  list;
+    struct dlist_head dlist;
+    int64_t           key;
+};
+
+
+
+int list_comp_less(const struct list_head *n1, const struct list_head *n2);
+int list_pred_key(const struct list_head *node, void *data);
+
+int dlist_comp_less(const struct dlist_head *n1, const struct dlist_head *n2);
+int dlist_pred_key(const struct dlist_head *node, void *data);
+
+
+
+
+
+#endif //ALGOS_BENCH_HEADER
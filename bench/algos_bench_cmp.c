@@ -0,0 +1,41 @@
+#include "algos_bench.h"
+
+
+
+
+
+int list_comp_less(const struct list_head *n1, const struct list_head *n2)
+{
+    struct tmp_data *d1 = list_data(n1, struct tmp_data, list);
+    struct tmp_data *d2 = list_data(n2, struct tmp_data, list);
+
+    return d1->key < d2->key;
+}
+
+
+
+int list_pred_key(const struct list_head *node, void *data)
+{
+    struct tmp_data *d = list_data(node, struct tmp_data, list);
+
+    return d->key == *(int64_t *)data;
+}
+
+
+
+int dlist_comp_less(const struct dlist_head *n1, const struct dlist_head *n2)
+{
+    struct tmp_data *d1 = dlist_data(n1, struct tmp_data, dlist);
+    struct tmp_data *d2 = dlist_data(n2, struct tmp_data, dlist);
+
+    return d1->key < d2->key;
+}
+
+
+
+int dlist_pred_key(const struct dlist_head *node, void *data)
+{
+    struct tmp_data *d = dlist_data(node, struct tmp_data, dlist);
+
+    return d->key == *(int64_t *)data;
+}
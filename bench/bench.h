@@ -0,0 +1,353 @@
+/*
+ * bench.h
+ *
+ *
+ * version 1.0
+ *
+ *
+ *
+ * BSD 3-Clause License
+ *
+ * Copyright (c) 2017, Koynov Stas - skojnov@yandex.ru
+ *
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice, this
+ *    list of conditions and the following disclaimer.
+ *
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ *    this list of conditions and the following disclaimer in the documentation
+ *    and/or other materials provided with the distribution.
+ *
+ * 3. Neither the name of the copyright holder nor the names of its
+ *    contributors may be used to endorse or promote products derived from
+ *    this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+ * FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ * DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ * SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ * CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+ * OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ */
+
+#ifndef BENCH_HEADER
+#define BENCH_HEADER
+
+
+#include <stdio.h>   //printf
+#include <stdlib.h>  //malloc, qsort
+#include <stdint.h>
+#include <string.h>  //strcmp
+#include <time.h>    //clock_gettime (need _POSIX_C_SOURCE, see Makefile)
+
+
+
+
+
+/*
+ * Simple timing harness for benchmarks.
+ *
+ * Every benchmark is a pair of functions:
+ *
+ *   setup - prepare the data for one run (is not measured)
+ *   run   - the code under test (is measured)
+ *
+ * bench_run calls setup+run one time for warmup, and then reps times,
+ * each run is measured by the monotonic clock. The result is
+ * the median of the runs (it is stable against the noise of the system),
+ * the p99 of the runs is printed too (it shows the tail: page faults,
+ * realloc, preemption).
+ *
+ * Format of the output is selected by the environment variable BENCH_FORMAT:
+ *
+ *   text (default) - table for the human
+ *   csv            - name,n,reps,median_ns,p99_ns,ns_per_op (with header)
+ *   json           - one JSON object per line (JSON Lines)
+ *
+ * so the runs of two versions can be compared by diff or any script.
+ *
+ * Example:
+ *
+ * static void setup(void *data) { ... }
+ * static void run(void *data)   { ... }
+ *
+ * bench_run("list_sort", n, 11, setup, run, &data);
+ */
+
+
+
+
+
+typedef void (*pbench_func)(void *data);
+
+
+
+enum bench_format_t
+{
+    BENCH_FORMAT_TEXT,
+    BENCH_FORMAT_CSV,
+    BENCH_FORMAT_JSON
+};
+
+
+
+/*
+ * Layout of the nodes in memory (see bench_layout):
+ *
+ *   contiguous - the nodes are linked in order of memory (best case for cache)
+ *   shuffled   - the nodes are linked in random order (like after many malloc/free)
+ */
+enum bench_layout_t
+{
+    BENCH_LAYOUT_CONTIGUOUS,
+    BENCH_LAYOUT_SHUFFLED
+};
+
+
+
+static inline const char* bench_layout_name(int layout)
+{
+    return layout == BENCH_LAYOUT_SHUFFLED ? "shuffled" : "contiguous";
+}
+
+
+
+/*
+ * bench_now - Returns the current value of the monotonic clock in ns.
+ */
+static inline uint64_t bench_now(void)
+{
+    struct timespec ts;
+
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+
+    return (uint64_t)ts.tv_sec * 1000000000u + (uint64_t)ts.tv_nsec;
+}
+
+
+
+/*
+ * bench_rand - Returns the next pseudo random number (xorshift64*).
+ *
+ * state: the state of the generator (must not be 0).
+ */
+static inline uint64_t bench_rand(uint64_t *state)
+{
+    uint64_t x = *state;
+
+    x ^= x >> 12;
+    x ^= x << 25;
+    x ^= x >> 27;
+    *state = x;
+
+    return x * 0x2545F4914F6CDD1Dull;
+}
+
+
+
+static int bench_cmp_u64(const void *a, const void *b)
+{
+    uint64_t v1 = *(const uint64_t *)a;
+    uint64_t v2 = *(const uint64_t *)b;
+
+    return (v1 > v2) - (v1 < v2);
+}
+
+
+
+/*
+ * bench_layout - Fills the order of the nodes for the layout.
+ *
+ * order:  array of indexes of the nodes (in order of linking)
+ * n:      count of nodes
+ * layout: BENCH_LAYOUT_CONTIGUOUS - 0, 1, 2, ... n-1
+ *         BENCH_LAYOUT_SHUFFLED   - random permutation (Fisher-Yates)
+ * seed:   the state of the generator (see bench_rand)
+ */
+static inline void bench_layout(size_t *order, size_t n, int layout, uint64_t *seed)
+{
+    size_t i, j, tmp;
+
+
+    for(i = 0; i < n; i++)
+        order[i] = i;
+
+    if( layout != BENCH_LAYOUT_SHUFFLED )
+        return;
+
+    for(i = n; i > 1; i--)
+    {
+        j          = bench_rand(seed) % i;
+        tmp        = order[i-1];
+        order[i-1] = order[j];
+        order[j]   = tmp;
+    }
+}
+
+
+
+/*
+ * bench_reps - Returns count of runs for n elements (about 10^7 operations,
+ * but from 5 to 101 runs).
+ */
+static inline size_t bench_reps(size_t n)
+{
+    size_t reps = n ? 10000000 / n : 101;
+
+    return reps < 5 ? 5 : (reps > 101 ? 101 : reps);
+}
+
+
+
+/*
+ * bench_format - Returns format of the output (see BENCH_FORMAT).
+ */
+static inline int bench_format(void)
+{
+    static int format = -1;
+    const char *env;
+
+
+    if( format < 0 )
+    {
+        env    = getenv("BENCH_FORMAT");
+        format = BENCH_FORMAT_TEXT;
+
+        if( env && !strcmp(env, "csv") )
+            format = BENCH_FORMAT_CSV;
+
+        if( env && !strcmp(env, "json") )
+            format = BENCH_FORMAT_JSON;
+    }
+
+    return format;
+}
+
+
+
+/*
+ * bench_print - Prints the result of the benchmark in format of bench_format.
+ */
+static inline void bench_print(const char *name, size_t n, size_t reps,
+                               uint64_t median, uint64_t p99)
+{
+    static int csv_header = 0;
+    double per_op = n ? (double)median / n : 0.0;
+
+
+    switch( bench_format() )
+    {
+        case BENCH_FORMAT_CSV:
+            if( !csv_header )
+            {
+                printf("name,n,reps,median_ns,p99_ns,ns_per_op\n");
+                csv_header = 1;
+            }
+
+            printf("%s,%zu,%zu,%llu,%llu,%.3f\n", name, n, reps,
+                   (unsigned long long)median, (unsigned long long)p99, per_op);
+            break;
+
+        case BENCH_FORMAT_JSON:
+            printf("{\"name\": \"%s\", \"n\": %zu, \"reps\": %zu, "
+                   "\"median_ns\": %llu, \"p99_ns\": %llu, \"ns_per_op\": %.3f}\n",
+                   name, n, reps, (unsigned long long)median, (unsigned long long)p99, per_op);
+            break;
+
+        default:
+            printf("%-40s %10zu %14llu ns %10.2f ns/op  p99 %14llu ns\n", name, n,
+                   (unsigned long long)median, per_op, (unsigned long long)p99);
+            break;
+    }
+
+    fflush(stdout);
+}
+
+
+
+/*
+ * bench_run - Runs the benchmark and prints the result.
+ *
+ * name:  the name of the benchmark
+ * n:     count of elements (operations) in one run
+ * reps:  count of measured runs
+ * setup: function for prepare data before every run (can be NULL)
+ * run:   function for measure
+ * data:  user data for setup and run functions
+ *
+ * ret: median time of one run in ns
+ */
+static inline uint64_t bench_run(const char *name, size_t n, size_t reps,
+                                 pbench_func setup, pbench_func run, void *data)
+{
+    uint64_t *samples, start, median, p99;
+    size_t i;
+
+
+    if( reps == 0 )
+        reps = 1;
+
+    samples = malloc(reps * sizeof(uint64_t));
+    if( !samples )
+        return 0;
+
+
+    //warmup
+    if( setup )
+        setup(data);
+
+    run(data);
+
+
+    for(i = 0; i < reps; i++)
+    {
+        if( setup )
+            setup(data);
+
+        start = bench_now();
+        run(data);
+        samples[i] = bench_now() - start;
+    }
+
+
+    qsort(samples, reps, sizeof(uint64_t), bench_cmp_u64);
+    median = samples[reps/2];
+    p99    = samples[(reps*99)/100];
+
+    bench_print(name, n, reps, median, p99);
+
+    free(samples);
+
+    return median;
+}
+
+
+
+/*
+ * bench_run_layout - The same as bench_run, but the name of the benchmark
+ * is "name/layout" (see bench_layout).
+ */
+static inline uint64_t bench_run_layout(const char *name, int layout, size_t n, size_t reps,
+                                        pbench_func setup, pbench_func run, void *data)
+{
+    char full_name[128];
+
+    snprintf(full_name, sizeof(full_name), "%s/%s", name, bench_layout_name(layout));
+
+    return bench_run(full_name, n, reps, setup, run, data);
+}
+
+
+
+
+
+#endif //BENCH_HEADER
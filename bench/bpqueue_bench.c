@@ -0,0 +1,217 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <stdint.h>
+
+
+
+#include "bench.h"
+#include "pqueue.h"
+#include "bpqueue.h"
+
+
+
+
+
+/*
+ * bpqueue.h (bitmap + dqueue_t buckets) vs pqueue.h (binary heap,
+ * (prio, seq) keys for FIFO inside a priority) for a scheduler workload
+ * on contiguous and shuffled layout of the nodes (see bench_layout):
+ *
+ * hold  - pop the top node and push it back with a random priority,
+ *         the number of the nodes in the queue (occupancy) is not changed
+ *
+ * The results are named <queue>_hold_p<priorities>_q<occupancy>,
+ * priorities: 8 (a few long buckets) and 256 (all buckets),
+ * occupancy: 10 .. 10^max_pow, every run is BENCH_HOLD_OPS steps.
+ *
+ * usage: bpqueue_bench [max_pow]   //occupancy 10 .. 10^max_pow (default 5)
+ */
+
+
+
+
+
+#define BENCH_HOLD_OPS  100000
+
+
+
+struct tmp_data
+{
+    struct bpqueue_node node;
+    unsigned int        prio;        //priority for pqueue
+    uint64_t            seq;         //FIFO order for pqueue
+    char                payload[32]; //one node == one cache line
+};
+
+
+
+struct bpqueue_bench
+{
+    struct pqueue_t       pqueue;
+    struct bpqueue_t      bpqueue;
+    struct tmp_data      *nodes;
+    size_t               *order;    //order of pushes of the nodes
+    size_t                size;     //occupancy
+    unsigned int          prios;    //range of priorities
+    uint64_t              seq;
+    uint64_t              seed;
+    uint64_t              setup_seed;
+    volatile uintptr_t    sink;     //result of the algorithm (do not optimize out)
+};
+
+
+
+static int cmp_prio(void *n1, void *n2)
+{
+    struct tmp_data *d1 = n1;
+    struct tmp_data *d2 = n2;
+
+    if( d1->prio != d2->prio )
+        return d1->prio < d2->prio;
+
+    return d1->seq <= d2->seq;
+}
+
+
+
+static unsigned int rand_prio(struct bpqueue_bench *b)
+{
+    return (unsigned int)(bench_rand(&b->seed) >> 32) % b->prios;
+}
+
+
+
+static void setup_pqueue(void *data)
+{
+    struct bpqueue_bench *b = data;
+    struct tmp_data *node;
+    size_t i;
+
+
+    b->seed        = b->setup_seed;  //the same priorities for both queues
+    b->seq         = 0;
+    b->pqueue.size = 0;
+
+    for(i = 0; i < b->size; i++)
+    {
+        node       = &b->nodes[b->order[i]];
+        node->prio = rand_prio(b);
+        node->seq  = b->seq++;
+        pqueue_push(&b->pqueue, node);
+    }
+}
+
+
+
+static void setup_bpqueue(void *data)
+{
+    struct bpqueue_bench *b = data;
+    size_t i;
+
+
+    b->seed = b->setup_seed;
+    bpqueue_init(&b->bpqueue);
+
+    for(i = 0; i < b->size; i++)
+        bpqueue_push(&b->bpqueue, &b->nodes[b->order[i]].node, rand_prio(b));
+}
+
+
+
+static void run_pqueue_hold(void *data)
+{
+    struct bpqueue_bench *b = data;
+    struct tmp_data *top;
+    uintptr_t sum = 0;
+    size_t i;
+
+
+    for(i = 0; i < BENCH_HOLD_OPS; i++)
+    {
+        top = pqueue_top(&b->pqueue);
+        pqueue_pop(&b->pqueue);
+        sum ^= (uintptr_t)top;
+
+        top->prio = rand_prio(b);
+        top->seq  = b->seq++;
+        pqueue_push(&b->pqueue, top);
+    }
+
+    b->sink = sum;
+}
+
+
+
+static void run_bpqueue_hold(void *data)
+{
+    struct bpqueue_bench *b = data;
+    struct bpqueue_node *top;
+    uintptr_t sum = 0;
+    size_t i;
+
+
+    for(i = 0; i < BENCH_HOLD_OPS; i++)
+    {
+        top  = bpqueue_pop(&b->bpqueue);
+        sum ^= (uintptr_t)top;
+
+        bpqueue_push(&b->bpqueue, top, rand_prio(b));
+    }
+
+    b->sink = sum;
+}
+
+
+
+int main(int argc, char *argv[])
+{
+    static const unsigned int prios[] = { 8, 256 };
+
+    struct bpqueue_bench b;
+    size_t max_pow = 5, pow, p, reps;
+    char name[64];
+    int layout;
+
+
+    if( argc > 1 )
+        max_pow = strtoul(argv[1], NULL, 10);
+
+
+    b.setup_seed = 0x9E3779B97F4A7C15ull;
+    reps         = bench_reps(BENCH_HOLD_OPS);
+
+    for(pow = 1, b.size = 10; pow <= max_pow; pow++, b.size *= 10)
+    {
+        b.nodes = malloc(b.size * sizeof(struct tmp_data));
+        b.order = malloc(b.size * sizeof(size_t));
+        if( !b.nodes || !b.order )
+            return 1;
+
+        if( pqueue_init(&b.pqueue, 0, b.size, cmp_prio) )
+            return 1;
+
+        for(layout = BENCH_LAYOUT_CONTIGUOUS; layout <= BENCH_LAYOUT_SHUFFLED; layout++)
+        {
+            bench_layout(b.order, b.size, layout, &b.setup_seed);
+
+            for(p = 0; p < sizeof(prios)/sizeof(prios[0]); p++)
+            {
+                b.prios = prios[p];
+
+                snprintf(name, sizeof(name), "pqueue_hold_p%u_q%zu", b.prios, b.size);
+                bench_run_layout(name, layout, BENCH_HOLD_OPS, reps, setup_pqueue, run_pqueue_hold, &b);
+
+                snprintf(name, sizeof(name), "bpqueue_hold_p%u_q%zu", b.prios, b.size);
+                bench_run_layout(name, layout, BENCH_HOLD_OPS, reps, setup_bpqueue, run_bpqueue_hold, &b);
+            }
+        }
+
+        pqueue_free(&b.pqueue);
+
+        free(b.order);
+        free(b.nodes);
+    }
+
+
+    return 0;
+}
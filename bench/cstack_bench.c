@@ -0,0 +1,177 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <stdint.h>
+#include <pthread.h>
+
+
+
+#include "bench.h"
+#include "stack.h"
+#include "cstack.h"
+
+
+
+
+
+/*
+ * Throughput of the lock-free stack (cstack_t) versus stack_t guarded
+ * by a mutex. Every thread makes pop+push pairs on one shared stack
+ * (free list like usage).
+ *
+ * usage: cstack_bench [max_threads]   //1, 2, 4 .. max_threads (default 8)
+ */
+
+
+
+
+
+#define OPS_PER_THREAD  200000
+#define COUNT_NODES     1024
+
+
+
+struct tmp_data
+{
+    struct list_head list;
+    int              key;
+};
+
+
+
+struct cstack_bench
+{
+    struct cstack_t  cstack;
+    struct stack_t   stack;
+    pthread_mutex_t  mutex;
+    struct tmp_data  nodes[COUNT_NODES];
+    size_t           threads;
+};
+
+
+
+static void setup(void *data)
+{
+    struct cstack_bench *b = data;
+    size_t i;
+
+
+    cstack_init(&b->cstack);
+    stack_init(&b->stack);
+
+    for(i = 0; i < COUNT_NODES/2; i++)
+    {
+        cstack_push(&b->nodes[i].list, &b->cstack);
+        stack_push(&b->nodes[COUNT_NODES/2 + i].list, &b->stack);
+    }
+}
+
+
+
+static void* cstack_thread(void *data)
+{
+    struct cstack_bench *b = data;
+    struct list_head *node;
+    size_t i;
+
+
+    for(i = 0; i < OPS_PER_THREAD; i++)
+    {
+        node = cstack_pop(&b->cstack);
+        if( node )
+            cstack_push(node, &b->cstack);
+    }
+
+    return NULL;
+}
+
+
+
+static void* stack_thread(void *data)
+{
+    struct cstack_bench *b = data;
+    struct list_head *node;
+    size_t i;
+
+
+    for(i = 0; i < OPS_PER_THREAD; i++)
+    {
+        pthread_mutex_lock(&b->mutex);
+        node = stack_top(&b->stack);
+        stack_pop(&b->stack);
+        pthread_mutex_unlock(&b->mutex);
+
+        if( node )
+        {
+            pthread_mutex_lock(&b->mutex);
+            stack_push(node, &b->stack);
+            pthread_mutex_unlock(&b->mutex);
+        }
+    }
+
+    return NULL;
+}
+
+
+
+static void run_threads(struct cstack_bench *b, void* (*func)(void *))
+{
+    pthread_t *threads = malloc(b->threads * sizeof(pthread_t));
+    size_t i;
+
+
+    if( !threads )
+        return;
+
+    for(i = 0; i < b->threads; i++)
+        pthread_create(&threads[i], NULL, func, b);
+
+    for(i = 0; i < b->threads; i++)
+        pthread_join(threads[i], NULL);
+
+    free(threads);
+}
+
+
+
+static void run_cstack(void *data)
+{
+    run_threads(data, cstack_thread);
+}
+
+
+
+static void run_mutex_stack(void *data)
+{
+    run_threads(data, stack_thread);
+}
+
+
+
+int main(int argc, char *argv[])
+{
+    static struct cstack_bench b;
+    size_t max_threads = 8;
+    char name[64];
+
+
+    if( argc > 1 )
+        max_threads = strtoul(argv[1], NULL, 10);
+
+
+    pthread_mutex_init(&b.mutex, NULL);
+
+    for(b.threads = 1; b.threads <= max_threads; b.threads *= 2)
+    {
+        //n - count of pop+push pairs of all threads
+        snprintf(name, sizeof(name), "cstack/threads_%zu", b.threads);
+        bench_run(name, b.threads * OPS_PER_THREAD, 11, setup, run_cstack, &b);
+
+        snprintf(name, sizeof(name), "mutex+stack/threads_%zu", b.threads);
+        bench_run(name, b.threads * OPS_PER_THREAD, 11, setup, run_mutex_stack, &b);
+    }
+
+    pthread_mutex_destroy(&b.mutex);
+
+
+    return 0;
+}
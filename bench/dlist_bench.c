@@ -0,0 +1,323 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <stdint.h>
+
+
+
+#include "bench.h"
+#include "dlist.h"
+#include "dqueue.h"
+
+
+
+
+
+/*
+ * Throughput of the base operations of dlist.h and dqueue.h
+ * for contiguous and shuffled layout of the nodes (see bench_layout).
+ *
+ * usage: dlist_bench [max_pow]   //sizes 10^3 .. 10^max_pow (default 6)
+ */
+
+
+
+
+
+struct tmp_data
+{
+    struct dlist_head list;
+    int               key;
+};
+
+
+
+struct dlist_bench
+{
+    struct dlist_head  head;
+    struct dqueue_t    dqueue;
+    struct dqueue_t    dqueue2;
+    struct tmp_data   *nodes;
+    size_t            *order;  //order of linking of the nodes
+    size_t             size;
+    uint64_t           seed;
+    volatile uintptr_t sink;   //result of the algorithm (do not optimize out)
+};
+
+
+
+static int pred_key(const struct dlist_head *node, void *data)
+{
+    struct tmp_data *d = dlist_data(node, struct tmp_data, list);
+
+    return d->key == *(int *)data;
+}
+
+
+
+static void setup_empty(void *data)
+{
+    struct dlist_bench *b = data;
+
+    dlist_init_head(&b->head);
+    dqueue_init(&b->dqueue);
+    dqueue_init(&b->dqueue2);
+}
+
+
+
+static void setup_dlist(void *data)
+{
+    struct dlist_bench *b = data;
+    size_t i;
+
+
+    dlist_init_head(&b->head);
+
+    for(i = 0; i < b->size; i++)
+        dlist_push_back(&b->nodes[b->order[i]].list, &b->head);
+}
+
+
+
+static void setup_dqueue(void *data)
+{
+    struct dlist_bench *b = data;
+    size_t i;
+
+
+    dqueue_init(&b->dqueue);
+    dqueue_init(&b->dqueue2);
+
+    for(i = 0; i < b->size; i++)
+        dqueue_push_back(&b->nodes[b->order[i]].list, &b->dqueue);
+}
+
+
+
+static void run_dlist_push_back(void *data)
+{
+    struct dlist_bench *b = data;
+    size_t i;
+
+    for(i = 0; i < b->size; i++)
+        dlist_push_back(&b->nodes[b->order[i]].list, &b->head);
+}
+
+
+
+static void run_dlist_pop_front(void *data)
+{
+    struct dlist_bench *b = data;
+
+    while( !dlist_empty(&b->head) )
+        dlist_pop_front(&b->head);
+}
+
+
+
+static void run_dlist_pop_back(void *data)
+{
+    struct dlist_bench *b = data;
+
+    while( !dlist_empty(&b->head) )
+        dlist_pop_back(&b->head);
+}
+
+
+
+static void run_dlist_del(void *data)
+{
+    struct dlist_bench *b = data;
+    size_t i;
+
+    for(i = 0; i < b->size; i++)  //in order of memory (random order in the list for shuffled)
+        dlist_del(&b->nodes[i].list);
+}
+
+
+
+static void run_dlist_size(void *data)
+{
+    struct dlist_bench *b = data;
+
+    b->sink = dlist_size(&b->head);
+}
+
+
+
+static void run_dlist_find2(void *data)
+{
+    struct dlist_bench *b = data;
+    int key = -1;  //no such key - full pass
+
+    b->sink = (uintptr_t)dlist_find2(b->head.next, &b->head, pred_key, &key);
+}
+
+
+
+static void run_dlist_reverse(void *data)
+{
+    struct dlist_bench *b = data;
+
+    dlist_reverse(&b->head);
+}
+
+
+
+static void run_dqueue_push_back(void *data)
+{
+    struct dlist_bench *b = data;
+    size_t i;
+
+    for(i = 0; i < b->size; i++)
+        dqueue_push_back(&b->nodes[b->order[i]].list, &b->dqueue);
+}
+
+
+
+static void run_dqueue_pop_front(void *data)
+{
+    struct dlist_bench *b = data;
+
+    while( !dqueue_empty(&b->dqueue) )
+        dqueue_pop_front(&b->dqueue);
+}
+
+
+
+//move all nodes one by one to the other dqueue (FIFO -> FIFO)
+static void run_dqueue_move(void *data)
+{
+    struct dlist_bench *b = data;
+    dqueue_node *node;
+
+    while( !dqueue_empty(&b->dqueue) )
+    {
+        node = dqueue_begin(&b->dqueue);
+        dqueue_pop_front(&b->dqueue);
+        dqueue_push_back(node, &b->dqueue2);
+    }
+}
+
+
+
+//size times splice of all nodes between two dqueues (O(1) each)
+static void run_dqueue_splice(void *data)
+{
+    struct dlist_bench *b = data;
+    size_t i;
+
+    for(i = 0; i < b->size; i++)
+    {
+        if( i & 1 )
+            dqueue_splice_back(&b->dqueue2, &b->dqueue);
+        else
+            dqueue_splice_back(&b->dqueue, &b->dqueue2);
+    }
+}
+
+
+
+//move the front half to the other dqueue node by node (e.g. expired entries)
+static void run_dqueue_move_half(void *data)
+{
+    struct dlist_bench *b = data;
+    dqueue_node *node;
+    size_t i;
+
+
+    for(i = 0; i < b->size/2; i++)
+    {
+        node = dqueue_begin(&b->dqueue);
+        dqueue_pop_front(&b->dqueue);
+        dqueue_push_back(node, &b->dqueue2);
+    }
+}
+
+
+
+//the same by one cut (the last node of the half is known, count is computed)
+static void run_dqueue_cut_half(void *data)
+{
+    struct dlist_bench *b = data;
+
+    dqueue_cut_position(&b->nodes[b->order[b->size/2 - 1]].list, &b->dqueue, &b->dqueue2);
+}
+
+
+
+//the same by one splice (the first node after the half and count are known)
+static void run_dqueue_splice_half(void *data)
+{
+    struct dlist_bench *b = data;
+
+    dqueue_splice_range_n(dqueue_begin(&b->dqueue), &b->nodes[b->order[b->size/2]].list,
+                          b->size/2, &b->dqueue, dqueue_end(&b->dqueue2), &b->dqueue2);
+}
+
+
+
+static void run_dqueue_find2(void *data)
+{
+    struct dlist_bench *b = data;
+    int key = -1;  //no such key - full pass
+
+    b->sink = (uintptr_t)dqueue_find2(dqueue_begin(&b->dqueue), dqueue_end(&b->dqueue),
+                                      pred_key, &key);
+}
+
+
+
+int main(int argc, char *argv[])
+{
+    struct dlist_bench b;
+    size_t max_pow = 6, pow, i, reps;
+    int layout;
+
+
+    if( argc > 1 )
+        max_pow = strtoul(argv[1], NULL, 10);
+
+
+    b.seed = 0x9E3779B97F4A7C15ull;
+
+    for(pow = 3, b.size = 1000; pow <= max_pow; pow++, b.size *= 10)
+    {
+        b.nodes = malloc(b.size * sizeof(struct tmp_data));
+        b.order = malloc(b.size * sizeof(size_t));
+        if( !b.nodes || !b.order )
+            return 1;
+
+        for(i = 0; i < b.size; i++)
+            b.nodes[i].key = (int)i;
+
+        reps = bench_reps(b.size);
+
+        for(layout = BENCH_LAYOUT_CONTIGUOUS; layout <= BENCH_LAYOUT_SHUFFLED; layout++)
+        {
+            bench_layout(b.order, b.size, layout, &b.seed);
+
+            bench_run_layout("dlist_push_back",    layout, b.size, reps, setup_empty,  run_dlist_push_back,    &b);
+            bench_run_layout("dlist_pop_front",    layout, b.size, reps, setup_dlist,  run_dlist_pop_front,    &b);
+            bench_run_layout("dlist_pop_back",     layout, b.size, reps, setup_dlist,  run_dlist_pop_back,     &b);
+            bench_run_layout("dlist_del",          layout, b.size, reps, setup_dlist,  run_dlist_del,          &b);
+            bench_run_layout("dlist_size",         layout, b.size, reps, setup_dlist,  run_dlist_size,         &b);
+            bench_run_layout("dlist_find2",        layout, b.size, reps, setup_dlist,  run_dlist_find2,        &b);
+            bench_run_layout("dlist_reverse",      layout, b.size, reps, setup_dlist,  run_dlist_reverse,      &b);
+            bench_run_layout("dqueue_push_back",   layout, b.size, reps, setup_empty,  run_dqueue_push_back,   &b);
+            bench_run_layout("dqueue_pop_front",   layout, b.size, reps, setup_dqueue, run_dqueue_pop_front,   &b);
+            bench_run_layout("dqueue_move",        layout, b.size, reps, setup_dqueue, run_dqueue_move,        &b);
+            bench_run_layout("dqueue_splice",      layout, b.size, reps, setup_dqueue, run_dqueue_splice,      &b);
+            bench_run_layout("dqueue_move_half",   layout, b.size, reps, setup_dqueue, run_dqueue_move_half,   &b);
+            bench_run_layout("dqueue_cut_half",    layout, b.size, reps, setup_dqueue, run_dqueue_cut_half,    &b);
+            bench_run_layout("dqueue_splice_half", layout, b.size, reps, setup_dqueue, run_dqueue_splice_half, &b);
+            bench_run_layout("dqueue_find2",       layout, b.size, reps, setup_dqueue, run_dqueue_find2,       &b);
+        }
+
+        free(b.order);
+        free(b.nodes);
+    }
+
+
+    return 0;
+}
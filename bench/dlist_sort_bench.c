@@ -0,0 +1,202 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <stdint.h>
+
+
+
+#include "bench.h"
+#include "dqueue.h"
+
+
+
+
+
+/*
+ * dqueue_sort (natural merge sort) on different patterns of data
+ * versus the "copy node pointers into array, qsort and relink" way.
+ *
+ * usage: dlist_sort_bench [max_pow]   //sizes 10^3 .. 10^max_pow (default 6)
+ */
+
+
+
+
+
+struct tmp_data
+{
+    dqueue_node node;
+    int64_t     timestamp;
+};
+
+
+
+enum pattern_t
+{
+    PATTERN_SORTED,
+    PATTERN_ALMOST_SORTED,  //timestamps arriving slightly out of order
+    PATTERN_REVERSED,
+    PATTERN_RANDOM
+};
+
+
+
+static const char *pattern_names[] =
+{
+    "sorted",
+    "almost_sorted",
+    "reversed",
+    "random"
+};
+
+
+
+struct sort_bench
+{
+    struct dqueue_t  dqueue;
+    struct tmp_data *nodes;
+    size_t           size;
+    int              pattern;
+    uint64_t         seed;
+};
+
+
+
+static int comp_less(const dqueue_node *n1, const dqueue_node *n2)
+{
+    struct tmp_data *d1 = dqueue_data(n1, struct tmp_data, node);
+    struct tmp_data *d2 = dqueue_data(n2, struct tmp_data, node);
+
+    return d1->timestamp < d2->timestamp;
+}
+
+
+
+static int qsort_cmp(const void *p1, const void *p2)
+{
+    const dqueue_node *n1 = *(dqueue_node * const *)p1;
+    const dqueue_node *n2 = *(dqueue_node * const *)p2;
+
+    if( comp_less(n1, n2) )
+        return -1;
+
+    return comp_less(n2, n1);
+}
+
+
+
+static void setup(void *data)
+{
+    struct sort_bench *b = data;
+    size_t i;
+    int64_t ts;
+
+
+    dqueue_init(&b->dqueue);
+
+    for(i = 0; i < b->size; i++)
+    {
+        switch( b->pattern )
+        {
+            case PATTERN_SORTED:
+                ts = (int64_t)i * 100;
+                break;
+
+            case PATTERN_ALMOST_SORTED:
+                ts = (int64_t)i * 100 + (int64_t)(bench_rand(&b->seed) % 1000);  //jitter +-5 positions
+                break;
+
+            case PATTERN_REVERSED:
+                ts = (int64_t)(b->size - i) * 100;
+                break;
+
+            default:
+                ts = (int64_t)(bench_rand(&b->seed) >> 1);
+                break;
+        }
+
+        b->nodes[i].timestamp = ts;
+        dqueue_push_back(&b->nodes[i].node, &b->dqueue);
+    }
+}
+
+
+
+static void run_dqueue_sort(void *data)
+{
+    struct sort_bench *b = data;
+
+    dqueue_sort(&b->dqueue, comp_less);
+}
+
+
+
+static void run_qsort(void *data)
+{
+    struct sort_bench *b = data;
+    dqueue_node **array, *it, *prev;
+    size_t i, size = 0;
+
+
+    array = malloc(b->size * sizeof(dqueue_node *));
+    if( !array )
+        return;
+
+    dqueue_citer(it, &b->dqueue)
+        array[size++] = it;
+
+
+    qsort(array, size, sizeof(dqueue_node *), qsort_cmp);
+
+
+    prev = &b->dqueue.head;
+    for(i = 0; i < size; i++)
+    {
+        prev->next     = array[i];
+        array[i]->prev = prev;
+        prev           = array[i];
+    }
+    prev->next         = &b->dqueue.head;
+    b->dqueue.head.prev = prev;
+
+
+    free(array);
+}
+
+
+
+int main(int argc, char *argv[])
+{
+    struct sort_bench b;
+    size_t max_pow = 6, pow, reps;
+    char name[64];
+
+
+    if( argc > 1 )
+        max_pow = strtoul(argv[1], NULL, 10);
+
+
+    b.seed = 0x9E3779B97F4A7C15ull;
+
+    for(pow = 3, b.size = 1000; pow <= max_pow; pow++, b.size *= 10)
+    {
+        b.nodes = malloc(b.size * sizeof(struct tmp_data));
+        if( !b.nodes )
+            return 1;
+
+        reps = bench_reps(b.size);
+
+        for(b.pattern = PATTERN_SORTED; b.pattern <= PATTERN_RANDOM; b.pattern++)
+        {
+            snprintf(name, sizeof(name), "dqueue_sort/%s", pattern_names[b.pattern]);
+            bench_run(name, b.size, reps, setup, run_dqueue_sort, &b);
+
+            snprintf(name, sizeof(name), "copy+qsort/%s", pattern_names[b.pattern]);
+            bench_run(name, b.size, reps, setup, run_qsort, &b);
+        }
+
+        free(b.nodes);
+    }
+
+
+    return 0;
+}
@@ -0,0 +1,314 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <stdint.h>
+#include <string.h>
+
+
+
+#include "bench.h"
+#include "dlist.h"
+#include "htable.h"
+
+
+
+
+
+/*
+ * htable.h (buckets are hlist_head: one pointer) vs the same chaining
+ * hash table with dlist_head buckets (two pointers, every empty bucket
+ * points to itself) on contiguous and shuffled layout of the nodes
+ * (see bench_layout). Both tables have the same count of buckets
+ * (the power of 2 >= n, load factor ~1), the same hash of the keys and
+ * the keys are compared by the function pointer in both.
+ *
+ * lookup_hit  - lookup of every key (random order)
+ * lookup_miss - lookup of n keys that are not in the table
+ * insert      - insert of n nodes into the empty table (buckets are allocated)
+ * insert_grow - htable only: insert of n nodes from HTABLE_MIN_BUCKETS
+ *               (incremental rehash)
+ *
+ * usage: htable_bench [max_pow]   //n = 10^3 .. 10^max_pow (default 6)
+ */
+
+
+
+
+
+struct tmp_data
+{
+    uint64_t           key;
+    struct htable_node hnode;        //node of htable
+    struct dlist_head  dnode;        //node of the dlist bucket table
+    size_t             dhash;
+    char               payload[8];
+};
+
+
+
+struct dtable_t
+{
+    struct dlist_head *buckets;
+    size_t             mask;
+    int (*eq_func)(const struct tmp_data *node, uint64_t key);
+};
+
+
+
+struct htable_bench
+{
+    struct htable_t       htable;
+    struct dtable_t       dtable;
+    struct tmp_data      *nodes;
+    size_t               *order;    //order of inserts of the nodes
+    uint64_t             *keys;     //order of lookups (keys)
+    size_t                size;
+    volatile uintptr_t    sink;     //result of the algorithm (do not optimize out)
+};
+
+
+
+static size_t hash_key(uint64_t key)
+{
+    key ^= key >> 33;
+    key *= 0xFF51AFD7ED558CCDull;
+    key ^= key >> 33;
+
+    return (size_t)key;
+}
+
+
+
+// keys of the nodes are odd, the keys for miss are even
+static uint64_t node_key(size_t i)
+{
+    return ((uint64_t)i * 0x9E3779B97F4A7C15ull) | 1;
+}
+
+
+
+static int key_eq(const struct htable_node *node, const void *key)
+{
+    const struct tmp_data *d = htable_data(node, const struct tmp_data, hnode);
+
+    return d->key == *(const uint64_t *)key;
+}
+
+
+
+static int dkey_eq(const struct tmp_data *node, uint64_t key)
+{
+    return node->key == key;
+}
+
+
+
+static void dtable_insert(struct dtable_t *dt, struct tmp_data *node, size_t hash)
+{
+    node->dhash = hash;
+    dlist_push_front(&node->dnode, &dt->buckets[hash & dt->mask]);
+}
+
+
+
+static struct tmp_data* dtable_lookup(const struct dtable_t *dt, size_t hash, uint64_t key)
+{
+    const struct dlist_head *bucket = &dt->buckets[hash & dt->mask];
+    struct dlist_head *it;
+    struct tmp_data *node;
+
+
+    dlist_citer(it, bucket)
+    {
+        node = dlist_data(it, struct tmp_data, dnode);
+
+        if( node->dhash == hash && dt->eq_func(node, key) )
+            return node;
+    }
+
+    return NULL;
+}
+
+
+
+static void setup_dtable(void *data)
+{
+    struct htable_bench *b = data;
+
+    for(size_t i = 0; i <= b->dtable.mask; i++)
+        dlist_init_head(&b->dtable.buckets[i]);
+}
+
+
+
+static void setup_htable(void *data)
+{
+    struct htable_bench *b = data;
+
+    htable_free(&b->htable);
+    htable_init(&b->htable, b->size, key_eq);
+
+    //calloc can map the pages lazily, fault them in here (not in the run)
+    memset(b->htable.buckets, 0, htable_buckets(&b->htable) * sizeof(struct hlist_head));
+}
+
+
+
+static void setup_htable_grow(void *data)
+{
+    struct htable_bench *b = data;
+
+    htable_free(&b->htable);
+    htable_init(&b->htable, 0, key_eq);
+}
+
+
+
+static void run_dtable_insert(void *data)
+{
+    struct htable_bench *b = data;
+    struct tmp_data *node;
+
+
+    for(size_t i = 0; i < b->size; i++)
+    {
+        node = &b->nodes[b->order[i]];
+        dtable_insert(&b->dtable, node, hash_key(node->key));
+    }
+}
+
+
+
+static void run_htable_insert(void *data)
+{
+    struct htable_bench *b = data;
+    struct tmp_data *node;
+
+
+    for(size_t i = 0; i < b->size; i++)
+    {
+        node = &b->nodes[b->order[i]];
+        htable_insert(&b->htable, &node->hnode, hash_key(node->key));
+    }
+}
+
+
+
+static void run_dtable_lookup(void *data)
+{
+    struct htable_bench *b = data;
+    uintptr_t sum = 0;
+
+
+    for(size_t i = 0; i < b->size; i++)
+        sum += (uintptr_t)dtable_lookup(&b->dtable, hash_key(b->keys[i]), b->keys[i]);
+
+    b->sink = sum;
+}
+
+
+
+static void run_htable_lookup(void *data)
+{
+    struct htable_bench *b = data;
+    uintptr_t sum = 0;
+
+
+    for(size_t i = 0; i < b->size; i++)
+        sum += (uintptr_t)htable_lookup(&b->htable, hash_key(b->keys[i]), &b->keys[i]);
+
+    b->sink = sum;
+}
+
+
+
+static void set_keys(struct htable_bench *b, int miss, uint64_t *seed)
+{
+    bench_layout(b->order, b->size, BENCH_LAYOUT_SHUFFLED, seed);
+
+    for(size_t i = 0; i < b->size; i++)
+        b->keys[i] = miss ? node_key(b->order[i]) & ~(uint64_t)1 : node_key(b->order[i]);
+}
+
+
+
+int main(int argc, char *argv[])
+{
+    struct htable_bench b;
+    size_t max_pow = 6, pow, i, reps;
+    uint64_t seed = 0x9E3779B97F4A7C15ull;
+    char name[64];
+    int layout;
+
+
+    if( argc > 1 )
+        max_pow = strtoul(argv[1], NULL, 10);
+
+
+    for(pow = 3, b.size = 1000; pow <= max_pow; pow++, b.size *= 10)
+    {
+        b.nodes = malloc(b.size * sizeof(struct tmp_data));
+        b.order = malloc(b.size * sizeof(size_t));
+        b.keys  = malloc(b.size * sizeof(uint64_t));
+        if( !b.nodes || !b.order || !b.keys || htable_init(&b.htable, b.size, key_eq) )
+            return 1;
+
+        b.dtable.mask    = htable_buckets(&b.htable) - 1;
+        b.dtable.eq_func = dkey_eq;
+        b.dtable.buckets = malloc((b.dtable.mask + 1) * sizeof(struct dlist_head));
+        if( !b.dtable.buckets )
+            return 1;
+
+        for(i = 0; i < b.size; i++)
+            b.nodes[i].key = node_key(i);
+
+        reps = bench_reps(b.size);
+
+
+        for(layout = BENCH_LAYOUT_CONTIGUOUS; layout <= BENCH_LAYOUT_SHUFFLED; layout++)
+        {
+            bench_layout(b.order, b.size, layout, &seed);
+
+            snprintf(name, sizeof(name), "dlist_table_insert_%zu", b.size);
+            bench_run_layout(name, layout, b.size, reps, setup_dtable, run_dtable_insert, &b);
+
+            snprintf(name, sizeof(name), "htable_insert_%zu", b.size);
+            bench_run_layout(name, layout, b.size, reps, setup_htable, run_htable_insert, &b);
+
+            snprintf(name, sizeof(name), "htable_insert_grow_%zu", b.size);
+            bench_run_layout(name, layout, b.size, reps, setup_htable_grow, run_htable_insert, &b);
+
+
+            //the both tables are filled in the layout order (without rehash)
+            setup_dtable(&b);
+            run_dtable_insert(&b);
+            setup_htable(&b);
+            run_htable_insert(&b);
+
+            set_keys(&b, 0, &seed);
+
+            snprintf(name, sizeof(name), "dlist_table_lookup_hit_%zu", b.size);
+            bench_run_layout(name, layout, b.size, reps, NULL, run_dtable_lookup, &b);
+
+            snprintf(name, sizeof(name), "htable_lookup_hit_%zu", b.size);
+            bench_run_layout(name, layout, b.size, reps, NULL, run_htable_lookup, &b);
+
+            set_keys(&b, 1, &seed);
+
+            snprintf(name, sizeof(name), "dlist_table_lookup_miss_%zu", b.size);
+            bench_run_layout(name, layout, b.size, reps, NULL, run_dtable_lookup, &b);
+
+            snprintf(name, sizeof(name), "htable_lookup_miss_%zu", b.size);
+            bench_run_layout(name, layout, b.size, reps, NULL, run_htable_lookup, &b);
+        }
+
+        htable_free(&b.htable);
+
+        free(b.dtable.buckets);
+        free(b.keys);
+        free(b.order);
+        free(b.nodes);
+    }
+
+
+    return 0;
+}
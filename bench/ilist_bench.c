@@ -0,0 +1,309 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <stdint.h>
+
+
+
+#include "bench.h"
+#include "list.h"
+#include "dlist.h"
+#include "ilist.h"
+#include "idlist.h"
+
+
+
+
+
+/*
+ * Index links (ilist.h, idlist.h) vs pointer links (list.h, dlist.h)
+ * for the nodes in one array (a node is the link and uint32_t key),
+ * contiguous and shuffled layout (see bench_layout):
+ *
+ * push_back - link all the nodes (in order of the layout)
+ * traverse  - sum of the keys of the list
+ * del       - delete all the nodes in order of memory
+ *             (random order in the list for shuffled)
+ * pop_front - pop all the nodes (singly linked lists)
+ *
+ * The size of the nodes is printed to stderr.
+ *
+ * usage: ilist_bench [max_pow]   //sizes 10^3 .. 10^max_pow (default 6)
+ */
+
+
+
+
+
+struct snode
+{
+    struct list_head list;
+    uint32_t         key;
+};
+
+
+
+struct inode
+{
+    struct ilist_node list;
+    uint32_t          key;
+};
+
+
+
+struct dnode
+{
+    struct dlist_head list;
+    uint32_t          key;
+};
+
+
+
+struct idnode
+{
+    struct idlist_node list;
+    uint32_t           key;
+};
+
+
+
+struct ilist_bench
+{
+    struct list_head    shead;
+    struct ilist_head   ihead;
+    struct dlist_head   dhead;
+    struct idlist_head  idhead;
+    struct ilist_base   ibase;
+    struct idlist_base  idbase;
+    struct snode       *snodes;
+    struct inode       *inodes;
+    struct dnode       *dnodes;
+    struct idnode      *idnodes;
+    size_t             *order;  //order of linking of the nodes
+    size_t              size;
+    uint64_t            seed;
+    volatile uint64_t   sink;   //result of the algorithm (do not optimize out)
+};
+
+
+
+static void setup_empty(void *data)
+{
+    struct ilist_bench *b = data;
+
+    list_init_head(&b->shead);
+    ilist_init_head(&b->ihead);
+    dlist_init_head(&b->dhead);
+    idlist_init_head(&b->idhead);
+}
+
+
+
+//the singly linked lists are built by push_front in reverse order (O(1))
+static void setup_lists(void *data)
+{
+    struct ilist_bench *b = data;
+    size_t i;
+
+
+    setup_empty(b);
+
+    for(i = b->size; i > 0; i--)
+    {
+        list_push_front(&b->snodes[b->order[i-1]].list, &b->shead);
+        ilist_push_front(&b->ibase, (uint32_t)b->order[i-1], &b->ihead);
+    }
+
+    for(i = 0; i < b->size; i++)
+    {
+        dlist_push_back(&b->dnodes[b->order[i]].list, &b->dhead);
+        idlist_push_back(&b->idbase, (uint32_t)b->order[i], &b->idhead);
+    }
+}
+
+
+
+static void run_dlist_push_back(void *data)
+{
+    struct ilist_bench *b = data;
+    size_t i;
+
+    for(i = 0; i < b->size; i++)
+        dlist_push_back(&b->dnodes[b->order[i]].list, &b->dhead);
+}
+
+
+
+static void run_idlist_push_back(void *data)
+{
+    struct ilist_bench *b = data;
+    size_t i;
+
+    for(i = 0; i < b->size; i++)
+        idlist_push_back(&b->idbase, (uint32_t)b->order[i], &b->idhead);
+}
+
+
+
+static void run_list_traverse(void *data)
+{
+    struct ilist_bench *b = data;
+    struct snode *it;
+    uint64_t sum = 0;
+
+    list_data_citer(it, &b->shead, struct snode, list)
+        sum += it->key;
+
+    b->sink = sum;
+}
+
+
+
+static void run_ilist_traverse(void *data)
+{
+    struct ilist_bench *b = data;
+    uint64_t sum = 0;
+    uint32_t it;
+
+    ilist_citer(it, &b->ibase, &b->ihead)
+        sum += b->inodes[it].key;
+
+    b->sink = sum;
+}
+
+
+
+static void run_dlist_traverse(void *data)
+{
+    struct ilist_bench *b = data;
+    struct dnode *it;
+    uint64_t sum = 0;
+
+    dlist_data_citer(it, &b->dhead, struct dnode, list)
+        sum += it->key;
+
+    b->sink = sum;
+}
+
+
+
+static void run_idlist_traverse(void *data)
+{
+    struct ilist_bench *b = data;
+    uint64_t sum = 0;
+    uint32_t it;
+
+    idlist_citer(it, &b->idbase, &b->idhead)
+        sum += b->idnodes[it].key;
+
+    b->sink = sum;
+}
+
+
+
+static void run_dlist_del(void *data)
+{
+    struct ilist_bench *b = data;
+    size_t i;
+
+    for(i = 0; i < b->size; i++)
+        dlist_del(&b->dnodes[i].list);
+}
+
+
+
+static void run_idlist_del(void *data)
+{
+    struct ilist_bench *b = data;
+    size_t i;
+
+    for(i = 0; i < b->size; i++)
+        idlist_del(&b->idbase, (uint32_t)i, &b->idhead);
+}
+
+
+
+static void run_list_pop_front(void *data)
+{
+    struct ilist_bench *b = data;
+
+    while( !list_empty(&b->shead) )
+        list_pop_front(&b->shead);
+}
+
+
+
+static void run_ilist_pop_front(void *data)
+{
+    struct ilist_bench *b = data;
+
+    while( ilist_pop_front(&b->ibase, &b->ihead) != ILIST_NIL );
+}
+
+
+
+int main(int argc, char *argv[])
+{
+    struct ilist_bench b;
+    size_t max_pow = 6, pow, i, reps;
+    int layout;
+
+
+    if( argc > 1 )
+        max_pow = strtoul(argv[1], NULL, 10);
+
+
+    fprintf(stderr, "size of node: list %zu, ilist %zu, dlist %zu, idlist %zu bytes\n",
+            sizeof(struct snode), sizeof(struct inode), sizeof(struct dnode),
+            sizeof(struct idnode));
+
+    b.seed = 0x9E3779B97F4A7C15ull;
+
+    for(pow = 3, b.size = 1000; pow <= max_pow; pow++, b.size *= 10)
+    {
+        b.snodes  = malloc(b.size * sizeof(struct snode));
+        b.inodes  = malloc(b.size * sizeof(struct inode));
+        b.dnodes  = malloc(b.size * sizeof(struct dnode));
+        b.idnodes = malloc(b.size * sizeof(struct idnode));
+        b.order   = malloc(b.size * sizeof(size_t));
+        if( !b.snodes || !b.inodes || !b.dnodes || !b.idnodes || !b.order )
+            return 1;
+
+        for(i = 0; i < b.size; i++)
+        {
+            b.snodes[i].key  = (uint32_t)i;
+            b.inodes[i].key  = (uint32_t)i;
+            b.dnodes[i].key  = (uint32_t)i;
+            b.idnodes[i].key = (uint32_t)i;
+        }
+
+        ilist_init_base(&b.ibase, b.inodes, sizeof(struct inode), offsetof(struct inode, list));
+        idlist_init_base(&b.idbase, b.idnodes, sizeof(struct idnode), offsetof(struct idnode, list));
+
+        reps = bench_reps(b.size);
+
+        for(layout = BENCH_LAYOUT_CONTIGUOUS; layout <= BENCH_LAYOUT_SHUFFLED; layout++)
+        {
+            bench_layout(b.order, b.size, layout, &b.seed);
+
+            bench_run_layout("dlist_push_back",  layout, b.size, reps, setup_empty, run_dlist_push_back,  &b);
+            bench_run_layout("idlist_push_back", layout, b.size, reps, setup_empty, run_idlist_push_back, &b);
+            bench_run_layout("list_traverse",    layout, b.size, reps, setup_lists, run_list_traverse,    &b);
+            bench_run_layout("ilist_traverse",   layout, b.size, reps, setup_lists, run_ilist_traverse,   &b);
+            bench_run_layout("dlist_traverse",   layout, b.size, reps, setup_lists, run_dlist_traverse,   &b);
+            bench_run_layout("idlist_traverse",  layout, b.size, reps, setup_lists, run_idlist_traverse,  &b);
+            bench_run_layout("dlist_del",        layout, b.size, reps, setup_lists, run_dlist_del,        &b);
+            bench_run_layout("idlist_del",       layout, b.size, reps, setup_lists, run_idlist_del,       &b);
+            bench_run_layout("list_pop_front",   layout, b.size, reps, setup_lists, run_list_pop_front,   &b);
+            bench_run_layout("ilist_pop_front",  layout, b.size, reps, setup_lists, run_ilist_pop_front,  &b);
+        }
+
+        free(b.order);
+        free(b.idnodes);
+        free(b.dnodes);
+        free(b.inodes);
+        free(b.snodes);
+    }
+
+
+    return 0;
+}
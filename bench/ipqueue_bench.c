@@ -0,0 +1,291 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <stddef.h>
+#include <stdint.h>
+
+
+
+#include "bench.h"
+#include "pqueue.h"
+#include "ipqueue.h"
+
+
+
+
+
+/*
+ * ipqueue.h (indexed heap: remove/update in place) vs pqueue.h with
+ * lazy deletion (a cancelled node stays in the heap until it is popped)
+ * for contiguous and shuffled layout of the nodes (see bench_layout).
+ *
+ * cancel: cancel a half of the nodes (random), then pop all the live nodes
+ * update: change the keys of all the nodes (random), then pop all
+ *
+ * usage: ipqueue_bench [max_pow]   //sizes 10^3 .. 10^max_pow (default 5)
+ */
+
+
+
+
+
+struct tmp_data
+{
+    int64_t key;
+    size_t  pos;        //position in ipqueue
+    int     cancelled;  //for lazy deletion in pqueue
+    char    payload[44];  //one node == one cache line
+};
+
+
+
+struct ipqueue_bench
+{
+    struct ipqueue_t   ipqueue;
+    struct pqueue_t    pqueue;
+    struct tmp_data   *nodes;
+    size_t            *order;   //order of pushes of the nodes
+    size_t            *cancel;  //random order of the nodes for cancel/update
+    size_t             size;
+    uint64_t           seed;
+    volatile uintptr_t sink;    //result of the algorithm (do not optimize out)
+};
+
+
+
+static int cmp_min(void *n1, void *n2)
+{
+    return ((struct tmp_data *)n1)->key <= ((struct tmp_data *)n2)->key;
+}
+
+
+
+static void setup_keys(struct ipqueue_bench *b)
+{
+    size_t i;
+
+    for(i = 0; i < b->size; i++)
+    {
+        b->nodes[i].key       = (int64_t)(bench_rand(&b->seed) >> 40);  //the same range as the steps of update
+        b->nodes[i].pos       = IPQUEUE_INVALID_POS;
+        b->nodes[i].cancelled = 0;
+    }
+}
+
+
+
+static void setup_ipqueue_empty(void *data)
+{
+    struct ipqueue_bench *b = data;
+
+    setup_keys(b);
+    b->ipqueue.size = 0;
+}
+
+
+
+static void setup_ipqueue(void *data)
+{
+    struct ipqueue_bench *b = data;
+    size_t i;
+
+
+    setup_ipqueue_empty(data);
+
+    for(i = 0; i < b->size; i++)
+        ipqueue_push(&b->ipqueue, &b->nodes[b->order[i]]);
+}
+
+
+
+static void setup_pqueue_empty(void *data)
+{
+    struct ipqueue_bench *b = data;
+
+    setup_keys(b);
+    b->pqueue.size = 0;
+}
+
+
+
+static void setup_pqueue(void *data)
+{
+    struct ipqueue_bench *b = data;
+    size_t i;
+
+
+    setup_pqueue_empty(data);
+
+    for(i = 0; i < b->size; i++)
+        pqueue_push(&b->pqueue, &b->nodes[b->order[i]]);
+}
+
+
+
+static void run_ipqueue_push(void *data)
+{
+    struct ipqueue_bench *b = data;
+    size_t i;
+
+    for(i = 0; i < b->size; i++)
+        ipqueue_push(&b->ipqueue, &b->nodes[b->order[i]]);
+}
+
+
+
+static void run_pqueue_push(void *data)
+{
+    struct ipqueue_bench *b = data;
+    size_t i;
+
+    for(i = 0; i < b->size; i++)
+        pqueue_push(&b->pqueue, &b->nodes[b->order[i]]);
+}
+
+
+
+static void run_ipqueue_pop(void *data)
+{
+    struct ipqueue_bench *b = data;
+    uintptr_t sum = 0;
+
+
+    while( b->ipqueue.size )
+    {
+        sum ^= (uintptr_t)ipqueue_top(&b->ipqueue);
+        ipqueue_pop(&b->ipqueue);
+    }
+
+    b->sink = sum;
+}
+
+
+
+static void run_pqueue_pop(void *data)
+{
+    struct ipqueue_bench *b = data;
+    uintptr_t sum = 0;
+
+
+    while( b->pqueue.size )
+    {
+        sum ^= (uintptr_t)pqueue_top(&b->pqueue);
+        pqueue_pop(&b->pqueue);
+    }
+
+    b->sink = sum;
+}
+
+
+
+static void run_ipqueue_cancel(void *data)
+{
+    struct ipqueue_bench *b = data;
+    size_t i;
+
+
+    for(i = 0; i < b->size/2; i++)
+        ipqueue_remove(&b->ipqueue, &b->nodes[b->cancel[i]]);
+
+    run_ipqueue_pop(data);
+}
+
+
+
+static void run_pqueue_lazy_cancel(void *data)
+{
+    struct ipqueue_bench *b = data;
+    struct tmp_data *top;
+    uintptr_t sum = 0;
+    size_t i;
+
+
+    for(i = 0; i < b->size/2; i++)
+        b->nodes[b->cancel[i]].cancelled = 1;
+
+
+    while( b->pqueue.size )
+    {
+        top = pqueue_top(&b->pqueue);
+        pqueue_pop(&b->pqueue);
+
+        if( !top->cancelled )
+            sum ^= (uintptr_t)top;
+    }
+
+    b->sink = sum;
+}
+
+
+
+static void run_ipqueue_update(void *data)
+{
+    struct ipqueue_bench *b = data;
+    struct tmp_data *node;
+    size_t i;
+
+
+    for(i = 0; i < b->size; i++)
+    {
+        node       = &b->nodes[b->cancel[i]];
+        node->key += (int64_t)(bench_rand(&b->seed) >> 40) - (1 << 23);
+        ipqueue_update(&b->ipqueue, node);
+    }
+
+    run_ipqueue_pop(data);
+}
+
+
+
+int main(int argc, char *argv[])
+{
+    struct ipqueue_bench b;
+    size_t max_pow = 5, pow, reps;
+    int layout;
+
+
+    if( argc > 1 )
+        max_pow = strtoul(argv[1], NULL, 10);
+
+
+    b.seed = 0x9E3779B97F4A7C15ull;
+
+    for(pow = 3, b.size = 1000; pow <= max_pow; pow++, b.size *= 10)
+    {
+        b.nodes  = malloc(b.size * sizeof(struct tmp_data));
+        b.order  = malloc(b.size * sizeof(size_t));
+        b.cancel = malloc(b.size * sizeof(size_t));
+        if( !b.nodes || !b.order || !b.cancel )
+            return 1;
+
+        if( ipqueue_init(&b.ipqueue, 0, b.size, cmp_min, offsetof(struct tmp_data, pos)) ||
+            pqueue_init(&b.pqueue, 0, b.size, cmp_min) )
+            return 1;
+
+        bench_layout(b.cancel, b.size, BENCH_LAYOUT_SHUFFLED, &b.seed);
+
+        reps = bench_reps(b.size);
+
+        for(layout = BENCH_LAYOUT_CONTIGUOUS; layout <= BENCH_LAYOUT_SHUFFLED; layout++)
+        {
+            bench_layout(b.order, b.size, layout, &b.seed);
+
+            bench_run_layout("pqueue_push",         layout, b.size, reps, setup_pqueue_empty,  run_pqueue_push,        &b);
+            bench_run_layout("ipqueue_push",        layout, b.size, reps, setup_ipqueue_empty, run_ipqueue_push,       &b);
+            bench_run_layout("pqueue_pop",          layout, b.size, reps, setup_pqueue,        run_pqueue_pop,         &b);
+            bench_run_layout("ipqueue_pop",         layout, b.size, reps, setup_ipqueue,       run_ipqueue_pop,        &b);
+            bench_run_layout("pqueue_lazy_cancel",  layout, b.size, reps, setup_pqueue,        run_pqueue_lazy_cancel, &b);
+            bench_run_layout("ipqueue_cancel",      layout, b.size, reps, setup_ipqueue,       run_ipqueue_cancel,     &b);
+            bench_run_layout("ipqueue_update",      layout, b.size, reps, setup_ipqueue,       run_ipqueue_update,     &b);
+        }
+
+        pqueue_free((struct pqueue_t *)&b.ipqueue);
+        pqueue_free(&b.pqueue);
+
+        free(b.cancel);
+        free(b.order);
+        free(b.nodes);
+    }
+
+
+    return 0;
+}
@@ -0,0 +1,281 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <stdint.h>
+
+
+
+#include "bench.h"
+#include "pqueue.h"
+#include "kpqueue.h"
+
+
+
+
+
+/*
+ * kpqueue.h (keys inline in the heap array) vs pqueue.h (void* items,
+ * the keys are in the nodes) for contiguous and shuffled layout of
+ * the nodes (see bench_layout).
+ *
+ * pqueue    - binary heap of void*, cmp_func dereferences the nodes
+ * pqueue4   - 4-ary heap of void*
+ * kpqueue2  - binary heap of {uint64_t key, void *item}
+ * kpqueue4  - 4-ary heap of {key, item} (kpqueue_u64)
+ * kpqueue8  - 8-ary heap of {key, item}
+ *
+ * usage: kpqueue_bench [max_pow]   //sizes 10^3 .. 10^max_pow (default 6)
+ */
+
+
+
+
+
+struct tmp_data
+{
+    uint64_t key;
+    char     payload[56];  //one node == one cache line
+};
+
+
+
+DEFINE_KPQUEUE(kpqueue2, uint64_t, 2, a->key < b->key)
+DEFINE_KPQUEUE(kpqueue8, uint64_t, 8, a->key < b->key)
+
+
+
+struct kpqueue_bench
+{
+    struct pqueue_t       pqueue;
+    struct kpqueue2_t     kpqueue2;
+    struct kpqueue_u64_t  kpqueue4;
+    struct kpqueue8_t     kpqueue8;
+    struct tmp_data      *nodes;
+    size_t               *order;  //order of pushes of the nodes
+    size_t                size;
+    uint64_t              seed;
+    volatile uintptr_t    sink;   //result of the algorithm (do not optimize out)
+};
+
+
+
+static int cmp_min(void *n1, void *n2)
+{
+    return ((struct tmp_data *)n1)->key <= ((struct tmp_data *)n2)->key;
+}
+
+
+
+static void setup_keys(struct kpqueue_bench *b)
+{
+    size_t i;
+
+    for(i = 0; i < b->size; i++)
+        b->nodes[i].key = bench_rand(&b->seed) >> 40;  //the same range as the steps of hold
+}
+
+
+
+// setup, push, pop and hold (see pqueue_bench.c) for void* heaps
+#define DEFINE_PQUEUE_BENCH(name, push, top, pop)                           \
+                                                                            \
+static void setup_##name##_empty(void *data)                                \
+{                                                                           \
+    struct kpqueue_bench *b = data;                                         \
+                                                                            \
+    setup_keys(b);                                                          \
+    b->pqueue.size = 0;                                                     \
+}                                                                           \
+                                                                            \
+static void setup_##name(void *data)                                        \
+{                                                                           \
+    struct kpqueue_bench *b = data;                                         \
+    size_t i;                                                               \
+                                                                            \
+    setup_##name##_empty(data);                                             \
+                                                                            \
+    for(i = 0; i < b->size; i++)                                            \
+        push(&b->pqueue, &b->nodes[b->order[i]]);                           \
+}                                                                           \
+                                                                            \
+static void run_##name##_push(void *data)                                   \
+{                                                                           \
+    struct kpqueue_bench *b = data;                                         \
+    size_t i;                                                               \
+                                                                            \
+    for(i = 0; i < b->size; i++)                                            \
+        push(&b->pqueue, &b->nodes[b->order[i]]);                           \
+}                                                                           \
+                                                                            \
+static void run_##name##_pop(void *data)                                    \
+{                                                                           \
+    struct kpqueue_bench *b = data;                                         \
+    uintptr_t sum = 0;                                                      \
+                                                                            \
+    while( b->pqueue.size )                                                 \
+    {                                                                       \
+        sum ^= (uintptr_t)top(&b->pqueue);                                  \
+        pop(&b->pqueue);                                                    \
+    }                                                                       \
+                                                                            \
+    b->sink = sum;                                                          \
+}                                                                           \
+                                                                            \
+static void run_##name##_hold(void *data)                                   \
+{                                                                           \
+    struct kpqueue_bench *b = data;                                         \
+    struct tmp_data *node;                                                  \
+    size_t i;                                                               \
+                                                                            \
+    for(i = 0; i < b->size; i++)                                            \
+    {                                                                       \
+        node = top(&b->pqueue);                                             \
+        pop(&b->pqueue);                                                    \
+                                                                            \
+        node->key += bench_rand(&b->seed) >> 40;                            \
+        push(&b->pqueue, node);                                             \
+    }                                                                       \
+}
+
+
+
+// setup, push, pop and hold for keyed heaps (the key is copied to the heap)
+#define DEFINE_KPQUEUE_BENCH(name, member)                                  \
+                                                                            \
+static void setup_##name##_empty(void *data)                                \
+{                                                                           \
+    struct kpqueue_bench *b = data;                                         \
+                                                                            \
+    setup_keys(b);                                                          \
+    b->member.size = 0;                                                     \
+}                                                                           \
+                                                                            \
+static void setup_##name(void *data)                                        \
+{                                                                           \
+    struct kpqueue_bench *b = data;                                         \
+    struct tmp_data *node;                                                  \
+    size_t i;                                                               \
+                                                                            \
+    setup_##name##_empty(data);                                             \
+                                                                            \
+    for(i = 0; i < b->size; i++)                                            \
+    {                                                                       \
+        node = &b->nodes[b->order[i]];                                      \
+        name##_push(&b->member, node->key, node);                           \
+    }                                                                       \
+}                                                                           \
+                                                                            \
+static void run_##name##_push(void *data)                                   \
+{                                                                           \
+    struct kpqueue_bench *b = data;                                         \
+    struct tmp_data *node;                                                  \
+    size_t i;                                                               \
+                                                                            \
+    for(i = 0; i < b->size; i++)                                            \
+    {                                                                       \
+        node = &b->nodes[b->order[i]];                                      \
+        name##_push(&b->member, node->key, node);                           \
+    }                                                                       \
+}                                                                           \
+                                                                            \
+static void run_##name##_pop(void *data)                                    \
+{                                                                           \
+    struct kpqueue_bench *b = data;                                         \
+    uintptr_t sum = 0;                                                      \
+                                                                            \
+    while( !name##_empty(&b->member) )                                      \
+    {                                                                       \
+        sum ^= (uintptr_t)name##_top(&b->member);                           \
+        name##_pop(&b->member);                                             \
+    }                                                                       \
+                                                                            \
+    b->sink = sum;                                                          \
+}                                                                           \
+                                                                            \
+static void run_##name##_hold(void *data)                                   \
+{                                                                           \
+    struct kpqueue_bench *b = data;                                         \
+    uint64_t key;                                                           \
+    void *item;                                                             \
+    size_t i;                                                               \
+                                                                            \
+    for(i = 0; i < b->size; i++)                                            \
+    {                                                                       \
+        key  = name##_top_key(&b->member);                                  \
+        item = name##_top(&b->member);                                      \
+        name##_pop(&b->member);                                             \
+                                                                            \
+        name##_push(&b->member, key + (bench_rand(&b->seed) >> 40), item);  \
+    }                                                                       \
+}
+
+
+
+DEFINE_PQUEUE_BENCH(pqueue,  pqueue_push,  pqueue_top,  pqueue_pop)
+DEFINE_PQUEUE_BENCH(pqueue4, pqueue4_push, pqueue4_top, pqueue4_pop)
+
+DEFINE_KPQUEUE_BENCH(kpqueue2,    kpqueue2)
+DEFINE_KPQUEUE_BENCH(kpqueue_u64, kpqueue4)
+DEFINE_KPQUEUE_BENCH(kpqueue8,    kpqueue8)
+
+
+
+#define RUN_BENCH(name, prefix, layout, b, reps)                                                              \
+    do {                                                                                                     \
+        bench_run_layout(name "_push", layout, b.size, reps, setup_##prefix##_empty, run_##prefix##_push, &b); \
+        bench_run_layout(name "_pop",  layout, b.size, reps, setup_##prefix,         run_##prefix##_pop,  &b); \
+        bench_run_layout(name "_hold", layout, b.size, reps, setup_##prefix,         run_##prefix##_hold, &b); \
+    } while(0)
+
+
+
+int main(int argc, char *argv[])
+{
+    struct kpqueue_bench b;
+    size_t max_pow = 6, pow, reps;
+    int layout;
+
+
+    if( argc > 1 )
+        max_pow = strtoul(argv[1], NULL, 10);
+
+
+    b.seed = 0x9E3779B97F4A7C15ull;
+
+    for(pow = 3, b.size = 1000; pow <= max_pow; pow++, b.size *= 10)
+    {
+        b.nodes = malloc(b.size * sizeof(struct tmp_data));
+        b.order = malloc(b.size * sizeof(size_t));
+        if( !b.nodes || !b.order )
+            return 1;
+
+        if( pqueue_init(&b.pqueue, 0, b.size, cmp_min)  ||
+            kpqueue2_init(&b.kpqueue2, 0, b.size)       ||
+            kpqueue_u64_init(&b.kpqueue4, 0, b.size)    ||
+            kpqueue8_init(&b.kpqueue8, 0, b.size) )
+            return 1;
+
+        reps = bench_reps(b.size);
+
+        for(layout = BENCH_LAYOUT_CONTIGUOUS; layout <= BENCH_LAYOUT_SHUFFLED; layout++)
+        {
+            bench_layout(b.order, b.size, layout, &b.seed);
+
+            RUN_BENCH("pqueue",   pqueue,      layout, b, reps);
+            RUN_BENCH("pqueue4",  pqueue4,     layout, b, reps);
+            RUN_BENCH("kpqueue2", kpqueue2,    layout, b, reps);
+            RUN_BENCH("kpqueue4", kpqueue_u64, layout, b, reps);
+            RUN_BENCH("kpqueue8", kpqueue8,    layout, b, reps);
+        }
+
+        kpqueue8_free(&b.kpqueue8);
+        kpqueue_u64_free(&b.kpqueue4);
+        kpqueue2_free(&b.kpqueue2);
+        pqueue_free(&b.pqueue);
+
+        free(b.order);
+        free(b.nodes);
+    }
+
+
+    return 0;
+}
@@ -0,0 +1,208 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <stdint.h>
+
+
+
+#include "bench.h"
+#include "list.h"
+#include "tlist.h"
+
+
+
+
+
+/*
+ * Throughput of the base operations of list.h and tlist.h
+ * for contiguous and shuffled layout of the nodes (see bench_layout).
+ *
+ * usage: list_bench [max_pow]   //sizes 10^3 .. 10^max_pow (default 6)
+ */
+
+
+
+
+
+struct tmp_data
+{
+    struct list_head list;
+    int              key;
+};
+
+
+
+struct list_bench
+{
+    struct list_head   head;
+    struct tlist_head  tlist;
+    struct tmp_data   *nodes;
+    size_t            *order;  //order of linking of the nodes
+    size_t             size;
+    uint64_t           seed;
+    volatile uintptr_t sink;   //result of the algorithm (do not optimize out)
+};
+
+
+
+static int pred_key(const struct list_head *node, void *data)
+{
+    struct tmp_data *d = list_data(node, struct tmp_data, list);
+
+    return d->key == *(int *)data;
+}
+
+
+
+static void setup_empty(void *data)
+{
+    struct list_bench *b = data;
+
+    list_init_head(&b->head);
+    tlist_init_head(&b->tlist);
+}
+
+
+
+static void setup_list(void *data)
+{
+    struct list_bench *b = data;
+    size_t i;
+
+
+    list_init_head(&b->head);
+
+    for(i = b->size; i > 0; i--)
+        list_push_front(&b->nodes[b->order[i-1]].list, &b->head);
+}
+
+
+
+static void setup_tlist(void *data)
+{
+    struct list_bench *b = data;
+    size_t i;
+
+
+    tlist_init_head(&b->tlist);
+
+    for(i = 0; i < b->size; i++)
+        tlist_push_back(&b->nodes[b->order[i]].list, &b->tlist);
+}
+
+
+
+static void run_list_push_front(void *data)
+{
+    struct list_bench *b = data;
+    size_t i;
+
+    for(i = 0; i < b->size; i++)
+        list_push_front(&b->nodes[b->order[i]].list, &b->head);
+}
+
+
+
+static void run_list_pop_front(void *data)
+{
+    struct list_bench *b = data;
+
+    while( !list_empty(&b->head) )
+        list_pop_front(&b->head);
+}
+
+
+
+static void run_list_size(void *data)
+{
+    struct list_bench *b = data;
+
+    b->sink = list_size(&b->head);
+}
+
+
+
+static void run_list_find2(void *data)
+{
+    struct list_bench *b = data;
+    int key = -1;  //no such key - full pass
+
+    b->sink = (uintptr_t)list_find2(b->head.next, &b->head, pred_key, &key);
+}
+
+
+
+static void run_list_reverse(void *data)
+{
+    struct list_bench *b = data;
+
+    list_reverse(&b->head);
+}
+
+
+
+static void run_tlist_push_back(void *data)
+{
+    struct list_bench *b = data;
+    size_t i;
+
+    for(i = 0; i < b->size; i++)
+        tlist_push_back(&b->nodes[b->order[i]].list, &b->tlist);
+}
+
+
+
+static void run_tlist_pop_front(void *data)
+{
+    struct list_bench *b = data;
+
+    while( !tlist_empty(&b->tlist) )
+        tlist_pop_front(&b->tlist);
+}
+
+
+
+int main(int argc, char *argv[])
+{
+    struct list_bench b;
+    size_t max_pow = 6, pow, i, reps;
+    int layout;
+
+
+    if( argc > 1 )
+        max_pow = strtoul(argv[1], NULL, 10);
+
+
+    b.seed = 0x9E3779B97F4A7C15ull;
+
+    for(pow = 3, b.size = 1000; pow <= max_pow; pow++, b.size *= 10)
+    {
+        b.nodes = malloc(b.size * sizeof(struct tmp_data));
+        b.order = malloc(b.size * sizeof(size_t));
+        if( !b.nodes || !b.order )
+            return 1;
+
+        for(i = 0; i < b.size; i++)
+            b.nodes[i].key = (int)i;
+
+        reps = bench_reps(b.size);
+
+        for(layout = BENCH_LAYOUT_CONTIGUOUS; layout <= BENCH_LAYOUT_SHUFFLED; layout++)
+        {
+            bench_layout(b.order, b.size, layout, &b.seed);
+
+            bench_run_layout("list_push_front", layout, b.size, reps, setup_empty, run_list_push_front, &b);
+            bench_run_layout("list_pop_front",  layout, b.size, reps, setup_list,  run_list_pop_front,  &b);
+            bench_run_layout("list_size",       layout, b.size, reps, setup_list,  run_list_size,       &b);
+            bench_run_layout("list_find2",      layout, b.size, reps, setup_list,  run_list_find2,      &b);
+            bench_run_layout("list_reverse",    layout, b.size, reps, setup_list,  run_list_reverse,    &b);
+            bench_run_layout("tlist_push_back", layout, b.size, reps, setup_empty, run_tlist_push_back, &b);
+            bench_run_layout("tlist_pop_front", layout, b.size, reps, setup_tlist, run_tlist_pop_front, &b);
+        }
+
+        free(b.order);
+        free(b.nodes);
+    }
+
+
+    return 0;
+}
@@ -0,0 +1,152 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <stdint.h>
+
+
+
+#include "bench.h"
+#include "list.h"
+
+
+
+
+
+/*
+ * list_sort versus the "copy node pointers into array, qsort and relink" way.
+ *
+ * usage: list_sort_bench [max_pow]   //sizes 10^3 .. 10^max_pow (default 7)
+ */
+
+
+
+
+
+struct tmp_data
+{
+    struct list_head list;
+    int              key;
+};
+
+
+
+struct sort_bench
+{
+    struct list_head  head;
+    struct tmp_data  *nodes;
+    size_t            size;
+    uint64_t          seed;
+};
+
+
+
+static int comp_less(const struct list_head *n1, const struct list_head *n2)
+{
+    struct tmp_data *d1 = list_data(n1, struct tmp_data, list);
+    struct tmp_data *d2 = list_data(n2, struct tmp_data, list);
+
+    return d1->key < d2->key;
+}
+
+
+
+static int qsort_cmp(const void *p1, const void *p2)
+{
+    const struct list_head *n1 = *(struct list_head * const *)p1;
+    const struct list_head *n2 = *(struct list_head * const *)p2;
+
+    if( comp_less(n1, n2) )
+        return -1;
+
+    return comp_less(n2, n1);
+}
+
+
+
+//random keys, the nodes are linked in order of memory
+static void setup(void *data)
+{
+    struct sort_bench *b = data;
+    size_t i;
+
+
+    list_init_head(&b->head);
+
+    for(i = 0; i < b->size; i++)
+    {
+        b->nodes[i].key = (int)(bench_rand(&b->seed) >> 33);
+        list_push_front(&b->nodes[b->size - i - 1].list, &b->head);
+    }
+}
+
+
+
+static void run_list_sort(void *data)
+{
+    struct sort_bench *b = data;
+
+    list_sort(&b->head, comp_less);
+}
+
+
+
+static void run_qsort(void *data)
+{
+    struct sort_bench *b = data;
+    struct list_head **array, *it, *prev;
+    size_t i, size = 0;
+
+
+    array = malloc(b->size * sizeof(struct list_head *));
+    if( !array )
+        return;
+
+    list_citer(it, &b->head)
+        array[size++] = it;
+
+
+    qsort(array, size, sizeof(struct list_head *), qsort_cmp);
+
+
+    prev = &b->head;
+    for(i = 0; i < size; i++)
+    {
+        prev->next = array[i];
+        prev       = array[i];
+    }
+    prev->next = &b->head;
+
+
+    free(array);
+}
+
+
+
+int main(int argc, char *argv[])
+{
+    struct sort_bench b;
+    size_t max_pow = 7, pow, reps;
+
+
+    if( argc > 1 )
+        max_pow = strtoul(argv[1], NULL, 10);
+
+
+    b.seed = 0x9E3779B97F4A7C15ull;
+
+    for(pow = 3, b.size = 1000; pow <= max_pow; pow++, b.size *= 10)
+    {
+        b.nodes = malloc(b.size * sizeof(struct tmp_data));
+        if( !b.nodes )
+            return 1;
+
+        reps = bench_reps(b.size);
+
+        bench_run("list_sort",  b.size, reps, setup, run_list_sort, &b);
+        bench_run("copy+qsort", b.size, reps, setup, run_qsort,     &b);
+
+        free(b.nodes);
+    }
+
+
+    return 0;
+}
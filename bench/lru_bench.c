@@ -0,0 +1,374 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <stdint.h>
+#include <math.h>
+
+
+
+#include "bench.h"
+#include "stack.h"
+#include "lru.h"
+
+
+
+
+
+/*
+ * lru.h (dqueue_t + intrusive htable_t index) vs the usual ad hoc LRU:
+ * dqueue_move_to_front plus an external chaining hash map, every entry
+ * of the map is allocated (malloc/free) and points to the cached item.
+ *
+ * The access keys are Zipfian (s = BENCH_ZIPF_S) on the universe of
+ * 10 * capacity keys. An access is lookup, on miss a free item gets the key
+ * and is inserted, the evicted item goes back to the free list.
+ * The caches are warm (the warmup run fills them) and are not reset
+ * between the runs. The free list is filled in the layout order
+ * (see bench_layout).
+ *
+ * The results are named <cache>_zipf_c<capacity>, every run is
+ * BENCH_ACCESSES accesses, the hit ratio is printed to stderr.
+ *
+ * usage: lru_bench [max_pow]   //capacity 10^3 .. 10^max_pow (default 5)
+ */
+
+
+
+
+
+#define BENCH_ACCESSES  1000000
+#define BENCH_ZIPF_S    0.99
+
+
+
+struct tmp_data
+{
+    struct lru_node    node;         //for lru_t
+    dqueue_node        list;         //for the ad hoc LRU
+    struct list_head   free;         //free list of the items
+    uint64_t           key;
+    char               payload[16];
+};
+
+
+
+struct map_entry
+{
+    struct map_entry *next;
+    uint64_t          key;
+    struct tmp_data  *item;
+};
+
+
+
+struct adhoc_lru
+{
+    struct dqueue_t    queue;
+    struct map_entry **buckets;
+    size_t             mask;
+    size_t             hits;
+};
+
+
+
+struct lru_bench
+{
+    struct lru_t          lru;
+    struct adhoc_lru      adhoc;
+    struct tmp_data      *items;
+    struct stack_t        free_items;
+    uint64_t             *keys;     //access sequence
+    size_t                capacity;
+    volatile uintptr_t    sink;     //result of the algorithm (do not optimize out)
+};
+
+
+
+static size_t hash_key(uint64_t key)
+{
+    key ^= key >> 33;
+    key *= 0xFF51AFD7ED558CCDull;
+    key ^= key >> 33;
+
+    return (size_t)key;
+}
+
+
+
+static int key_eq(const struct htable_node *hnode, const void *key)
+{
+    const struct tmp_data *d = lru_hash_data(hnode, const struct tmp_data, node);
+
+    return d->key == *(const uint64_t *)key;
+}
+
+
+
+static struct tmp_data* get_free_item(struct lru_bench *b)
+{
+    struct tmp_data *item = list_data(stack_top(&b->free_items), struct tmp_data, free);
+
+    stack_pop(&b->free_items);
+
+    return item;
+}
+
+
+
+static void put_free_item(struct lru_node *node, void *arg)
+{
+    struct lru_bench *b = arg;
+
+    struct tmp_data *item = lru_data(node, struct tmp_data, node);
+
+    stack_push(&item->free, &b->free_items);
+}
+
+
+
+static struct map_entry** adhoc_find(struct adhoc_lru *c, uint64_t key)
+{
+    struct map_entry **pentry = &c->buckets[hash_key(key) & c->mask];
+
+    while( *pentry && (*pentry)->key != key )
+        pentry = &(*pentry)->next;
+
+    return pentry;
+}
+
+
+
+static void run_lru(void *data)
+{
+    struct lru_bench *b = data;
+    struct lru_node *node;
+    struct tmp_data *item;
+    uintptr_t sum = 0;
+    size_t i, hash;
+
+
+    for(i = 0; i < BENCH_ACCESSES; i++)
+    {
+        hash = hash_key(b->keys[i]);
+        node = lru_lookup(&b->lru, hash, &b->keys[i]);
+
+        if( !node )
+        {
+            item      = get_free_item(b);
+            item->key = b->keys[i];
+            node      = &item->node;
+            lru_insert(&b->lru, node, hash);   //the victim goes to put_free_item
+        }
+
+        sum += (uintptr_t)node;
+    }
+
+    b->sink = sum;
+}
+
+
+
+static void run_adhoc(void *data)
+{
+    struct lru_bench *b = data;
+    struct adhoc_lru *c = &b->adhoc;
+    struct map_entry **pentry, *entry;
+    struct tmp_data *item;
+    uintptr_t sum = 0;
+    size_t i;
+
+
+    for(i = 0; i < BENCH_ACCESSES; i++)
+    {
+        pentry = adhoc_find(c, b->keys[i]);
+
+        if( *pentry )
+        {
+            item = (*pentry)->item;
+            dqueue_move_to_front(&item->list, &c->queue);
+            c->hits++;
+        }
+        else
+        {
+            entry = malloc(sizeof(struct map_entry));
+            if( !entry )
+                exit(1);
+
+            item        = get_free_item(b);
+            item->key   = b->keys[i];
+            entry->key  = item->key;
+            entry->item = item;
+            entry->next = NULL;
+            *pentry     = entry;
+            dqueue_push_front(&item->list, &c->queue);
+
+
+            if( dqueue_size(&c->queue) > b->capacity )
+            {
+                item = dqueue_last_data(&c->queue, struct tmp_data, list);
+                dqueue_pop_back(&c->queue);
+
+                pentry  = adhoc_find(c, item->key);
+                entry   = *pentry;
+                *pentry = entry->next;
+                free(entry);
+
+                stack_push(&item->free, &b->free_items);
+            }
+        }
+
+        sum += (uintptr_t)item;
+    }
+
+    b->sink = sum;
+}
+
+
+
+static void adhoc_clear(struct adhoc_lru *c)
+{
+    struct map_entry *entry;
+    size_t i;
+
+
+    for(i = 0; i <= c->mask; i++)
+    {
+        while( (entry = c->buckets[i]) )
+        {
+            c->buckets[i] = entry->next;
+            free(entry);
+        }
+    }
+
+    dqueue_init(&c->queue);
+    c->hits = 0;
+}
+
+
+
+static void fill_free_items(struct lru_bench *b, const size_t *order)
+{
+    size_t i;
+
+    stack_init(&b->free_items);
+
+    for(i = b->capacity + 1; i > 0; i--)
+        stack_push(&b->items[order[i-1]].free, &b->free_items);
+}
+
+
+
+// Zipf: key of rank r (1..universe) with probability ~ 1/r^s (inverse of CDF)
+static void fill_zipf_keys(uint64_t *keys, size_t n, size_t universe, uint64_t *seed)
+{
+    double *cdf = malloc(universe * sizeof(double));
+    double sum = 0, u;
+    size_t i, lo, hi, mid;
+
+
+    if( !cdf )
+        exit(1);
+
+    for(i = 0; i < universe; i++)
+    {
+        sum   += 1.0 / pow((double)(i + 1), BENCH_ZIPF_S);
+        cdf[i] = sum;
+    }
+
+    for(i = 0; i < n; i++)
+    {
+        u  = (double)(bench_rand(seed) >> 11) / (double)(1ull << 53) * sum;
+        lo = 0;
+        hi = universe - 1;
+
+        while( lo < hi )
+        {
+            mid = (lo + hi) / 2;
+
+            if( cdf[mid] < u )
+                lo = mid + 1;
+            else
+                hi = mid;
+        }
+
+        keys[i] = (uint64_t)lo * 0x9E3779B97F4A7C15ull;   //rank -> key
+    }
+
+    free(cdf);
+}
+
+
+
+int main(int argc, char *argv[])
+{
+    struct lru_bench b;
+    DECLARE_DQUEUE(victims);
+    size_t max_pow = 5, pow, reps, buckets, *order;
+    uint64_t seed = 0x9E3779B97F4A7C15ull;
+    char name[64];
+    int layout;
+
+
+    if( argc > 1 )
+        max_pow = strtoul(argv[1], NULL, 10);
+
+
+    b.keys = malloc(BENCH_ACCESSES * sizeof(uint64_t));
+    if( !b.keys )
+        return 1;
+
+    reps = bench_reps(BENCH_ACCESSES);
+
+    for(pow = 3, b.capacity = 1000; pow <= max_pow; pow++, b.capacity *= 10)
+    {
+        b.items = malloc((b.capacity + 1) * sizeof(struct tmp_data));
+        order   = malloc((b.capacity + 1) * sizeof(size_t));
+        if( !b.items || !order || lru_init(&b.lru, b.capacity, key_eq, put_free_item, &b) )
+            return 1;
+
+        buckets          = htable_buckets(&b.lru.index);   //the same count of buckets
+        b.adhoc.mask     = buckets - 1;
+        b.adhoc.buckets  = calloc(buckets, sizeof(struct map_entry *));
+        if( !b.adhoc.buckets )
+            return 1;
+
+        dqueue_init(&b.adhoc.queue);
+        b.adhoc.hits = 0;
+
+        fill_zipf_keys(b.keys, BENCH_ACCESSES, 10 * b.capacity, &seed);
+
+
+        for(layout = BENCH_LAYOUT_CONTIGUOUS; layout <= BENCH_LAYOUT_SHUFFLED; layout++)
+        {
+            bench_layout(order, b.capacity + 1, layout, &seed);
+
+            fill_free_items(&b, order);
+            snprintf(name, sizeof(name), "lru_zipf_c%zu", b.capacity);
+            bench_run_layout(name, layout, BENCH_ACCESSES, reps, NULL, run_lru, &b);
+            fprintf(stderr, "    hit ratio %.3f\n", (double)lru_hits(&b.lru) /
+                                           (lru_hits(&b.lru) + lru_misses(&b.lru)));
+
+            lru_evict(&b.lru, 0, &victims);
+            lru_reset_stats(&b.lru);
+            dqueue_init(&victims);
+
+
+            fill_free_items(&b, order);
+            snprintf(name, sizeof(name), "adhoc_lru_zipf_c%zu", b.capacity);
+            bench_run_layout(name, layout, BENCH_ACCESSES, reps, NULL, run_adhoc, &b);
+            fprintf(stderr, "    hit ratio %.3f\n", (double)b.adhoc.hits / ((reps + 1) * BENCH_ACCESSES));
+
+            adhoc_clear(&b.adhoc);
+        }
+
+        lru_free(&b.lru);
+
+        free(b.adhoc.buckets);
+        free(order);
+        free(b.items);
+    }
+
+    free(b.keys);
+
+
+    return 0;
+}
@@ -0,0 +1,303 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <stddef.h>
+#include <stdint.h>
+
+
+
+#include "bench.h"
+#include "mmpqueue.h"
+#include "ipqueue.h"
+
+
+
+
+
+/*
+ * mmpqueue.h (min-max heap) vs two indexed heaps (ipqueue.h: a min heap and
+ * a max heap with the positions of every node in both, an item popped from
+ * one heap is removed from the other) for contiguous and shuffled layout
+ * of the nodes (see bench_layout).
+ *
+ * push       - push n nodes
+ * pop_both   - pop min and max in turn until empty
+ * hold_both  - pop min and max, push both back with new keys (size is not changed)
+ *
+ * usage: mmpqueue_bench [max_pow]   //sizes 10^3 .. 10^max_pow (default 5)
+ */
+
+
+
+
+
+struct tmp_data
+{
+    int64_t key;
+    size_t  min_pos;      //position in the min ipqueue
+    size_t  max_pos;      //position in the max ipqueue
+    char    payload[40];  //one node == one cache line
+};
+
+
+
+struct mmpqueue_bench
+{
+    struct mmpqueue_t  mmpqueue;
+    struct ipqueue_t   min_ipqueue;
+    struct ipqueue_t   max_ipqueue;
+    struct tmp_data   *nodes;
+    size_t            *order;  //order of pushes of the nodes
+    size_t             size;
+    uint64_t           seed;
+    volatile uintptr_t sink;   //result of the algorithm (do not optimize out)
+};
+
+
+
+static int cmp_le(void *n1, void *n2)
+{
+    return ((struct tmp_data *)n1)->key <= ((struct tmp_data *)n2)->key;
+}
+
+
+
+static int cmp_ge(void *n1, void *n2)
+{
+    return ((struct tmp_data *)n1)->key >= ((struct tmp_data *)n2)->key;
+}
+
+
+
+static void setup_keys(struct mmpqueue_bench *b)
+{
+    size_t i;
+
+    for(i = 0; i < b->size; i++)
+        b->nodes[i].key = (int64_t)(bench_rand(&b->seed) >> 40);
+}
+
+
+
+static void setup_mmpqueue_empty(void *data)
+{
+    struct mmpqueue_bench *b = data;
+
+    setup_keys(b);
+    b->mmpqueue.size = 0;
+}
+
+
+
+static void setup_mmpqueue(void *data)
+{
+    struct mmpqueue_bench *b = data;
+    size_t i;
+
+
+    setup_mmpqueue_empty(data);
+
+    for(i = 0; i < b->size; i++)
+        mmpqueue_push(&b->mmpqueue, &b->nodes[b->order[i]]);
+}
+
+
+
+static void setup_dual_empty(void *data)
+{
+    struct mmpqueue_bench *b = data;
+
+    setup_keys(b);
+    b->min_ipqueue.size = 0;
+    b->max_ipqueue.size = 0;
+}
+
+
+
+static void dual_push(struct mmpqueue_bench *b, struct tmp_data *node)
+{
+    ipqueue_push(&b->min_ipqueue, node);
+    ipqueue_push(&b->max_ipqueue, node);
+}
+
+
+
+static void setup_dual(void *data)
+{
+    struct mmpqueue_bench *b = data;
+    size_t i;
+
+
+    setup_dual_empty(data);
+
+    for(i = 0; i < b->size; i++)
+        dual_push(b, &b->nodes[b->order[i]]);
+}
+
+
+
+static void run_mmpqueue_push(void *data)
+{
+    struct mmpqueue_bench *b = data;
+    size_t i;
+
+    for(i = 0; i < b->size; i++)
+        mmpqueue_push(&b->mmpqueue, &b->nodes[b->order[i]]);
+}
+
+
+
+static void run_dual_push(void *data)
+{
+    struct mmpqueue_bench *b = data;
+    size_t i;
+
+    for(i = 0; i < b->size; i++)
+        dual_push(b, &b->nodes[b->order[i]]);
+}
+
+
+
+static void run_mmpqueue_pop_both(void *data)
+{
+    struct mmpqueue_bench *b = data;
+    uintptr_t sum = 0;
+
+
+    while( mmpqueue_size(&b->mmpqueue) )
+    {
+        sum ^= (uintptr_t)mmpqueue_min(&b->mmpqueue);
+        mmpqueue_pop_min(&b->mmpqueue);
+
+        sum ^= (uintptr_t)mmpqueue_max(&b->mmpqueue);
+        mmpqueue_pop_max(&b->mmpqueue);
+    }
+
+    b->sink = sum;
+}
+
+
+
+static void run_dual_pop_both(void *data)
+{
+    struct mmpqueue_bench *b = data;
+    struct tmp_data *node;
+    uintptr_t sum = 0;
+
+
+    while( b->min_ipqueue.size )
+    {
+        node = ipqueue_top(&b->min_ipqueue);
+        ipqueue_pop(&b->min_ipqueue);
+        ipqueue_remove(&b->max_ipqueue, node);
+        sum ^= (uintptr_t)node;
+
+        node = ipqueue_top(&b->max_ipqueue);
+        ipqueue_pop(&b->max_ipqueue);
+        ipqueue_remove(&b->min_ipqueue, node);
+        sum ^= (uintptr_t)node;
+    }
+
+    b->sink = sum;
+}
+
+
+
+static void run_mmpqueue_hold_both(void *data)
+{
+    struct mmpqueue_bench *b = data;
+    struct tmp_data *min, *max;
+    size_t i;
+
+
+    for(i = 0; i < b->size; i += 2)
+    {
+        min = mmpqueue_min(&b->mmpqueue);
+        mmpqueue_pop_min(&b->mmpqueue);
+        max = mmpqueue_max(&b->mmpqueue);
+        mmpqueue_pop_max(&b->mmpqueue);
+
+        min->key += (int64_t)(bench_rand(&b->seed) >> 40);
+        max->key -= (int64_t)(bench_rand(&b->seed) >> 40);
+        mmpqueue_push(&b->mmpqueue, min);
+        mmpqueue_push(&b->mmpqueue, max);
+    }
+}
+
+
+
+static void run_dual_hold_both(void *data)
+{
+    struct mmpqueue_bench *b = data;
+    struct tmp_data *min, *max;
+    size_t i;
+
+
+    for(i = 0; i < b->size; i += 2)
+    {
+        min = ipqueue_top(&b->min_ipqueue);
+        ipqueue_pop(&b->min_ipqueue);
+        ipqueue_remove(&b->max_ipqueue, min);
+
+        max = ipqueue_top(&b->max_ipqueue);
+        ipqueue_pop(&b->max_ipqueue);
+        ipqueue_remove(&b->min_ipqueue, max);
+
+        min->key += (int64_t)(bench_rand(&b->seed) >> 40);
+        max->key -= (int64_t)(bench_rand(&b->seed) >> 40);
+        dual_push(b, min);
+        dual_push(b, max);
+    }
+}
+
+
+
+int main(int argc, char *argv[])
+{
+    struct mmpqueue_bench b;
+    size_t max_pow = 5, pow, reps;
+    int layout;
+
+
+    if( argc > 1 )
+        max_pow = strtoul(argv[1], NULL, 10);
+
+
+    b.seed = 0x9E3779B97F4A7C15ull;
+
+    for(pow = 3, b.size = 1000; pow <= max_pow; pow++, b.size *= 10)
+    {
+        b.nodes = malloc(b.size * sizeof(struct tmp_data));
+        b.order = malloc(b.size * sizeof(size_t));
+        if( !b.nodes || !b.order )
+            return 1;
+
+        if( mmpqueue_init(&b.mmpqueue, 0, b.size, cmp_le) ||
+            ipqueue_init(&b.min_ipqueue, 0, b.size, cmp_le, offsetof(struct tmp_data, min_pos)) ||
+            ipqueue_init(&b.max_ipqueue, 0, b.size, cmp_ge, offsetof(struct tmp_data, max_pos)) )
+            return 1;
+
+        reps = bench_reps(b.size);
+
+        for(layout = BENCH_LAYOUT_CONTIGUOUS; layout <= BENCH_LAYOUT_SHUFFLED; layout++)
+        {
+            bench_layout(b.order, b.size, layout, &b.seed);
+
+            bench_run_layout("mmpqueue_push",          layout, b.size, reps, setup_mmpqueue_empty, run_mmpqueue_push,      &b);
+            bench_run_layout("dual_ipqueue_push",      layout, b.size, reps, setup_dual_empty,     run_dual_push,          &b);
+            bench_run_layout("mmpqueue_pop_both",      layout, b.size, reps, setup_mmpqueue,       run_mmpqueue_pop_both,  &b);
+            bench_run_layout("dual_ipqueue_pop_both",  layout, b.size, reps, setup_dual,           run_dual_pop_both,      &b);
+            bench_run_layout("mmpqueue_hold_both",     layout, b.size, reps, setup_mmpqueue,       run_mmpqueue_hold_both, &b);
+            bench_run_layout("dual_ipqueue_hold_both", layout, b.size, reps, setup_dual,           run_dual_hold_both,     &b);
+        }
+
+        pqueue_free((struct pqueue_t *)&b.max_ipqueue);
+        pqueue_free((struct pqueue_t *)&b.min_ipqueue);
+        pqueue_free((struct pqueue_t *)&b.mmpqueue);
+
+        free(b.order);
+        free(b.nodes);
+    }
+
+
+    return 0;
+}
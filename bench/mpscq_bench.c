@@ -0,0 +1,225 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <stdint.h>
+#include <pthread.h>
+#include <sched.h>
+
+
+
+#include "bench.h"
+#include "mpscq.h"
+#include "dqueue.h"
+
+
+
+
+
+/*
+ * Many producers and one consumer: mpscq_t (push + mpscq_drain) versus
+ * dqueue_t guarded by a mutex (push_back under the lock, the consumer
+ * takes all nodes by dqueue_splice_back under the lock).
+ *
+ * usage: mpscq_bench [max_producers]   //1, 2, 4 .. max_producers (default 8)
+ */
+
+
+
+
+
+#define NODES_PER_PRODUCER  200000
+
+
+
+struct tmp_data
+{
+    struct list_head  list;   //for mpscq_t
+    dqueue_node       node;   //for dqueue_t
+    int               key;
+};
+
+
+
+struct mpscq_bench
+{
+    struct mpscq_t   mpscq;
+    struct dqueue_t  dqueue;
+    pthread_mutex_t  mutex;
+    struct tmp_data *nodes;
+    size_t           producers;
+};
+
+
+
+struct producer_arg
+{
+    struct mpscq_bench *b;
+    struct tmp_data    *nodes;
+};
+
+
+
+static void setup(void *data)
+{
+    struct mpscq_bench *b = data;
+
+    mpscq_init(&b->mpscq);
+    dqueue_init(&b->dqueue);
+}
+
+
+
+static void* mpscq_producer(void *data)
+{
+    struct producer_arg *arg = data;
+    size_t i;
+
+    for(i = 0; i < NODES_PER_PRODUCER; i++)
+        mpscq_push(&arg->nodes[i].list, &arg->b->mpscq);
+
+    return NULL;
+}
+
+
+
+static void* dqueue_producer(void *data)
+{
+    struct producer_arg *arg = data;
+    size_t i;
+
+
+    for(i = 0; i < NODES_PER_PRODUCER; i++)
+    {
+        pthread_mutex_lock(&arg->b->mutex);
+        dqueue_push_back(&arg->nodes[i].node, &arg->b->dqueue);
+        pthread_mutex_unlock(&arg->b->mutex);
+    }
+
+    return NULL;
+}
+
+
+
+static size_t mpscq_consume(struct mpscq_bench *b)
+{
+    DECLARE_LIST_HEAD(burst);
+    struct tmp_data *it;
+    size_t count;
+    int64_t sum = 0;
+
+
+    count = mpscq_drain(&b->mpscq, &burst);
+
+    list_data_citer(it, &burst, struct tmp_data, list)
+        sum += it->key;
+
+    return count + (sum < 0);  //sum is always >= 0 (do not optimize out)
+}
+
+
+
+static size_t dqueue_consume(struct mpscq_bench *b)
+{
+    DECLARE_DQUEUE(burst);
+    struct tmp_data *it;
+    int64_t sum = 0;
+
+
+    pthread_mutex_lock(&b->mutex);
+    dqueue_splice_back(&b->dqueue, &burst);
+    pthread_mutex_unlock(&b->mutex);
+
+    dqueue_data_citer(it, &burst, struct tmp_data, node)
+        sum += it->key;
+
+    return dqueue_size(&burst) + (sum < 0);
+}
+
+
+
+static void run_threads(struct mpscq_bench *b, void* (*producer)(void *),
+                        size_t (*consume)(struct mpscq_bench *b))
+{
+    pthread_t           *threads = malloc(b->producers * sizeof(pthread_t));
+    struct producer_arg *args    = malloc(b->producers * sizeof(struct producer_arg));
+    size_t i, count = 0;
+
+
+    if( !threads || !args )
+        goto exit;
+
+    for(i = 0; i < b->producers; i++)
+    {
+        args[i].b     = b;
+        args[i].nodes = &b->nodes[i * NODES_PER_PRODUCER];
+        pthread_create(&threads[i], NULL, producer, &args[i]);
+    }
+
+
+    //the consumer is this thread
+    while( count < b->producers * NODES_PER_PRODUCER )
+    {
+        i = consume(b);
+        if( !i )
+            sched_yield();
+
+        count += i;
+    }
+
+
+    for(i = 0; i < b->producers; i++)
+        pthread_join(threads[i], NULL);
+
+exit:
+    free(args);
+    free(threads);
+}
+
+
+
+static void run_mpscq(void *data)
+{
+    run_threads(data, mpscq_producer, mpscq_consume);
+}
+
+
+
+static void run_mutex_dqueue(void *data)
+{
+    run_threads(data, dqueue_producer, dqueue_consume);
+}
+
+
+
+int main(int argc, char *argv[])
+{
+    struct mpscq_bench b;
+    size_t max_producers = 8;
+    char name[64];
+
+
+    if( argc > 1 )
+        max_producers = strtoul(argv[1], NULL, 10);
+
+
+    b.nodes = calloc(max_producers * NODES_PER_PRODUCER, sizeof(struct tmp_data));
+    if( !b.nodes )
+        return 1;
+
+    pthread_mutex_init(&b.mutex, NULL);
+
+    for(b.producers = 1; b.producers <= max_producers; b.producers *= 2)
+    {
+        //n - count of nodes passed from producers to the consumer
+        snprintf(name, sizeof(name), "mpscq/producers_%zu", b.producers);
+        bench_run(name, b.producers * NODES_PER_PRODUCER, 11, setup, run_mpscq, &b);
+
+        snprintf(name, sizeof(name), "mutex+dqueue/producers_%zu", b.producers);
+        bench_run(name, b.producers * NODES_PER_PRODUCER, 11, setup, run_mutex_dqueue, &b);
+    }
+
+    pthread_mutex_destroy(&b.mutex);
+    free(b.nodes);
+
+
+    return 0;
+}
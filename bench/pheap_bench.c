@@ -0,0 +1,423 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <stddef.h>
+#include <stdint.h>
+
+
+
+#include "bench.h"
+#include "pqueue.h"
+#include "ipqueue.h"
+#include "pheap.h"
+
+
+
+
+
+/*
+ * pheap.h (intrusive pairing heap) vs pqueue.h/ipqueue.h (binary heaps)
+ * for scheduler-style workloads on contiguous and shuffled layout of
+ * the nodes (see bench_layout):
+ *
+ * push, pop  - fill the heap with n nodes, take them all
+ * hold       - pop the top and push it back with a later key (size is not changed)
+ * meld       - merge two heaps of n/2 nodes (pheap_meld vs pqueue_push_n)
+ * decrease   - move n/4 random nodes earlier, then pop all
+ *              (pheap_decrease_key vs ipqueue_update)
+ *
+ * usage: pheap_bench [max_pow]   //sizes 10^3 .. 10^max_pow (default 5)
+ */
+
+
+
+
+
+struct tmp_data
+{
+    int64_t           key;
+    struct pheap_node node;
+    size_t            pos;         //position in ipqueue
+    char              payload[24]; //one node == one cache line
+};
+
+
+
+struct pheap_bench
+{
+    struct pheap_t     pheap;
+    struct pheap_t     pheap2;   //second heap for meld
+    struct pqueue_t    pqueue;
+    struct pqueue_t    pqueue2;
+    struct ipqueue_t   ipqueue;
+    struct tmp_data   *nodes;
+    int64_t           *keys;     //initial keys of the nodes
+    size_t            *order;    //order of pushes of the nodes
+    size_t            *random;   //random order of the nodes for decrease
+    size_t             size;
+    uint64_t           seed;
+    volatile uintptr_t sink;     //result of the algorithm (do not optimize out)
+};
+
+
+
+static int cmp_pheap(void *n1, void *n2)
+{
+    struct tmp_data *d1 = pheap_data(n1, struct tmp_data, node);
+    struct tmp_data *d2 = pheap_data(n2, struct tmp_data, node);
+
+    return d1->key <= d2->key;
+}
+
+
+
+static int cmp_pqueue(void *n1, void *n2)
+{
+    return ((struct tmp_data *)n1)->key <= ((struct tmp_data *)n2)->key;
+}
+
+
+
+static void setup_keys(struct pheap_bench *b)
+{
+    size_t i;
+
+    for(i = 0; i < b->size; i++)
+        b->nodes[i].key = b->keys[i];
+}
+
+
+
+static void setup_pheap_empty(void *data)
+{
+    struct pheap_bench *b = data;
+
+    setup_keys(b);
+    pheap_init(&b->pheap,  cmp_pheap);
+    pheap_init(&b->pheap2, cmp_pheap);
+}
+
+
+
+static void setup_pheap(void *data)
+{
+    struct pheap_bench *b = data;
+    size_t i;
+
+
+    setup_pheap_empty(data);
+
+    for(i = 0; i < b->size; i++)
+        pheap_push(&b->pheap, &b->nodes[b->order[i]].node);
+
+    //pairing heap after n pushes is a star (all nodes are children of the root),
+    //one pop makes it a real tree (as it is after some work)
+    struct pheap_node *top = pheap_top(&b->pheap);
+    pheap_pop(&b->pheap);
+    pheap_push(&b->pheap, top);
+}
+
+
+
+static void setup_pheap_halves(void *data)
+{
+    struct pheap_bench *b = data;
+    size_t i;
+
+
+    setup_pheap_empty(data);
+
+    for(i = 0; i < b->size; i++)
+        pheap_push((i & 1) ? &b->pheap : &b->pheap2, &b->nodes[b->order[i]].node);
+}
+
+
+
+static void setup_pqueue_empty(void *data)
+{
+    struct pheap_bench *b = data;
+
+    setup_keys(b);
+    b->pqueue.size  = 0;
+    b->pqueue2.size = 0;
+}
+
+
+
+static void setup_pqueue(void *data)
+{
+    struct pheap_bench *b = data;
+    size_t i;
+
+
+    setup_pqueue_empty(data);
+
+    for(i = 0; i < b->size; i++)
+        pqueue_push(&b->pqueue, &b->nodes[b->order[i]]);
+}
+
+
+
+static void setup_pqueue_halves(void *data)
+{
+    struct pheap_bench *b = data;
+    size_t i;
+
+
+    setup_pqueue_empty(data);
+
+    for(i = 0; i < b->size; i++)
+        pqueue_push((i & 1) ? &b->pqueue : &b->pqueue2, &b->nodes[b->order[i]]);
+}
+
+
+
+static void setup_ipqueue(void *data)
+{
+    struct pheap_bench *b = data;
+    size_t i;
+
+
+    setup_keys(b);
+    b->ipqueue.size = 0;
+
+    for(i = 0; i < b->size; i++)
+        ipqueue_push(&b->ipqueue, &b->nodes[b->order[i]]);
+}
+
+
+
+static void run_pheap_push(void *data)
+{
+    struct pheap_bench *b = data;
+    size_t i;
+
+    for(i = 0; i < b->size; i++)
+        pheap_push(&b->pheap, &b->nodes[b->order[i]].node);
+}
+
+
+
+static void run_pqueue_push(void *data)
+{
+    struct pheap_bench *b = data;
+    size_t i;
+
+    for(i = 0; i < b->size; i++)
+        pqueue_push(&b->pqueue, &b->nodes[b->order[i]]);
+}
+
+
+
+static void run_pheap_pop(void *data)
+{
+    struct pheap_bench *b = data;
+    uintptr_t sum = 0;
+
+
+    while( !pheap_empty(&b->pheap) )
+    {
+        sum ^= (uintptr_t)pheap_top(&b->pheap);
+        pheap_pop(&b->pheap);
+    }
+
+    b->sink = sum;
+}
+
+
+
+static void run_pqueue_pop(void *data)
+{
+    struct pheap_bench *b = data;
+    uintptr_t sum = 0;
+
+
+    while( b->pqueue.size )
+    {
+        sum ^= (uintptr_t)pqueue_top(&b->pqueue);
+        pqueue_pop(&b->pqueue);
+    }
+
+    b->sink = sum;
+}
+
+
+
+static void run_ipqueue_pop(void *data)
+{
+    struct pheap_bench *b = data;
+    uintptr_t sum = 0;
+
+
+    while( b->ipqueue.size )
+    {
+        sum ^= (uintptr_t)ipqueue_top(&b->ipqueue);
+        ipqueue_pop(&b->ipqueue);
+    }
+
+    b->sink = sum;
+}
+
+
+
+static void run_pheap_hold(void *data)
+{
+    struct pheap_bench *b = data;
+    struct pheap_node *top;
+    struct tmp_data *d;
+    size_t i;
+
+
+    for(i = 0; i < b->size; i++)
+    {
+        top = pheap_top(&b->pheap);
+        pheap_pop(&b->pheap);
+
+        d       = pheap_data(top, struct tmp_data, node);
+        d->key += (int64_t)(bench_rand(&b->seed) >> 40);
+        pheap_push(&b->pheap, top);
+    }
+}
+
+
+
+static void run_pqueue_hold(void *data)
+{
+    struct pheap_bench *b = data;
+    struct tmp_data *top;
+    size_t i;
+
+
+    for(i = 0; i < b->size; i++)
+    {
+        top = pqueue_top(&b->pqueue);
+        pqueue_pop(&b->pqueue);
+
+        top->key += (int64_t)(bench_rand(&b->seed) >> 40);
+        pqueue_push(&b->pqueue, top);
+    }
+}
+
+
+
+static void run_pheap_meld(void *data)
+{
+    struct pheap_bench *b = data;
+
+    pheap_meld(&b->pheap2, &b->pheap);
+    b->sink = (uintptr_t)pheap_top(&b->pheap);
+}
+
+
+
+static void run_pqueue_meld(void *data)
+{
+    struct pheap_bench *b = data;
+
+    pqueue_push_n(&b->pqueue, b->pqueue2.items, b->pqueue2.size);
+    b->pqueue2.size = 0;
+    b->sink = (uintptr_t)pqueue_top(&b->pqueue);
+}
+
+
+
+static void run_pheap_decrease(void *data)
+{
+    struct pheap_bench *b = data;
+    struct tmp_data *d;
+    size_t i;
+
+
+    for(i = 0; i < b->size/4; i++)
+    {
+        d       = &b->nodes[b->random[i]];
+        d->key -= (int64_t)(bench_rand(&b->seed) >> 40);
+        pheap_decrease_key(&b->pheap, &d->node);
+    }
+
+    run_pheap_pop(data);
+}
+
+
+
+static void run_ipqueue_decrease(void *data)
+{
+    struct pheap_bench *b = data;
+    struct tmp_data *d;
+    size_t i;
+
+
+    for(i = 0; i < b->size/4; i++)
+    {
+        d       = &b->nodes[b->random[i]];
+        d->key -= (int64_t)(bench_rand(&b->seed) >> 40);
+        ipqueue_update(&b->ipqueue, d);
+    }
+
+    run_ipqueue_pop(data);
+}
+
+
+
+int main(int argc, char *argv[])
+{
+    struct pheap_bench b;
+    size_t max_pow = 5, pow, i, reps;
+    int layout;
+
+
+    if( argc > 1 )
+        max_pow = strtoul(argv[1], NULL, 10);
+
+
+    b.seed = 0x9E3779B97F4A7C15ull;
+
+    for(pow = 3, b.size = 1000; pow <= max_pow; pow++, b.size *= 10)
+    {
+        b.nodes  = malloc(b.size * sizeof(struct tmp_data));
+        b.keys   = malloc(b.size * sizeof(int64_t));
+        b.order  = malloc(b.size * sizeof(size_t));
+        b.random = malloc(b.size * sizeof(size_t));
+        if( !b.nodes || !b.keys || !b.order || !b.random )
+            return 1;
+
+        if( pqueue_init(&b.pqueue,  0, b.size, cmp_pqueue) ||
+            pqueue_init(&b.pqueue2, 0, b.size, cmp_pqueue) ||
+            ipqueue_init(&b.ipqueue, 0, b.size, cmp_pqueue, offsetof(struct tmp_data, pos)) )
+            return 1;
+
+        for(i = 0; i < b.size; i++)
+            b.keys[i] = (int64_t)(bench_rand(&b.seed) >> 40);  //the same range as the steps of hold
+
+        bench_layout(b.random, b.size, BENCH_LAYOUT_SHUFFLED, &b.seed);
+
+        reps = bench_reps(b.size);
+
+        for(layout = BENCH_LAYOUT_CONTIGUOUS; layout <= BENCH_LAYOUT_SHUFFLED; layout++)
+        {
+            bench_layout(b.order, b.size, layout, &b.seed);
+
+            bench_run_layout("pqueue_push",      layout, b.size, reps, setup_pqueue_empty,  run_pqueue_push,      &b);
+            bench_run_layout("pheap_push",       layout, b.size, reps, setup_pheap_empty,   run_pheap_push,       &b);
+            bench_run_layout("pqueue_pop",       layout, b.size, reps, setup_pqueue,        run_pqueue_pop,       &b);
+            bench_run_layout("pheap_pop",        layout, b.size, reps, setup_pheap,         run_pheap_pop,        &b);
+            bench_run_layout("pqueue_hold",      layout, b.size, reps, setup_pqueue,        run_pqueue_hold,      &b);
+            bench_run_layout("pheap_hold",       layout, b.size, reps, setup_pheap,         run_pheap_hold,       &b);
+            bench_run_layout("pqueue_meld",      layout, b.size, reps, setup_pqueue_halves, run_pqueue_meld,      &b);
+            bench_run_layout("pheap_meld",       layout, b.size, reps, setup_pheap_halves,  run_pheap_meld,       &b);
+            bench_run_layout("ipqueue_decrease", layout, b.size, reps, setup_ipqueue,       run_ipqueue_decrease, &b);
+            bench_run_layout("pheap_decrease",   layout, b.size, reps, setup_pheap,         run_pheap_decrease,   &b);
+        }
+
+        pqueue_free((struct pqueue_t *)&b.ipqueue);
+        pqueue_free(&b.pqueue2);
+        pqueue_free(&b.pqueue);
+
+        free(b.random);
+        free(b.order);
+        free(b.keys);
+        free(b.nodes);
+    }
+
+
+    return 0;
+}
@@ -0,0 +1,208 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <stdint.h>
+
+
+
+#include "bench.h"
+#include "dqueue.h"
+#include "pool.h"
+
+
+
+
+
+/*
+ * pool.h vs malloc for the nodes of dqueue_t on contiguous and shuffled
+ * layout (see bench_layout: the order of linking of the nodes vs the order
+ * of the allocations):
+ *
+ * traverse  - sum of the keys of the dqueue_t (dqueue_data_citer),
+ *             the malloc'd nodes are allocated between other blocks
+ *             of random size (the usual heap of a service), the pooled
+ *             nodes are in the slabs
+ * alloc     - n allocs + n frees of the nodes (malloc/free vs
+ *             pool_alloc/pool_release, the pool has the slabs)
+ *
+ * The results are named <alloc>_<func>_<n>.
+ *
+ * usage: pool_bench [max_pow]   //n = 10^3 .. 10^max_pow (default 6)
+ */
+
+
+
+
+
+struct tmp_data
+{
+    dqueue_node list;
+    uint64_t    key;
+    char        payload[24];
+};
+
+
+
+struct pool_bench
+{
+    struct pool_t         pool;
+    struct dqueue_t       dqueue;
+    struct tmp_data     **nodes;    //nodes in order of the allocations
+    void                **noise;    //other blocks of the heap
+    size_t               *order;    //order of linking of the nodes
+    size_t                size;
+    uint64_t              seed;
+    volatile uintptr_t    sink;     //result of the algorithm (do not optimize out)
+};
+
+
+
+static void run_traverse(void *data)
+{
+    struct pool_bench *b = data;
+    struct tmp_data *it;
+    uint64_t sum = 0;
+
+
+    dqueue_data_citer(it, &b->dqueue, struct tmp_data, list)
+        sum += it->key;
+
+    b->sink = (uintptr_t)sum;
+}
+
+
+
+static void run_malloc_alloc(void *data)
+{
+    struct pool_bench *b = data;
+    size_t i;
+
+
+    for(i = 0; i < b->size; i++)
+        b->nodes[i] = malloc(sizeof(struct tmp_data));
+
+    for(i = 0; i < b->size; i++)
+        free(b->nodes[i]);
+}
+
+
+
+static void run_pool_alloc(void *data)
+{
+    struct pool_bench *b = data;
+    size_t i;
+
+
+    for(i = 0; i < b->size; i++)
+        b->nodes[i] = pool_alloc(&b->pool);
+
+    for(i = 0; i < b->size; i++)
+        pool_release(&b->pool, b->nodes[i]);
+}
+
+
+
+static void link_nodes(struct pool_bench *b)
+{
+    size_t i;
+
+
+    dqueue_init(&b->dqueue);
+
+    for(i = 0; i < b->size; i++)
+    {
+        b->nodes[b->order[i]]->key = i;
+        dqueue_push_back(&b->nodes[b->order[i]]->list, &b->dqueue);
+    }
+}
+
+
+
+int main(int argc, char *argv[])
+{
+    struct pool_bench b;
+    size_t max_pow = 6, pow, i, reps;
+    char name[64];
+    int layout;
+
+
+    if( argc > 1 )
+        max_pow = strtoul(argv[1], NULL, 10);
+
+
+    b.seed = 0x9E3779B97F4A7C15ull;
+
+    if( pool_init(&b.pool, sizeof(struct tmp_data), 0) )
+        return 1;
+
+    for(pow = 3, b.size = 1000; pow <= max_pow; pow++, b.size *= 10)
+    {
+        b.nodes = malloc(b.size * sizeof(struct tmp_data *));
+        b.noise = malloc(b.size * sizeof(void *));
+        b.order = malloc(b.size * sizeof(size_t));
+        if( !b.nodes || !b.noise || !b.order )
+            return 1;
+
+        reps = bench_reps(b.size);
+
+
+        for(layout = BENCH_LAYOUT_CONTIGUOUS; layout <= BENCH_LAYOUT_SHUFFLED; layout++)
+        {
+            bench_layout(b.order, b.size, layout, &b.seed);
+
+            //malloc'd nodes between the other blocks (16 .. 271 bytes)
+            for(i = 0; i < b.size; i++)
+            {
+                b.nodes[i] = malloc(sizeof(struct tmp_data));
+                b.noise[i] = malloc(16 + bench_rand(&b.seed) % 256);
+                if( !b.nodes[i] || !b.noise[i] )
+                    return 1;
+            }
+
+            link_nodes(&b);
+            snprintf(name, sizeof(name), "malloc_traverse_%zu", b.size);
+            bench_run_layout(name, layout, b.size, reps, NULL, run_traverse, &b);
+
+            for(i = 0; i < b.size; i++)
+            {
+                free(b.nodes[i]);
+                free(b.noise[i]);
+            }
+
+
+            //pooled nodes (the same blocks of the heap)
+            for(i = 0; i < b.size; i++)
+            {
+                b.nodes[i] = pool_alloc(&b.pool);
+                b.noise[i] = malloc(16 + bench_rand(&b.seed) % 256);
+                if( !b.nodes[i] || !b.noise[i] )
+                    return 1;
+            }
+
+            link_nodes(&b);
+            snprintf(name, sizeof(name), "pool_traverse_%zu", b.size);
+            bench_run_layout(name, layout, b.size, reps, NULL, run_traverse, &b);
+
+            for(i = 0; i < b.size; i++)
+            {
+                pool_release(&b.pool, b.nodes[i]);
+                free(b.noise[i]);
+            }
+        }
+
+
+        snprintf(name, sizeof(name), "malloc_alloc_%zu", b.size);
+        bench_run(name, b.size, reps, NULL, run_malloc_alloc, &b);
+
+        snprintf(name, sizeof(name), "pool_alloc_%zu", b.size);
+        bench_run(name, b.size, reps, NULL, run_pool_alloc, &b);
+
+        free(b.order);
+        free(b.noise);
+        free(b.nodes);
+    }
+
+    pool_free(&b.pool);
+
+
+    return 0;
+}
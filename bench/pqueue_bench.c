@@ -0,0 +1,301 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <stdint.h>
+
+
+
+#include "bench.h"
+#include "spqueue.h"
+#include "pqueue.h"
+
+
+
+
+
+/*
+ * Throughput of spqueue.h and pqueue.h (min heap of pointers to the nodes
+ * with random keys) for contiguous and shuffled layout of the nodes
+ * (see bench_layout).
+ *
+ * usage: pqueue_bench [max_pow]   //sizes 10^3 .. 10^max_pow (default 5)
+ */
+
+
+
+
+
+struct tmp_data
+{
+    int64_t key;
+    char    payload[56];  //one node == one cache line
+};
+
+
+
+struct pqueue_bench
+{
+    struct spqueue_t   spqueue;
+    struct pqueue_t    pqueue;
+    void             **items;  //storage for spqueue
+    void             **batch;  //pointers to the nodes in order of pushes (for push_n)
+    struct tmp_data   *nodes;
+    size_t            *order;  //order of pushes of the nodes
+    size_t             size;
+    size_t             inc_step;
+    size_t             grow_factor;
+    size_t             reserve;
+    uint64_t           seed;
+    volatile uintptr_t sink;   //result of the algorithm (do not optimize out)
+};
+
+
+
+static int cmp_min(void *n1, void *n2)
+{
+    return ((struct tmp_data *)n1)->key <= ((struct tmp_data *)n2)->key;
+}
+
+
+
+static void setup_spqueue_empty(void *data)
+{
+    struct pqueue_bench *b = data;
+
+    spqueue_init(&b->spqueue, b->items, b->size, cmp_min);
+}
+
+
+
+static void setup_spqueue(void *data)
+{
+    struct pqueue_bench *b = data;
+    size_t i;
+
+
+    spqueue_init(&b->spqueue, b->items, b->size, cmp_min);
+
+    for(i = 0; i < b->size; i++)
+        spqueue_push(&b->spqueue, &b->nodes[b->order[i]]);
+}
+
+
+
+static void setup_pqueue_empty(void *data)
+{
+    struct pqueue_bench *b = data;
+
+    pqueue_free(&b->pqueue);
+    pqueue_init(&b->pqueue, b->inc_step, b->inc_step ? b->inc_step : b->size, cmp_min);
+    pqueue_set_grow_factor(&b->pqueue, b->grow_factor);
+
+    if( b->reserve )
+        pqueue_reserve(&b->pqueue, b->reserve);
+}
+
+
+
+static void setup_pqueue(void *data)
+{
+    struct pqueue_bench *b = data;
+    size_t i;
+
+
+    setup_pqueue_empty(data);
+
+    for(i = 0; i < b->size; i++)
+        pqueue_push(&b->pqueue, &b->nodes[b->order[i]]);
+}
+
+
+
+// items of spqueue in order of pushes, the heap is not built
+static void setup_spqueue_items(void *data)
+{
+    struct pqueue_bench *b = data;
+    size_t i;
+
+    for(i = 0; i < b->size; i++)
+        b->items[i] = &b->nodes[b->order[i]];
+}
+
+
+
+static void run_spqueue_push(void *data)
+{
+    struct pqueue_bench *b = data;
+    size_t i;
+
+    for(i = 0; i < b->size; i++)
+        spqueue_push(&b->spqueue, &b->nodes[b->order[i]]);
+}
+
+
+
+static void run_spqueue_make_heap(void *data)
+{
+    struct pqueue_bench *b = data;
+
+    spqueue_make_heap(&b->spqueue, b->items, b->size, b->size, cmp_min);
+}
+
+
+
+static void run_spqueue_pop(void *data)
+{
+    struct pqueue_bench *b = data;
+    uintptr_t sum = 0;
+
+
+    while( b->spqueue.size )
+    {
+        sum ^= (uintptr_t)spqueue_top(&b->spqueue);
+        spqueue_pop(&b->spqueue);
+    }
+
+    b->sink = sum;
+}
+
+
+
+//hold model: pop the top and push it back with new key (size is not changed)
+static void run_spqueue_hold(void *data)
+{
+    struct pqueue_bench *b = data;
+    struct tmp_data *top;
+    size_t i;
+
+
+    for(i = 0; i < b->size; i++)
+    {
+        top = spqueue_top(&b->spqueue);
+        spqueue_pop(&b->spqueue);
+
+        top->key += (int64_t)(bench_rand(&b->seed) >> 40);
+        spqueue_push(&b->spqueue, top);
+    }
+}
+
+
+
+static void run_pqueue_push(void *data)
+{
+    struct pqueue_bench *b = data;
+    size_t i;
+
+    for(i = 0; i < b->size; i++)
+        pqueue_push(&b->pqueue, &b->nodes[b->order[i]]);
+}
+
+
+
+static void run_pqueue_push_n(void *data)
+{
+    struct pqueue_bench *b = data;
+
+    pqueue_push_n(&b->pqueue, b->batch, b->size);
+}
+
+
+
+static void run_pqueue_push_n_64(void *data)
+{
+    struct pqueue_bench *b = data;
+    size_t i;
+
+    for(i = 0; i < b->size; i += 64)
+        pqueue_push_n(&b->pqueue, b->batch + i, (b->size - i < 64) ? b->size - i : 64);
+}
+
+
+
+static void run_pqueue_pop(void *data)
+{
+    struct pqueue_bench *b = data;
+    uintptr_t sum = 0;
+
+
+    while( b->pqueue.size )
+    {
+        sum ^= (uintptr_t)pqueue_top(&b->pqueue);
+        pqueue_pop(&b->pqueue);
+    }
+
+    b->sink = sum;
+}
+
+
+
+int main(int argc, char *argv[])
+{
+    struct pqueue_bench b;
+    size_t max_pow = 5, pow, i, reps;
+    int layout;
+
+
+    if( argc > 1 )
+        max_pow = strtoul(argv[1], NULL, 10);
+
+
+    b.seed            = 0x9E3779B97F4A7C15ull;
+    b.pqueue.items    = NULL;
+    b.pqueue.capacity = 0;
+
+    for(pow = 3, b.size = 1000; pow <= max_pow; pow++, b.size *= 10)
+    {
+        b.nodes = malloc(b.size * sizeof(struct tmp_data));
+        b.order = malloc(b.size * sizeof(size_t));
+        b.items = malloc(b.size * sizeof(void *));
+        b.batch = malloc(b.size * sizeof(void *));
+        if( !b.nodes || !b.order || !b.items || !b.batch )
+            return 1;
+
+        for(i = 0; i < b.size; i++)
+            b.nodes[i].key = (int64_t)(bench_rand(&b.seed) >> 40);  //the same range as the steps of hold
+
+        reps = bench_reps(b.size);
+
+        for(layout = BENCH_LAYOUT_CONTIGUOUS; layout <= BENCH_LAYOUT_SHUFFLED; layout++)
+        {
+            bench_layout(b.order, b.size, layout, &b.seed);
+
+            for(i = 0; i < b.size; i++)
+                b.batch[i] = &b.nodes[b.order[i]];
+
+            bench_run_layout("spqueue_push", layout, b.size, reps, setup_spqueue_empty, run_spqueue_push, &b);
+            bench_run_layout("spqueue_make_heap", layout, b.size, reps, setup_spqueue_items, run_spqueue_make_heap, &b);
+            bench_run_layout("spqueue_pop",  layout, b.size, reps, setup_spqueue,       run_spqueue_pop,  &b);
+            bench_run_layout("spqueue_hold", layout, b.size, reps, setup_spqueue,       run_spqueue_hold, &b);
+
+            b.inc_step    = 0;  //capacity == size, realloc is not called
+            b.grow_factor = 0;
+            b.reserve     = 0;
+            bench_run_layout("pqueue_push",  layout, b.size, reps, setup_pqueue_empty,  run_pqueue_push,  &b);
+            bench_run_layout("pqueue_pop",   layout, b.size, reps, setup_pqueue,        run_pqueue_pop,   &b);
+            bench_run_layout("pqueue_push_n",          layout, b.size, reps, setup_pqueue_empty, run_pqueue_push_n,    &b);
+            bench_run_layout("pqueue_push_n/batch_64", layout, b.size, reps, setup_pqueue_empty, run_pqueue_push_n_64, &b);
+
+            b.inc_step = 1024;
+            bench_run_layout("pqueue_push/inc_step_1024", layout, b.size, reps, setup_pqueue_empty, run_pqueue_push, &b);
+
+            b.grow_factor = 150;
+            bench_run_layout("pqueue_push/grow_factor_150", layout, b.size, reps, setup_pqueue_empty, run_pqueue_push, &b);
+
+            b.grow_factor = 200;
+            bench_run_layout("pqueue_push/grow_factor_200", layout, b.size, reps, setup_pqueue_empty, run_pqueue_push, &b);
+
+            b.grow_factor = 0;
+            b.reserve     = b.size;
+            bench_run_layout("pqueue_push/reserve",         layout, b.size, reps, setup_pqueue_empty, run_pqueue_push, &b);
+        }
+
+        free(b.batch);
+        free(b.items);
+        free(b.order);
+        free(b.nodes);
+    }
+
+    pqueue_free(&b.pqueue);
+
+
+    return 0;
+}
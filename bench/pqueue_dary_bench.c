@@ -0,0 +1,195 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <stdint.h>
+
+
+
+#include "bench.h"
+#include "spqueue.h"
+
+
+
+
+
+/*
+ * Binary (spqueue_*) vs 4-ary (spqueue4_*) vs 8-ary (spqueue8_*) heap
+ * (min heap of pointers to the nodes with random keys) for contiguous
+ * and shuffled layout of the nodes (see bench_layout).
+ *
+ * usage: pqueue_dary_bench [max_pow]   //sizes 10^3 .. 10^max_pow (default 5)
+ */
+
+
+
+
+
+struct tmp_data
+{
+    int64_t key;
+    char    payload[56];  //one node == one cache line
+};
+
+
+
+struct dary_bench
+{
+    struct spqueue_t   spqueue;
+    void             **items;  //storage for spqueue
+    struct tmp_data   *nodes;
+    size_t            *order;  //order of pushes of the nodes
+    size_t             size;
+    uint64_t           seed;
+    volatile uintptr_t sink;   //result of the algorithm (do not optimize out)
+};
+
+
+
+static int cmp_min(void *n1, void *n2)
+{
+    return ((struct tmp_data *)n1)->key <= ((struct tmp_data *)n2)->key;
+}
+
+
+
+static void setup_empty(void *data)
+{
+    struct dary_bench *b = data;
+
+    spqueue_init(&b->spqueue, b->items, b->size, cmp_min);
+}
+
+
+
+// items in order of pushes, the heap is not built
+static void setup_items(void *data)
+{
+    struct dary_bench *b = data;
+    size_t i;
+
+    for(i = 0; i < b->size; i++)
+        b->items[i] = &b->nodes[b->order[i]];
+}
+
+
+
+// setup, push, make_heap, pop and hold (see pqueue_bench.c) for one arity of the heap
+#define DEFINE_DARY_BENCH(prefix)                                           \
+                                                                            \
+static void setup_##prefix(void *data)                                      \
+{                                                                           \
+    struct dary_bench *b = data;                                            \
+    size_t i;                                                               \
+                                                                            \
+    setup_empty(data);                                                      \
+                                                                            \
+    for(i = 0; i < b->size; i++)                                            \
+        prefix##_push(&b->spqueue, &b->nodes[b->order[i]]);                 \
+}                                                                           \
+                                                                            \
+static void run_##prefix##_push(void *data)                                 \
+{                                                                           \
+    struct dary_bench *b = data;                                            \
+    size_t i;                                                               \
+                                                                            \
+    for(i = 0; i < b->size; i++)                                            \
+        prefix##_push(&b->spqueue, &b->nodes[b->order[i]]);                 \
+}                                                                           \
+                                                                            \
+static void run_##prefix##_make_heap(void *data)                            \
+{                                                                           \
+    struct dary_bench *b = data;                                            \
+                                                                            \
+    prefix##_make_heap(&b->spqueue, b->items, b->size, b->size, cmp_min);   \
+}                                                                           \
+                                                                            \
+static void run_##prefix##_pop(void *data)                                  \
+{                                                                           \
+    struct dary_bench *b = data;                                            \
+    uintptr_t sum = 0;                                                      \
+                                                                            \
+    while( b->spqueue.size )                                                \
+    {                                                                       \
+        sum ^= (uintptr_t)prefix##_top(&b->spqueue);                        \
+        prefix##_pop(&b->spqueue);                                          \
+    }                                                                       \
+                                                                            \
+    b->sink = sum;                                                          \
+}                                                                           \
+                                                                            \
+static void run_##prefix##_hold(void *data)                                 \
+{                                                                           \
+    struct dary_bench *b = data;                                            \
+    struct tmp_data *top;                                                   \
+    size_t i;                                                               \
+                                                                            \
+    for(i = 0; i < b->size; i++)                                            \
+    {                                                                       \
+        top = prefix##_top(&b->spqueue);                                    \
+        prefix##_pop(&b->spqueue);                                          \
+                                                                            \
+        top->key += (int64_t)(bench_rand(&b->seed) >> 40);                  \
+        prefix##_push(&b->spqueue, top);                                    \
+    }                                                                       \
+}
+
+
+
+DEFINE_DARY_BENCH(spqueue)
+DEFINE_DARY_BENCH(spqueue4)
+DEFINE_DARY_BENCH(spqueue8)
+
+
+
+#define RUN_DARY_BENCH(prefix, layout, b, reps)                                                   \
+    do {                                                                                          \
+        bench_run_layout(#prefix "_push", layout, b.size, reps, setup_empty,    run_##prefix##_push, &b); \
+        bench_run_layout(#prefix "_make_heap", layout, b.size, reps, setup_items, run_##prefix##_make_heap, &b); \
+        bench_run_layout(#prefix "_pop",  layout, b.size, reps, setup_##prefix, run_##prefix##_pop,  &b); \
+        bench_run_layout(#prefix "_hold", layout, b.size, reps, setup_##prefix, run_##prefix##_hold, &b); \
+    } while(0)
+
+
+
+int main(int argc, char *argv[])
+{
+    struct dary_bench b;
+    size_t max_pow = 5, pow, i, reps;
+    int layout;
+
+
+    if( argc > 1 )
+        max_pow = strtoul(argv[1], NULL, 10);
+
+
+    b.seed = 0x9E3779B97F4A7C15ull;
+
+    for(pow = 3, b.size = 1000; pow <= max_pow; pow++, b.size *= 10)
+    {
+        b.nodes = malloc(b.size * sizeof(struct tmp_data));
+        b.order = malloc(b.size * sizeof(size_t));
+        b.items = malloc(b.size * sizeof(void *));
+        if( !b.nodes || !b.order || !b.items )
+            return 1;
+
+        for(i = 0; i < b.size; i++)
+            b.nodes[i].key = (int64_t)(bench_rand(&b.seed) >> 40);  //the same range as the steps of hold
+
+        reps = bench_reps(b.size);
+
+        for(layout = BENCH_LAYOUT_CONTIGUOUS; layout <= BENCH_LAYOUT_SHUFFLED; layout++)
+        {
+            bench_layout(b.order, b.size, layout, &b.seed);
+
+            RUN_DARY_BENCH(spqueue,  layout, b, reps);
+            RUN_DARY_BENCH(spqueue4, layout, b, reps);
+            RUN_DARY_BENCH(spqueue8, layout, b, reps);
+        }
+
+        free(b.items);
+        free(b.order);
+        free(b.nodes);
+    }
+
+
+    return 0;
+}
@@ -0,0 +1,232 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <stdint.h>
+
+
+
+#include "bench.h"
+#include "dqueue.h"
+#include "rbtree.h"
+
+
+
+
+
+/*
+ * rbtree.h vs linear search (dqueue_find2) for "find by key"
+ * on contiguous and shuffled layout of the nodes (see bench_layout):
+ *
+ * lookup       - BENCH_LOOKUPS lookups of the random keys (all are found)
+ *                in the dqueue_t by dqueue_find2 and in the tree by rbtree_lookup
+ * lower_bound  - BENCH_LOOKUPS rbtree_lower_bound of the random keys
+ * insert       - insert of n nodes (random keys) into the empty tree
+ * erase        - erase of n nodes (random order) from the full tree
+ *
+ * The results are named <func>_<n>, n = 10^2 .. 10^max_pow.
+ *
+ * usage: rbtree_bench [max_pow]   //n = 10^2 .. 10^max_pow (default 5)
+ */
+
+
+
+
+
+#define BENCH_LOOKUPS  1000
+
+
+
+struct tmp_data
+{
+    struct rbtree_node node;
+    dqueue_node        list;
+    uint64_t           key;
+    char               payload[16];
+};
+
+
+
+struct rbtree_bench
+{
+    struct rbtree_t       tree;
+    struct dqueue_t       dqueue;
+    struct tmp_data      *nodes;
+    size_t               *order;    //order of inserts of the nodes
+    uint64_t             *keys;     //keys for lookups
+    size_t                size;
+    volatile uintptr_t    sink;     //result of the algorithm (do not optimize out)
+};
+
+
+
+static int cmp_key(const struct rbtree_node *node, const void *key)
+{
+    const struct tmp_data *d = rbtree_data(node, const struct tmp_data, node);
+    uint64_t k = *(const uint64_t *)key;
+
+    return (d->key > k) - (d->key < k);
+}
+
+
+
+static int pred_key(const dqueue_node *node, void *key)
+{
+    const struct tmp_data *d = dqueue_data(node, const struct tmp_data, list);
+
+    return d->key == *(const uint64_t *)key;
+}
+
+
+
+static void setup_insert(void *data)
+{
+    struct rbtree_bench *b = data;
+
+    rbtree_init(&b->tree, cmp_key);
+}
+
+
+
+static void run_insert(void *data)
+{
+    struct rbtree_bench *b = data;
+    struct tmp_data *node;
+
+
+    for(size_t i = 0; i < b->size; i++)
+    {
+        node = &b->nodes[b->order[i]];
+        rbtree_insert(&b->tree, &node->node, &node->key);
+    }
+}
+
+
+
+static void setup_erase(void *data)
+{
+    setup_insert(data);
+    run_insert(data);
+}
+
+
+
+static void run_erase(void *data)
+{
+    struct rbtree_bench *b = data;
+
+    //the order of erase is the order of the keys (random for the tree)
+    for(size_t i = 0; i < b->size; i++)
+        rbtree_erase(&b->tree, &b->nodes[i].node);
+}
+
+
+
+static void run_dqueue_lookup(void *data)
+{
+    struct rbtree_bench *b = data;
+    uintptr_t sum = 0;
+
+
+    for(size_t i = 0; i < BENCH_LOOKUPS; i++)
+        sum += (uintptr_t)dqueue_find2(dqueue_begin(&b->dqueue), dqueue_end(&b->dqueue),
+                                       pred_key, &b->keys[i]);
+
+    b->sink = sum;
+}
+
+
+
+static void run_rbtree_lookup(void *data)
+{
+    struct rbtree_bench *b = data;
+    uintptr_t sum = 0;
+
+
+    for(size_t i = 0; i < BENCH_LOOKUPS; i++)
+        sum += (uintptr_t)rbtree_lookup(&b->tree, &b->keys[i]);
+
+    b->sink = sum;
+}
+
+
+
+static void run_rbtree_lower_bound(void *data)
+{
+    struct rbtree_bench *b = data;
+    uintptr_t sum = 0;
+
+
+    for(size_t i = 0; i < BENCH_LOOKUPS; i++)
+        sum += (uintptr_t)rbtree_lower_bound(&b->tree, &b->keys[i]);
+
+    b->sink = sum;
+}
+
+
+
+int main(int argc, char *argv[])
+{
+    struct rbtree_bench b;
+    size_t max_pow = 5, pow, i, reps;
+    uint64_t seed = 0x9E3779B97F4A7C15ull;
+    char name[64];
+    int layout;
+
+
+    if( argc > 1 )
+        max_pow = strtoul(argv[1], NULL, 10);
+
+
+    for(pow = 2, b.size = 100; pow <= max_pow; pow++, b.size *= 10)
+    {
+        b.nodes = malloc(b.size * sizeof(struct tmp_data));
+        b.order = malloc(b.size * sizeof(size_t));
+        b.keys  = malloc(BENCH_LOOKUPS * sizeof(uint64_t));
+        if( !b.nodes || !b.order || !b.keys )
+            return 1;
+
+        for(i = 0; i < b.size; i++)
+            b.nodes[i].key = bench_rand(&seed);
+
+        for(i = 0; i < BENCH_LOOKUPS; i++)
+            b.keys[i] = b.nodes[bench_rand(&seed) % b.size].key;
+
+        reps = bench_reps(b.size);
+
+
+        for(layout = BENCH_LAYOUT_CONTIGUOUS; layout <= BENCH_LAYOUT_SHUFFLED; layout++)
+        {
+            bench_layout(b.order, b.size, layout, &seed);
+
+            snprintf(name, sizeof(name), "rbtree_insert_%zu", b.size);
+            bench_run_layout(name, layout, b.size, reps, setup_insert, run_insert, &b);
+
+            snprintf(name, sizeof(name), "rbtree_erase_%zu", b.size);
+            bench_run_layout(name, layout, b.size, reps, setup_erase, run_erase, &b);
+
+
+            //the both containers are filled in the layout order
+            setup_erase(&b);
+            dqueue_init(&b.dqueue);
+
+            for(i = 0; i < b.size; i++)
+                dqueue_push_back(&b.nodes[b.order[i]].list, &b.dqueue);
+
+            snprintf(name, sizeof(name), "dqueue_find2_lookup_%zu", b.size);
+            bench_run_layout(name, layout, BENCH_LOOKUPS, bench_reps(b.size * BENCH_LOOKUPS / 2),
+                             NULL, run_dqueue_lookup, &b);
+
+            snprintf(name, sizeof(name), "rbtree_lookup_%zu", b.size);
+            bench_run_layout(name, layout, BENCH_LOOKUPS, 101, NULL, run_rbtree_lookup, &b);
+
+            snprintf(name, sizeof(name), "rbtree_lower_bound_%zu", b.size);
+            bench_run_layout(name, layout, BENCH_LOOKUPS, 101, NULL, run_rbtree_lower_bound, &b);
+        }
+
+        free(b.keys);
+        free(b.order);
+        free(b.nodes);
+    }
+
+
+    return 0;
+}
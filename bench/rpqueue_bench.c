@@ -0,0 +1,448 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <stddef.h>
+#include <stdint.h>
+
+
+
+#include "bench.h"
+#include "pqueue.h"
+#include "ipqueue.h"
+#include "kpqueue.h"
+#include "rpqueue.h"
+
+
+
+
+
+/*
+ * rpqueue.h (radix heap, monotone keys) vs comparison heaps for
+ * timer/Dijkstra-like workloads on contiguous and shuffled layout of
+ * the nodes (see bench_layout):
+ *
+ * push, pop  - fill the queue with n nodes, take them all
+ * hold       - pop the top and push it back with a later key (size is not changed)
+ * decrease   - move n/4 random nodes earlier (not below the last popped key),
+ *              then pop all (rpqueue_update vs ipqueue_update)
+ *
+ * pqueue   - binary heap of void*, cmp_func dereferences the nodes
+ * kpqueue  - 4-ary heap of {uint64_t key, void *item} (kpqueue_u64)
+ * ipqueue  - indexed binary heap (only for decrease)
+ * rpqueue  - radix heap of intrusive nodes
+ *
+ * usage: rpqueue_bench [max_pow]   //sizes 10^3 .. 10^max_pow (default 6)
+ */
+
+
+
+
+
+struct tmp_data
+{
+    uint64_t            key;
+    struct rpqueue_node node;
+    size_t              pos;         //position in ipqueue
+    char                payload[24]; //one node == one cache line
+};
+
+
+
+struct rpqueue_bench
+{
+    struct pqueue_t       pqueue;
+    struct ipqueue_t      ipqueue;
+    struct kpqueue_u64_t  kpqueue;
+    struct rpqueue_t      rpqueue;
+    struct tmp_data      *nodes;
+    uint64_t             *keys;     //initial keys of the nodes
+    size_t               *order;    //order of pushes of the nodes
+    size_t               *random;   //random order of the nodes for decrease
+    size_t                size;
+    uint64_t              seed;
+    volatile uintptr_t    sink;     //result of the algorithm (do not optimize out)
+};
+
+
+
+static int cmp_min(void *n1, void *n2)
+{
+    return ((struct tmp_data *)n1)->key <= ((struct tmp_data *)n2)->key;
+}
+
+
+
+static void setup_keys(struct rpqueue_bench *b)
+{
+    size_t i;
+
+    for(i = 0; i < b->size; i++)
+        b->nodes[i].key = b->keys[i];
+}
+
+
+
+static void setup_pqueue_empty(void *data)
+{
+    struct rpqueue_bench *b = data;
+
+    setup_keys(b);
+    b->pqueue.size = 0;
+}
+
+
+
+static void setup_pqueue(void *data)
+{
+    struct rpqueue_bench *b = data;
+    size_t i;
+
+
+    setup_pqueue_empty(data);
+
+    for(i = 0; i < b->size; i++)
+        pqueue_push(&b->pqueue, &b->nodes[b->order[i]]);
+}
+
+
+
+static void setup_ipqueue(void *data)
+{
+    struct rpqueue_bench *b = data;
+    size_t i;
+
+
+    setup_keys(b);
+    b->ipqueue.size = 0;
+
+    for(i = 0; i < b->size; i++)
+        ipqueue_push(&b->ipqueue, &b->nodes[b->order[i]]);
+}
+
+
+
+static void setup_kpqueue_empty(void *data)
+{
+    struct rpqueue_bench *b = data;
+
+    setup_keys(b);
+    b->kpqueue.size = 0;
+}
+
+
+
+static void setup_kpqueue(void *data)
+{
+    struct rpqueue_bench *b = data;
+    struct tmp_data *node;
+    size_t i;
+
+
+    setup_kpqueue_empty(data);
+
+    for(i = 0; i < b->size; i++)
+    {
+        node = &b->nodes[b->order[i]];
+        kpqueue_u64_push(&b->kpqueue, node->key, node);
+    }
+}
+
+
+
+static void setup_rpqueue_empty(void *data)
+{
+    struct rpqueue_bench *b = data;
+
+    setup_keys(b);
+    rpqueue_init(&b->rpqueue);
+}
+
+
+
+static void setup_rpqueue(void *data)
+{
+    struct rpqueue_bench *b = data;
+    struct tmp_data *node;
+    size_t i;
+
+
+    setup_rpqueue_empty(data);
+
+    for(i = 0; i < b->size; i++)
+    {
+        node = &b->nodes[b->order[i]];
+        rpqueue_push(&b->rpqueue, &node->node, node->key);
+    }
+}
+
+
+
+static void run_pqueue_push(void *data)
+{
+    struct rpqueue_bench *b = data;
+    size_t i;
+
+    for(i = 0; i < b->size; i++)
+        pqueue_push(&b->pqueue, &b->nodes[b->order[i]]);
+}
+
+
+
+static void run_kpqueue_push(void *data)
+{
+    struct rpqueue_bench *b = data;
+    struct tmp_data *node;
+    size_t i;
+
+
+    for(i = 0; i < b->size; i++)
+    {
+        node = &b->nodes[b->order[i]];
+        kpqueue_u64_push(&b->kpqueue, node->key, node);
+    }
+}
+
+
+
+static void run_rpqueue_push(void *data)
+{
+    struct rpqueue_bench *b = data;
+    struct tmp_data *node;
+    size_t i;
+
+
+    for(i = 0; i < b->size; i++)
+    {
+        node = &b->nodes[b->order[i]];
+        rpqueue_push(&b->rpqueue, &node->node, node->key);
+    }
+}
+
+
+
+static void run_pqueue_pop(void *data)
+{
+    struct rpqueue_bench *b = data;
+    uintptr_t sum = 0;
+
+
+    while( b->pqueue.size )
+    {
+        sum ^= (uintptr_t)pqueue_top(&b->pqueue);
+        pqueue_pop(&b->pqueue);
+    }
+
+    b->sink = sum;
+}
+
+
+
+static void run_ipqueue_pop(void *data)
+{
+    struct rpqueue_bench *b = data;
+    uintptr_t sum = 0;
+
+
+    while( b->ipqueue.size )
+    {
+        sum ^= (uintptr_t)ipqueue_top(&b->ipqueue);
+        ipqueue_pop(&b->ipqueue);
+    }
+
+    b->sink = sum;
+}
+
+
+
+static void run_kpqueue_pop(void *data)
+{
+    struct rpqueue_bench *b = data;
+    uintptr_t sum = 0;
+
+
+    while( !kpqueue_u64_empty(&b->kpqueue) )
+    {
+        sum ^= (uintptr_t)kpqueue_u64_top(&b->kpqueue);
+        kpqueue_u64_pop(&b->kpqueue);
+    }
+
+    b->sink = sum;
+}
+
+
+
+static void run_rpqueue_pop(void *data)
+{
+    struct rpqueue_bench *b = data;
+    uintptr_t sum = 0;
+
+
+    while( !rpqueue_empty(&b->rpqueue) )
+    {
+        sum ^= (uintptr_t)rpqueue_top(&b->rpqueue);
+        rpqueue_pop(&b->rpqueue);
+    }
+
+    b->sink = sum;
+}
+
+
+
+static void run_pqueue_hold(void *data)
+{
+    struct rpqueue_bench *b = data;
+    struct tmp_data *top;
+    size_t i;
+
+
+    for(i = 0; i < b->size; i++)
+    {
+        top = pqueue_top(&b->pqueue);
+        pqueue_pop(&b->pqueue);
+
+        top->key += bench_rand(&b->seed) >> 40;
+        pqueue_push(&b->pqueue, top);
+    }
+}
+
+
+
+static void run_kpqueue_hold(void *data)
+{
+    struct rpqueue_bench *b = data;
+    uint64_t key;
+    void *item;
+    size_t i;
+
+
+    for(i = 0; i < b->size; i++)
+    {
+        key  = kpqueue_u64_top_key(&b->kpqueue);
+        item = kpqueue_u64_top(&b->kpqueue);
+        kpqueue_u64_pop(&b->kpqueue);
+
+        kpqueue_u64_push(&b->kpqueue, key + (bench_rand(&b->seed) >> 40), item);
+    }
+}
+
+
+
+static void run_rpqueue_hold(void *data)
+{
+    struct rpqueue_bench *b = data;
+    struct rpqueue_node *top;
+    size_t i;
+
+
+    for(i = 0; i < b->size; i++)
+    {
+        top = rpqueue_top(&b->rpqueue);
+        rpqueue_pop(&b->rpqueue);
+
+        rpqueue_push(&b->rpqueue, top, top->key + (bench_rand(&b->seed) >> 40));
+    }
+}
+
+
+
+static void run_ipqueue_decrease(void *data)
+{
+    struct rpqueue_bench *b = data;
+    struct tmp_data *d;
+    size_t i;
+
+
+    for(i = 0; i < b->size/4; i++)
+    {
+        d       = &b->nodes[b->random[i]];
+        d->key -= (bench_rand(&b->seed) >> 40) % (d->key + 1);
+        ipqueue_update(&b->ipqueue, d);
+    }
+
+    run_ipqueue_pop(data);
+}
+
+
+
+static void run_rpqueue_decrease(void *data)
+{
+    struct rpqueue_bench *b = data;
+    struct tmp_data *d;
+    size_t i;
+
+
+    for(i = 0; i < b->size/4; i++)
+    {
+        d = &b->nodes[b->random[i]];
+        rpqueue_update(&b->rpqueue, &d->node,
+                       d->node.key - (bench_rand(&b->seed) >> 40) % (d->node.key + 1));
+    }
+
+    run_rpqueue_pop(data);
+}
+
+
+
+int main(int argc, char *argv[])
+{
+    struct rpqueue_bench b;
+    size_t max_pow = 6, pow, i, reps;
+    int layout;
+
+
+    if( argc > 1 )
+        max_pow = strtoul(argv[1], NULL, 10);
+
+
+    b.seed = 0x9E3779B97F4A7C15ull;
+
+    for(pow = 3, b.size = 1000; pow <= max_pow; pow++, b.size *= 10)
+    {
+        b.nodes  = malloc(b.size * sizeof(struct tmp_data));
+        b.keys   = malloc(b.size * sizeof(uint64_t));
+        b.order  = malloc(b.size * sizeof(size_t));
+        b.random = malloc(b.size * sizeof(size_t));
+        if( !b.nodes || !b.keys || !b.order || !b.random )
+            return 1;
+
+        if( pqueue_init(&b.pqueue, 0, b.size, cmp_min)     ||
+            kpqueue_u64_init(&b.kpqueue, 0, b.size)        ||
+            ipqueue_init(&b.ipqueue, 0, b.size, cmp_min, offsetof(struct tmp_data, pos)) )
+            return 1;
+
+        for(i = 0; i < b.size; i++)
+            b.keys[i] = bench_rand(&b.seed) >> 40;  //the same range as the steps of hold
+
+        bench_layout(b.random, b.size, BENCH_LAYOUT_SHUFFLED, &b.seed);
+
+        reps = bench_reps(b.size);
+
+        for(layout = BENCH_LAYOUT_CONTIGUOUS; layout <= BENCH_LAYOUT_SHUFFLED; layout++)
+        {
+            bench_layout(b.order, b.size, layout, &b.seed);
+
+            bench_run_layout("pqueue_push",      layout, b.size, reps, setup_pqueue_empty,  run_pqueue_push,      &b);
+            bench_run_layout("kpqueue_push",     layout, b.size, reps, setup_kpqueue_empty, run_kpqueue_push,     &b);
+            bench_run_layout("rpqueue_push",     layout, b.size, reps, setup_rpqueue_empty, run_rpqueue_push,     &b);
+            bench_run_layout("pqueue_pop",       layout, b.size, reps, setup_pqueue,        run_pqueue_pop,       &b);
+            bench_run_layout("kpqueue_pop",      layout, b.size, reps, setup_kpqueue,       run_kpqueue_pop,      &b);
+            bench_run_layout("rpqueue_pop",      layout, b.size, reps, setup_rpqueue,       run_rpqueue_pop,      &b);
+            bench_run_layout("pqueue_hold",      layout, b.size, reps, setup_pqueue,        run_pqueue_hold,      &b);
+            bench_run_layout("kpqueue_hold",     layout, b.size, reps, setup_kpqueue,       run_kpqueue_hold,     &b);
+            bench_run_layout("rpqueue_hold",     layout, b.size, reps, setup_rpqueue,       run_rpqueue_hold,     &b);
+            bench_run_layout("ipqueue_decrease", layout, b.size, reps, setup_ipqueue,       run_ipqueue_decrease, &b);
+            bench_run_layout("rpqueue_decrease", layout, b.size, reps, setup_rpqueue,       run_rpqueue_decrease, &b);
+        }
+
+        pqueue_free((struct pqueue_t *)&b.ipqueue);
+        kpqueue_u64_free(&b.kpqueue);
+        pqueue_free(&b.pqueue);
+
+        free(b.random);
+        free(b.order);
+        free(b.keys);
+        free(b.nodes);
+    }
+
+
+    return 0;
+}
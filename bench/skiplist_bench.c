@@ -0,0 +1,333 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <stdint.h>
+
+
+
+#include "bench.h"
+#include "dqueue.h"
+#include "rbtree.h"
+#include "skiplist.h"
+
+
+
+
+
+/*
+ * skiplist.h vs sorted dqueue_t (linear search of the position) and
+ * rbtree.h on contiguous and shuffled layout of the nodes (see bench_layout):
+ *
+ * insert  - sorted insert of n nodes in random order into the empty container
+ *           (dqueue_t only for n <= BENCH_DQUEUE_MAX: it is O(n^2))
+ * erase   - erase of n nodes (in order of the inserts) from the full container
+ * at      - BENCH_LOOKUPS accesses by the random index: skiplist_at vs
+ *           walk from the front of the dqueue_t
+ *
+ * The results are named <container>_<func>_<n>, n = 10^2 .. 10^max_pow,
+ * the skip list has the same seed in every run.
+ *
+ * usage: skiplist_bench [max_pow]   //n = 10^2 .. 10^max_pow (default 5)
+ */
+
+
+
+
+
+#define BENCH_LOOKUPS     1000
+#define BENCH_DQUEUE_MAX  10000
+
+
+
+struct tmp_data
+{
+    struct skiplist_node snode;
+    struct rbtree_node   rnode;
+    dqueue_node          list;
+    uint64_t             key;
+    char                 payload[16];
+};
+
+
+
+struct skiplist_bench
+{
+    struct skiplist_t     sl;
+    struct rbtree_t       tree;
+    struct dqueue_t       dqueue;
+    struct tmp_data      *nodes;
+    size_t               *order;    //order of inserts of the nodes
+    size_t               *index;    //indexes for at
+    size_t                size;
+    volatile uintptr_t    sink;     //result of the algorithm (do not optimize out)
+};
+
+
+
+static int cmp_skiplist(const struct skiplist_node *node, const void *key)
+{
+    const struct tmp_data *d = skiplist_data(node, const struct tmp_data, snode);
+    uint64_t k = *(const uint64_t *)key;
+
+    return (d->key > k) - (d->key < k);
+}
+
+
+
+static int cmp_rbtree(const struct rbtree_node *node, const void *key)
+{
+    const struct tmp_data *d = rbtree_data(node, const struct tmp_data, rnode);
+    uint64_t k = *(const uint64_t *)key;
+
+    return (d->key > k) - (d->key < k);
+}
+
+
+
+static void setup_skiplist(void *data)
+{
+    struct skiplist_bench *b = data;
+
+    skiplist_clear(&b->sl);
+    skiplist_init(&b->sl, cmp_skiplist, 1);
+}
+
+
+
+static void setup_rbtree(void *data)
+{
+    struct skiplist_bench *b = data;
+
+    rbtree_init(&b->tree, cmp_rbtree);
+}
+
+
+
+static void setup_dqueue(void *data)
+{
+    struct skiplist_bench *b = data;
+
+    dqueue_init(&b->dqueue);
+}
+
+
+
+static void run_skiplist_insert(void *data)
+{
+    struct skiplist_bench *b = data;
+    struct tmp_data *node;
+
+
+    for(size_t i = 0; i < b->size; i++)
+    {
+        node = &b->nodes[b->order[i]];
+        if( skiplist_insert(&b->sl, &node->snode, &node->key) )
+            exit(1);
+    }
+}
+
+
+
+static void run_rbtree_insert(void *data)
+{
+    struct skiplist_bench *b = data;
+    struct tmp_data *node;
+
+
+    for(size_t i = 0; i < b->size; i++)
+    {
+        node = &b->nodes[b->order[i]];
+        rbtree_insert(&b->tree, &node->rnode, &node->key);
+    }
+}
+
+
+
+static void run_dqueue_insert(void *data)
+{
+    struct skiplist_bench *b = data;
+    struct tmp_data *node, *d;
+    dqueue_node *it;
+
+
+    for(size_t i = 0; i < b->size; i++)
+    {
+        node = &b->nodes[b->order[i]];
+
+        for(it = dqueue_begin(&b->dqueue); it != dqueue_end(&b->dqueue); it = it->next)
+        {
+            d = dqueue_data(it, struct tmp_data, list);
+            if( d->key > node->key )
+                break;
+        }
+
+        //insert before it
+        dlist_push_back(&node->list, it);
+        b->dqueue.size++;
+    }
+}
+
+
+
+static void setup_skiplist_erase(void *data)
+{
+    setup_skiplist(data);
+    run_skiplist_insert(data);
+}
+
+
+
+static void setup_rbtree_erase(void *data)
+{
+    setup_rbtree(data);
+    run_rbtree_insert(data);
+}
+
+
+
+static void run_skiplist_erase(void *data)
+{
+    struct skiplist_bench *b = data;
+    struct tmp_data *node;
+
+
+    for(size_t i = 0; i < b->size; i++)
+    {
+        node = &b->nodes[b->order[i]];
+        skiplist_erase(&b->sl, &node->snode, &node->key);
+    }
+}
+
+
+
+static void run_rbtree_erase(void *data)
+{
+    struct skiplist_bench *b = data;
+
+    for(size_t i = 0; i < b->size; i++)
+        rbtree_erase(&b->tree, &b->nodes[b->order[i]].rnode);
+}
+
+
+
+static void run_skiplist_at(void *data)
+{
+    struct skiplist_bench *b = data;
+    uintptr_t sum = 0;
+
+
+    for(size_t i = 0; i < BENCH_LOOKUPS; i++)
+        sum += (uintptr_t)skiplist_at(&b->sl, b->index[i]);
+
+    b->sink = sum;
+}
+
+
+
+static void run_dqueue_at(void *data)
+{
+    struct skiplist_bench *b = data;
+    uintptr_t sum = 0;
+    dqueue_node *it;
+    size_t i, j;
+
+
+    for(i = 0; i < BENCH_LOOKUPS; i++)
+    {
+        it = dqueue_begin(&b->dqueue);
+        for(j = b->index[i]; j; j--)
+            it = it->next;
+
+        sum += (uintptr_t)it;
+    }
+
+    b->sink = sum;
+}
+
+
+
+int main(int argc, char *argv[])
+{
+    struct skiplist_bench b;
+    struct tmp_data *node_it;
+    size_t max_pow = 5, pow, i, reps;
+    uint64_t seed = 0x9E3779B97F4A7C15ull;
+    char name[64];
+    int layout;
+
+
+    if( argc > 1 )
+        max_pow = strtoul(argv[1], NULL, 10);
+
+
+    skiplist_init(&b.sl, cmp_skiplist, 1);
+
+    for(pow = 2, b.size = 100; pow <= max_pow; pow++, b.size *= 10)
+    {
+        b.nodes = malloc(b.size * sizeof(struct tmp_data));
+        b.order = malloc(b.size * sizeof(size_t));
+        b.index = malloc(BENCH_LOOKUPS * sizeof(size_t));
+        if( !b.nodes || !b.order || !b.index )
+            return 1;
+
+        for(i = 0; i < BENCH_LOOKUPS; i++)
+            b.index[i] = bench_rand(&seed) % b.size;
+
+        reps = bench_reps(b.size);
+
+
+        for(layout = BENCH_LAYOUT_CONTIGUOUS; layout <= BENCH_LAYOUT_SHUFFLED; layout++)
+        {
+            //the layout is the order of the keys in memory (the order of the lists),
+            //the order of the inserts is random
+            bench_layout(b.order, b.size, layout, &seed);
+
+            for(i = 0; i < b.size; i++)
+                b.nodes[b.order[i]].key = i;
+
+            bench_layout(b.order, b.size, BENCH_LAYOUT_SHUFFLED, &seed);
+
+
+            snprintf(name, sizeof(name), "skiplist_insert_%zu", b.size);
+            bench_run_layout(name, layout, b.size, reps, setup_skiplist, run_skiplist_insert, &b);
+
+            snprintf(name, sizeof(name), "rbtree_insert_%zu", b.size);
+            bench_run_layout(name, layout, b.size, reps, setup_rbtree, run_rbtree_insert, &b);
+
+            if( b.size <= BENCH_DQUEUE_MAX )
+            {
+                snprintf(name, sizeof(name), "dqueue_insert_%zu", b.size);
+                bench_run_layout(name, layout, b.size, bench_reps(b.size * b.size / 2),
+                                 setup_dqueue, run_dqueue_insert, &b);
+            }
+
+            snprintf(name, sizeof(name), "skiplist_erase_%zu", b.size);
+            bench_run_layout(name, layout, b.size, reps, setup_skiplist_erase, run_skiplist_erase, &b);
+
+            snprintf(name, sizeof(name), "rbtree_erase_%zu", b.size);
+            bench_run_layout(name, layout, b.size, reps, setup_rbtree_erase, run_rbtree_erase, &b);
+
+
+            //the both lists are sorted
+            setup_skiplist_erase(&b);
+            dqueue_init(&b.dqueue);
+            skiplist_data_citer(node_it, &b.sl, struct tmp_data, snode)
+                dqueue_push_back(&node_it->list, &b.dqueue);
+
+            snprintf(name, sizeof(name), "skiplist_at_%zu", b.size);
+            bench_run_layout(name, layout, BENCH_LOOKUPS, 101, NULL, run_skiplist_at, &b);
+
+            snprintf(name, sizeof(name), "dqueue_at_%zu", b.size);
+            bench_run_layout(name, layout, BENCH_LOOKUPS, bench_reps(b.size * BENCH_LOOKUPS / 2),
+                             NULL, run_dqueue_at, &b);
+        }
+
+        skiplist_clear(&b.sl);
+
+        free(b.index);
+        free(b.order);
+        free(b.nodes);
+    }
+
+
+    return 0;
+}
@@ -0,0 +1,157 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <stdint.h>
+
+
+
+#include "bench.h"
+#include "stack.h"
+
+
+
+
+
+/*
+ * Throughput of stack.h for contiguous and shuffled layout
+ * of the nodes (see bench_layout).
+ *
+ * usage: stack_bench [max_pow]   //sizes 10^3 .. 10^max_pow (default 6)
+ */
+
+
+
+
+
+struct tmp_data
+{
+    struct list_head list;
+    int              key;
+};
+
+
+
+struct stack_bench
+{
+    struct stack_t     stack;
+    struct tmp_data   *nodes;
+    size_t            *order;  //order of pushes of the nodes
+    size_t             size;
+    uint64_t           seed;
+    volatile uintptr_t sink;   //result of the algorithm (do not optimize out)
+};
+
+
+
+static void setup_empty(void *data)
+{
+    struct stack_bench *b = data;
+
+    stack_init(&b->stack);
+}
+
+
+
+static void setup_stack(void *data)
+{
+    struct stack_bench *b = data;
+    size_t i;
+
+
+    stack_init(&b->stack);
+
+    for(i = 0; i < b->size; i++)
+        stack_push(&b->nodes[b->order[i]].list, &b->stack);
+}
+
+
+
+static void run_stack_push(void *data)
+{
+    struct stack_bench *b = data;
+    size_t i;
+
+    for(i = 0; i < b->size; i++)
+        stack_push(&b->nodes[b->order[i]].list, &b->stack);
+}
+
+
+
+static void run_stack_pop(void *data)
+{
+    struct stack_bench *b = data;
+    struct list_head *top;
+    struct tmp_data  *it;
+    uintptr_t sum = 0;
+
+
+    while( (top = stack_top(&b->stack)) )
+    {
+        it   = list_data(top, struct tmp_data, list);
+        sum += (uintptr_t)it->key;
+        stack_pop(&b->stack);
+    }
+
+    b->sink = sum;
+}
+
+
+
+//push+pop pairs on the full stack (free list like usage)
+static void run_stack_push_pop(void *data)
+{
+    struct stack_bench *b = data;
+    struct list_head *top;
+    size_t i;
+
+
+    for(i = 0; i < b->size; i++)
+    {
+        top = stack_top(&b->stack);
+        stack_pop(&b->stack);
+        stack_push(top, &b->stack);
+    }
+}
+
+
+
+int main(int argc, char *argv[])
+{
+    struct stack_bench b;
+    size_t max_pow = 6, pow, i, reps;
+    int layout;
+
+
+    if( argc > 1 )
+        max_pow = strtoul(argv[1], NULL, 10);
+
+
+    b.seed = 0x9E3779B97F4A7C15ull;
+
+    for(pow = 3, b.size = 1000; pow <= max_pow; pow++, b.size *= 10)
+    {
+        b.nodes = malloc(b.size * sizeof(struct tmp_data));
+        b.order = malloc(b.size * sizeof(size_t));
+        if( !b.nodes || !b.order )
+            return 1;
+
+        for(i = 0; i < b.size; i++)
+            b.nodes[i].key = (int)i;
+
+        reps = bench_reps(b.size);
+
+        for(layout = BENCH_LAYOUT_CONTIGUOUS; layout <= BENCH_LAYOUT_SHUFFLED; layout++)
+        {
+            bench_layout(b.order, b.size, layout, &b.seed);
+
+            bench_run_layout("stack_push",     layout, b.size, reps, setup_empty, run_stack_push,     &b);
+            bench_run_layout("stack_pop",      layout, b.size, reps, setup_stack, run_stack_pop,      &b);
+            bench_run_layout("stack_push_pop", layout, b.size, reps, setup_stack, run_stack_push_pop, &b);
+        }
+
+        free(b.order);
+        free(b.nodes);
+    }
+
+
+    return 0;
+}
@@ -0,0 +1,210 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <stdint.h>
+#include <pthread.h>
+
+
+
+#include "bench.h"
+#include "dqueue.h"
+#include "tcpool.h"
+
+
+
+
+
+/*
+ * Throughput of the node churn in threads: every thread allocates a batch
+ * of nodes, pushes them to its dqueue_t (dqueue_push_back) and then pops
+ * and frees them (dqueue_pop_front). The allocators:
+ *
+ * malloc  - malloc/free (the arenas of libc)
+ * mutex   - pool_t guarded by one mutex
+ * tcpool  - tcpool_t, a cache (two magazines) per thread
+ *
+ * usage: tcpool_bench [max_threads]   //1, 2, 4 .. max_threads (default 8)
+ */
+
+
+
+
+
+#define OPS_PER_THREAD  400000      // count of alloc+free pairs of a thread
+#define BATCH           64
+
+
+
+struct tmp_data
+{
+    dqueue_node list;
+    uint64_t    key;
+    char        payload[24];
+};
+
+
+
+struct tcpool_bench
+{
+    struct tcpool_t  tcp;
+    struct pool_t    pool;
+    pthread_mutex_t  mutex;
+    size_t           threads;
+    int              alloc;         // ALLOC_*
+    volatile size_t  sum;
+};
+
+
+
+enum
+{
+    ALLOC_MALLOC,
+    ALLOC_MUTEX,
+    ALLOC_TCPOOL,
+};
+
+
+
+
+
+static void* thread_func(void *data)
+{
+    struct tcpool_bench *b = data;
+    struct tcpool_cache cache = { NULL, NULL, NULL, 0, 0 };
+    struct tmp_data *node;
+    DECLARE_DQUEUE(tmp_dqueue);
+    size_t i, j, sum = 0;
+
+
+    if( b->alloc == ALLOC_TCPOOL && tcpool_cache_init(&cache, &b->tcp) )
+        return NULL;
+
+
+    for(i = 0; i < OPS_PER_THREAD; i += BATCH)
+    {
+        for(j = 0; j < BATCH; j++)
+        {
+            switch( b->alloc )
+            {
+                case ALLOC_MALLOC:
+                    node = malloc(sizeof(struct tmp_data));
+                    break;
+
+                case ALLOC_MUTEX:
+                    pthread_mutex_lock(&b->mutex);
+                    node = pool_alloc(&b->pool);
+                    pthread_mutex_unlock(&b->mutex);
+                    break;
+
+                default:
+                    node = tcpool_alloc(&cache);
+                    break;
+            }
+
+            if( !node )
+                break;
+
+            node->key = i + j;
+            dqueue_push_back(&node->list, &tmp_dqueue);
+        }
+
+
+        while( !dqueue_empty(&tmp_dqueue) )
+        {
+            node = dqueue_data(dqueue_begin(&tmp_dqueue), struct tmp_data, list);
+            dqueue_pop_front(&tmp_dqueue);
+            sum += node->key;
+
+            switch( b->alloc )
+            {
+                case ALLOC_MALLOC:
+                    free(node);
+                    break;
+
+                case ALLOC_MUTEX:
+                    pthread_mutex_lock(&b->mutex);
+                    pool_release(&b->pool, node);
+                    pthread_mutex_unlock(&b->mutex);
+                    break;
+
+                default:
+                    tcpool_release(&cache, node);
+                    break;
+            }
+        }
+    }
+
+
+    if( b->alloc == ALLOC_TCPOOL )
+        tcpool_cache_free(&cache);
+
+    b->sum += sum;
+
+    return NULL;
+}
+
+
+
+static void run_threads(void *data)
+{
+    struct tcpool_bench *b = data;
+    pthread_t *threads     = malloc(b->threads * sizeof(pthread_t));
+    size_t i;
+
+
+    if( !threads )
+        return;
+
+    for(i = 0; i < b->threads; i++)
+        pthread_create(&threads[i], NULL, thread_func, b);
+
+    for(i = 0; i < b->threads; i++)
+        pthread_join(threads[i], NULL);
+
+    free(threads);
+}
+
+
+
+int main(int argc, char *argv[])
+{
+    static struct tcpool_bench b;
+    static const char *names[] = { "malloc", "mutex+pool", "tcpool" };
+    size_t max_threads = 8;
+    struct tcpool_stats stats;
+    char name[64];
+
+
+    if( argc > 1 )
+        max_threads = strtoul(argv[1], NULL, 10);
+
+
+    if( tcpool_init(&b.tcp, sizeof(struct tmp_data), 0, 0) ||
+        pool_init(&b.pool, sizeof(struct tmp_data), 0) )
+        return 1;
+
+    pthread_mutex_init(&b.mutex, NULL);
+
+
+    for(b.threads = 1; b.threads <= max_threads; b.threads *= 2)
+    {
+        for(b.alloc = ALLOC_MALLOC; b.alloc <= ALLOC_TCPOOL; b.alloc++)
+        {
+            //n - count of alloc+free pairs of all threads
+            snprintf(name, sizeof(name), "%s/threads_%zu", names[b.alloc], b.threads);
+            bench_run(name, b.threads * OPS_PER_THREAD, 11, NULL, run_threads, &b);
+        }
+    }
+
+
+    //the depot is taken once per TCPOOL_MAG_SIZE ops
+    tcpool_get_stats(&b.tcp, &stats);
+    fprintf(stderr, "tcpool: slabs %zu, magazines %zu, fills %zu, gets %zu, puts %zu\n",
+            stats.pool.slabs, stats.mags, stats.fills, stats.gets, stats.puts);
+
+    tcpool_free(&b.tcp);
+    pool_free(&b.pool);
+    pthread_mutex_destroy(&b.mutex);
+
+
+    return 0;
+}
@@ -0,0 +1,314 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <stddef.h>
+#include <stdint.h>
+
+
+
+#include "bench.h"
+#include "pqueue.h"
+#include "ipqueue.h"
+#include "kpqueue.h"
+#include "twheel.h"
+
+
+
+
+
+/*
+ * twheel.h (hierarchical timer wheel) vs timer sets on heaps for
+ * timeouts which are mostly cancelled before they expire (keepalive of
+ * connections) on contiguous and shuffled layout of the nodes
+ * (see bench_layout):
+ *
+ * every op is an activity of a random connection: its timer is moved
+ * to now + timeout (cancel + add). A run is BENCH_TICKS ticks (n ops),
+ * every tick the expired timers are armed again. The timers start with
+ * the expiries in [1, 2*BENCH_TIMEOUT), so ~1/8 of them expire in a run,
+ * the others are moved (cancelled) or wait.
+ *
+ * twheel   - twheel_mod, twheel_advance to the dqueue_t of expired timers
+ * ipqueue  - indexed heap (pqueue_t with positions): cancel is ipqueue_update
+ * lazy     - kpqueue_u64 {expires, node} without cancel: a new entry for every
+ *            mod, the old entries are skipped on pop (the heap grows by them)
+ *
+ * usage: twheel_bench [max_pow]   //count of timers 10^3 .. 10^max_pow (default 6)
+ */
+
+
+
+
+
+#define BENCH_TICKS    256   //ticks of one run
+#define BENCH_TIMEOUT  1024  //timeout is [BENCH_TIMEOUT, 2*BENCH_TIMEOUT) ticks
+
+
+
+struct tmp_data
+{
+    struct twheel_timer timer;
+    uint64_t            expires;     //for heaps
+    size_t              pos;         //position in ipqueue
+    char                payload[16]; //one node == one cache line
+};
+
+
+
+struct twheel_bench
+{
+    struct twheel_t       twheel;
+    struct ipqueue_t      ipqueue;
+    struct kpqueue_u64_t  lazy;
+    struct dqueue_t       expired;
+    struct tmp_data      *nodes;
+    size_t               *order;    //order of the nodes (layout)
+    size_t                size;
+    size_t                ops_per_tick;
+    uint64_t              now;
+    uint64_t              seed;
+    uint64_t              setup_seed;
+    volatile uintptr_t    sink;     //result of the algorithm (do not optimize out)
+};
+
+
+
+static int cmp_expires(void *n1, void *n2)
+{
+    return ((struct tmp_data *)n1)->expires <= ((struct tmp_data *)n2)->expires;
+}
+
+
+
+static uint64_t timeout(struct twheel_bench *b)
+{
+    return b->now + BENCH_TIMEOUT + (bench_rand(&b->seed) >> 32) % BENCH_TIMEOUT;
+}
+
+
+
+// expiry of the timer at the start (timers were armed before the run)
+static uint64_t first_timeout(struct twheel_bench *b)
+{
+    return 1 + (bench_rand(&b->seed) >> 32) % (2 * BENCH_TIMEOUT - 1);
+}
+
+
+
+static struct tmp_data* rand_node(struct twheel_bench *b)
+{
+    return &b->nodes[b->order[(bench_rand(&b->seed) >> 32) % b->size]];
+}
+
+
+
+static void setup_twheel(void *data)
+{
+    struct twheel_bench *b = data;
+    struct tmp_data *node;
+    size_t i;
+
+
+    b->seed = b->setup_seed;  //the same activities for all timer sets
+    b->now  = 0;
+    twheel_init(&b->twheel, 0);
+
+    for(i = 0; i < b->size; i++)
+    {
+        node = &b->nodes[b->order[i]];
+        twheel_init_timer(&node->timer);
+        twheel_add(&b->twheel, &node->timer, first_timeout(b));
+    }
+}
+
+
+
+static void setup_ipqueue(void *data)
+{
+    struct twheel_bench *b = data;
+    struct tmp_data *node;
+    size_t i;
+
+
+    b->seed         = b->setup_seed;
+    b->now          = 0;
+    b->ipqueue.size = 0;
+
+    for(i = 0; i < b->size; i++)
+    {
+        node          = &b->nodes[b->order[i]];
+        node->expires = first_timeout(b);
+        ipqueue_push(&b->ipqueue, node);
+    }
+}
+
+
+
+static void setup_lazy(void *data)
+{
+    struct twheel_bench *b = data;
+    struct tmp_data *node;
+    size_t i;
+
+
+    b->seed      = b->setup_seed;
+    b->now       = 0;
+    b->lazy.size = 0;
+
+    for(i = 0; i < b->size; i++)
+    {
+        node          = &b->nodes[b->order[i]];
+        node->expires = first_timeout(b);
+        kpqueue_u64_push(&b->lazy, node->expires, node);
+    }
+}
+
+
+
+static void run_twheel(void *data)
+{
+    struct twheel_bench *b = data;
+    struct twheel_timer *timer;
+    size_t i, fired = 0;
+
+
+    for(i = 0; i < b->size; i++)
+    {
+        twheel_mod(&b->twheel, &rand_node(b)->timer, timeout(b));
+
+        if( (i + 1) % b->ops_per_tick )
+            continue;
+
+
+        fired += twheel_advance(&b->twheel, ++b->now, &b->expired);
+
+        while( !dqueue_empty(&b->expired) )
+        {
+            timer = dqueue_first_data(&b->expired, struct twheel_timer, list);
+            dqueue_pop_front(&b->expired);
+            twheel_add(&b->twheel, timer, timeout(b));
+        }
+    }
+
+    b->sink = fired;
+}
+
+
+
+static void run_ipqueue(void *data)
+{
+    struct twheel_bench *b = data;
+    struct tmp_data *node;
+    size_t i, fired = 0;
+
+
+    for(i = 0; i < b->size; i++)
+    {
+        node          = rand_node(b);
+        node->expires = timeout(b);
+        ipqueue_update(&b->ipqueue, node);
+
+        if( (i + 1) % b->ops_per_tick )
+            continue;
+
+
+        b->now++;
+
+        while( (node = ipqueue_top(&b->ipqueue)) && node->expires <= b->now )
+        {
+            node->expires = timeout(b);
+            ipqueue_update(&b->ipqueue, node);  //pop + push
+            fired++;
+        }
+    }
+
+    b->sink = fired;
+}
+
+
+
+static void run_lazy(void *data)
+{
+    struct twheel_bench *b = data;
+    struct tmp_data *node;
+    uint64_t key;
+    size_t i, fired = 0;
+
+
+    for(i = 0; i < b->size; i++)
+    {
+        node          = rand_node(b);
+        node->expires = timeout(b);
+        kpqueue_u64_push(&b->lazy, node->expires, node);
+
+        if( (i + 1) % b->ops_per_tick )
+            continue;
+
+
+        b->now++;
+
+        while( !kpqueue_u64_empty(&b->lazy) && (key = kpqueue_u64_top_key(&b->lazy)) <= b->now )
+        {
+            node = kpqueue_u64_top(&b->lazy);
+            kpqueue_u64_pop(&b->lazy);
+
+            if( key != node->expires )
+                continue;   //cancelled (moved) timer
+
+            node->expires = timeout(b);
+            kpqueue_u64_push(&b->lazy, node->expires, node);
+            fired++;
+        }
+    }
+
+    b->sink = fired;
+}
+
+
+
+int main(int argc, char *argv[])
+{
+    struct twheel_bench b;
+    size_t max_pow = 6, pow, reps;
+    int layout;
+
+
+    if( argc > 1 )
+        max_pow = strtoul(argv[1], NULL, 10);
+
+
+    b.setup_seed = 0x9E3779B97F4A7C15ull;
+    dqueue_init(&b.expired);
+
+    for(pow = 3, b.size = 1000; pow <= max_pow; pow++, b.size *= 10)
+    {
+        b.nodes = malloc(b.size * sizeof(struct tmp_data));
+        b.order = malloc(b.size * sizeof(size_t));
+        if( !b.nodes || !b.order )
+            return 1;
+
+        if( ipqueue_init(&b.ipqueue, 0, b.size, cmp_expires, offsetof(struct tmp_data, pos)) ||
+            kpqueue_u64_init(&b.lazy, b.size, 2 * b.size) )
+            return 1;
+
+        reps           = bench_reps(b.size);
+        b.ops_per_tick = b.size / BENCH_TICKS;
+
+        for(layout = BENCH_LAYOUT_CONTIGUOUS; layout <= BENCH_LAYOUT_SHUFFLED; layout++)
+        {
+            bench_layout(b.order, b.size, layout, &b.setup_seed);
+
+            bench_run_layout("ipqueue_timers", layout, b.size, reps, setup_ipqueue, run_ipqueue, &b);
+            bench_run_layout("lazy_timers",    layout, b.size, reps, setup_lazy,    run_lazy,    &b);
+            bench_run_layout("twheel_timers",  layout, b.size, reps, setup_twheel,  run_twheel,  &b);
+        }
+
+        kpqueue_u64_free(&b.lazy);
+        pqueue_free((struct pqueue_t *)&b.ipqueue);
+
+        free(b.order);
+        free(b.nodes);
+    }
+
+
+    return 0;
+}
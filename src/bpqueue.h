@@ -0,0 +1,317 @@
+/*
+ * bpqueue.h
+ *
+ *
+ * BSD 3-Clause License
+ *
+ * Copyright (c) 2017, Koynov Stas - skojnov@yandex.ru
+ *
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice, this
+ *    list of conditions and the following disclaimer.
+ *
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ *    this list of conditions and the following disclaimer in the documentation
+ *    and/or other materials provided with the distribution.
+ *
+ * 3. Neither the name of the copyright holder nor the names of its
+ *    contributors may be used to endorse or promote products derived from
+ *    this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+ * FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ * DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ * SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ * CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+ * OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+
+
+#ifndef BPQUEUE_H
+#define BPQUEUE_H
+
+#include <stddef.h>
+#include <stdint.h>
+#include "dqueue.h"
+
+
+
+
+
+/*
+ *  bpqueue_t - bucket priority queue for a fixed range of priorities
+ *  (0 .. BPQUEUE_PRIOS-1, 0 is the top priority), the shape of
+ *  the O(1) scheduler of Linux: an array of dqueue_t (one bucket per priority)
+ *  and a bitmap of non-empty buckets, the top bucket is found by
+ *  find-first-set. The nodes with the same priority are in FIFO order.
+ *
+ *  A node (bpqueue_node) is embedded in the struct of data like dlist_head,
+ *  the queue does not allocate memory. There is no cmp_func.
+ *
+ *  BPQUEUE_PRIOS (multiple of 64, default 256) can be defined before
+ *  the include.
+ *
+ *
+ *  Algorithmic complexity:
+ *
+ *  bpqueue_size       -   O(1)
+ *  bpqueue_empty      -   O(1)
+ *  bpqueue_push       -   O(1)
+ *  bpqueue_peek       -   O(P/64), P - BPQUEUE_PRIOS
+ *  bpqueue_pop        -   O(P/64)
+ *  bpqueue_remove     -   O(1)
+ *  bpqueue_requeue    -   O(1)
+ */
+
+
+
+
+
+#ifndef BPQUEUE_PRIOS
+#define BPQUEUE_PRIOS  256
+#endif
+
+#if BPQUEUE_PRIOS <= 0 || BPQUEUE_PRIOS % 64
+#error "BPQUEUE_PRIOS must be a multiple of 64"
+#endif
+
+#define BPQUEUE_WORDS  (BPQUEUE_PRIOS / 64)
+
+
+
+struct bpqueue_node
+{
+    struct dlist_head list;
+    unsigned int      prio;
+};
+
+
+
+struct bpqueue_t
+{
+    struct dqueue_t buckets[BPQUEUE_PRIOS];
+    uint64_t        bitmap[BPQUEUE_WORDS];  // bit prio - bucket is not empty
+    size_t          size;
+};
+
+
+
+
+
+static inline void bpqueue_init(struct bpqueue_t *bpq)
+{
+    size_t i;
+
+    for(i = 0; i < BPQUEUE_PRIOS; i++)
+        dqueue_init(&bpq->buckets[i]);
+
+    for(i = 0; i < BPQUEUE_WORDS; i++)
+        bpq->bitmap[i] = 0;
+
+    bpq->size = 0;
+}
+
+
+
+static inline size_t bpqueue_size(const struct bpqueue_t *bpq)
+{
+    return bpq->size;
+}
+
+
+
+static inline int bpqueue_empty(const struct bpqueue_t *bpq)
+{
+    return bpq->size == 0;
+}
+
+
+
+// index of the lowest set bit (x != 0)
+static inline unsigned int sys_bpqueue_lsb(uint64_t x)
+{
+#if defined(__GNUC__)
+    return (unsigned int)__builtin_ctzll(x);
+#else
+    unsigned int i = 0;
+
+    while( !(x & 1) )
+    {
+        x >>= 1;
+        i++;
+    }
+
+    return i;
+#endif
+}
+
+
+
+static inline void sys_bpqueue_add(struct bpqueue_t *bpq, struct bpqueue_node *node,
+                                   unsigned int prio)
+{
+    node->prio = prio;
+    dqueue_push_back(&node->list, &bpq->buckets[prio]);
+
+    bpq->bitmap[prio / 64] |= (uint64_t)1 << (prio % 64);
+}
+
+
+
+static inline void sys_bpqueue_del(struct bpqueue_t *bpq, struct bpqueue_node *node)
+{
+    struct dqueue_t *bucket = &bpq->buckets[node->prio];
+
+
+    dqueue_del(&node->list, bucket);
+
+    if( dqueue_empty(bucket) )
+        bpq->bitmap[node->prio / 64] &= ~((uint64_t)1 << (node->prio % 64));
+}
+
+
+
+/*
+ * bpqueue_push - Pushes the node to the back of the bucket of the priority.
+ *
+ * bpq:  the queue for work.
+ * node: the node for push (must not be in a queue)
+ * prio: the priority (0 - the top)
+ *
+ * ret: -1  //if prio >= BPQUEUE_PRIOS (the node is not pushed)
+ * ret:  0  //good job
+ */
+static inline int bpqueue_push(struct bpqueue_t *bpq, struct bpqueue_node *node,
+                               unsigned int prio)
+{
+    if( prio >= BPQUEUE_PRIOS )
+        return -1;
+
+
+    sys_bpqueue_add(bpq, node, prio);
+    bpq->size++;
+
+    return 0;
+}
+
+
+
+/*
+ * bpqueue_peek - Returns the first node of the top priority
+ * (node->prio is its priority).
+ * This node will be removed on a call to pop().
+ *
+ * bpq: the queue for work.
+ *
+ * ret: NULL   //if queue is empty
+ * ret: *node  //good job ret top node.
+ */
+static inline struct bpqueue_node* bpqueue_peek(const struct bpqueue_t *bpq)
+{
+    size_t i;
+
+
+    for(i = 0; i < BPQUEUE_WORDS; i++)
+    {
+        if( bpq->bitmap[i] )
+        {
+            const struct dqueue_t *bucket = &bpq->buckets[i*64 + sys_bpqueue_lsb(bpq->bitmap[i])];
+
+            return dqueue_first_data(bucket, struct bpqueue_node, list);
+        }
+    }
+
+    return NULL;
+}
+
+
+
+/*
+ * bpqueue_pop - Removes the first node of the top priority from the queue.
+ *
+ * bpq: the queue for work.
+ *
+ * ret: NULL   //if queue is empty
+ * ret: *node  //good job ret the removed node.
+ */
+static inline struct bpqueue_node* bpqueue_pop(struct bpqueue_t *bpq)
+{
+    struct bpqueue_node *node = bpqueue_peek(bpq);
+
+
+    if( !node )
+        return NULL;
+
+
+    sys_bpqueue_del(bpq, node);
+    bpq->size--;
+
+    return node;
+}
+
+
+
+/*
+ * bpqueue_remove - Removes the node from the queue.
+ *
+ * bpq:  the queue for work.
+ * node: the node (in the queue) for remove
+ */
+static inline void bpqueue_remove(struct bpqueue_t *bpq, struct bpqueue_node *node)
+{
+    sys_bpqueue_del(bpq, node);
+    bpq->size--;
+}
+
+
+
+/*
+ * bpqueue_requeue - Moves the node to the back of the bucket of the priority
+ * (the same priority - to the back of its bucket, round robin).
+ *
+ * bpq:  the queue for work.
+ * node: the node (in the queue) for move
+ * prio: the new priority (0 - the top)
+ *
+ * ret: -1  //if prio >= BPQUEUE_PRIOS (the node is not changed)
+ * ret:  0  //good job
+ */
+static inline int bpqueue_requeue(struct bpqueue_t *bpq, struct bpqueue_node *node,
+                                  unsigned int prio)
+{
+    if( prio >= BPQUEUE_PRIOS )
+        return -1;
+
+
+    sys_bpqueue_del(bpq, node);
+    sys_bpqueue_add(bpq, node, prio);
+
+    return 0;
+}
+
+
+
+/*
+ * bpqueue_data - get the struct (data) for this node
+ *
+ * node:   the node.
+ * type:   the type of the struct of data this is embedded in.
+ * member: the name of the node(bpqueue_node) within the struct of data.
+ */
+#define bpqueue_data(node, type, member) \
+    (type *)( (const char *)node - offsetof(type, member) )
+
+
+
+
+
+#endif // BPQUEUE_H
@@ -0,0 +1,261 @@
+/*
+ * cstack.h
+ *
+ *
+ * BSD 3-Clause License
+ *
+ * Copyright (c) 2017, Koynov Stas - skojnov@yandex.ru
+ *
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice, this
+ *    list of conditions and the following disclaimer.
+ *
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ *    this list of conditions and the following disclaimer in the documentation
+ *    and/or other materials provided with the distribution.
+ *
+ * 3. Neither the name of the copyright holder nor the names of its
+ *    contributors may be used to endorse or promote products derived from
+ *    this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+ * FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ * DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ * SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ * CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+ * OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#ifndef CSTACK_H
+#define CSTACK_H
+
+#include <stdint.h>
+#include <stdatomic.h>  //need C11 (-std=c11) and may be -latomic (see tests/Makefile)
+
+#include "list.h"
+
+
+
+
+
+/*
+ * The concurrent stack (cstack_t) is a lock-free stack (Treiber stack)
+ * on the embedded list_head, for many producers and many consumers.
+ *
+ * The top of the stack is the pair {node, tag}, it is changed by one
+ * double-width CAS (16 bytes on 64 bit platforms). Every change of the top
+ * increments the tag, so the CAS fails if the top was popped and pushed
+ * again by the other thread between our load and CAS (ABA problem).
+ *
+ * The chain of the nodes inside the stack is NULL-terminated
+ * (the stack does not have the head node in the chain).
+ *
+ * The memory of a node must stay valid (the node must not be freed to OS)
+ * while other threads can pop: pop can read node->next of a node that
+ * was already popped by the other thread (the CAS will fail and pop repeats).
+ * Use nodes from a pool or from the static memory.
+ *
+ * The stack does not have a counter of nodes: it would be one more
+ * shared variable for all threads (see cstack_pop_all, it returns count).
+ *
+ *
+ *  Algorithmic complexity:
+ *
+ *  cstack_empty     -   O(1)
+ *  cstack_push      -   O(1)  (lock-free)
+ *  cstack_pop       -   O(1)  (lock-free)
+ *  cstack_pop_all   -   O(n)  (one exchange + walk on the taken chain)
+ */
+
+
+
+
+
+struct cstack_top
+{
+    struct list_head *node;
+    uintptr_t         tag;   //counter of changes (ABA protection)
+};
+
+
+
+struct cstack_t
+{
+    _Atomic struct cstack_top top;
+};
+
+
+
+
+
+#define DECLARE_CSTACK(name) \
+    struct cstack_t name = { { NULL, 0 } }
+
+
+
+static inline void cstack_init(struct cstack_t *cstack)
+{
+    struct cstack_top top = { NULL, 0 };
+
+    atomic_init(&cstack->top, top);
+}
+
+
+
+/*
+ * The field next of the node is written by push and read by pop in other
+ * threads, so it is accessed as atomic (node must not be changed by user
+ * while it is in the stack).
+ */
+static inline struct list_head* sys_cstack_get_next(struct list_head *node)
+{
+    return atomic_load_explicit((_Atomic(struct list_head *) *)&node->next,
+                                memory_order_relaxed);
+}
+
+
+
+static inline void sys_cstack_set_next(struct list_head *node, struct list_head *next)
+{
+    atomic_store_explicit((_Atomic(struct list_head *) *)&node->next, next,
+                          memory_order_relaxed);
+}
+
+
+
+/*
+ * cstack_empty - Tests whether a stack is empty.
+ * (In the concurrent code the result can be out of date at once.)
+ *
+ * cstack: the stack to test.
+ */
+static inline int cstack_empty(struct cstack_t *cstack)
+{
+    struct cstack_top top = atomic_load_explicit(&cstack->top, memory_order_relaxed);
+
+    return top.node == NULL;
+}
+
+
+
+/*
+ * cstack_push - Pushes the given node to the top of the stack.
+ *
+ * node:   the node for push.
+ * cstack: the stack to work.
+ */
+static inline void cstack_push(struct list_head *node, struct cstack_t *cstack)
+{
+    struct cstack_top old_top = atomic_load_explicit(&cstack->top, memory_order_relaxed);
+    struct cstack_top new_top;
+
+
+    do
+    {
+        sys_cstack_set_next(node, old_top.node);
+
+        new_top.node = node;
+        new_top.tag  = old_top.tag + 1;
+
+    } while( !atomic_compare_exchange_weak_explicit(&cstack->top, &old_top, new_top,
+                                                    memory_order_release,
+                                                    memory_order_relaxed) );
+}
+
+
+
+/*
+ * cstack_pop - Removes the top node from the stack.
+ *
+ * cstack: the stack to work.
+ *
+ * ret: ptr   //pointer to the removed node (node->next == node, like list_empty)
+ * ret: NULL  //if stack is empty.
+ */
+static inline struct list_head* cstack_pop(struct cstack_t *cstack)
+{
+    struct cstack_top old_top = atomic_load_explicit(&cstack->top, memory_order_acquire);
+    struct cstack_top new_top;
+
+
+    do
+    {
+        if( !old_top.node )
+            return NULL;
+
+        new_top.node = sys_cstack_get_next(old_top.node);
+        new_top.tag  = old_top.tag + 1;
+
+    } while( !atomic_compare_exchange_weak_explicit(&cstack->top, &old_top, new_top,
+                                                    memory_order_acquire,
+                                                    memory_order_acquire) );
+
+
+    sys_cstack_set_next(old_top.node, old_top.node);
+
+    return old_top.node;
+}
+
+
+
+/*
+ * cstack_pop_all - Removes all nodes from the stack (by one atomic operation)
+ * and adds them to the front of the list head.
+ * The order of nodes in the list is the order of pops (the top is first).
+ *
+ * cstack: the stack to work.
+ * head:   the list (list_head) for the nodes.
+ *
+ * ret: count of removed nodes
+ */
+static inline size_t cstack_pop_all(struct cstack_t *cstack, struct list_head *head)
+{
+    struct cstack_top old_top = atomic_load_explicit(&cstack->top, memory_order_relaxed);
+    struct cstack_top new_top;
+    struct list_head *it, *last;
+    size_t count;
+
+
+    do
+    {
+        if( !old_top.node )
+            return 0;
+
+        new_top.node = NULL;
+        new_top.tag  = old_top.tag + 1;
+
+    } while( !atomic_compare_exchange_weak_explicit(&cstack->top, &old_top, new_top,
+                                                    memory_order_acquire,
+                                                    memory_order_relaxed) );
+
+
+    //the chain is ours now, but a late pop of the other thread can still
+    //read the next of its nodes (its CAS will fail), so next stays atomic
+    count = 1;
+    last  = old_top.node;
+
+    while( (it = sys_cstack_get_next(last)) )
+    {
+        last = it;
+        count++;
+    }
+
+    sys_cstack_set_next(last, head->next);
+    head->next = old_top.node;
+
+    return count;
+}
+
+
+
+
+
+#endif // CSTACK_H
@@ -117,6 +117,8 @@
  *  dlist_rotate_right    -     O(1)
  *  dlist_splice_front    -     O(1)
  *  dlist_splice_back     -     O(1)
+ *  dlist_splice_range    -     O(1)
+ *  dlist_cut_position    -     O(1)
  *  dlist_reverse         -     O(n)
  *  dlist_swap            -     O(1)
  *
@@ -142,6 +144,7 @@
  *  dlist_minmax          -     O(n)
  *  dlist_find            -     O(n)
  *  dlist_find2           -     O(n)
+ *  dlist_sort            -     O(n*ln(n)), O(n) for sorted list
  */
 
 
@@ -555,6 +558,71 @@ static inline void dlist_splice_back(struct dlist_head *src,
 
 
 
+/*
+ * dlist_splice_range - transfers the elements of the range [first, last)
+ *                      to the position before pos (in the same or other list)
+ *
+ * The range used is [first,last), which contains all the elements
+ * between first and last, including the element pointed by first
+ * but not the element pointed by last.
+ * pos must not be in the range [first, last).
+ *
+ * first: the first node of the range
+ * last:  the node after the last node of the range (can be head of the list)
+ * pos:   the node (or head of the list) before which the range will be inserted
+ *
+ * before: [...] <-> [first] <-> [...] <-> [X] <-> [last] <-> [...]
+ *         [...] <-> [P] <-> [pos] <-> [...]
+ *
+ * after:  [...] <-> [last] <-> [...]
+ *         [...] <-> [P] <-> [first] <-> [...] <-> [X] <-> [pos] <-> [...]
+ */
+static inline void dlist_splice_range(struct dlist_head *first,
+                                      struct dlist_head *last,
+                                      struct dlist_head *pos)
+{
+    struct dlist_head *range_last = last->prev;
+
+    if( (first == last) || (pos == last) )
+        return;  //empty range or range is before pos already
+
+
+    //cut
+    first->prev->next = last;
+    last->prev        = first->prev;
+
+    //paste
+    first->prev       = pos->prev;
+    range_last->next  = pos;
+    pos->prev->next   = first;
+    pos->prev         = range_last;
+}
+
+
+
+/*
+ * dlist_cut_position - transfers the elements from the first to the node
+ *                      (including node) of src to the back of dest
+ *                      (splits the list in two).
+ *
+ * node: the last node of src for transfer (if node == src nothing is done)
+ * src:  dlist to cut from
+ * dest: dlist to copy to  (copy to back)
+ *
+ * before: src:  [head] <-> [1] <-> [node] <-> [3] <-> [...]
+ * after:  src:  [head] <-> [3] <-> [...]
+ *         dest: [head] <-> [...] <-> [1] <-> [node]
+ */
+static inline void dlist_cut_position(struct dlist_head *node,
+                                      struct dlist_head *src,
+                                      struct dlist_head *dest)
+{
+    if( node != src )
+        dlist_splice_range(src->next, node->next, dest);
+}
+
+
+
 /*
  * dlist_reverse - reverse the list
  *
@@ -1060,6 +1128,541 @@ static inline struct dlist_head* dlist_find2(struct dlist_head *first, struct dl
 
 
 
+// dlist_sort: runs shorter than this are extended by insertion sort
+#define DLIST_SORT_MIN_RUN     32
+
+// dlist_sort: count of wins in a row of one run before the galloping mode
+#define DLIST_SORT_MIN_GALLOP  7
+
+// dlist_sort: max count of pending runs. The sizes of the pending runs
+// grow at least as Fibonacci numbers, so 96 is enough for any size_t.
+#define DLIST_SORT_MAX_RUNS    96
+
+
+
+/*
+ * A sorted run of nodes for dlist_sort.
+ *
+ * The nodes of the run are linked by next/prev, last->next == NULL.
+ * first->prev is undefined.
+ *
+ * This is only for internal list manipulation (see dlist_sort)!
+ */
+struct sys_dlist_run
+{
+    struct dlist_head *first;
+    struct dlist_head *last;
+    size_t             size;
+};
+
+
+
+static inline int sys_dlist_gallop_cond(const struct dlist_head *node,
+                                        const struct dlist_head *key, int less,
+                                        int (*comp) (const struct dlist_head *n1, const struct dlist_head *n2) )
+{
+    return less ? comp(node, key) : !comp(key, node);
+}
+
+
+
+/*
+ * Find the longest prefix of chain (first->...->NULL) for which:
+ *
+ *   comp(node, key)  -  if less != 0  (nodes that are less than key)
+ *  !comp(key, node)  -  if less == 0  (nodes that are not greater than key)
+ *
+ * This is only for internal list manipulation (see dlist_sort)!
+ *
+ * Exponential search then binary search, so it calls comp O(ln(k)) times
+ * for a prefix of k nodes (the nodes are walked O(k) times).
+ *
+ * ret: the last node of the prefix or NULL if the prefix is empty
+ */
+static inline struct dlist_head* sys_dlist_gallop(struct dlist_head *first,
+                                                  const struct dlist_head *key, int less,
+                                                  int (*comp) (const struct dlist_head *n1, const struct dlist_head *n2) )
+{
+    struct dlist_head *good  = NULL;  //the last node known to be in the prefix
+    struct dlist_head *probe = first;
+    struct dlist_head *mid;
+    size_t step = 1, gap = 0, half, i;
+
+
+    //exponential search: probe nodes 0, 1, 3, 7, 15, ...
+    while( probe && sys_dlist_gallop_cond(probe, key, less, comp) )
+    {
+        good = probe;
+
+        for(i = 0; i < step && probe; i++)
+            probe = probe->next;
+
+        gap   = i - 1;  //not checked nodes between good and probe (or the end)
+        step <<= 1;
+    }
+
+
+    //binary search of the border in (good, probe)
+    while( good && gap )
+    {
+        half = (gap + 1) / 2;
+
+        for(mid = good, i = 0; i < half; i++)
+            mid = mid->next;
+
+        if( sys_dlist_gallop_cond(mid, key, less, comp) )
+        {
+            good = mid;
+            gap -= half;
+        }
+        else
+        {
+            gap = half - 1;
+        }
+    }
+
+
+    return good;
+}
+
+
+
+/*
+ * Append the nodes first..last (linked chain) to tail.
+ *
+ * This is only for internal list manipulation (see dlist_sort)!
+ *
+ * ret: new tail
+ */
+static inline struct dlist_head* sys_dlist_sort_append(struct dlist_head *tail,
+                                                       struct dlist_head *first,
+                                                       struct dlist_head *last)
+{
+    tail->next  = first;
+    first->prev = tail;
+
+    return last;
+}
+
+
+
+/*
+ * Merge two adjacent sorted runs: a (older) and b (newer). Result in a.
+ *
+ * This is only for internal list manipulation (see dlist_sort)!
+ *
+ * On equal nodes the node from a goes first (merge is stable).
+ * If one run wins DLIST_SORT_MIN_GALLOP times in a row,
+ * the merge looks for the whole block of its winning nodes (sys_dlist_gallop)
+ * and moves the block by one relink.
+ */
+static inline void sys_dlist_merge(struct sys_dlist_run *a, struct sys_dlist_run *b,
+                                   int (*comp) (const struct dlist_head *n1, const struct dlist_head *n2) )
+{
+    struct dlist_head  head;
+    struct dlist_head *tail = &head;
+    struct dlist_head *x    = a->first;
+    struct dlist_head *y    = b->first;
+    struct dlist_head *block;
+    size_t wins_x = 0, wins_y = 0;
+
+
+    while( x && y )
+    {
+        if( comp(y, x) )
+        {
+            tail   = sys_dlist_sort_append(tail, y, y);
+            y      = y->next;
+            wins_x = 0;
+
+            if( ++wins_y >= DLIST_SORT_MIN_GALLOP && y )
+            {
+                block = sys_dlist_gallop(y, x, 1, comp);
+                if( block )
+                {
+                    tail = sys_dlist_sort_append(tail, y, block);
+                    y    = block->next;
+                }
+
+                wins_y = 0;
+            }
+        }
+        else
+        {
+            tail   = sys_dlist_sort_append(tail, x, x);
+            x      = x->next;
+            wins_y = 0;
+
+            if( ++wins_x >= DLIST_SORT_MIN_GALLOP && x )
+            {
+                block = sys_dlist_gallop(x, y, 0, comp);
+                if( block )
+                {
+                    tail = sys_dlist_sort_append(tail, x, block);
+                    x    = block->next;
+                }
+
+                wins_x = 0;
+            }
+        }
+    }
+
+
+    //the rest of one run is already linked, only one relink is needed
+    if( x )
+        sys_dlist_sort_append(tail, x, a->last);
+    else
+        a->last = sys_dlist_sort_append(tail, y, b->last);
+
+
+    a->first = head.next;
+    a->size += b->size;
+}
+
+
+
+/*
+ * Cut the next run from chain (list->...->NULL).
+ *
+ * This is only for internal list manipulation (see dlist_sort)!
+ *
+ * The run is the longest non-descending prefix, or the longest strictly
+ * descending prefix (it is reversed, so the sort stays stable).
+ * A short run is extended to DLIST_SORT_MIN_RUN nodes by insertion sort,
+ * the place of new node is searched from the end of the run (via prev),
+ * so almost sorted data needs few comparisons.
+ *
+ * ret: the rest of the chain (or NULL)
+ */
+static inline struct dlist_head* sys_dlist_next_run(struct dlist_head *list, struct sys_dlist_run *run,
+                                                    int (*comp) (const struct dlist_head *n1, const struct dlist_head *n2) )
+{
+    struct dlist_head *node, *it, *tmp;
+
+
+    run->first = list;
+    run->last  = list;
+    run->size  = 1;
+    list       = list->next;
+
+
+    if( list && comp(list, run->last) )
+    {
+        //strictly descending
+        do
+        {
+            run->last = list;
+            list      = list->next;
+            run->size++;
+        }
+        while( list && comp(list, run->last) );
+
+
+        //reverse: swap next and prev of nodes
+        for(it = run->first; it != list; it = tmp)
+        {
+            tmp      = it->next;
+            it->next = it->prev;
+            it->prev = tmp;
+        }
+
+        tmp        = run->first;
+        run->first = run->last;
+        run->last  = tmp;
+    }
+    else if( list )
+    {
+        //non-descending (the second node is already checked)
+        do
+        {
+            run->last = list;
+            list      = list->next;
+            run->size++;
+        }
+        while( list && !comp(list, run->last) );
+    }
+
+
+    //extend short run by insertion sort
+    while( list && run->size < DLIST_SORT_MIN_RUN )
+    {
+        node = list;
+        list = list->next;
+
+        for(it = run->last; comp(node, it); it = it->prev)
+        {
+            if( it == run->first )
+            {
+                it = NULL;  //node is less than all nodes of the run
+                break;
+            }
+        }
+
+
+        if( !it )
+        {
+            node->next       = run->first;
+            run->first->prev = node;
+            run->first       = node;
+        }
+        else if( it == run->last )
+        {
+            it->next   = node;
+            node->prev = it;
+            run->last  = node;
+        }
+        else
+        {
+            node->next     = it->next;
+            node->prev     = it;
+            it->next->prev = node;
+            it->next       = node;
+        }
+
+        run->size++;
+    }
+
+
+    run->last->next = NULL;
+
+    return list;
+}
+
+
+
+/*
+ * Merge the runs run[i] and run[i+1] into run[i].
+ *
+ * This is only for internal list manipulation (see dlist_sort)!
+ */
+static inline void sys_dlist_merge_at(struct sys_dlist_run *runs, size_t *count, size_t i,
+                                      int (*comp) (const struct dlist_head *n1, const struct dlist_head *n2) )
+{
+    sys_dlist_merge(&runs[i], &runs[i+1], comp);
+
+    if( i + 2 < *count )
+        runs[i+1] = runs[i+2];
+
+    (*count)--;
+}
+
+
+
+/*
+ * dlist_sort - Sorts the elements of the list
+ *
+ * Sorts the elements in ascending order (see comp). The order of equal
+ * elements is preserved (sort is stable).
+ *
+ * It is a natural merge sort (like TimSort): the list is cut into
+ * already sorted (ascending or descending) runs, the runs are merged
+ * with galloping. So already sorted (or reversed) list is sorted
+ * with n-1 comparisons, almost sorted list - with O(n) comparisons,
+ * the worst case is O(n*ln(n)).
+ *
+ * The nodes are only relinked, no memory is allocated. The prev links
+ * are kept valid by the merges (there is not a second pass to fix them).
+ *
+ * head:   the head of the list
+ * comp:   Binary function that accepts two elements in the range as arguments,
+ *         and returns a value convertible to bool. The value returned indicates
+ *         whether the element passed as first argument is considered less than the second.
+ *         The function shall not modify any of its arguments
+ *         (the same as for dlist_min)
+ */
+static inline void dlist_sort(struct dlist_head *head,
+                              int (*comp) (const struct dlist_head *n1, const struct dlist_head *n2) )
+{
+    struct sys_dlist_run runs[DLIST_SORT_MAX_RUNS];
+    struct dlist_head *list;
+    size_t count = 0, i;
+
+
+    if( dlist_empty(head) || dlist_is_singular(head) )
+        return;
+
+
+    head->prev->next = NULL;  //break the ring
+    list = head->next;
+
+
+    while( list )
+    {
+        list = sys_dlist_next_run(list, &runs[count++], comp);
+
+
+        //keep the invariants of TimSort for the sizes of pending runs:
+        //runs[i-2].size > runs[i-1].size + runs[i].size
+        //runs[i-1].size > runs[i].size
+        while( count > 1 )
+        {
+            i = count - 2;
+
+            if( (i > 0 && runs[i-1].size <= runs[i].size + runs[i+1].size) ||
+                (i > 1 && runs[i-2].size <= runs[i-1].size + runs[i].size) )
+            {
+                if( runs[i-1].size < runs[i+1].size )
+                    i--;
+            }
+            else if( runs[i].size > runs[i+1].size )
+            {
+                break;
+            }
+
+            sys_dlist_merge_at(runs, &count, i, comp);
+        }
+    }
+
+
+    while( count > 1 )
+    {
+        i = count - 2;
+
+        if( i > 0 && runs[i-1].size < runs[i+1].size )
+            i--;
+
+        sys_dlist_merge_at(runs, &count, i, comp);
+    }
+
+
+    //close the ring
+    head->next          = runs[0].first;
+    runs[0].first->prev = head;
+    head->prev          = runs[0].last;
+    runs[0].last->next  = head;
+}
+
+
+
+
+/*
+ * DEFINE_DLIST_ALGOS - generate typed versions of the algorithms
+ *
+ * dlist_min, dlist_max, dlist_minmax, dlist_find and dlist_find2 take a pointer
+ * to function, so the compiler makes an indirect call for every element
+ * (it can inline it only if the function is known in the same translation
+ * unit). This macro generates static inline versions for one type of data,
+ * where the comparison and the predicate are expressions on the data,
+ * so they are always inlined.
+ * prefix_less can be used as comp for dlist_sort.
+ *
+ * prefix:    prefix for names of the generated functions
+ * type:      the type of the struct of data this is embedded in.
+ * member:    the name of the node(dlist_head) within the struct of data.
+ * less_expr: expression on (const type *a, const type *b),
+ *            true if a is less than b. example: a->key < b->key
+ * pred_expr: expression on (const type *a, void *data),
+ *            true if a is a match. example: a->key == *(int *)data
+ *            (for prefix_find data is NULL)
+ *
+ * Generated functions (the same semantics as dlist_*):
+ *
+ *   int                prefix_less(const struct dlist_head *n1, const struct dlist_head *n2);
+ *   int                prefix_pred(const struct dlist_head *node, void *data);
+ *   struct dlist_head* prefix_min(struct dlist_head *first, struct dlist_head *last);
+ *   struct dlist_head* prefix_max(struct dlist_head *first, struct dlist_head *last);
+ *   void               prefix_minmax(struct dlist_head *first, struct dlist_head *last,
+ *                                    struct dlist_head *res[2]);
+ *   struct dlist_head* prefix_find(struct dlist_head *first, struct dlist_head *last);
+ *   struct dlist_head* prefix_find2(struct dlist_head *first, struct dlist_head *last,
+ *                                   void *data);
+ *
+ * example:
+ *
+ * DEFINE_DLIST_ALGOS(tmp, struct tmp_data, list, a->data < b->data, a->data == *(int *)data)
+ *
+ * min = tmp_min(head.next, &head);
+ */
+#define DEFINE_DLIST_ALGOS(prefix, type, member, less_expr, pred_expr)                      \
+                                                                                            \
+static inline int prefix##_less(const struct dlist_head *n1, const struct dlist_head *n2)   \
+{                                                                                           \
+    const type *a = dlist_data(n1, type, member);                                           \
+    const type *b = dlist_data(n2, type, member);                                           \
+                                                                                            \
+    return (less_expr);                                                                     \
+}                                                                                           \
+                                                                                            \
+static inline int prefix##_pred(const struct dlist_head *node, void *data)                  \
+{                                                                                           \
+    const type *a = dlist_data(node, type, member);                                         \
+                                                                                            \
+    (void)data;                                                                             \
+    return (pred_expr);                                                                     \
+}                                                                                           \
+                                                                                            \
+static inline struct dlist_head* prefix##_min(struct dlist_head *first, struct dlist_head *last) \
+{                                                                                           \
+    struct dlist_head *smallest = first;                                                    \
+    struct dlist_head *it       = first;                                                    \
+                                                                                            \
+    if(first==last)                                                                         \
+        return last;                                                                        \
+                                                                                            \
+    while( (it = it->next) != last )                                                        \
+        if(prefix##_less(it, smallest))                                                     \
+            smallest=it;                                                                    \
+                                                                                            \
+    return smallest;                                                                        \
+}                                                                                           \
+                                                                                            \
+static inline struct dlist_head* prefix##_max(struct dlist_head *first, struct dlist_head *last) \
+{                                                                                           \
+    struct dlist_head *largest = first;                                                     \
+    struct dlist_head *it      = first;                                                     \
+                                                                                            \
+    if(first==last)                                                                         \
+        return last;                                                                        \
+                                                                                            \
+    while( (it = it->next) != last )                                                        \
+        if(prefix##_less(largest, it))                                                      \
+            largest=it;                                                                     \
+                                                                                            \
+    return largest;                                                                         \
+}                                                                                           \
+                                                                                            \
+static inline void prefix##_minmax(struct dlist_head *first, struct dlist_head *last,       \
+                                   struct dlist_head *res[2])                               \
+{                                                                                           \
+    struct dlist_head *it = first;                                                          \
+                                                                                            \
+    res[0] = first;                                                                         \
+    res[1] = first;                                                                         \
+                                                                                            \
+    if(first==last)                                                                         \
+        return;                                                                             \
+                                                                                            \
+    while( (it = it->next) != last )                                                        \
+    {                                                                                       \
+        if(prefix##_less(it, res[0]))                                                       \
+            res[0]=it;                                                                      \
+                                                                                            \
+        if(prefix##_less(res[1], it))                                                       \
+            res[1]=it;                                                                      \
+    }                                                                                       \
+}                                                                                           \
+                                                                                            \
+static inline struct dlist_head* prefix##_find2(struct dlist_head *first, struct dlist_head *last, \
+                                               void *data)                                  \
+{                                                                                           \
+    while( first != last )                                                                  \
+    {                                                                                       \
+        if( prefix##_pred(first, data) )                                                    \
+            return first;                                                                   \
+                                                                                            \
+        first = first->next;                                                                \
+    }                                                                                       \
+                                                                                            \
+    return last;                                                                            \
+}                                                                                           \
+                                                                                            \
+static inline struct dlist_head* prefix##_find(struct dlist_head *first, struct dlist_head *last) \
+{                                                                                           \
+    return prefix##_find2(first, last, NULL);                                               \
+}
+
+
+
 
 
 #endif  //DLIST_HEADER
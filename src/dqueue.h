@@ -69,6 +69,9 @@
  *  dqueue_rotate_right    -     O(1)
  *  dqueue_splice_front    -     O(1)
  *  dqueue_splice_back     -     O(1)
+ *  dqueue_splice_range    -     O(k), k - size of the range (count of nodes)
+ *  dqueue_splice_range_n  -     O(1)
+ *  dqueue_cut_position    -     O(min(k, n-k)), k - count of the transferred nodes
  *  dqueue_reverse         -     O(n)
  *  dqueue_swap            -     O(1)
  *
@@ -94,6 +97,7 @@
  *  dqueue_minmax          -     O(n)
  *  dqueue_find            -     O(n)
  *  dqueue_find2           -     O(n)
+ *  dqueue_sort            -     O(n*ln(n)), O(n) for sorted dqueue
  */
 
 
@@ -431,6 +435,106 @@ static inline void dqueue_splice_back(struct dqueue_t *src, struct dqueue_t *des
 
 
 
+/*
+ * dqueue_splice_range_n - transfers the elements of the range [first, last)
+ * of src to the position before pos in dest (see dlist_splice_range).
+ * The count of nodes in the range is known by the caller.
+ *
+ * first: the first node of the range
+ * last:  the node after the last node of the range (can be dqueue_end(src))
+ * count: count of nodes in the range [first, last)
+ * src:   dqueue of the range
+ * pos:   the node of dest (or dqueue_end(dest)) before which
+ *        the range will be inserted
+ * dest:  dqueue to copy to (can be == src, pos must not be in the range)
+ */
+static inline void dqueue_splice_range_n(dqueue_node *first, dqueue_node *last, size_t count,
+                                         struct dqueue_t *src,
+                                         dqueue_node *pos, struct dqueue_t *dest)
+{
+    dlist_splice_range(first, last, pos);
+
+    if( src != dest )
+    {
+        src->size  -= count;
+        dest->size += count;
+    }
+}
+
+
+
+/*
+ * dqueue_splice_range - transfers the elements of the range [first, last)
+ * of src to the position before pos in dest (see dlist_splice_range).
+ * The count of nodes is computed by one pass on the range
+ * (if the count is known use dqueue_splice_range_n).
+ *
+ * first: the first node of the range
+ * last:  the node after the last node of the range (can be dqueue_end(src))
+ * src:   dqueue of the range
+ * pos:   the node of dest (or dqueue_end(dest)) before which
+ *        the range will be inserted
+ * dest:  dqueue to copy to (can be == src, pos must not be in the range)
+ */
+static inline void dqueue_splice_range(dqueue_node *first, dqueue_node *last,
+                                       struct dqueue_t *src,
+                                       dqueue_node *pos, struct dqueue_t *dest)
+{
+    size_t count = 0;
+    dqueue_node *it;
+
+
+    if( src != dest )
+        for(it = first; it != last; it = it->next)
+            count++;
+
+    dqueue_splice_range_n(first, last, count, src, pos, dest);
+}
+
+
+
+/*
+ * dqueue_cut_position - transfers the elements from the first to the node
+ * (including node) of src to the back of dest (splits the dqueue in two).
+ *
+ * The count of nodes is computed by two walks at the same time:
+ * from the first node to the node and from the node to the end of src,
+ * so it costs O(min(k, n-k)), k - count of the transferred nodes.
+ *
+ * node: the last node of src for transfer (if node == dqueue_end(src) nothing is done)
+ * src:  dqueue to cut from
+ * dest: dqueue to copy to  (copy to back)
+ */
+static inline void dqueue_cut_position(dqueue_node *node, struct dqueue_t *src,
+                                       struct dqueue_t *dest)
+{
+    dqueue_node *left  = src->head.next;  //walk: first -> node
+    dqueue_node *right = node->next;      //walk: node  -> end
+    size_t left_count  = 1;               //count of nodes in [first, left]
+    size_t right_count = 0;               //count of nodes in (node, right)
+
+
+    if( node == &src->head )
+        return;
+
+
+    while( (left != node) && (right != &src->head) )
+    {
+        left  = left->next;
+        right = right->next;
+        left_count++;
+        right_count++;
+    }
+
+
+    if( left != node )
+        left_count = src->size - right_count;
+
+    dqueue_splice_range_n(src->head.next, node->next, left_count, src, &dest->head, dest);
+}
+
+
+
 /*
  * dqueue_reverse - reverse the dqueue
  *
@@ -892,6 +996,51 @@ static inline dqueue_node* dqueue_find2(dqueue_node *first, dqueue_node *last,
 
 
 
+/*
+ * dqueue_sort - Sorts the elements of the dqueue
+ *
+ * Stable natural merge sort (see dlist_sort): O(n) for sorted or almost
+ * sorted dqueue, O(n*ln(n)) in the worst case. The size of the dqueue
+ * is not changed.
+ *
+ * dqueue: the dqueue for work.
+ * comp:   Binary function that accepts two elements in the range as arguments,
+ *         and returns a value convertible to bool. The value returned indicates
+ *         whether the element passed as first argument is considered less than the second.
+ *         The function shall not modify any of its arguments
+ */
+static inline void dqueue_sort(struct dqueue_t *dqueue,
+                               int (*comp) (const dqueue_node *n1, const dqueue_node *n2) )
+{
+    dlist_sort(&dqueue->head, comp);
+}
+
+
+
+/*
+ * DEFINE_DQUEUE_ALGOS - generate typed versions of the algorithms
+ *
+ * The same as DEFINE_DLIST_ALGOS (see dlist.h):
+ *
+ *   int           prefix_less(const dqueue_node *n1, const dqueue_node *n2);
+ *   int           prefix_pred(const dqueue_node *node, void *data);
+ *   dqueue_node*  prefix_min(dqueue_node *first, dqueue_node *last);
+ *   dqueue_node*  prefix_max(dqueue_node *first, dqueue_node *last);
+ *   void          prefix_minmax(dqueue_node *first, dqueue_node *last, dqueue_node *res[2]);
+ *   dqueue_node*  prefix_find(dqueue_node *first, dqueue_node *last);
+ *   dqueue_node*  prefix_find2(dqueue_node *first, dqueue_node *last, void *data);
+ *
+ * example:
+ *
+ * DEFINE_DQUEUE_ALGOS(tmp, struct tmp_data, node, a->data < b->data, a->data == *(int *)data)
+ *
+ * min = tmp_min(dqueue_begin(&dqueue), dqueue_end(&dqueue));
+ * dqueue_sort(&dqueue, tmp_less);
+ */
+#define DEFINE_DQUEUE_ALGOS(prefix, type, member, less_expr, pred_expr) \
+        DEFINE_DLIST_ALGOS(prefix, type, member, less_expr, pred_expr)
+
+
 
 
 #endif // DQUEUE_H
@@ -0,0 +1,448 @@
+/*
+ * hlist.h
+ *
+ *
+ * BSD 3-Clause License
+ *
+ * Copyright (c) 2017, Koynov Stas - skojnov@yandex.ru
+ *
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice, this
+ *    list of conditions and the following disclaimer.
+ *
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ *    this list of conditions and the following disclaimer in the documentation
+ *    and/or other materials provided with the distribution.
+ *
+ * 3. Neither the name of the copyright holder nor the names of its
+ *    contributors may be used to endorse or promote products derived from
+ *    this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+ * FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ * DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ * SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ * CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+ * OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+
+
+#ifndef HLIST_HEADER
+#define HLIST_HEADER
+
+
+#include <stddef.h>
+
+
+
+
+
+/*
+ * Embedded doubly linked list with a single pointer head (for hash tables).
+ *
+ * Definitions and designations:
+ *
+ *
+ *   next:  ->
+ *   pprev: the address of the pointer to the node (&prev->next or &head->first)
+ *
+ *
+ *   empty list:
+ *       ______
+ *      |      |
+ *      | head |-> NULL
+ *      |______|
+ *
+ *
+ *   list with nodes:
+ *       ______     _______     _______
+ *      |      |   |       |   |       |
+ *      | head |-->| node0 |-->| node1 |-> NULL
+ *      |______|<--|_______|<--|_______|
+ *              pprev       pprev
+ *
+ *
+ * The head is one pointer (half of dlist_head), so an array of buckets
+ * takes half of the memory. The node has next and pprev, so a node is
+ * deleted in O(1) without the head (the head is not known in a hash table
+ * after rehash). The list is not circular, there is no access to the last
+ * node in O(1).
+ *
+ * Node - a data structure (payloads) in which one of the fields is
+ * a variable of type hlist_node.
+ *
+ * example:
+ *
+ * struct tmp_data
+ * {
+ *    struct hlist_node node;
+ *    int               data;
+ * };
+ *
+ * To get pointer to data structure(payloads), if you have a pointer to a node,
+ * use the function: hlist_data
+ *
+ *
+ *  Algorithmic complexity:
+ *
+ *  hlist_size            -     O(n)
+ *  hlist_empty           -     O(1)
+ *  hlist_unhashed        -     O(1)
+ *  hlist_is_singular     -     O(1)
+ *
+ *  hlist_push_front      -     O(1)
+ *  hlist_pop_front       -     O(1)
+ *  hlist_insert_before   -     O(1)
+ *  hlist_insert_after    -     O(1)
+ *  hlist_del             -     O(1)
+ *  hlist_replace         -     O(1)
+ *  hlist_move            -     O(1)
+ *
+ *  //Get Data from node
+ *  hlist_data            -     O(1)
+ *  hlist_first_data      -     O(1)
+ *
+ *  //Iterator
+ *  hlist_citer           -     O(n)
+ *  hlist_iter            -     O(n)
+ *  hlist_data_citer      -     O(n)
+ *  hlist_data_iter       -     O(n)
+ */
+
+
+
+
+
+struct hlist_node
+{
+    struct hlist_node  *next;
+    struct hlist_node **pprev;
+};
+
+
+
+struct hlist_head
+{
+    struct hlist_node *first;
+};
+
+
+
+
+
+#define INIT_HLIST_HEAD(name) { NULL }
+
+#define DECLARE_HLIST_HEAD(name) \
+    struct hlist_head name = INIT_HLIST_HEAD(name)
+
+
+
+static inline void hlist_init_head(struct hlist_head *head)
+{
+    head->first = NULL;
+}
+
+
+
+static inline void hlist_init_node(struct hlist_node *node)
+{
+    node->next  = NULL;
+    node->pprev = NULL;
+}
+
+
+
+/*
+ * hlist_empty - tests whether a list is empty
+ *
+ * head: the list to test.
+ *
+ * ret: true  //if the container size is 0
+ * ret: false //otherwise.
+ */
+static inline int hlist_empty(const struct hlist_head *head)
+{
+    return head->first == NULL;
+}
+
+
+
+/*
+ * hlist_unhashed - tests whether a node is not in a list
+ * (after hlist_init_node or hlist_del)
+ *
+ * node: the node to test.
+ */
+static inline int hlist_unhashed(const struct hlist_node *node)
+{
+    return node->pprev == NULL;
+}
+
+
+
+/*
+ * hlist_is_singular - tests whether a list has just one node.
+ *
+ * head: the list to test.
+ */
+static inline int hlist_is_singular(const struct hlist_head *head)
+{
+    return head->first && !head->first->next;
+}
+
+
+
+/*
+ * hlist_size - Returns the number of elements in the list.
+ *
+ * head: the list to test.
+ */
+static inline size_t hlist_size(const struct hlist_head *head)
+{
+    const struct hlist_node *it;
+    size_t size = 0;
+
+    for(it = head->first; it; it = it->next)
+        size++;
+
+    return size;
+}
+
+
+
+/*
+ * hlist_push_front - add a new node at the beginning of the list
+ *
+ * node: new node to be added
+ * head: list head to add it after
+ *
+ * before:  [head] -> [first]
+ * after:   [head] -> [node] -> [first]
+ */
+static inline void hlist_push_front(struct hlist_node *node, struct hlist_head *head)
+{
+    struct hlist_node *first = head->first;
+
+
+    node->next = first;
+
+    if( first )
+        first->pprev = &node->next;
+
+    head->first = node;
+    node->pprev = &head->first;
+}
+
+
+
+/*
+ * hlist_insert_before - add a new node before the node next
+ *
+ * node: new node to be added
+ * next: the node in a list
+ */
+static inline void hlist_insert_before(struct hlist_node *node, struct hlist_node *next)
+{
+    node->pprev  = next->pprev;
+    node->next   = next;
+    next->pprev  = &node->next;
+    *node->pprev = node;
+}
+
+
+
+/*
+ * hlist_insert_after - add a new node after the node prev
+ *
+ * node: new node to be added
+ * prev: the node in a list
+ */
+static inline void hlist_insert_after(struct hlist_node *node, struct hlist_node *prev)
+{
+    node->next  = prev->next;
+    prev->next  = node;
+    node->pprev = &prev->next;
+
+    if( node->next )
+        node->next->pprev = &node->next;
+}
+
+
+
+/*
+ * hlist_del - deletes node from its list (the head is not needed).
+ *
+ * node: the element to delete from the list.
+ *
+ * Note: hlist_unhashed() on node return true after this
+ */
+static inline void hlist_del(struct hlist_node *node)
+{
+    struct hlist_node  *next  = node->next;
+    struct hlist_node **pprev = node->pprev;
+
+
+    *pprev = next;
+
+    if( next )
+        next->pprev = pprev;
+
+    hlist_init_node(node);
+}
+
+
+
+/*
+ * hlist_pop_front - Delete first element
+ *
+ * head: list head
+ */
+static inline void hlist_pop_front(struct hlist_head *head)
+{
+    if( head->first )
+        hlist_del(head->first);
+}
+
+
+
+/*
+ * hlist_replace - replace old node by new node
+ *
+ * old_node: the element to be replaced (hlist_unhashed is true after this)
+ * new_node: the new element to insert (out of the list)
+ */
+static inline void hlist_replace(struct hlist_node *old_node, struct hlist_node *new_node)
+{
+    new_node->next  = old_node->next;
+    new_node->pprev = old_node->pprev;
+    *new_node->pprev = new_node;
+
+    if( new_node->next )
+        new_node->next->pprev = &new_node->next;
+
+    hlist_init_node(old_node);
+}
+
+
+
+/*
+ * hlist_move - transfers all the elements of src to dest
+ *
+ * src:  list to move from (empty after this)
+ * dest: list to move to (must be empty)
+ */
+static inline void hlist_move(struct hlist_head *src, struct hlist_head *dest)
+{
+    dest->first = src->first;
+
+    if( dest->first )
+        dest->first->pprev = &dest->first;
+
+    src->first = NULL;
+}
+
+
+
+
+
+/*
+ * hlist_data - get the struct (data) for this node
+ *
+ * node:   the node.
+ * type:   the type of the struct of data this is embedded in.
+ * member: the name of the node(hlist_node) within the struct of data.
+ */
+#define hlist_data(node, type, member) \
+     (type *)( (const char *)node - offsetof(type, member) )
+
+
+
+/*
+ * hlist_first_data - get the first struct (data) from a list
+ *
+ * head:   the list to take the element from.
+ * type:   the type of the struct of data this is embedded in.
+ * member: the name of the node(hlist_node) within the struct of data.
+ *
+ * Note - list don't have to be empty.
+ */
+#define hlist_first_data(head, type, member) \
+    hlist_data((head)->first, type, member)
+
+
+
+
+
+/*
+ * hlist_citer - constant iterate over a list
+ *
+ * it:    the &struct hlist_node to use as a loop cursor(iterator).
+ * head:  the head for your list.
+ *
+ * Note You do not have to change list in this cycle.
+ */
+#define hlist_citer(it, head) \
+    for( it = (head)->first; it; it = it->next )
+
+
+
+/*
+ * hlist_iter - iterate over a list safe against removal of list node
+ *
+ * it:     the &struct hlist_node to use as a loop cursor(iterator).
+ * tmp_it: another &struct hlist_node to use as temporary cursor(iterator)
+ * head:   the head for your list.
+ */
+#define hlist_iter(it, tmp_it, head)                                  \
+    for( it = (head)->first, tmp_it = it ? it->next : NULL; it;       \
+         it = tmp_it, tmp_it = it ? it->next : NULL )
+
+
+
+/*
+ * hlist_data_citer - constant iterate over list of given type (data)
+ *
+ * it:     the &struct data to use as a loop cursor(iterator).
+ * head:   the &hlist_head to take the element from.
+ * type:   the type of the struct of data this is embedded in.
+ * member: the name of the node(hlist_node) within the struct of data.
+ *
+ * Note You do not have to change list in this cycle.
+ */
+#define hlist_data_citer(it, head, type, member)                               \
+    for( it = (head)->first ? hlist_data((head)->first, type, member) : NULL;  \
+         it;                                                                   \
+         it = it->member.next ? hlist_data(it->member.next, type, member) : NULL )
+
+
+
+/*
+ * hlist_data_iter - iterate over list of given type safe against removal
+ *
+ * it:     the &struct data to use as a loop cursor(iterator).
+ * head:   the &hlist_head to take the element from.
+ * tmp_it: another &struct hlist_node to use as temporary cursor(iterator)
+ * type:   the type of the struct of data this is embedded in.
+ * member: the name of the node(hlist_node) within the struct of data.
+ */
+#define hlist_data_iter(it, head, tmp_it, type, member)                                 \
+    for( it = (head)->first ? hlist_data((head)->first, type, member) : NULL,           \
+         tmp_it = it ? it->member.next : NULL;                                          \
+         it;                                                                            \
+         it = tmp_it ? hlist_data(tmp_it, type, member) : NULL,                         \
+         tmp_it = it ? it->member.next : NULL )
+
+
+
+
+
+#endif // HLIST_HEADER
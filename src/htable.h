@@ -0,0 +1,431 @@
+/*
+ * htable.h
+ *
+ *
+ * BSD 3-Clause License
+ *
+ * Copyright (c) 2017, Koynov Stas - skojnov@yandex.ru
+ *
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice, this
+ *    list of conditions and the following disclaimer.
+ *
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ *    this list of conditions and the following disclaimer in the documentation
+ *    and/or other materials provided with the distribution.
+ *
+ * 3. Neither the name of the copyright holder nor the names of its
+ *    contributors may be used to endorse or promote products derived from
+ *    this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+ * FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ * DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ * SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ * CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+ * OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+
+
+#ifndef HTABLE_H
+#define HTABLE_H
+
+#include <stddef.h>
+#include <stdlib.h>
+#include <stdint.h>
+#include "hlist.h"
+
+
+
+
+
+/*
+ *  htable_t - intrusive hash table (chaining) on hlist: a bucket is one
+ *  pointer (hlist_head). A node (htable_node) is embedded in the struct of
+ *  data, the table allocates only the array of buckets. The table does
+ *  not hash the keys: the caller gives the hash on insert and lookup,
+ *  the hash is stored in the node (compare of the keys only on equal hashes,
+ *  rehash without the keys).
+ *
+ *  The count of buckets is a power of 2. When the size reaches the count
+ *  of buckets (load factor 1) the table starts to grow x2 incrementally:
+ *  the old array of buckets is kept, every insert and remove moves
+ *  HTABLE_REHASH_STEP buckets from it, lookup checks the both arrays
+ *  (no stop-the-world rehash). htable_rehash_step moves the buckets
+ *  on demand (e.g. in idle time).
+ *
+ *  eq_func(node, key) returns true if the key of the node is equal to key.
+ *
+ *
+ *  Algorithmic complexity:
+ *
+ *  htable_size         -   O(1)
+ *  htable_empty        -   O(1)
+ *  htable_buckets      -   O(1)
+ *  htable_rehashing    -   O(1)
+ *  htable_insert       -   O(1) (amortized with incremental rehash)
+ *  htable_lookup       -   O(1) average
+ *  htable_remove       -   O(1)
+ *  htable_rehash_step  -   O(k), k - count of buckets and nodes moved
+ *  htable_resize       -   O(1) + finish of the current rehash
+ *  htable_for_each     -   O(n + buckets)
+ */
+
+
+
+
+
+#define HTABLE_MIN_BUCKETS   8
+#define HTABLE_REHASH_STEP   2
+
+
+
+struct htable_node
+{
+    struct hlist_node node;
+    size_t            hash;
+};
+
+
+
+typedef int (*htable_eq_func)(const struct htable_node *node, const void *key);
+
+
+
+struct htable_t
+{
+    struct hlist_head *buckets;     // current array of buckets
+    size_t             mask;        // count of buckets - 1
+    struct hlist_head *old;         // old array of buckets while rehash (else NULL)
+    size_t             old_mask;
+    size_t             rehash_pos;  // the next bucket of old for move
+    size_t             size;
+    htable_eq_func     eq_func;
+};
+
+
+
+
+
+// count of buckets for capacity: power of 2 >= capacity (0 if overflow)
+static inline size_t sys_htable_buckets_count(size_t capacity)
+{
+    size_t count = HTABLE_MIN_BUCKETS;
+
+
+    while( count < capacity )
+    {
+        if( count > SIZE_MAX / 2 / sizeof(struct hlist_head) )
+            return 0;
+
+        count <<= 1;
+    }
+
+    return count;
+}
+
+
+
+/*
+ * htable_init - init the hash table.
+ *
+ * ht:       the hash table for work.
+ * capacity: count of nodes without grow (the count of buckets is
+ *           the power of 2 >= capacity, min HTABLE_MIN_BUCKETS)
+ * eq_func:  compare function of the keys
+ *
+ * ret: -1    //if cant get memory
+ * ret: 0     //good job. the hash table was init.
+ */
+static inline int htable_init(struct htable_t *ht, size_t capacity, htable_eq_func eq_func)
+{
+    size_t count = sys_htable_buckets_count(capacity);
+
+
+    ht->buckets = count ? calloc(count, sizeof(struct hlist_head)) : NULL;
+    if( !ht->buckets )
+        return -1;
+
+
+    ht->mask       = count - 1;
+    ht->old        = NULL;
+    ht->old_mask   = 0;
+    ht->rehash_pos = 0;
+    ht->size       = 0;
+    ht->eq_func    = eq_func;
+
+    return 0;
+}
+
+
+
+/*
+ * htable_free - Free the memory of the hash table (the arrays of buckets).
+ * The nodes are not freed (the table does not own them), take them
+ * by htable_for_each before. htable_init must be called to work with
+ * the table again.
+ *
+ * ht: the hash table for work.
+ */
+static inline void htable_free(struct htable_t *ht)
+{
+    free(ht->old);
+    free(ht->buckets);
+
+    ht->buckets = NULL;
+    ht->old     = NULL;
+    ht->mask    = 0;
+    ht->size    = 0;
+}
+
+
+
+static inline size_t htable_size(const struct htable_t *ht)
+{
+    return ht->size;
+}
+
+
+
+static inline int htable_empty(const struct htable_t *ht)
+{
+    return ht->size == 0;
+}
+
+
+
+// count of buckets of the current array (the target of the rehash)
+static inline size_t htable_buckets(const struct htable_t *ht)
+{
+    return ht->mask + 1;
+}
+
+
+
+static inline int htable_rehashing(const struct htable_t *ht)
+{
+    return ht->old != NULL;
+}
+
+
+
+/*
+ * htable_rehash_step - Moves up to n buckets of the old array to the current
+ * one (does nothing if the table is not rehashing).
+ *
+ * ht: the hash table for work.
+ * n:  count of buckets for move (SIZE_MAX - finish the rehash)
+ *
+ * ret: true   //if the rehash is not finished
+ * ret: false  //the table is not rehashing
+ */
+static inline int htable_rehash_step(struct htable_t *ht, size_t n)
+{
+    struct hlist_node *it, *tmp_it;
+    struct htable_node *node;
+
+
+    if( !ht->old )
+        return 0;
+
+
+    for(; n && ht->rehash_pos <= ht->old_mask; n--, ht->rehash_pos++)
+    {
+        hlist_iter(it, tmp_it, &ht->old[ht->rehash_pos])
+        {
+            node = hlist_data(it, struct htable_node, node);
+            hlist_push_front(it, &ht->buckets[node->hash & ht->mask]);
+        }
+
+        ht->old[ht->rehash_pos].first = NULL;
+    }
+
+
+    if( ht->rehash_pos <= ht->old_mask )
+        return 1;
+
+
+    free(ht->old);
+    ht->old = NULL;
+
+    return 0;
+}
+
+
+
+/*
+ * htable_resize - Starts the incremental rehash to the new count of buckets
+ * (grow or shrink). The current rehash is finished before.
+ *
+ * ht:       the hash table for work.
+ * capacity: count of nodes without grow (see htable_init)
+ *
+ * ret: -1    //if cant get memory (the table is not changed)
+ * ret: 0     //good job
+ */
+static inline int htable_resize(struct htable_t *ht, size_t capacity)
+{
+    size_t count = sys_htable_buckets_count(capacity);
+    struct hlist_head *buckets;
+
+
+    htable_rehash_step(ht, SIZE_MAX);
+
+    if( count == ht->mask + 1 )
+        return 0;
+
+
+    buckets = count ? calloc(count, sizeof(struct hlist_head)) : NULL;
+    if( !buckets )
+        return -1;
+
+
+    ht->old        = ht->buckets;
+    ht->old_mask   = ht->mask;
+    ht->rehash_pos = 0;
+    ht->buckets    = buckets;
+    ht->mask       = count - 1;
+
+    return 0;
+}
+
+
+
+/*
+ * htable_insert - Inserts the node with the hash (the keys are not checked
+ * for duplicates, use htable_lookup before for unique keys).
+ * If the table is full it starts to grow (if there is no memory
+ * the table works with the higher load).
+ *
+ * ht:   the hash table for work.
+ * node: the node for insert (not in a table)
+ * hash: the hash of the key of the node
+ */
+static inline void htable_insert(struct htable_t *ht, struct htable_node *node, size_t hash)
+{
+    if( !ht->old && ht->size > ht->mask )
+        htable_resize(ht, 2 * (ht->mask + 1));
+
+
+    node->hash = hash;
+    hlist_push_front(&node->node, &ht->buckets[hash & ht->mask]);
+    ht->size++;
+
+    htable_rehash_step(ht, HTABLE_REHASH_STEP);
+}
+
+
+
+static inline struct htable_node* sys_htable_find(const struct hlist_head *bucket, size_t hash,
+                                                  const void *key, htable_eq_func eq_func)
+{
+    struct hlist_node *it;
+    struct htable_node *node;
+
+
+    hlist_citer(it, bucket)
+    {
+        node = hlist_data(it, struct htable_node, node);
+
+        if( node->hash == hash && eq_func(node, key) )
+            return node;
+    }
+
+    return NULL;
+}
+
+
+
+/*
+ * htable_lookup - Returns the node with the key.
+ *
+ * ht:   the hash table for work.
+ * hash: the hash of the key
+ * key:  the key for eq_func
+ *
+ * ret: NULL   //if there is no node with the key
+ * ret: *node  //good job ret the node (for duplicate keys any of them:
+ *              //the rehash does not keep the order of the nodes in a bucket)
+ */
+static inline struct htable_node* htable_lookup(const struct htable_t *ht, size_t hash,
+                                                const void *key)
+{
+    struct htable_node *node = sys_htable_find(&ht->buckets[hash & ht->mask], hash, key,
+                                               ht->eq_func);
+
+
+    // the bucket of the old array is not moved yet
+    if( !node && ht->old && (hash & ht->old_mask) >= ht->rehash_pos )
+        node = sys_htable_find(&ht->old[hash & ht->old_mask], hash, key, ht->eq_func);
+
+    return node;
+}
+
+
+
+/*
+ * htable_remove - Removes the node from the table.
+ *
+ * ht:   the hash table for work.
+ * node: the node (in the table) for remove
+ */
+static inline void htable_remove(struct htable_t *ht, struct htable_node *node)
+{
+    hlist_del(&node->node);
+    ht->size--;
+
+    htable_rehash_step(ht, HTABLE_REHASH_STEP);
+}
+
+
+
+/*
+ * htable_for_each - Applies function fn to each node of the table.
+ * fn must not insert or remove the nodes of the table (but can free
+ * them before htable_free).
+ *
+ * ht: the hash table for work.
+ * fn: function for the node.
+ */
+static inline void htable_for_each(struct htable_t *ht, void (*fn)(struct htable_node *node))
+{
+    struct hlist_node *it, *tmp_it;
+    size_t i;
+
+
+    if( ht->old )
+        for(i = ht->rehash_pos; i <= ht->old_mask; i++)
+            hlist_iter(it, tmp_it, &ht->old[i])
+                fn(hlist_data(it, struct htable_node, node));
+
+    for(i = 0; i <= ht->mask; i++)
+        hlist_iter(it, tmp_it, &ht->buckets[i])
+            fn(hlist_data(it, struct htable_node, node));
+}
+
+
+
+/*
+ * htable_data - get the struct (data) for this node
+ *
+ * node:   the node.
+ * type:   the type of the struct of data this is embedded in.
+ * member: the name of the node(htable_node) within the struct of data.
+ */
+#define htable_data(node, type, member) \
+    (type *)( (const char *)node - offsetof(type, member) )
+
+
+
+
+
+#endif // HTABLE_H
@@ -0,0 +1,726 @@
+/*
+ * idlist.h
+ *
+ *
+ * BSD 3-Clause License
+ *
+ * Copyright (c) 2017, Koynov Stas - skojnov@yandex.ru
+ *
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice, this
+ *    list of conditions and the following disclaimer.
+ *
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ *    this list of conditions and the following disclaimer in the documentation
+ *    and/or other materials provided with the distribution.
+ *
+ * 3. Neither the name of the copyright holder nor the names of its
+ *    contributors may be used to endorse or promote products derived from
+ *    this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+ * FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ * DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ * SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ * CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+ * OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+
+
+
+#ifndef IDLIST_H
+#define IDLIST_H
+
+#include <stddef.h>
+#include <stdint.h>
+
+
+
+
+
+/*
+ * Doubly linked list on 32-bit indexes (counterpart of dlist.h).
+ *
+ * The nodes are the elements of one array (base): the struct of data
+ * has the member idlist_node (8 bytes: the indexes of the next and
+ * the prev nodes instead of the pointers, 16 bytes on 64 bit platforms).
+ * The list is NULL-terminated in both directions: the head has
+ * the indexes of the first and the last nodes, the ends of the list are
+ * IDLIST_NIL (so the functions that change the ends get the head).
+ *
+ * The array is described by idlist_base (the address of the array,
+ * the size of the element and the offset of the node), all the functions
+ * get it. An index < IDLIST_NIL is the number of the element of the array,
+ * so the data of the node is base[idx] (idlist_data) and the nodes of
+ * the list in order of the array are read in order of memory.
+ * The array can be realloc'd (the indexes stay valid), update the base.
+ *
+ * example:
+ *
+ * struct tmp_data
+ * {
+ *    struct idlist_node list;
+ *    int                data;
+ * };
+ *
+ * struct tmp_data nodes[100];
+ * DECLARE_IDLIST_BASE(base, nodes, struct tmp_data, list);
+ * DECLARE_IDLIST_HEAD(head);
+ *
+ * idlist_push_back(&base, 5, &head);   // nodes[5] is in the list
+ *
+ *
+ *  Algorithmic complexity:
+ *
+ *  idlist_size           -     O(n)
+ *  idlist_empty          -     O(1)  use it for check
+ *  idlist_is_first       -     O(1)
+ *  idlist_is_last        -     O(1)
+ *  idlist_is_singular    -     O(1)
+ *  idlist_first          -     O(1)
+ *  idlist_last           -     O(1)
+ *  idlist_next           -     O(1)
+ *  idlist_prev           -     O(1)
+ *
+ *  idlist_push_front     -     O(1)
+ *  idlist_push_back      -     O(1)
+ *  idlist_insert_after   -     O(1)
+ *  idlist_insert_before  -     O(1)
+ *  idlist_pop_front      -     O(1)
+ *  idlist_pop_back       -     O(1)
+ *  idlist_del            -     O(1)
+ *  idlist_move_to_front  -     O(1)
+ *  idlist_move_to_back   -     O(1)
+ *  idlist_splice_front   -     O(1)
+ *  idlist_splice_back    -     O(1)
+ *  idlist_reverse        -     O(n)
+ *  idlist_swap           -     O(1)
+ *
+ *  //Get Data from index
+ *  idlist_node           -     O(1)
+ *  idlist_data           -     O(1)
+ *
+ *  //Iterator
+ *  idlist_citer          -     O(n)
+ *  idlist_criter         -     O(n)
+ *  idlist_iter           -     O(n)
+ *  idlist_riter          -     O(n)
+ *
+ *  //Algorithm
+ *  idlist_for_each       -     O(n)
+ *  idlist_find           -     O(n)
+ */
+
+
+
+
+
+#define IDLIST_NIL  UINT32_MAX  // end of the list (max count of nodes is IDLIST_NIL)
+
+
+
+struct idlist_node
+{
+    uint32_t next;
+    uint32_t prev;
+};
+
+
+
+struct idlist_head
+{
+    uint32_t first;
+    uint32_t last;
+};
+
+
+
+struct idlist_base
+{
+    char   *array;              // address of the array
+    size_t  stride;             // size of the element of the array
+    size_t  offset;             // offset of idlist_node in the element
+};
+
+
+
+
+
+#define INIT_IDLIST_HEAD(name) { IDLIST_NIL, IDLIST_NIL }
+
+#define DECLARE_IDLIST_HEAD(name) \
+    struct idlist_head name = INIT_IDLIST_HEAD(name)
+
+
+
+#define INIT_IDLIST_BASE(array, type, member) \
+    { (char *)(array), sizeof(type), offsetof(type, member) }
+
+#define DECLARE_IDLIST_BASE(name, array, type, member) \
+    struct idlist_base name = INIT_IDLIST_BASE(array, type, member)
+
+
+
+static inline void idlist_init_head(struct idlist_head *head)
+{
+    head->first = IDLIST_NIL;
+    head->last  = IDLIST_NIL;
+}
+
+
+
+/*
+ * idlist_init_base - init the description of the array of the nodes.
+ *
+ * base:   the description for init.
+ * array:  address of the array
+ * stride: size of the element of the array
+ * offset: offset of idlist_node in the element
+ */
+static inline void idlist_init_base(struct idlist_base *base, void *array,
+                                    size_t stride, size_t offset)
+{
+    base->array  = array;
+    base->stride = stride;
+    base->offset = offset;
+}
+
+
+
+/*
+ * idlist_node - get the node (idlist_node) for the index
+ *
+ * base: the array of the nodes.
+ * idx:  the index of the node (< IDLIST_NIL)
+ */
+static inline struct idlist_node* idlist_node(const struct idlist_base *base, uint32_t idx)
+{
+    return (struct idlist_node *)(base->array + (size_t)idx * base->stride + base->offset);
+}
+
+
+
+/*
+ * idlist_empty - tests whether a list is empty
+ *
+ * head: the list to test.
+ *
+ * ret: true  //if the container size is 0
+ * ret: false //otherwise.
+ */
+static inline int idlist_empty(const struct idlist_head *head)
+{
+    return head->first == IDLIST_NIL;
+}
+
+
+
+static inline uint32_t idlist_first(const struct idlist_head *head)
+{
+    return head->first;
+}
+
+
+
+static inline uint32_t idlist_last(const struct idlist_head *head)
+{
+    return head->last;
+}
+
+
+
+// ret: the index of the node after idx or IDLIST_NIL if idx is the last
+static inline uint32_t idlist_next(const struct idlist_base *base, uint32_t idx)
+{
+    return idlist_node(base, idx)->next;
+}
+
+
+
+// ret: the index of the node before idx or IDLIST_NIL if idx is the first
+static inline uint32_t idlist_prev(const struct idlist_base *base, uint32_t idx)
+{
+    return idlist_node(base, idx)->prev;
+}
+
+
+
+static inline int idlist_is_first(uint32_t idx, const struct idlist_head *head)
+{
+    return head->first == idx;
+}
+
+
+
+static inline int idlist_is_last(uint32_t idx, const struct idlist_head *head)
+{
+    return head->last == idx;
+}
+
+
+
+static inline int idlist_is_singular(const struct idlist_head *head)
+{
+    return !idlist_empty(head) && head->first == head->last;
+}
+
+
+
+/*
+ * idlist_size - Returns the number of elements in the list container.
+ *
+ * base: the array of the nodes.
+ * head: the list to test.
+ * ret:  the number of elements in the list
+ */
+static inline size_t idlist_size(const struct idlist_base *base, const struct idlist_head *head)
+{
+    size_t size = 0;
+    uint32_t it;
+
+    for(it = head->first; it != IDLIST_NIL; it = idlist_next(base, it))
+        size++;
+
+    return size;
+}
+
+
+
+/*
+ * Insert the node between two consecutive nodes prev and next
+ * (IDLIST_NIL - the end of the list).
+ *
+ * before:  [prev] <-> [next]
+ * after:   [prev] <-> [idx] <-> [next]
+ */
+static inline void sys_idlist_add(const struct idlist_base *base, uint32_t idx,
+                                  uint32_t prev, uint32_t next, struct idlist_head *head)
+{
+    struct idlist_node *node = idlist_node(base, idx);
+
+
+    node->next = next;
+    node->prev = prev;
+
+    if( next == IDLIST_NIL )
+        head->last = idx;
+    else
+        idlist_node(base, next)->prev = idx;
+
+    if( prev == IDLIST_NIL )
+        head->first = idx;
+    else
+        idlist_node(base, prev)->next = idx;
+}
+
+
+
+/*
+ * idlist_push_front - Inserts the node at the beginning of the list.
+ *
+ * base: the array of the nodes.
+ * idx:  the index of the new node
+ * head: the list
+ */
+static inline void idlist_push_front(const struct idlist_base *base, uint32_t idx,
+                                     struct idlist_head *head)
+{
+    sys_idlist_add(base, idx, IDLIST_NIL, head->first, head);
+}
+
+
+
+/*
+ * idlist_push_back - Inserts the node at the end of the list.
+ *
+ * base: the array of the nodes.
+ * idx:  the index of the new node
+ * head: the list
+ */
+static inline void idlist_push_back(const struct idlist_base *base, uint32_t idx,
+                                    struct idlist_head *head)
+{
+    sys_idlist_add(base, idx, head->last, IDLIST_NIL, head);
+}
+
+
+
+/*
+ * idlist_insert_after - Inserts the node after the node pos of the list.
+ *
+ * base: the array of the nodes.
+ * idx:  the index of the new node
+ * pos:  the index of the node of the list
+ * head: the list
+ */
+static inline void idlist_insert_after(const struct idlist_base *base, uint32_t idx,
+                                       uint32_t pos, struct idlist_head *head)
+{
+    sys_idlist_add(base, idx, pos, idlist_next(base, pos), head);
+}
+
+
+
+/*
+ * idlist_insert_before - Inserts the node before the node pos of the list.
+ *
+ * base: the array of the nodes.
+ * idx:  the index of the new node
+ * pos:  the index of the node of the list
+ * head: the list
+ */
+static inline void idlist_insert_before(const struct idlist_base *base, uint32_t idx,
+                                        uint32_t pos, struct idlist_head *head)
+{
+    sys_idlist_add(base, idx, idlist_prev(base, pos), pos, head);
+}
+
+
+
+/*
+ * idlist_del - deletes the node from the list.
+ *
+ * base: the array of the nodes.
+ * idx:  the index of the node (in the list) to delete
+ * head: the list
+ *
+ * Note: the next and the prev of the node are its index after this
+ *
+ * before:  [prev] <-> [idx] <-> [next]
+ * after:   [prev] <-> [next];              self <- [idx] -> self
+ */
+static inline void idlist_del(const struct idlist_base *base, uint32_t idx,
+                              struct idlist_head *head)
+{
+    struct idlist_node *node = idlist_node(base, idx);
+
+
+    if( node->next == IDLIST_NIL )
+        head->last = node->prev;
+    else
+        idlist_node(base, node->next)->prev = node->prev;
+
+    if( node->prev == IDLIST_NIL )
+        head->first = node->next;
+    else
+        idlist_node(base, node->prev)->next = node->next;
+
+    node->next = idx;
+    node->prev = idx;
+}
+
+
+
+/*
+ * idlist_pop_front - Removes the first node of the list.
+ *
+ * base: the array of the nodes.
+ * head: the list
+ *
+ * ret: the index of the removed node
+ * ret: IDLIST_NIL //if the list is empty.
+ */
+static inline uint32_t idlist_pop_front(const struct idlist_base *base, struct idlist_head *head)
+{
+    uint32_t idx = head->first;
+
+    if( idx != IDLIST_NIL )
+        idlist_del(base, idx, head);
+
+    return idx;
+}
+
+
+
+/*
+ * idlist_pop_back - Removes the last node of the list.
+ *
+ * base: the array of the nodes.
+ * head: the list
+ *
+ * ret: the index of the removed node
+ * ret: IDLIST_NIL //if the list is empty.
+ */
+static inline uint32_t idlist_pop_back(const struct idlist_base *base, struct idlist_head *head)
+{
+    uint32_t idx = head->last;
+
+    if( idx != IDLIST_NIL )
+        idlist_del(base, idx, head);
+
+    return idx;
+}
+
+
+
+/*
+ * idlist_move_to_front - delete the node from the list src and add
+ *                        it to the front of the list dest
+ *                        (src and dest can be the same list)
+ */
+static inline void idlist_move_to_front(const struct idlist_base *base, uint32_t idx,
+                                        struct idlist_head *src, struct idlist_head *dest)
+{
+    idlist_del(base, idx, src);
+    idlist_push_front(base, idx, dest);
+}
+
+
+
+/*
+ * idlist_move_to_back - delete the node from the list src and add
+ *                       it to the back of the list dest
+ *                       (src and dest can be the same list)
+ */
+static inline void idlist_move_to_back(const struct idlist_base *base, uint32_t idx,
+                                       struct idlist_head *src, struct idlist_head *dest)
+{
+    idlist_del(base, idx, src);
+    idlist_push_back(base, idx, dest);
+}
+
+
+
+/*
+ * idlist_splice_front - transfers all the nodes of src to the front of dest
+ *                       (src is empty after this)
+ *
+ * base: the array of the nodes (the same for the both lists).
+ * src:  the list to copy from
+ * dest: the list to copy to
+ */
+static inline void idlist_splice_front(const struct idlist_base *base,
+                                       struct idlist_head *src, struct idlist_head *dest)
+{
+    if( idlist_empty(src) )
+        return;
+
+
+    if( idlist_empty(dest) )
+        dest->last = src->last;
+    else
+    {
+        idlist_node(base, src->last)->next   = dest->first;
+        idlist_node(base, dest->first)->prev = src->last;
+    }
+
+    dest->first = src->first;
+    idlist_init_head(src);
+}
+
+
+
+/*
+ * idlist_splice_back - transfers all the nodes of src to the back of dest
+ *                      (src is empty after this)
+ *
+ * base: the array of the nodes (the same for the both lists).
+ * src:  the list to copy from
+ * dest: the list to copy to
+ */
+static inline void idlist_splice_back(const struct idlist_base *base,
+                                      struct idlist_head *src, struct idlist_head *dest)
+{
+    if( idlist_empty(src) )
+        return;
+
+
+    if( idlist_empty(dest) )
+        dest->first = src->first;
+    else
+    {
+        idlist_node(base, dest->last)->next = src->first;
+        idlist_node(base, src->first)->prev = dest->last;
+    }
+
+    dest->last = src->last;
+    idlist_init_head(src);
+}
+
+
+
+/*
+ * idlist_reverse - reverse the list
+ *
+ * base: the array of the nodes.
+ * head: the list
+ */
+static inline void idlist_reverse(const struct idlist_base *base, struct idlist_head *head)
+{
+    uint32_t it = head->first;
+    struct idlist_node *node;
+
+
+    while( it != IDLIST_NIL )
+    {
+        node       = idlist_node(base, it);
+        it         = node->next;
+        node->next = node->prev;
+        node->prev = it;
+    }
+
+    it          = head->first;
+    head->first = head->last;
+    head->last  = it;
+}
+
+
+
+/*
+ * idlist_swap - Exchanges the contents of the containers.
+ */
+static inline void idlist_swap(struct idlist_head *head1, struct idlist_head *head2)
+{
+    struct idlist_head tmp = *head1;
+
+    *head1 = *head2;
+    *head2 = tmp;
+}
+
+
+
+
+//---------------- Get Data from index ----------------
+
+
+
+
+
+/*
+ * idlist_data - get the struct (data) for the index
+ *
+ * base: the array of the nodes (&idlist_base).
+ * idx:  the index of the node.
+ * type: the type of the element of the array.
+ */
+#define idlist_data(base, idx, type) \
+    ((type *)((base)->array + (size_t)(idx) * (base)->stride))
+
+
+
+
+//---------------- Iterator ----------------
+
+
+
+
+
+/*
+ * idlist_citer - constant iterate over a list
+ *
+ * it:    the uint32_t to use as a loop cursor(iterator): the index of the node.
+ * base:  the array of the nodes (&idlist_base).
+ * head:  the head for your list.
+ *
+ * Note You do not have to change list in this cycle.
+ */
+#define idlist_citer(it, base, head) \
+    for( it = (head)->first; it != IDLIST_NIL; it = idlist_next(base, it) )
+
+
+
+/*
+ * idlist_criter - constant reverse iterate over a list
+ *
+ * it:    the uint32_t to use as a loop cursor(iterator): the index of the node.
+ * base:  the array of the nodes (&idlist_base).
+ * head:  the head for your list.
+ *
+ * Note You do not have to change list in this cycle.
+ */
+#define idlist_criter(it, base, head) \
+    for( it = (head)->last; it != IDLIST_NIL; it = idlist_prev(base, it) )
+
+
+
+/*
+ * idlist_iter - iterate over a list safe against removal of list node
+ *
+ * it:     the uint32_t to use as a loop cursor(iterator).
+ * tmp_it: another uint32_t to use as temporary cursor(iterator)
+ * base:   the array of the nodes (&idlist_base).
+ * head:   the head for your list.
+ */
+#define idlist_iter(it, tmp_it, base, head)                                     \
+    for( it = (head)->first;                                                    \
+         it != IDLIST_NIL && ((tmp_it = idlist_next(base, it)), 1); it = tmp_it )
+
+
+
+/*
+ * idlist_riter - reverse iterate over a list safe against removal of list node
+ *
+ * it:     the uint32_t to use as a loop cursor(iterator).
+ * tmp_it: another uint32_t to use as temporary cursor(iterator)
+ * base:   the array of the nodes (&idlist_base).
+ * head:   the head for your list.
+ */
+#define idlist_riter(it, tmp_it, base, head)                                    \
+    for( it = (head)->last;                                                     \
+         it != IDLIST_NIL && ((tmp_it = idlist_prev(base, it)), 1); it = tmp_it )
+
+
+
+
+
+//---------------- Algorithm ----------------
+
+
+
+
+
+/*
+ * idlist_for_each - Applies function fn to each of the nodes in the range [first,last)
+ *
+ * base:  the array of the nodes.
+ * first: the index of the first node
+ * last:  the index of the node after the range (IDLIST_NIL - to the end)
+ * fn:    function for the index of the node.
+ * data:  Pointer to user data for fn function.
+ */
+static inline void idlist_for_each(const struct idlist_base *base, uint32_t first, uint32_t last,
+                                   void (*fn) (uint32_t idx, void *data), void *data)
+{
+    for(; first != last; first = idlist_next(base, first))
+        fn(first, data);
+}
+
+
+
+/*
+ * idlist_find - Find node in range
+ *
+ * Returns the index of the first node in the range [first,last)
+ * for which pred returns true.
+ * If no such node is found, the function returns last.
+ *
+ * base:  the array of the nodes.
+ * first: the index of the first node
+ * last:  the index of the node after the range (IDLIST_NIL - to the end)
+ * pred:  function for the index of the node, returns true for the match.
+ * data:  Pointer to user data for pred function.
+ */
+static inline uint32_t idlist_find(const struct idlist_base *base, uint32_t first, uint32_t last,
+                                   int (*pred) (uint32_t idx, void *data), void *data)
+{
+    for(; first != last; first = idlist_next(base, first))
+        if( pred(first, data) )
+            return first;
+
+    return last;
+}
+
+
+
+
+
+#endif // IDLIST_H
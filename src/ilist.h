@@ -0,0 +1,610 @@
+/*
+ * ilist.h
+ *
+ *
+ * BSD 3-Clause License
+ *
+ * Copyright (c) 2017, Koynov Stas - skojnov@yandex.ru
+ *
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice, this
+ *    list of conditions and the following disclaimer.
+ *
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ *    this list of conditions and the following disclaimer in the documentation
+ *    and/or other materials provided with the distribution.
+ *
+ * 3. Neither the name of the copyright holder nor the names of its
+ *    contributors may be used to endorse or promote products derived from
+ *    this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+ * FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ * DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ * SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ * CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+ * OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+
+
+
+#ifndef ILIST_H
+#define ILIST_H
+
+#include <stddef.h>
+#include <stdint.h>
+
+
+
+
+
+/*
+ * Singly linked list on 32-bit indexes (counterpart of list.h).
+ *
+ * The nodes are the elements of one array (base): the struct of data
+ * has the member ilist_node (4 bytes: the index of the next node instead
+ * of the pointer, 8 bytes on 64 bit platforms). The list is
+ * NULL-terminated: the head is the index of the first node, the next
+ * of the last node is ILIST_NIL.
+ *
+ * The array is described by ilist_base (the address of the array,
+ * the size of the element and the offset of the node), all the functions
+ * get it. An index < ILIST_NIL is the number of the element of the array,
+ * so the data of the node is base[idx] (ilist_data) and the nodes of
+ * the list in order of the array are read in order of memory.
+ * The array can be realloc'd (the indexes stay valid), update the base.
+ *
+ * example:
+ *
+ * struct tmp_data
+ * {
+ *    struct ilist_node list;
+ *    int               data;
+ * };
+ *
+ * struct tmp_data nodes[100];
+ * DECLARE_ILIST_BASE(base, nodes, struct tmp_data, list);
+ * DECLARE_ILIST_HEAD(head);
+ *
+ * ilist_push_front(&base, 5, &head);   // nodes[5] is in the list
+ *
+ *
+ *  Algorithmic complexity:
+ *
+ *  ilist_size           -     O(n)
+ *  ilist_empty          -     O(1)  use it for check
+ *  ilist_is_first       -     O(1)
+ *  ilist_is_last        -     O(1)
+ *  ilist_is_singular    -     O(1)
+ *  ilist_first          -     O(1)
+ *  ilist_last           -     O(n)
+ *  ilist_next           -     O(1)
+ *
+ *  ilist_push_front     -     O(1)
+ *  ilist_pop_front      -     O(1)
+ *  ilist_insert_after   -     O(1)
+ *  ilist_push_back      -     O(n)
+ *  ilist_pop_back       -     O(n)
+ *  ilist_del            -     O(n)
+ *  ilist_splice_front   -     O(n)  n - size of src
+ *  ilist_splice_back    -     O(n)  n - size of dest
+ *  ilist_reverse        -     O(n)
+ *  ilist_swap           -     O(1)
+ *
+ *  //Get Data from index
+ *  ilist_node           -     O(1)
+ *  ilist_data           -     O(1)
+ *
+ *  //Iterator
+ *  ilist_citer          -     O(n)
+ *  ilist_iter           -     O(n)
+ *
+ *  //Algorithm
+ *  ilist_for_each       -     O(n)
+ *  ilist_find           -     O(n)
+ */
+
+
+
+
+
+#define ILIST_NIL  UINT32_MAX   // end of the list (max count of nodes is ILIST_NIL)
+
+
+
+struct ilist_node
+{
+    uint32_t next;
+};
+
+
+
+struct ilist_head
+{
+    uint32_t first;
+};
+
+
+
+struct ilist_base
+{
+    char   *array;              // address of the array
+    size_t  stride;             // size of the element of the array
+    size_t  offset;             // offset of ilist_node in the element
+};
+
+
+
+
+
+#define INIT_ILIST_HEAD(name) { ILIST_NIL }
+
+#define DECLARE_ILIST_HEAD(name) \
+    struct ilist_head name = INIT_ILIST_HEAD(name)
+
+
+
+#define INIT_ILIST_BASE(array, type, member) \
+    { (char *)(array), sizeof(type), offsetof(type, member) }
+
+#define DECLARE_ILIST_BASE(name, array, type, member) \
+    struct ilist_base name = INIT_ILIST_BASE(array, type, member)
+
+
+
+static inline void ilist_init_head(struct ilist_head *head)
+{
+    head->first = ILIST_NIL;
+}
+
+
+
+/*
+ * ilist_init_base - init the description of the array of the nodes.
+ *
+ * base:   the description for init.
+ * array:  address of the array
+ * stride: size of the element of the array
+ * offset: offset of ilist_node in the element
+ */
+static inline void ilist_init_base(struct ilist_base *base, void *array,
+                                   size_t stride, size_t offset)
+{
+    base->array  = array;
+    base->stride = stride;
+    base->offset = offset;
+}
+
+
+
+/*
+ * ilist_node - get the node (ilist_node) for the index
+ *
+ * base: the array of the nodes.
+ * idx:  the index of the node (< ILIST_NIL)
+ */
+static inline struct ilist_node* ilist_node(const struct ilist_base *base, uint32_t idx)
+{
+    return (struct ilist_node *)(base->array + (size_t)idx * base->stride + base->offset);
+}
+
+
+
+/*
+ * ilist_empty - tests whether a list is empty
+ *
+ * head: the list to test.
+ *
+ * ret: true  //if the container size is 0
+ * ret: false //otherwise.
+ */
+static inline int ilist_empty(const struct ilist_head *head)
+{
+    return head->first == ILIST_NIL;
+}
+
+
+
+static inline uint32_t ilist_first(const struct ilist_head *head)
+{
+    return head->first;
+}
+
+
+
+// ret: the index of the node after idx or ILIST_NIL if idx is the last
+static inline uint32_t ilist_next(const struct ilist_base *base, uint32_t idx)
+{
+    return ilist_node(base, idx)->next;
+}
+
+
+
+static inline int ilist_is_first(uint32_t idx, const struct ilist_head *head)
+{
+    return head->first == idx;
+}
+
+
+
+static inline int ilist_is_last(const struct ilist_base *base, uint32_t idx)
+{
+    return ilist_next(base, idx) == ILIST_NIL;
+}
+
+
+
+static inline int ilist_is_singular(const struct ilist_base *base, const struct ilist_head *head)
+{
+    return !ilist_empty(head) && ilist_is_last(base, head->first);
+}
+
+
+
+/*
+ * ilist_size - Returns the number of elements in the list container.
+ *
+ * base: the array of the nodes.
+ * head: the list to test.
+ * ret:  the number of elements in the list
+ */
+static inline size_t ilist_size(const struct ilist_base *base, const struct ilist_head *head)
+{
+    size_t size = 0;
+    uint32_t it;
+
+    for(it = head->first; it != ILIST_NIL; it = ilist_next(base, it))
+        size++;
+
+    return size;
+}
+
+
+
+// ret: the index of the last node or ILIST_NIL if the list is empty
+static inline uint32_t ilist_last(const struct ilist_base *base, const struct ilist_head *head)
+{
+    uint32_t it = head->first;
+
+    if( it != ILIST_NIL )
+        while( !ilist_is_last(base, it) )
+            it = ilist_next(base, it);
+
+    return it;
+}
+
+
+
+/*
+ * ilist_push_front - Inserts the node at the beginning of the list.
+ *
+ * base: the array of the nodes.
+ * idx:  the index of the new node
+ * head: the list
+ */
+static inline void ilist_push_front(const struct ilist_base *base, uint32_t idx,
+                                    struct ilist_head *head)
+{
+    ilist_node(base, idx)->next = head->first;
+    head->first = idx;
+}
+
+
+
+/*
+ * ilist_insert_after - Inserts the node after the node pos.
+ *
+ * base: the array of the nodes.
+ * idx:  the index of the new node
+ * pos:  the index of the node of the list
+ */
+static inline void ilist_insert_after(const struct ilist_base *base, uint32_t idx, uint32_t pos)
+{
+    struct ilist_node *prev = ilist_node(base, pos);
+
+    ilist_node(base, idx)->next = prev->next;
+    prev->next = idx;
+}
+
+
+
+/*
+ * ilist_push_back - Inserts the node at the end of the list.
+ *
+ * base: the array of the nodes.
+ * idx:  the index of the new node
+ * head: the list
+ */
+static inline void ilist_push_back(const struct ilist_base *base, uint32_t idx,
+                                   struct ilist_head *head)
+{
+    uint32_t last = ilist_last(base, head);
+
+    if( last == ILIST_NIL )
+        ilist_push_front(base, idx, head);
+    else
+        ilist_insert_after(base, idx, last);
+}
+
+
+
+/*
+ * ilist_pop_front - Removes the first node of the list.
+ *
+ * base: the array of the nodes.
+ * head: the list
+ *
+ * ret: the index of the removed node (its next is its index after this)
+ * ret: ILIST_NIL //if the list is empty.
+ */
+static inline uint32_t ilist_pop_front(const struct ilist_base *base, struct ilist_head *head)
+{
+    uint32_t idx = head->first;
+    struct ilist_node *node;
+
+
+    if( idx != ILIST_NIL )
+    {
+        node        = ilist_node(base, idx);
+        head->first = node->next;
+        node->next  = idx;
+    }
+
+    return idx;
+}
+
+
+
+/*
+ * ilist_del - deletes the node from the list.
+ *
+ * base: the array of the nodes.
+ * idx:  the index of the node (in the list) to delete
+ * head: the list
+ *
+ * Note: the next of the node is its index after this
+ */
+static inline void ilist_del(const struct ilist_base *base, uint32_t idx, struct ilist_head *head)
+{
+    struct ilist_node *node = ilist_node(base, idx);
+    uint32_t it = head->first;
+
+
+    if( it == idx )
+        head->first = node->next;
+    else
+    {
+        while( ilist_next(base, it) != idx )
+            it = ilist_next(base, it);
+
+        ilist_node(base, it)->next = node->next;
+    }
+
+    node->next = idx;
+}
+
+
+
+/*
+ * ilist_pop_back - Removes the last node of the list.
+ *
+ * base: the array of the nodes.
+ * head: the list
+ *
+ * ret: the index of the removed node
+ * ret: ILIST_NIL //if the list is empty.
+ */
+static inline uint32_t ilist_pop_back(const struct ilist_base *base, struct ilist_head *head)
+{
+    uint32_t last = ilist_last(base, head);
+
+    if( last != ILIST_NIL )
+        ilist_del(base, last, head);
+
+    return last;
+}
+
+
+
+/*
+ * ilist_splice_front - transfers all the nodes of src to the front of dest
+ *                      (src is empty after this)
+ *
+ * base: the array of the nodes (the same for the both lists).
+ * src:  the list to copy from
+ * dest: the list to copy to
+ */
+static inline void ilist_splice_front(const struct ilist_base *base,
+                                      struct ilist_head *src, struct ilist_head *dest)
+{
+    uint32_t last = ilist_last(base, src);
+
+    if( last != ILIST_NIL )
+    {
+        ilist_node(base, last)->next = dest->first;
+        dest->first = src->first;
+        src->first  = ILIST_NIL;
+    }
+}
+
+
+
+/*
+ * ilist_splice_back - transfers all the nodes of src to the back of dest
+ *                     (src is empty after this)
+ *
+ * base: the array of the nodes (the same for the both lists).
+ * src:  the list to copy from
+ * dest: the list to copy to
+ */
+static inline void ilist_splice_back(const struct ilist_base *base,
+                                     struct ilist_head *src, struct ilist_head *dest)
+{
+    uint32_t last = ilist_last(base, dest);
+
+    if( last == ILIST_NIL )
+        dest->first = src->first;
+    else
+        ilist_node(base, last)->next = src->first;
+
+    src->first = ILIST_NIL;
+}
+
+
+
+/*
+ * ilist_reverse - reverse the list
+ *
+ * base: the array of the nodes.
+ * head: the list
+ */
+static inline void ilist_reverse(const struct ilist_base *base, struct ilist_head *head)
+{
+    uint32_t it = head->first, prev = ILIST_NIL, next;
+    struct ilist_node *node;
+
+
+    while( it != ILIST_NIL )
+    {
+        node       = ilist_node(base, it);
+        next       = node->next;
+        node->next = prev;
+        prev       = it;
+        it         = next;
+    }
+
+    head->first = prev;
+}
+
+
+
+/*
+ * ilist_swap - Exchanges the contents of the containers.
+ */
+static inline void ilist_swap(struct ilist_head *head1, struct ilist_head *head2)
+{
+    uint32_t tmp = head1->first;
+
+    head1->first = head2->first;
+    head2->first = tmp;
+}
+
+
+
+
+//---------------- Get Data from index ----------------
+
+
+
+
+
+/*
+ * ilist_data - get the struct (data) for the index
+ *
+ * base: the array of the nodes (&ilist_base).
+ * idx:  the index of the node.
+ * type: the type of the element of the array.
+ */
+#define ilist_data(base, idx, type) \
+    ((type *)((base)->array + (size_t)(idx) * (base)->stride))
+
+
+
+
+//---------------- Iterator ----------------
+
+
+
+
+
+/*
+ * ilist_citer - constant iterate over a list
+ *
+ * it:    the uint32_t to use as a loop cursor(iterator): the index of the node.
+ * base:  the array of the nodes (&ilist_base).
+ * head:  the head for your list.
+ *
+ * Note You do not have to change list in this cycle.
+ */
+#define ilist_citer(it, base, head) \
+    for( it = (head)->first; it != ILIST_NIL; it = ilist_next(base, it) )
+
+
+
+/*
+ * ilist_iter - iterate over a list safe against removal of list node
+ *
+ * it:     the uint32_t to use as a loop cursor(iterator).
+ * tmp_it: another uint32_t to use as temporary cursor(iterator)
+ * base:   the array of the nodes (&ilist_base).
+ * head:   the head for your list.
+ */
+#define ilist_iter(it, tmp_it, base, head)                                     \
+    for( it = (head)->first;                                                   \
+         it != ILIST_NIL && ((tmp_it = ilist_next(base, it)), 1); it = tmp_it )
+
+
+
+
+
+//---------------- Algorithm ----------------
+
+
+
+
+
+/*
+ * ilist_for_each - Applies function fn to each of the nodes in the range [first,last)
+ *
+ * base:  the array of the nodes.
+ * first: the index of the first node
+ * last:  the index of the node after the range (ILIST_NIL - to the end)
+ * fn:    function for the index of the node.
+ * data:  Pointer to user data for fn function.
+ */
+static inline void ilist_for_each(const struct ilist_base *base, uint32_t first, uint32_t last,
+                                  void (*fn) (uint32_t idx, void *data), void *data)
+{
+    for(; first != last; first = ilist_next(base, first))
+        fn(first, data);
+}
+
+
+
+/*
+ * ilist_find - Find node in range
+ *
+ * Returns the index of the first node in the range [first,last)
+ * for which pred returns true.
+ * If no such node is found, the function returns last.
+ *
+ * base:  the array of the nodes.
+ * first: the index of the first node
+ * last:  the index of the node after the range (ILIST_NIL - to the end)
+ * pred:  function for the index of the node, returns true for the match.
+ * data:  Pointer to user data for pred function.
+ */
+static inline uint32_t ilist_find(const struct ilist_base *base, uint32_t first, uint32_t last,
+                                  int (*pred) (uint32_t idx, void *data), void *data)
+{
+    for(; first != last; first = ilist_next(base, first))
+        if( pred(first, data) )
+            return first;
+
+    return last;
+}
+
+
+
+
+
+#endif // ILIST_H
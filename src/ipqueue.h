@@ -0,0 +1,355 @@
+/*
+ * ipqueue.h
+ *
+ *
+ * BSD 3-Clause License
+ *
+ * Copyright (c) 2017, Koynov Stas - skojnov@yandex.ru
+ *
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice, this
+ *    list of conditions and the following disclaimer.
+ *
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ *    this list of conditions and the following disclaimer in the documentation
+ *    and/or other materials provided with the distribution.
+ *
+ * 3. Neither the name of the copyright holder nor the names of its
+ *    contributors may be used to endorse or promote products derived from
+ *    this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+ * FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ * DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ * SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ * CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+ * OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+
+#ifndef IPQUEUE_H
+#define IPQUEUE_H
+
+#include "pqueue.h"
+
+
+
+
+
+/*
+ *  ipqueue_t - indexed (addressable) priority queue based on dynamic array
+ *  (standart binary heap). Every item stores its current position in the heap
+ *  (size_t field in the item, see pos_offset), the position is updated on every
+ *  move of the item, so the item can be found in O(1) and its key can be changed
+ *  (ipqueue_update) or the item can be removed (ipqueue_remove) in O(ln(n))
+ *  without a scan and without lazy deletion.
+ *
+ *  The first fields of ipqueue_t are the same as pqueue_t, so pqueue_reserve,
+ *  pqueue_shrink_to_fit, pqueue_set_grow_factor and pqueue_free can be used
+ *  for it (by cast to struct pqueue_t *).
+ *
+ *  example:
+ *
+ *  struct job
+ *  {
+ *      int    key;
+ *      size_t heap_pos;
+ *  };
+ *
+ *  ipqueue_init(&q, 16, 16, cmp_jobs, offsetof(struct job, heap_pos));
+ *  ipqueue_push(&q, &job);          //items are pointers to struct job
+ *
+ *  job.key = 0;
+ *  ipqueue_update(&q, &job);        //decrease or increase key
+ *  ipqueue_remove(&q, &job);        //cancel
+ *
+ *
+ *  Algorithmic complexity:
+ *
+ *  ipqueue_top       -   O(1)
+ *  ipqueue_contains  -   O(1)
+ *  ipqueue_pop       -   O(ln(n))
+ *  ipqueue_push      -   O(ln(n))
+ *  ipqueue_update    -   O(ln(n))
+ *  ipqueue_remove    -   O(ln(n))
+ */
+
+
+
+
+
+struct ipqueue_t
+{
+    void          **items;
+    size_t          size;
+    size_t          capacity;
+    pqueue_cmp_func cmp_func;    // <= for min heap, >= for max heap
+    size_t          inc_step;    // increment step for malloc (see pqueue_push)
+    size_t          grow_factor; // percent, 0 - linear growth by inc_step (see pqueue_set_grow_factor)
+    size_t          pos_offset;  // offset of the position (size_t) from the pointer to item
+};
+
+
+
+// The position of the item that is not in the queue
+#define IPQUEUE_INVALID_POS  ((size_t)-1)
+
+
+// Get pointer to the position (size_t) of the item
+#define IPQUEUE_POS(pqueue, item)  ((size_t *)((char *)(item) + (pqueue)->pos_offset))
+
+
+
+
+
+/*
+ * ipqueue_init - init the indexed priority queue.
+ *
+ * pqueue:     the priority queue for work.
+ * inc_step:   increment step for realloc in push func (if == 0 realloc dont call)
+ * capacity:   current capacity of queue
+ * cmp_func:   compare function for work heap
+ * pos_offset: offset of the position (size_t) from the pointer to item,
+ *             offsetof(type, pos) if items are pointers to the type
+ *
+ * ret: -1    //if cant get memory
+ * ret: 0     //good job. the priority queue was init.
+ */
+static inline int ipqueue_init(struct ipqueue_t *pqueue, size_t inc_step, size_t capacity,
+                               pqueue_cmp_func cmp_func, size_t pos_offset)
+{
+    pqueue->pos_offset = pos_offset;
+
+    return pqueue_init((struct pqueue_t *)pqueue, inc_step, capacity, cmp_func);
+}
+
+
+
+// place item to the position i and save the position in the item
+static inline void sys_ipqueue_set(struct ipqueue_t *pqueue, size_t i, void *item)
+{
+    pqueue->items[i]           = item;
+    *IPQUEUE_POS(pqueue, item) = i;
+}
+
+
+
+static inline void ipqueue_sift_down(struct ipqueue_t *pqueue, size_t i)
+{
+    void *item = pqueue->items[i];  //moves down, the children move up to the hole
+
+
+    while(PQUEUE_LEFT(i) < pqueue->size)
+    {
+        size_t left  = PQUEUE_LEFT(i);
+        size_t right = PQUEUE_RIGHT(i);
+        size_t j     = left;
+
+        if( (right < pqueue->size) && pqueue->cmp_func(pqueue->items[right], pqueue->items[left]) )
+            j = right;
+
+        if( pqueue->cmp_func(item, pqueue->items[j]) )
+            break;
+
+        sys_ipqueue_set(pqueue, i, pqueue->items[j]);
+
+        i = j;
+    }
+
+    sys_ipqueue_set(pqueue, i, item);
+}
+
+
+
+static inline void ipqueue_sift_up(struct ipqueue_t *pqueue, size_t i)
+{
+    void *item = pqueue->items[i];  //moves up, the parents move down to the hole
+
+
+    while( (i > 0) && pqueue->cmp_func(item, pqueue->items[PQUEUE_PARENT(i)]) )   // i == 0 is root
+    {
+        sys_ipqueue_set(pqueue, i, pqueue->items[PQUEUE_PARENT(i)]);
+        i = PQUEUE_PARENT(i);
+    }
+
+    sys_ipqueue_set(pqueue, i, item);
+}
+
+
+
+/*
+ * ipqueue_contains - Checks whether the item is in the priority queue.
+ *
+ * pqueue: the priority queue for work.
+ * item:   the item for check (its position must be IPQUEUE_INVALID_POS
+ *         if it was never pushed)
+ *
+ * ret: 1 if the item is in the priority queue, 0 otherwise
+ */
+static inline int ipqueue_contains(struct ipqueue_t *pqueue, void *item)
+{
+    size_t pos = *IPQUEUE_POS(pqueue, item);
+
+    return (pos < pqueue->size) && (pqueue->items[pos] == item);
+}
+
+
+
+/*
+ * ipqueue_push - Pushes the given element item to the priority queue.
+ * If the priority queue is full and pqueue->inc_step != 0 (or
+ * pqueue->grow_factor != 0) will be call realloc function for get memory.
+ *
+ * pqueue: the priority queue for work.
+ * item:   the item for push (must not be in the queue)
+ *
+ * ret: -1    //if pqueue is full and cant push
+ * ret: 0     //good job. item was pushed to the priority queue.
+ */
+static inline int ipqueue_push(struct ipqueue_t *pqueue, void *item)
+{
+    if( sys_pqueue_grow((struct pqueue_t *)pqueue, pqueue->size + 1) )
+        return -1; //cant get memory or queue is full
+
+
+    pqueue->items[pqueue->size] = item;
+    ipqueue_sift_up(pqueue, pqueue->size);
+    pqueue->size += 1;
+
+    return 0; //good job
+}
+
+
+
+/*
+ * ipqueue_top - Returns reference to the top element in the priority queue.
+ * This element will be removed on a call to pop().
+ *
+ * pqueue: the priority queue for work.
+ *
+ * ret: NULL   //if pqueue is empty
+ * ret: *Item  //good job ret top item.
+ */
+static inline void* ipqueue_top(struct ipqueue_t *pqueue)
+{
+    return pqueue->size ? pqueue->items[0] : NULL;
+}
+
+
+
+/*
+ * ipqueue_remove - Removes the item from the priority queue.
+ * The position of the item will be IPQUEUE_INVALID_POS.
+ *
+ * pqueue: the priority queue for work.
+ * item:   the item for remove
+ *
+ * ret: -1    //if the item is not in the queue
+ * ret: 0     //good job. item was removed.
+ */
+static inline int ipqueue_remove(struct ipqueue_t *pqueue, void *item)
+{
+    size_t pos;
+    void  *last;
+
+
+    if( !ipqueue_contains(pqueue, item) )
+        return -1;
+
+
+    pos = *IPQUEUE_POS(pqueue, item);
+    *IPQUEUE_POS(pqueue, item) = IPQUEUE_INVALID_POS;
+
+    pqueue->size--;
+    last                        = pqueue->items[pqueue->size];
+    pqueue->items[pqueue->size] = NULL;  //clear old value if size == 0 top == NULL
+
+    if( pos == pqueue->size )
+        return 0;  //it was the last item
+
+
+    sys_ipqueue_set(pqueue, pos, last);
+
+    if( (pos > 0) && pqueue->cmp_func(last, pqueue->items[PQUEUE_PARENT(pos)]) )
+        ipqueue_sift_up(pqueue, pos);
+    else
+        ipqueue_sift_down(pqueue, pos);
+
+    return 0;
+}
+
+
+
+/*
+ * ipqueue_pop - Removes the top element from the priority queue.
+ * The position of the item will be IPQUEUE_INVALID_POS.
+ *
+ * pqueue: the priority queue for work.
+ */
+static inline void ipqueue_pop(struct ipqueue_t *pqueue)
+{
+    if(pqueue->size == 0)
+        return;
+
+
+    ipqueue_remove(pqueue, pqueue->items[0]);
+}
+
+
+
+/*
+ * ipqueue_update - Restores the heap after the key of the item was changed
+ * (decrease-key or increase-key).
+ *
+ * pqueue: the priority queue for work.
+ * item:   the item with the changed key
+ *
+ * ret: -1    //if the item is not in the queue
+ * ret: 0     //good job.
+ */
+static inline int ipqueue_update(struct ipqueue_t *pqueue, void *item)
+{
+    size_t pos;
+
+
+    if( !ipqueue_contains(pqueue, item) )
+        return -1;
+
+
+    pos = *IPQUEUE_POS(pqueue, item);
+
+    if( (pos > 0) && pqueue->cmp_func(item, pqueue->items[PQUEUE_PARENT(pos)]) )
+        ipqueue_sift_up(pqueue, pos);
+    else
+        ipqueue_sift_down(pqueue, pos);
+
+    return 0;
+}
+
+
+
+/*
+ * ipqueue_swap - Exchanges the contents of the containers pqueue1 and pqueue2
+ *
+ * pqueue1/2: the priority queues for work.
+ */
+static inline void ipqueue_swap(struct ipqueue_t *pqueue1, struct ipqueue_t *pqueue2)
+{
+    struct ipqueue_t tmp = *pqueue1;
+    *pqueue1             = *pqueue2;
+    *pqueue2             = tmp;
+}
+
+
+
+
+
+#endif // IPQUEUE_H
@@ -0,0 +1,311 @@
+/*
+ * kpqueue.h
+ *
+ *
+ * BSD 3-Clause License
+ *
+ * Copyright (c) 2017, Koynov Stas - skojnov@yandex.ru
+ *
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice, this
+ *    list of conditions and the following disclaimer.
+ *
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ *    this list of conditions and the following disclaimer in the documentation
+ *    and/or other materials provided with the distribution.
+ *
+ * 3. Neither the name of the copyright holder nor the names of its
+ *    contributors may be used to endorse or promote products derived from
+ *    this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+ * FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ * DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ * SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ * CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+ * OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+
+#ifndef KPQUEUE_H
+#define KPQUEUE_H
+
+#include <stdint.h>
+#include "pqueue.h"  // growth policy (inc_step / grow_factor)
+
+
+
+
+
+/*
+ *  Keyed priority queue - heap of pairs {key, item} stored in one array.
+ *
+ *  spqueue_t/pqueue_t store only void* and every comparison calls cmp_func,
+ *  which dereferences two items (two cache misses per level on big heaps).
+ *  Here the key is stored next to the item pointer, so sift_up/sift_down
+ *  touch only the array, and the comparison is an inlined expression.
+ *  The items are never dereferenced by the queue.
+ *
+ *  The queue is d-ary (see arity): for 8-byte keys an entry is 16 bytes,
+ *  so the 4 children of a node are 64 bytes (one or two cache lines).
+ *
+ *  DEFINE_KPQUEUE generates the queue for one type of the key, predefined:
+ *
+ *  kpqueue_u64_t  - uint64_t keys, min heap, 4-ary
+ *  kpqueue_i64_t  - int64_t keys,  min heap, 4-ary
+ *  kpqueue_dbl_t  - double keys,   min heap, 4-ary (NaN keys are not allowed)
+ *
+ *
+ *  Algorithmic complexity:
+ *
+ *  prefix_size              -   O(1)
+ *  prefix_empty             -   O(1)
+ *  prefix_top               -   O(1)
+ *  prefix_top_key           -   O(1)
+ *  prefix_pop               -   O(d*log_d(n))
+ *  prefix_push              -   O(log_d(n))
+ *  prefix_reserve           -   O(n)
+ *  prefix_free              -   O(1)
+ */
+
+
+
+
+
+/*
+ * DEFINE_KPQUEUE - generate a keyed priority queue
+ *
+ * prefix:    prefix for names of the generated types and functions
+ * key_type:  type of the key (integer, floating or a struct)
+ * arity:     count of children of each node (constant expression > 1)
+ * less_expr: expression on (const struct prefix_entry *a, *b),
+ *            true if a must be popped before b. example: a->key < b->key
+ *            The optional tiebreak for equal keys can use the items:
+ *            a->key < b->key || (a->key == b->key && tie(a->item, b->item))
+ *            (the items are dereferenced only for equal keys)
+ *
+ * Generated types:
+ *
+ *   struct prefix_entry { key_type key; void *item; };
+ *   struct prefix_t     { entries, size, capacity, inc_step, grow_factor };
+ *
+ * Generated functions (see pqueue_* for the growth policy):
+ *
+ *   int       prefix_init(struct prefix_t *pqueue, size_t inc_step, size_t capacity);
+ *   int       prefix_set_grow_factor(struct prefix_t *pqueue, size_t grow_factor);
+ *   int       prefix_reserve(struct prefix_t *pqueue, size_t capacity);
+ *   void      prefix_free(struct prefix_t *pqueue);
+ *   size_t    prefix_size(const struct prefix_t *pqueue);
+ *   int       prefix_empty(const struct prefix_t *pqueue);
+ *   int       prefix_push(struct prefix_t *pqueue, key_type key, void *item);
+ *   void*     prefix_top(const struct prefix_t *pqueue);      //NULL if empty
+ *   key_type  prefix_top_key(const struct prefix_t *pqueue);  //queue must not be empty
+ *   void      prefix_pop(struct prefix_t *pqueue);
+ *
+ * example:
+ *
+ * DEFINE_KPQUEUE(timers, uint64_t, 4, a->key < b->key)
+ *
+ * struct timers_t q;
+ * timers_init(&q, 0, 1024);
+ * timers_push(&q, deadline, timer);
+ */
+#define DEFINE_KPQUEUE(prefix, key_type, arity, less_expr)                                  \
+                                                                                            \
+struct prefix##_entry                                                                       \
+{                                                                                           \
+    key_type  key;                                                                          \
+    void     *item;                                                                         \
+};                                                                                          \
+                                                                                            \
+struct prefix##_t                                                                           \
+{                                                                                           \
+    struct prefix##_entry *entries;                                                         \
+    size_t                 size;                                                            \
+    size_t                 capacity;                                                        \
+    size_t                 inc_step;    /* increment step for realloc (see pqueue_t) */     \
+    size_t                 grow_factor; /* percent, 0 - linear growth by inc_step */        \
+};                                                                                          \
+                                                                                            \
+static inline int prefix##_less(const struct prefix##_entry *a,                             \
+                                const struct prefix##_entry *b)                             \
+{                                                                                           \
+    return (less_expr);                                                                     \
+}                                                                                           \
+                                                                                            \
+static inline int prefix##_init(struct prefix##_t *pqueue, size_t inc_step,                 \
+                                size_t capacity)                                            \
+{                                                                                           \
+    pqueue->entries = malloc(capacity*sizeof(struct prefix##_entry));                       \
+    if( !pqueue->entries )                                                                  \
+        return -1; /* cant get memory */                                                    \
+                                                                                            \
+    pqueue->size        = 0;                                                                \
+    pqueue->capacity    = capacity;                                                         \
+    pqueue->inc_step    = inc_step;                                                         \
+    pqueue->grow_factor = 0;                                                                \
+                                                                                            \
+    return 0;                                                                               \
+}                                                                                           \
+                                                                                            \
+static inline int prefix##_set_grow_factor(struct prefix##_t *pqueue, size_t grow_factor)   \
+{                                                                                           \
+    if( grow_factor && (grow_factor <= 100) )                                               \
+        return -1; /* capacity will not grow */                                             \
+                                                                                            \
+    pqueue->grow_factor = grow_factor;                                                      \
+                                                                                            \
+    return 0;                                                                               \
+}                                                                                           \
+                                                                                            \
+static inline int prefix##_reserve(struct prefix##_t *pqueue, size_t capacity)              \
+{                                                                                           \
+    void *tmp;                                                                              \
+                                                                                            \
+    if( capacity <= pqueue->capacity )                                                      \
+        return 0;                                                                           \
+                                                                                            \
+    if( capacity > SIZE_MAX / sizeof(struct prefix##_entry) )                               \
+        return -1; /* too big */                                                            \
+                                                                                            \
+    tmp = realloc(pqueue->entries, capacity*sizeof(struct prefix##_entry));                 \
+    if( !tmp )                                                                              \
+        return -1; /* cant get memory */                                                    \
+                                                                                            \
+    pqueue->entries  = tmp;                                                                 \
+    pqueue->capacity = capacity;                                                            \
+                                                                                            \
+    return 0;                                                                               \
+}                                                                                           \
+                                                                                            \
+static inline void prefix##_free(struct prefix##_t *pqueue)                                 \
+{                                                                                           \
+    free(pqueue->entries);                                                                  \
+                                                                                            \
+    pqueue->entries  = NULL;                                                                \
+    pqueue->size     = 0;                                                                   \
+    pqueue->capacity = 0;                                                                   \
+}                                                                                           \
+                                                                                            \
+static inline size_t prefix##_size(const struct prefix##_t *pqueue)                        \
+{                                                                                           \
+    return pqueue->size;                                                                    \
+}                                                                                           \
+                                                                                            \
+static inline int prefix##_empty(const struct prefix##_t *pqueue)                           \
+{                                                                                           \
+    return pqueue->size == 0;                                                               \
+}                                                                                           \
+                                                                                            \
+static inline void prefix##_sift_up(struct prefix##_t *pqueue, size_t i)                    \
+{                                                                                           \
+    struct prefix##_entry entry = pqueue->entries[i];                                       \
+                                                                                            \
+    while( i > 0 )  /* i == 0 is root */                                                    \
+    {                                                                                       \
+        size_t parent = (i - 1) / (arity);                                                  \
+                                                                                            \
+        if( !prefix##_less(&entry, &pqueue->entries[parent]) )                              \
+            break;                                                                          \
+                                                                                            \
+        pqueue->entries[i] = pqueue->entries[parent];                                       \
+        i = parent;                                                                         \
+    }                                                                                       \
+                                                                                            \
+    pqueue->entries[i] = entry;                                                             \
+}                                                                                           \
+                                                                                            \
+static inline void prefix##_sift_down(struct prefix##_t *pqueue, size_t i)                  \
+{                                                                                           \
+    struct prefix##_entry entry = pqueue->entries[i];                                       \
+                                                                                            \
+    while( (arity)*i + 1 < pqueue->size )                                                   \
+    {                                                                                       \
+        size_t first = (arity)*i + 1;                                                       \
+        size_t last  = first + (arity);                                                     \
+        size_t j     = first;                                                               \
+                                                                                            \
+        if( last > pqueue->size )                                                           \
+            last = pqueue->size;                                                            \
+                                                                                            \
+        for(size_t c = first + 1; c < last; c++)                                            \
+        {                                                                                   \
+            if( prefix##_less(&pqueue->entries[c], &pqueue->entries[j]) )                   \
+                j = c;                                                                      \
+        }                                                                                   \
+                                                                                            \
+        if( !prefix##_less(&pqueue->entries[j], &entry) )                                   \
+            break;                                                                          \
+                                                                                            \
+        pqueue->entries[i] = pqueue->entries[j];                                            \
+        i = j;                                                                              \
+    }                                                                                       \
+                                                                                            \
+    pqueue->entries[i] = entry;                                                             \
+}                                                                                           \
+                                                                                            \
+static inline int prefix##_push(struct prefix##_t *pqueue, key_type key, void *item)        \
+{                                                                                           \
+    if( pqueue->size >= pqueue->capacity )                                                  \
+    {                                                                                       \
+        if( !pqueue->inc_step && !pqueue->grow_factor )                                     \
+            return -1; /* queue is full */                                                  \
+                                                                                            \
+        if( prefix##_reserve(pqueue, sys_pqueue_new_capacity(pqueue->capacity,              \
+                                                             pqueue->inc_step,              \
+                                                             pqueue->grow_factor,           \
+                                                             pqueue->size + 1)) )           \
+            return -1; /* cant get memory */                                                \
+    }                                                                                       \
+                                                                                            \
+    pqueue->entries[pqueue->size].key  = key;                                               \
+    pqueue->entries[pqueue->size].item = item;                                              \
+    prefix##_sift_up(pqueue, pqueue->size);                                                 \
+    pqueue->size += 1;                                                                      \
+                                                                                            \
+    return 0;                                                                               \
+}                                                                                           \
+                                                                                            \
+static inline void* prefix##_top(const struct prefix##_t *pqueue)                           \
+{                                                                                           \
+    return pqueue->size ? pqueue->entries[0].item : NULL;                                   \
+}                                                                                           \
+                                                                                            \
+static inline key_type prefix##_top_key(const struct prefix##_t *pqueue)                    \
+{                                                                                           \
+    return pqueue->entries[0].key;                                                          \
+}                                                                                           \
+                                                                                            \
+static inline void prefix##_pop(struct prefix##_t *pqueue)                                  \
+{                                                                                           \
+    if( pqueue->size == 0 )                                                                 \
+        return;                                                                             \
+                                                                                            \
+    pqueue->size--;                                                                         \
+                                                                                            \
+    if( pqueue->size )                                                                      \
+    {                                                                                       \
+        pqueue->entries[0] = pqueue->entries[pqueue->size];                                 \
+        prefix##_sift_down(pqueue, 0);                                                      \
+    }                                                                                       \
+}
+
+
+
+DEFINE_KPQUEUE(kpqueue_u64, uint64_t, 4, a->key < b->key)
+DEFINE_KPQUEUE(kpqueue_i64, int64_t,  4, a->key < b->key)
+DEFINE_KPQUEUE(kpqueue_dbl, double,   4, a->key < b->key)
+
+
+
+
+
+#endif // KPQUEUE_H
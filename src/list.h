@@ -137,6 +137,7 @@
  *  list_minmax          -     O(n)
  *  list_find            -     O(n)
  *  list_find2           -     O(n)
+ *  list_sort            -     O(n*ln(n))
  */
 
 
@@ -1044,6 +1045,282 @@ static inline struct list_head* list_find2(struct list_head *first, struct list_
 
 
 
+/*
+ * Merge two sorted NULL-terminated chains of nodes.
+ *
+ * This is only for internal list manipulation (see list_sort)!
+ *
+ * a, a_tail: first chain (older nodes) and its last node
+ * b, b_tail: second chain (newer nodes) and its last node
+ * tail:      the last node of the result chain
+ *
+ * On equal nodes the node from a goes first (merge is stable).
+ *
+ * ret: the first node of the result chain
+ */
+static inline struct list_head* sys_list_merge(struct list_head *a, struct list_head *a_tail,
+                                               struct list_head *b, struct list_head *b_tail,
+                                               struct list_head **tail,
+                                               int (*comp) (const struct list_head *n1, const struct list_head *n2) )
+{
+    struct list_head  head;
+    struct list_head *it = &head;
+
+
+    for(;;)
+    {
+        if( comp(b, a) )
+        {
+            it->next = b;
+            it       = b;
+            b        = b->next;
+
+            if( !b )
+            {
+                it->next = a;
+                *tail    = a_tail;
+                break;
+            }
+        }
+        else
+        {
+            it->next = a;
+            it       = a;
+            a        = a->next;
+
+            if( !a )
+            {
+                it->next = b;
+                *tail    = b_tail;
+                break;
+            }
+        }
+    }
+
+    return head.next;
+}
+
+
+
+/*
+ * Sort the list and return the new last node of the list (or head if list is empty).
+ *
+ * This is only for internal list manipulation (see list_sort)!
+ */
+static inline struct list_head* sys_list_sort(struct list_head *head,
+                                              int (*comp) (const struct list_head *n1, const struct list_head *n2) )
+{
+    // pending[i] - sorted chain of 2^i nodes (or NULL), older chains have bigger i
+    struct list_head *pending[sizeof(size_t)*8];
+    struct list_head *pending_tail[sizeof(size_t)*8];
+    struct list_head *list, *node, *tail;
+    size_t i, levels = 0;
+
+
+    if( list_empty(head) || list_is_singular(head) )
+        return head->next;
+
+
+    for(list = head->next; list != head; )
+    {
+        node       = list;
+        tail       = list;
+        list       = list->next;
+        node->next = NULL;
+
+        // binary counter: merge equal sized chains while there is a carry
+        for(i = 0; i < levels && pending[i]; i++)
+        {
+            node       = sys_list_merge(pending[i], pending_tail[i], node, tail, &tail, comp);
+            pending[i] = NULL;
+        }
+
+        if( i == levels )
+            levels++;
+
+        pending[i]      = node;
+        pending_tail[i] = tail;
+    }
+
+
+    // merge all pending chains, from the newest (small) to the oldest (big)
+    node = NULL;
+    for(i = 0; i < levels; i++)
+    {
+        if( !pending[i] )
+            continue;
+
+        if( node )
+            node = sys_list_merge(pending[i], pending_tail[i], node, tail, &tail, comp);
+        else
+        {
+            node = pending[i];
+            tail = pending_tail[i];
+        }
+    }
+
+
+    head->next = node;
+    tail->next = head;
+
+    return tail;
+}
+
+
+
+/*
+ * list_sort - Sorts the elements of the list
+ *
+ * Sorts the elements in ascending order (see comp). The order of equal
+ * elements is preserved (sort is stable).
+ *
+ * It is a bottom-up merge sort: the nodes are only relinked,
+ * no memory is allocated, the extra memory is O(1) - a fixed array of
+ * the pending sublists (one per bit of size_t) on the stack.
+ *
+ * head:   the head of the list
+ * comp:   Binary function that accepts two elements in the range as arguments,
+ *         and returns a value convertible to bool. The value returned indicates
+ *         whether the element passed as first argument is considered less than the second.
+ *         The function shall not modify any of its arguments
+ *         (the same as for list_min)
+ */
+static inline void list_sort(struct list_head *head,
+                             int (*comp) (const struct list_head *n1, const struct list_head *n2) )
+{
+    sys_list_sort(head, comp);
+}
+
+
+
+/*
+ * DEFINE_LIST_ALGOS - generate typed versions of the algorithms
+ *
+ * list_min, list_max, list_minmax, list_find and list_find2 take a pointer
+ * to function, so the compiler makes an indirect call for every element
+ * (it can inline it only if the function is known in the same translation
+ * unit). This macro generates static inline versions for one type of data,
+ * where the comparison and the predicate are expressions on the data,
+ * so they are always inlined.
+ * prefix_less can be used as comp for list_sort.
+ *
+ * prefix:    prefix for names of the generated functions
+ * type:      the type of the struct of data this is embedded in.
+ * member:    the name of the node(list_head) within the struct of data.
+ * less_expr: expression on (const type *a, const type *b),
+ *            true if a is less than b. example: a->key < b->key
+ * pred_expr: expression on (const type *a, void *data),
+ *            true if a is a match. example: a->key == *(int *)data
+ *            (for prefix_find data is NULL)
+ *
+ * Generated functions (the same semantics as list_*):
+ *
+ *   int               prefix_less(const struct list_head *n1, const struct list_head *n2);
+ *   int               prefix_pred(const struct list_head *node, void *data);
+ *   struct list_head* prefix_min(struct list_head *first, struct list_head *last);
+ *   struct list_head* prefix_max(struct list_head *first, struct list_head *last);
+ *   void              prefix_minmax(struct list_head *first, struct list_head *last,
+ *                                   struct list_head *res[2]);
+ *   struct list_head* prefix_find(struct list_head *first, struct list_head *last);
+ *   struct list_head* prefix_find2(struct list_head *first, struct list_head *last,
+ *                                  void *data);
+ *
+ * example:
+ *
+ * DEFINE_LIST_ALGOS(tmp, struct tmp_data, list, a->data < b->data, a->data == *(int *)data)
+ *
+ * min = tmp_min(head.next, &head);
+ */
+#define DEFINE_LIST_ALGOS(prefix, type, member, less_expr, pred_expr)                       \
+                                                                                            \
+static inline int prefix##_less(const struct list_head *n1, const struct list_head *n2)     \
+{                                                                                           \
+    const type *a = list_data(n1, type, member);                                            \
+    const type *b = list_data(n2, type, member);                                            \
+                                                                                            \
+    return (less_expr);                                                                     \
+}                                                                                           \
+                                                                                            \
+static inline int prefix##_pred(const struct list_head *node, void *data)                   \
+{                                                                                           \
+    const type *a = list_data(node, type, member);                                          \
+                                                                                            \
+    (void)data;                                                                             \
+    return (pred_expr);                                                                     \
+}                                                                                           \
+                                                                                            \
+static inline struct list_head* prefix##_min(struct list_head *first, struct list_head *last) \
+{                                                                                           \
+    struct list_head *smallest = first;                                                     \
+    struct list_head *it       = first;                                                     \
+                                                                                            \
+    if(first==last)                                                                         \
+        return last;                                                                        \
+                                                                                            \
+    while( (it = it->next) != last )                                                        \
+        if(prefix##_less(it, smallest))                                                     \
+            smallest=it;                                                                    \
+                                                                                            \
+    return smallest;                                                                        \
+}                                                                                           \
+                                                                                            \
+static inline struct list_head* prefix##_max(struct list_head *first, struct list_head *last) \
+{                                                                                           \
+    struct list_head *largest = first;                                                      \
+    struct list_head *it      = first;                                                      \
+                                                                                            \
+    if(first==last)                                                                         \
+        return last;                                                                        \
+                                                                                            \
+    while( (it = it->next) != last )                                                        \
+        if(prefix##_less(largest, it))                                                      \
+            largest=it;                                                                     \
+                                                                                            \
+    return largest;                                                                         \
+}                                                                                           \
+                                                                                            \
+static inline void prefix##_minmax(struct list_head *first, struct list_head *last,         \
+                                   struct list_head *res[2])                                \
+{                                                                                           \
+    struct list_head *it = first;                                                           \
+                                                                                            \
+    res[0] = first;                                                                         \
+    res[1] = first;                                                                         \
+                                                                                            \
+    if(first==last)                                                                         \
+        return;                                                                             \
+                                                                                            \
+    while( (it = it->next) != last )                                                        \
+    {                                                                                       \
+        if(prefix##_less(it, res[0]))                                                       \
+            res[0]=it;                                                                      \
+                                                                                            \
+        if(prefix##_less(res[1], it))                                                       \
+            res[1]=it;                                                                      \
+    }                                                                                       \
+}                                                                                           \
+                                                                                            \
+static inline struct list_head* prefix##_find2(struct list_head *first, struct list_head *last, \
+                                               void *data)                                  \
+{                                                                                           \
+    while( first != last )                                                                  \
+    {                                                                                       \
+        if( prefix##_pred(first, data) )                                                    \
+            return first;                                                                   \
+                                                                                            \
+        first = first->next;                                                                \
+    }                                                                                       \
+                                                                                            \
+    return last;                                                                            \
+}                                                                                           \
+                                                                                            \
+static inline struct list_head* prefix##_find(struct list_head *first, struct list_head *last) \
+{                                                                                           \
+    return prefix##_find2(first, last, NULL);                                               \
+}
+
+
+
 
 
 #endif  //LIST_HEADER
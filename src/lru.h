@@ -0,0 +1,416 @@
+/*
+ * lru.h
+ *
+ *
+ * BSD 3-Clause License
+ *
+ * Copyright (c) 2017, Koynov Stas - skojnov@yandex.ru
+ *
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice, this
+ *    list of conditions and the following disclaimer.
+ *
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ *    this list of conditions and the following disclaimer in the documentation
+ *    and/or other materials provided with the distribution.
+ *
+ * 3. Neither the name of the copyright holder nor the names of its
+ *    contributors may be used to endorse or promote products derived from
+ *    this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+ * FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ * DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ * SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ * CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+ * OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+
+
+
+#ifndef LRU_H
+#define LRU_H
+
+#include <stddef.h>
+#include "dqueue.h"
+#include "htable.h"
+
+
+
+
+
+/*
+ *  lru_t - intrusive LRU cache: the recency order is a dqueue_t (the front is
+ *  the most recently used node, the back is the victim) and the index is
+ *  htable_t. A node (lru_node) has both of the nodes and is embedded in
+ *  the struct of data, the cache does not allocate the nodes.
+ *
+ *  The keys are hashed by the caller (as in htable_t), eq_func gets
+ *  the htable_node of the lru_node (see lru_hash_data).
+ *
+ *  lru_insert evicts the least recently used nodes above the capacity and
+ *  gives them to evict_func one by one, lru_evict cuts the victims to
+ *  the target size and moves them to a dqueue_t of the caller by one splice.
+ *  lru_lookup counts the hits and the misses.
+ *
+ *
+ *  Algorithmic complexity:
+ *
+ *  lru_size            -   O(1)
+ *  lru_empty           -   O(1)
+ *  lru_lookup          -   O(1) average
+ *  lru_peek            -   O(1) average
+ *  lru_touch           -   O(1)
+ *  lru_victim          -   O(1)
+ *  lru_insert          -   O(1) average (+ evicted nodes)
+ *  lru_remove          -   O(1)
+ *  lru_evict           -   O(k), k - count of evicted nodes
+ */
+
+
+
+
+
+struct lru_node
+{
+    dqueue_node        list;
+    struct htable_node hnode;
+};
+
+
+
+// evict_func(node, arg) takes the evicted node (it is not in the cache)
+typedef void (*lru_evict_func)(struct lru_node *node, void *arg);
+
+
+
+struct lru_t
+{
+    struct dqueue_t  queue;         // front - most recently used
+    struct htable_t  index;
+    size_t           capacity;
+    lru_evict_func   evict_func;    // can be NULL
+    void            *evict_arg;
+
+    size_t           hits;
+    size_t           misses;
+    size_t           evictions;
+};
+
+
+
+
+
+/*
+ * lru_init - init the LRU cache.
+ *
+ * lru:        the cache for work.
+ * capacity:   max count of nodes (the index is allocated for it)
+ * eq_func:    compare function of the keys (see htable_eq_func)
+ * evict_func: function for the nodes evicted by lru_insert (can be NULL)
+ * evict_arg:  arg for evict_func
+ *
+ * ret: -1    //if cant get memory
+ * ret: 0     //good job. the cache was init.
+ */
+static inline int lru_init(struct lru_t *lru, size_t capacity, htable_eq_func eq_func,
+                           lru_evict_func evict_func, void *evict_arg)
+{
+    if( htable_init(&lru->index, capacity, eq_func) )
+        return -1;
+
+
+    dqueue_init(&lru->queue);
+
+    lru->capacity   = capacity;
+    lru->evict_func = evict_func;
+    lru->evict_arg  = evict_arg;
+    lru->hits       = 0;
+    lru->misses     = 0;
+    lru->evictions  = 0;
+
+    return 0;
+}
+
+
+
+/*
+ * lru_free - Free the memory of the cache (the index). The nodes are not
+ * freed, take them by lru_evict(lru, 0, victims) before.
+ *
+ * lru: the cache for work.
+ */
+static inline void lru_free(struct lru_t *lru)
+{
+    htable_free(&lru->index);
+    dqueue_init(&lru->queue);
+}
+
+
+
+static inline size_t lru_size(const struct lru_t *lru)
+{
+    return dqueue_size(&lru->queue);
+}
+
+
+
+static inline int lru_empty(const struct lru_t *lru)
+{
+    return dqueue_size(&lru->queue) == 0;
+}
+
+
+
+static inline size_t lru_capacity(const struct lru_t *lru)
+{
+    return lru->capacity;
+}
+
+
+
+static inline size_t lru_hits(const struct lru_t *lru)
+{
+    return lru->hits;
+}
+
+
+
+static inline size_t lru_misses(const struct lru_t *lru)
+{
+    return lru->misses;
+}
+
+
+
+static inline size_t lru_evictions(const struct lru_t *lru)
+{
+    return lru->evictions;
+}
+
+
+
+static inline void lru_reset_stats(struct lru_t *lru)
+{
+    lru->hits      = 0;
+    lru->misses    = 0;
+    lru->evictions = 0;
+}
+
+
+
+/*
+ * lru_peek - Returns the node with the key. The recency and the counters
+ * are not changed.
+ *
+ * lru:  the cache for work.
+ * hash: the hash of the key
+ * key:  the key for eq_func
+ *
+ * ret: NULL   //if there is no node with the key
+ * ret: *node  //good job ret the node
+ */
+static inline struct lru_node* lru_peek(const struct lru_t *lru, size_t hash, const void *key)
+{
+    struct htable_node *hnode = htable_lookup(&lru->index, hash, key);
+
+    return hnode ? htable_data(hnode, struct lru_node, hnode) : NULL;
+}
+
+
+
+// makes the node the most recently used
+static inline void lru_touch(struct lru_t *lru, struct lru_node *node)
+{
+    dqueue_move_to_front(&node->list, &lru->queue);
+}
+
+
+
+// ret the least recently used node (the next victim) or NULL if the cache is empty
+static inline struct lru_node* lru_victim(struct lru_t *lru)
+{
+    return dqueue_last_data_or_null(&lru->queue, struct lru_node, list);
+}
+
+
+
+/*
+ * lru_lookup - Returns the node with the key and makes it the most
+ * recently used (hit), or counts the miss.
+ *
+ * lru:  the cache for work.
+ * hash: the hash of the key
+ * key:  the key for eq_func
+ *
+ * ret: NULL   //miss: there is no node with the key
+ * ret: *node  //hit: good job ret the node
+ */
+static inline struct lru_node* lru_lookup(struct lru_t *lru, size_t hash, const void *key)
+{
+    struct lru_node *node = lru_peek(lru, hash, key);
+
+
+    if( !node )
+    {
+        lru->misses++;
+        return NULL;
+    }
+
+
+    lru->hits++;
+    lru_touch(lru, node);
+
+    return node;
+}
+
+
+
+/*
+ * lru_remove - Removes the node from the cache (evict_func is not called).
+ *
+ * lru:  the cache for work.
+ * node: the node (in the cache) for remove
+ */
+static inline void lru_remove(struct lru_t *lru, struct lru_node *node)
+{
+    htable_remove(&lru->index, &node->hnode);
+    dqueue_del(&node->list, &lru->queue);
+}
+
+
+
+// remove the least recently used nodes down to size and give them to evict_func
+static inline size_t sys_lru_evict_to(struct lru_t *lru, size_t size)
+{
+    struct lru_node *victim;
+    size_t count = 0;
+
+
+    while( dqueue_size(&lru->queue) > size )
+    {
+        victim = dqueue_last_data(&lru->queue, struct lru_node, list);
+        lru_remove(lru, victim);
+        count++;
+
+        if( lru->evict_func )
+            lru->evict_func(victim, lru->evict_arg);
+    }
+
+    return count;
+}
+
+
+
+/*
+ * lru_insert - Inserts the node as the most recently used. If the cache
+ * is full the least recently used nodes are removed before the insert
+ * and given to evict_func (the new node is never evicted, if capacity > 0).
+ * The keys are not checked for duplicates, use lru_lookup before.
+ *
+ * lru:  the cache for work.
+ * node: the node for insert (not in a cache)
+ * hash: the hash of the key of the node
+ *
+ * ret: count of evicted nodes
+ */
+static inline size_t lru_insert(struct lru_t *lru, struct lru_node *node, size_t hash)
+{
+    size_t count;
+
+
+    // evict before insert: the index never holds more than capacity nodes
+    // (else a full cache with capacity == count of buckets starts a rehash)
+    count = lru->capacity ? sys_lru_evict_to(lru, lru->capacity - 1) : 0;
+
+    htable_insert(&lru->index, &node->hnode, hash);
+    dqueue_push_front(&node->list, &lru->queue);
+
+    count += sys_lru_evict_to(lru, lru->capacity);   // capacity 0: the node itself
+
+    lru->evictions += count;
+
+    return count;
+}
+
+
+
+/*
+ * lru_evict - Evicts the least recently used nodes down to the size:
+ * the victims are removed from the index and moved to the back of
+ * the victims queue by one splice (evict_func is not called).
+ * The order of the victims is kept (the least recently used is the last).
+ *
+ * lru:     the cache for work.
+ * size:    the target size of the cache (0 - evict all)
+ * victims: dqueue_t for the evicted nodes (list member of lru_node)
+ *
+ * ret: count of evicted nodes
+ */
+static inline size_t lru_evict(struct lru_t *lru, size_t size, struct dqueue_t *victims)
+{
+    size_t count = dqueue_size(&lru->queue);
+    dqueue_node *first = dqueue_end(&lru->queue);
+    struct lru_node *victim;
+    size_t i;
+
+
+    if( count <= size )
+        return 0;
+
+    count -= size;
+
+
+    for(i = 0; i < count; i++)
+    {
+        first  = first->prev;
+        victim = dqueue_data(first, struct lru_node, list);
+        htable_remove(&lru->index, &victim->hnode);
+    }
+
+    dqueue_splice_range_n(first, dqueue_end(&lru->queue), count, &lru->queue,
+                          dqueue_end(victims), victims);
+
+    lru->evictions += count;
+
+    return count;
+}
+
+
+
+/*
+ * lru_data - get the struct (data) for this node
+ *
+ * node:   the node (lru_node).
+ * type:   the type of the struct of data this is embedded in.
+ * member: the name of the node(lru_node) within the struct of data.
+ */
+#define lru_data(node, type, member) \
+    (type *)( (const char *)node - offsetof(type, member) )
+
+
+
+/*
+ * lru_hash_data - get the struct (data) for the htable_node of the lru_node
+ * (for eq_func)
+ *
+ * hnode:  the htable_node of the lru_node.
+ * type:   the type of the struct of data this is embedded in.
+ * member: the name of the node(lru_node) within the struct of data.
+ */
+#define lru_hash_data(hnode, type, member) \
+    (type *)( (const char *)hnode - offsetof(struct lru_node, hnode) - offsetof(type, member) )
+
+
+
+
+#endif // LRU_H
@@ -0,0 +1,201 @@
+/*
+ * mmpqueue.h
+ *
+ *
+ * BSD 3-Clause License
+ *
+ * Copyright (c) 2017, Koynov Stas - skojnov@yandex.ru
+ *
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice, this
+ *    list of conditions and the following disclaimer.
+ *
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ *    this list of conditions and the following disclaimer in the documentation
+ *    and/or other materials provided with the distribution.
+ *
+ * 3. Neither the name of the copyright holder nor the names of its
+ *    contributors may be used to endorse or promote products derived from
+ *    this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+ * FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ * DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ * SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ * CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+ * OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+
+#ifndef MMPQUEUE_H
+#define MMPQUEUE_H
+
+#include <stdlib.h>
+#include "smmpqueue.h"
+#include "pqueue.h"  // growth policy (sys_pqueue_grow)
+
+
+
+
+
+/*
+ *  A double-ended priority queue is a container that provides constant time
+ *  lookup of the smallest and the largest element, at the expense of
+ *  logarithmic insertion and extraction of both.
+ *
+ *  mmpqueue_t - min-max heap based on dynamic array (see smmpqueue.h).
+ *  The fields are the same as pqueue_t, so pqueue_set_grow_factor,
+ *  pqueue_reserve, pqueue_shrink_to_fit and pqueue_free can be used
+ *  for it (by cast to struct pqueue_t *).
+ *
+ *
+ *  Algorithmic complexity:
+ *
+ *  mmpqueue_size     -   O(1)
+ *  mmpqueue_min      -   O(1)
+ *  mmpqueue_max      -   O(1)
+ *  mmpqueue_pop_min  -   O(ln(n))
+ *  mmpqueue_pop_max  -   O(ln(n))
+ *  mmpqueue_push     -   O(ln(n))
+ *  mmpqueue_swap     -   O(1)
+ */
+
+
+
+
+
+struct mmpqueue_t
+{
+    void          **items;
+    size_t          size;
+    size_t          capacity;
+    pqueue_cmp_func cmp_func;    // <= (see smmpqueue.h)
+    size_t          inc_step;    // increment step for malloc (see push func)
+    size_t          grow_factor; // percent, 0 - linear growth by inc_step (see pqueue_set_grow_factor)
+};
+
+
+
+/*
+ * mmpqueue_init - init the priority queue.
+ *
+ * pqueue:   the priority queue for work.
+ * inc_step: increment step for realloc in push func (if == 0 realloc dont call)
+ * capacity: current capacity of queue
+ * cmp_func: compare function for work heap (<=)
+ *
+ * ret: -1    //if cant get memory
+ * ret: 0     //good job. the priority queue was init.
+ */
+static inline int mmpqueue_init(struct mmpqueue_t *pqueue, size_t inc_step,
+                                size_t capacity, pqueue_cmp_func cmp_func)
+{
+    return pqueue_init((struct pqueue_t *)pqueue, inc_step, capacity, cmp_func);
+}
+
+
+
+static inline size_t mmpqueue_size(const struct mmpqueue_t *pqueue)
+{
+    return pqueue->size;
+}
+
+
+
+/*
+ * mmpqueue_push - Pushes the given element item to the priority queue.
+ * If the priority queue is full and pqueue->inc_step != 0 (or
+ * pqueue->grow_factor != 0) will be call realloc function for get memory.
+ *
+ * pqueue: the priority queue for work.
+ * item:   the item for push
+ *
+ * ret: -1    //if pqueue is full and cant push
+ * ret: 0     //good job. item was pushed to the priority queue.
+ */
+static inline int mmpqueue_push(struct mmpqueue_t *pqueue, void *item)
+{
+    if( sys_pqueue_grow((struct pqueue_t *)pqueue, pqueue->size + 1) )
+        return -1; //cant get memory or queue is full
+
+
+    return smmpqueue_push((struct smmpqueue_t *)pqueue, item);
+}
+
+
+
+/*
+ * mmpqueue_min - Returns reference to the smallest element in the priority queue.
+ *
+ * ret: NULL   //if pqueue is empty
+ * ret: *Item  //good job ret min item.
+ */
+static inline void* mmpqueue_min(struct mmpqueue_t *pqueue)
+{
+    return smmpqueue_min((struct smmpqueue_t *)pqueue);
+}
+
+
+
+/*
+ * mmpqueue_max - Returns reference to the largest element in the priority queue.
+ *
+ * ret: NULL   //if pqueue is empty
+ * ret: *Item  //good job ret max item.
+ */
+static inline void* mmpqueue_max(struct mmpqueue_t *pqueue)
+{
+    return smmpqueue_max((struct smmpqueue_t *)pqueue);
+}
+
+
+
+/*
+ * mmpqueue_pop_min - Removes the smallest element from the priority queue.
+ *
+ * pqueue: the priority queue for work.
+ */
+static inline void mmpqueue_pop_min(struct mmpqueue_t *pqueue)
+{
+    smmpqueue_pop_min((struct smmpqueue_t *)pqueue);
+}
+
+
+
+/*
+ * mmpqueue_pop_max - Removes the largest element from the priority queue.
+ *
+ * pqueue: the priority queue for work.
+ */
+static inline void mmpqueue_pop_max(struct mmpqueue_t *pqueue)
+{
+    smmpqueue_pop_max((struct smmpqueue_t *)pqueue);
+}
+
+
+
+/*
+ * mmpqueue_swap - Exchanges the contents of the containers pqueue1 and pqueue2
+ *
+ * pqueue1/2: the priority queues for work.
+ */
+static inline void mmpqueue_swap(struct mmpqueue_t *pqueue1, struct mmpqueue_t *pqueue2)
+{
+    struct mmpqueue_t tmp = *pqueue1;
+    *pqueue1              = *pqueue2;
+    *pqueue2              = tmp;
+}
+
+
+
+
+
+#endif // MMPQUEUE_H
@@ -0,0 +1,280 @@
+/*
+ * mpscq.h
+ *
+ *
+ * BSD 3-Clause License
+ *
+ * Copyright (c) 2017, Koynov Stas - skojnov@yandex.ru
+ *
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice, this
+ *    list of conditions and the following disclaimer.
+ *
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ *    this list of conditions and the following disclaimer in the documentation
+ *    and/or other materials provided with the distribution.
+ *
+ * 3. Neither the name of the copyright holder nor the names of its
+ *    contributors may be used to endorse or promote products derived from
+ *    this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+ * FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ * DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ * SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ * CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+ * OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#ifndef MPSCQ_H
+#define MPSCQ_H
+
+#include <stddef.h>
+#include <stdatomic.h>  //need C11 (-std=c11)
+
+#include "list.h"
+#include "tlist.h"
+
+
+
+
+
+/*
+ * The mpsc queue (mpscq_t) is an intrusive FIFO queue for many producers
+ * and one consumer (D. Vyukov's algorithm) on the embedded list_head.
+ *
+ * Push is wait-free: one atomic exchange + one store (no loops, no CAS).
+ * Pop is lock-free for the consumer and does not touch the producers' side
+ * of the queue (field head) while there are two or more nodes in the queue,
+ * so drain of a burst touches only the nodes.
+ *
+ * The queue has the stub node: the chain is stub/nodes -> ... -> head,
+ * NULL-terminated; head is the last pushed node.
+ *
+ * Pop can return NULL for not empty queue: a producer made the exchange
+ * but did not link the node yet (it was preempted between two instructions).
+ * The node will be available after the producer's store, so the consumer
+ * should just try later (it is not an error).
+ *
+ * Only one thread may call mpscq_pop, mpscq_drain, mpscq_drain_tlist.
+ *
+ *
+ *  Algorithmic complexity:
+ *
+ *  mpscq_empty        -   O(1)
+ *  mpscq_push         -   O(1)  (wait-free)
+ *  mpscq_pop          -   O(1)
+ *  mpscq_drain        -   O(n)
+ *  mpscq_drain_tlist  -   O(n)
+ */
+
+
+
+
+
+struct mpscq_t
+{
+    _Atomic(struct list_head *) head;   //producers: the last pushed node
+    char pad[64 - sizeof(struct list_head *)];  //head and tail in different cache lines
+
+    struct list_head  *tail;            //consumer: the first node (or stub)
+    struct list_head   stub;
+};
+
+
+
+
+
+#define DECLARE_MPSCQ(name) \
+    struct mpscq_t name = { &name.stub, {0}, &name.stub, { NULL } }
+
+
+
+static inline void mpscq_init(struct mpscq_t *mpscq)
+{
+    mpscq->stub.next = NULL;
+    mpscq->tail      = &mpscq->stub;
+
+    atomic_init(&mpscq->head, &mpscq->stub);
+}
+
+
+
+/*
+ * The field next of the last node is written by a producer and read
+ * by the consumer, so it is accessed as atomic.
+ */
+static inline struct list_head* sys_mpscq_get_next(struct list_head *node)
+{
+    return atomic_load_explicit((_Atomic(struct list_head *) *)&node->next,
+                                memory_order_acquire);
+}
+
+
+
+static inline void sys_mpscq_set_next(struct list_head *node, struct list_head *next)
+{
+    atomic_store_explicit((_Atomic(struct list_head *) *)&node->next, next,
+                          memory_order_release);
+}
+
+
+
+/*
+ * mpscq_empty - Tests whether a queue is empty.
+ * (the consumer side, the result can be out of date at once)
+ *
+ * mpscq: the queue to test.
+ */
+static inline int mpscq_empty(struct mpscq_t *mpscq)
+{
+    return (mpscq->tail == &mpscq->stub) && !sys_mpscq_get_next(&mpscq->stub);
+}
+
+
+
+/*
+ * mpscq_push - Pushes the given node to the back of the queue.
+ * Can be called by many threads at the same time.
+ *
+ * node:  the node for push.
+ * mpscq: the queue to work.
+ */
+static inline void mpscq_push(struct list_head *node, struct mpscq_t *mpscq)
+{
+    struct list_head *prev;
+
+
+    atomic_store_explicit((_Atomic(struct list_head *) *)&node->next, NULL,
+                          memory_order_relaxed);
+
+    prev = atomic_exchange_explicit(&mpscq->head, node, memory_order_acq_rel);
+
+    //here the chain is broken (prev->next == NULL) till the next store
+    sys_mpscq_set_next(prev, node);
+}
+
+
+
+/*
+ * mpscq_pop - Removes the front node from the queue (only consumer).
+ *
+ * mpscq: the queue to work.
+ *
+ * ret: ptr   //pointer to the removed node (node->next == node, like list_empty)
+ * ret: NULL  //if queue is empty (or the front node is not linked yet, see above)
+ */
+static inline struct list_head* mpscq_pop(struct mpscq_t *mpscq)
+{
+    struct list_head *tail = mpscq->tail;
+    struct list_head *next = sys_mpscq_get_next(tail);
+
+
+    if( tail == &mpscq->stub )
+    {
+        if( !next )
+            return NULL;  //empty
+
+        //skip the stub
+        mpscq->tail = next;
+        tail        = next;
+        next        = sys_mpscq_get_next(next);
+    }
+
+
+    if( next )
+    {
+        mpscq->tail = next;
+        tail->next  = tail;
+        return tail;
+    }
+
+
+    //tail is the last node in the chain
+    if( tail != atomic_load_explicit(&mpscq->head, memory_order_acquire) )
+        return NULL;  //a producer is pushing now (chain is broken)
+
+
+    //return the stub to the queue, so the last node can be removed
+    mpscq_push(&mpscq->stub, mpscq);
+
+    next = sys_mpscq_get_next(tail);
+    if( next )
+    {
+        mpscq->tail = next;
+        tail->next  = tail;
+        return tail;
+    }
+
+
+    return NULL;  //other producer pushed between our load and push of the stub
+}
+
+
+
+/*
+ * mpscq_drain - Removes all available nodes from the queue (only consumer)
+ * and adds them to the front of the list head in FIFO order
+ * (the first removed node is the first in the list).
+ *
+ * mpscq: the queue to work.
+ * head:  the list (list_head) for the nodes.
+ *
+ * ret: count of removed nodes
+ */
+static inline size_t mpscq_drain(struct mpscq_t *mpscq, struct list_head *head)
+{
+    struct list_head *node, *last = head;
+    size_t count = 0;
+
+
+    while( (node = mpscq_pop(mpscq)) )
+    {
+        node->next = last->next;
+        last->next = node;
+        last       = node;
+        count++;
+    }
+
+    return count;
+}
+
+
+
+/*
+ * mpscq_drain_tlist - Removes all available nodes from the queue (only consumer)
+ * and adds them to the back of the tlist in FIFO order.
+ *
+ * mpscq: the queue to work.
+ * tlist: the tlist for the nodes.
+ *
+ * ret: count of removed nodes
+ */
+static inline size_t mpscq_drain_tlist(struct mpscq_t *mpscq, struct tlist_head *tlist)
+{
+    struct list_head *node;
+    size_t count = 0;
+
+
+    while( (node = mpscq_pop(mpscq)) )
+    {
+        tlist_push_back(node, tlist);
+        count++;
+    }
+
+    return count;
+}
+
+
+
+
+
+#endif // MPSCQ_H
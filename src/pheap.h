@@ -0,0 +1,400 @@
+/*
+ * pheap.h
+ *
+ *
+ * BSD 3-Clause License
+ *
+ * Copyright (c) 2017, Koynov Stas - skojnov@yandex.ru
+ *
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice, this
+ *    list of conditions and the following disclaimer.
+ *
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ *    this list of conditions and the following disclaimer in the documentation
+ *    and/or other materials provided with the distribution.
+ *
+ * 3. Neither the name of the copyright holder nor the names of its
+ *    contributors may be used to endorse or promote products derived from
+ *    this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+ * FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ * DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ * SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ * CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+ * OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+
+#ifndef PHEAP_H
+#define PHEAP_H
+
+#include <stddef.h>
+#include "spqueue.h"  // pqueue_cmp_func
+
+
+
+
+
+/*
+ *  pheap_t - intrusive pairing heap. A node (pheap_node) is embedded in the
+ *  struct of data like list_head, the heap does not allocate memory.
+ *
+ *  The heap is a tree, every node has the pointer to the first child,
+ *  to the next sibling and to the previous sibling (or to the parent for
+ *  the first child). Meld of two heaps is one link of two roots, pop links
+ *  the children of the root in pairs (two-pass method).
+ *
+ *  cmp_func has the same convention as for spqueue_t/pqueue_t
+ *  (<= for min heap, >= for max heap), but it gets pointers to
+ *  the nodes (pheap_node), use pheap_data to get the data.
+ *
+ *
+ *  Algorithmic complexity:
+ *
+ *  pheap_size         -   O(1)
+ *  pheap_empty        -   O(1)
+ *  pheap_top          -   O(1)
+ *  pheap_push         -   O(1)
+ *  pheap_meld         -   O(1)
+ *  pheap_pop          -   O(ln(n)) amortized
+ *  pheap_decrease_key -   O(ln(n)) amortized (o(ln(n)) in practice)
+ *  pheap_remove       -   O(ln(n)) amortized
+ *  pheap_update       -   O(ln(n)) amortized
+ *  pheap_swap         -   O(1)
+ */
+
+
+
+
+
+struct pheap_node
+{
+    struct pheap_node *child;  // the first child
+    struct pheap_node *next;   // the next sibling
+    struct pheap_node *prev;   // the previous sibling or the parent (for the first child)
+};
+
+
+
+struct pheap_t
+{
+    struct pheap_node *root;
+    size_t             size;
+    pqueue_cmp_func    cmp_func; // <= for min heap, >= for max heap
+};
+
+
+
+#define DECLARE_PHEAP(name, cmp_func) \
+    struct pheap_t name = { NULL, 0, cmp_func }
+
+
+
+
+
+static inline void pheap_init(struct pheap_t *pheap, pqueue_cmp_func cmp_func)
+{
+    pheap->root     = NULL;
+    pheap->size     = 0;
+    pheap->cmp_func = cmp_func;
+}
+
+
+
+static inline size_t pheap_size(const struct pheap_t *pheap)
+{
+    return pheap->size;
+}
+
+
+
+static inline int pheap_empty(const struct pheap_t *pheap)
+{
+    return pheap->root == NULL;
+}
+
+
+
+/*
+ * pheap_top - Returns the top node of the heap.
+ * This node will be removed on a call to pop().
+ *
+ * pheap: the heap for work.
+ *
+ * ret: NULL   //if heap is empty
+ * ret: *node  //good job ret top node.
+ */
+static inline struct pheap_node* pheap_top(const struct pheap_t *pheap)
+{
+    return pheap->root;
+}
+
+
+
+// link two roots: the root that loses becomes the first child of the other one
+static inline struct pheap_node* sys_pheap_link(struct pheap_t *pheap,
+                                                struct pheap_node *node1,
+                                                struct pheap_node *node2)
+{
+    struct pheap_node *parent = node1;
+    struct pheap_node *child  = node2;
+
+
+    if( !pheap->cmp_func(node1, node2) )
+    {
+        parent = node2;
+        child  = node1;
+    }
+
+
+    child->next = parent->child;
+    child->prev = parent;
+
+    if( parent->child )
+        parent->child->prev = child;
+
+    parent->child = child;
+    parent->next  = NULL;
+    parent->prev  = NULL;
+
+    return parent;
+}
+
+
+
+// two-pass pairing of the siblings: left to right in pairs, then right to left
+static inline struct pheap_node* sys_pheap_merge_pairs(struct pheap_t *pheap,
+                                                       struct pheap_node *first)
+{
+    struct pheap_node *node, *next, *pairs = NULL;
+
+
+    if( !first )
+        return NULL;
+
+
+    // first pass: link pairs, the results are a list (reverse order) by next
+    while( first )
+    {
+        node = first;
+        next = first->next;
+
+        if( next )
+        {
+            first = next->next;
+            node  = sys_pheap_link(pheap, node, next);
+        }
+        else
+        {
+            first = NULL;
+        }
+
+        node->next = pairs;
+        pairs      = node;
+    }
+
+
+    // second pass: link the results from the last to the first
+    node  = pairs;
+    pairs = pairs->next;
+
+    while( pairs )
+    {
+        next  = pairs->next;
+        node  = sys_pheap_link(pheap, node, pairs);
+        pairs = next;
+    }
+
+
+    node->next = NULL;
+    node->prev = NULL;
+
+    return node;
+}
+
+
+
+// cut the subtree of the node (not root) from its parent and siblings
+static inline void sys_pheap_cut(struct pheap_node *node)
+{
+    if( node->prev->child == node )
+        node->prev->child = node->next;  // the first child
+    else
+        node->prev->next  = node->next;
+
+    if( node->next )
+        node->next->prev = node->prev;
+
+    node->next = NULL;
+    node->prev = NULL;
+}
+
+
+
+/*
+ * pheap_push - Pushes the given node to the heap.
+ *
+ * pheap: the heap for work.
+ * node:  the node for push (must not be in a heap)
+ */
+static inline void pheap_push(struct pheap_t *pheap, struct pheap_node *node)
+{
+    node->child = NULL;
+    node->next  = NULL;
+    node->prev  = NULL;
+
+    pheap->root  = pheap->root ? sys_pheap_link(pheap, pheap->root, node) : node;
+    pheap->size += 1;
+}
+
+
+
+/*
+ * pheap_meld - Moves all nodes from the heap src to the heap dest.
+ * After the call src is empty.
+ * The heaps must have the same cmp_func.
+ *
+ * src:  the heap from which the nodes are taken.
+ * dest: the heap to which the nodes are moved.
+ */
+static inline void pheap_meld(struct pheap_t *src, struct pheap_t *dest)
+{
+    if( !src->root )
+        return;
+
+
+    dest->root  = dest->root ? sys_pheap_link(dest, dest->root, src->root) : src->root;
+    dest->size += src->size;
+
+    src->root = NULL;
+    src->size = 0;
+}
+
+
+
+/*
+ * pheap_pop - Removes the top node from the heap.
+ *
+ * pheap: the heap for work.
+ */
+static inline void pheap_pop(struct pheap_t *pheap)
+{
+    struct pheap_node *root = pheap->root;
+
+
+    if( !root )
+        return;
+
+
+    pheap->root  = sys_pheap_merge_pairs(pheap, root->child);
+    pheap->size -= 1;
+
+    root->child = NULL;
+}
+
+
+
+/*
+ * pheap_decrease_key - Restores the heap after the key of the node was moved
+ * to the top (decreased for min heap, increased for max heap).
+ *
+ * pheap: the heap for work.
+ * node:  the node (in the heap) with the changed key
+ */
+static inline void pheap_decrease_key(struct pheap_t *pheap, struct pheap_node *node)
+{
+    if( node == pheap->root )
+        return;
+
+
+    sys_pheap_cut(node);
+    pheap->root = sys_pheap_link(pheap, pheap->root, node);
+}
+
+
+
+/*
+ * pheap_remove - Removes the node from the heap.
+ *
+ * pheap: the heap for work.
+ * node:  the node (in the heap) for remove
+ */
+static inline void pheap_remove(struct pheap_t *pheap, struct pheap_node *node)
+{
+    struct pheap_node *children;
+
+
+    if( node == pheap->root )
+    {
+        pheap_pop(pheap);
+        return;
+    }
+
+
+    sys_pheap_cut(node);
+
+    children     = sys_pheap_merge_pairs(pheap, node->child);
+    node->child  = NULL;
+    pheap->size -= 1;
+
+    if( children )
+        pheap->root = sys_pheap_link(pheap, pheap->root, children);
+}
+
+
+
+/*
+ * pheap_update - Restores the heap after the key of the node was changed
+ * in any direction (remove and push, use pheap_decrease_key if the key
+ * was moved to the top).
+ *
+ * pheap: the heap for work.
+ * node:  the node (in the heap) with the changed key
+ */
+static inline void pheap_update(struct pheap_t *pheap, struct pheap_node *node)
+{
+    pheap_remove(pheap, node);
+    pheap_push(pheap, node);
+}
+
+
+
+/*
+ * pheap_swap - Exchanges the contents of the heaps pheap1 and pheap2
+ *
+ * pheap1/2: the heaps for work.
+ */
+static inline void pheap_swap(struct pheap_t *pheap1, struct pheap_t *pheap2)
+{
+    struct pheap_t tmp = *pheap1;
+    *pheap1            = *pheap2;
+    *pheap2            = tmp;
+}
+
+
+
+/*
+ * pheap_data - get the struct (data) for this node
+ *
+ * node:   the node.
+ * type:   the type of the struct of data this is embedded in.
+ * member: the name of the node(pheap_node) within the struct of data.
+ */
+#define pheap_data(node, type, member) \
+    (type *)( (const char *)node - offsetof(type, member) )
+
+
+
+
+
+#endif // PHEAP_H
@@ -0,0 +1,377 @@
+/*
+ * pool.h
+ *
+ *
+ * BSD 3-Clause License
+ *
+ * Copyright (c) 2017, Koynov Stas - skojnov@yandex.ru
+ *
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice, this
+ *    list of conditions and the following disclaimer.
+ *
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ *    this list of conditions and the following disclaimer in the documentation
+ *    and/or other materials provided with the distribution.
+ *
+ * 3. Neither the name of the copyright holder nor the names of its
+ *    contributors may be used to endorse or promote products derived from
+ *    this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+ * FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ * DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ * SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ * CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+ * OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+
+
+
+#ifndef POOL_H
+#define POOL_H
+
+#include <stddef.h>
+#include <stdint.h>
+#include <stdlib.h>
+#include "stack.h"
+
+
+
+
+
+/*
+ *  pool_t - pool of the objects of the fixed size (slab allocator).
+ *
+ *  The memory is allocated by slabs (a slab is slab_objs objects and
+ *  list_head of the list of the slabs), the objects of a slab are contiguous,
+ *  so the nodes of a container from the pool are close in memory.
+ *  The free objects are in stack_t: the list_head is in the memory of
+ *  the free object (no memory for the metadata of the objects), the last
+ *  released object is allocated first (it is in the cache).
+ *  The objects of a new slab are allocated in order of memory.
+ *
+ *  The slabs are freed only by pool_free (all at once).
+ *
+ *
+ *  Algorithmic complexity:
+ *
+ *  pool_alloc          -   O(1) (+ O(slab_objs) if a new slab is needed)
+ *  pool_release        -   O(1)
+ *  pool_alloc_bulk     -   O(n)
+ *  pool_release_bulk   -   O(n)
+ *  pool_reserve        -   O(count)
+ *  pool_used           -   O(1)
+ *  pool_capacity       -   O(1)
+ *  pool_get_stats      -   O(1)
+ *  pool_free           -   O(slabs)
+ */
+
+
+
+
+
+#define POOL_SLAB_SIZE  (64 * 1024)   // size of the slab if slab_objs == 0
+
+
+
+// the max alignment of the base types (the objects of the pool are aligned to it)
+struct sys_pool_align
+{
+    char c;
+    union
+    {
+        long double ld;
+        long long   ll;
+        void       *p;
+        void      (*f)(void);
+    } u;
+};
+
+#define POOL_ALIGN  offsetof(struct sys_pool_align, u)
+
+
+
+struct pool_t
+{
+    struct stack_t   free;          // free objects
+    struct list_head slabs;         // list_head at the start of every slab
+    size_t           obj_size;      // size of the object (aligned, >= sizeof(list_head))
+    size_t           slab_objs;     // count of objects in a slab
+    size_t           slabs_count;
+    size_t           used;          // count of allocated objects
+};
+
+
+
+struct pool_stats
+{
+    size_t slabs;                   // count of slabs
+    size_t capacity;                // count of objects in the slabs
+    size_t used;                    // count of allocated objects
+    size_t free;                    // count of free objects
+    size_t bytes;                   // memory of the slabs
+};
+
+
+
+
+
+static inline size_t sys_pool_align_up(size_t size)
+{
+    return (size + POOL_ALIGN - 1) / POOL_ALIGN * POOL_ALIGN;
+}
+
+
+
+/*
+ * pool_init - init the pool (slabs are not allocated, see pool_reserve).
+ *
+ * pool:      the pool for work.
+ * obj_size:  size of the object
+ * slab_objs: count of objects in a slab (0 - for POOL_SLAB_SIZE bytes)
+ *
+ * ret: -1    //if obj_size is 0 or the slab is too big
+ * ret: 0     //good job. the pool was init.
+ */
+static inline int pool_init(struct pool_t *pool, size_t obj_size, size_t slab_objs)
+{
+    if( !obj_size || obj_size > SIZE_MAX / 2 )
+        return -1;
+
+
+    if( obj_size < sizeof(struct list_head) )
+        obj_size = sizeof(struct list_head);
+
+    obj_size = sys_pool_align_up(obj_size);
+
+    if( !slab_objs )
+        slab_objs = POOL_SLAB_SIZE / obj_size ? POOL_SLAB_SIZE / obj_size : 1;
+
+    if( slab_objs > (SIZE_MAX - POOL_ALIGN) / obj_size )
+        return -1;
+
+
+    stack_init(&pool->free);
+    list_init_head(&pool->slabs);
+
+    pool->obj_size    = obj_size;
+    pool->slab_objs   = slab_objs;
+    pool->slabs_count = 0;
+    pool->used        = 0;
+
+    return 0;
+}
+
+
+
+// allocate a slab and push its objects to the free stack (the first is on the top)
+static inline int sys_pool_grow(struct pool_t *pool)
+{
+    size_t header = sys_pool_align_up(sizeof(struct list_head));
+    char *slab    = malloc(header + pool->slab_objs * pool->obj_size);
+    char *obj;
+
+
+    if( !slab )
+        return -1;
+
+    list_push_front((struct list_head *)slab, &pool->slabs);
+    pool->slabs_count++;
+
+
+    for(obj = slab + header + pool->slab_objs * pool->obj_size; obj != slab + header; )
+    {
+        obj -= pool->obj_size;
+        stack_push((struct list_head *)obj, &pool->free);
+    }
+
+    return 0;
+}
+
+
+
+/*
+ * pool_reserve - Allocates the slabs for count free objects.
+ *
+ * pool:  the pool for work.
+ * count: count of free objects
+ *
+ * ret: -1    //if cant get memory (some slabs can be allocated)
+ * ret: 0     //good job
+ */
+static inline int pool_reserve(struct pool_t *pool, size_t count)
+{
+    while( stack_size(&pool->free) < count )
+        if( sys_pool_grow(pool) )
+            return -1;
+
+    return 0;
+}
+
+
+
+/*
+ * pool_alloc - Allocates the object (a new slab is allocated if there are
+ * no free objects). The memory of the object is not initialized.
+ *
+ * pool: the pool for work.
+ *
+ * ret: NULL  //if cant get memory
+ * ret: ptr   //good job ret the object
+ */
+static inline void* pool_alloc(struct pool_t *pool)
+{
+    struct list_head *obj;
+
+
+    if( stack_empty(&pool->free) && sys_pool_grow(pool) )
+        return NULL;
+
+    obj = stack_top(&pool->free);
+    stack_pop(&pool->free);
+    pool->used++;
+
+    return obj;
+}
+
+
+
+/*
+ * pool_release - Returns the object to the pool.
+ *
+ * pool: the pool for work.
+ * obj:  the object of the pool (allocated by pool_alloc)
+ */
+static inline void pool_release(struct pool_t *pool, void *obj)
+{
+    stack_push((struct list_head *)obj, &pool->free);
+    pool->used--;
+}
+
+
+
+/*
+ * pool_alloc_bulk - Allocates up to n objects.
+ *
+ * pool: the pool for work.
+ * objs: array for the objects
+ * n:    count of objects
+ *
+ * ret: count of allocated objects (< n if cant get memory)
+ */
+static inline size_t pool_alloc_bulk(struct pool_t *pool, void **objs, size_t n)
+{
+    size_t i;
+
+
+    pool_reserve(pool, n);
+
+    for(i = 0; i < n && !stack_empty(&pool->free); i++)
+    {
+        objs[i] = stack_top(&pool->free);
+        stack_pop(&pool->free);
+    }
+
+    pool->used += i;
+
+    return i;
+}
+
+
+
+/*
+ * pool_release_bulk - Returns n objects to the pool. The first object
+ * of objs will be allocated first.
+ *
+ * pool: the pool for work.
+ * objs: array of the objects of the pool
+ * n:    count of objects
+ */
+static inline void pool_release_bulk(struct pool_t *pool, void **objs, size_t n)
+{
+    size_t i;
+
+
+    for(i = n; i > 0; i--)
+        stack_push((struct list_head *)objs[i-1], &pool->free);
+
+    pool->used -= n;
+}
+
+
+
+// count of allocated objects
+static inline size_t pool_used(const struct pool_t *pool)
+{
+    return pool->used;
+}
+
+
+
+// count of objects in the slabs (allocated and free)
+static inline size_t pool_capacity(const struct pool_t *pool)
+{
+    return pool->slabs_count * pool->slab_objs;
+}
+
+
+
+// size of the object in the pool (aligned)
+static inline size_t pool_obj_size(const struct pool_t *pool)
+{
+    return pool->obj_size;
+}
+
+
+
+static inline void pool_get_stats(const struct pool_t *pool, struct pool_stats *stats)
+{
+    stats->slabs    = pool->slabs_count;
+    stats->capacity = pool_capacity(pool);
+    stats->used     = pool->used;
+    stats->free     = stack_size(&pool->free);
+    stats->bytes    = pool->slabs_count * (sys_pool_align_up(sizeof(struct list_head)) +
+                                           pool->slab_objs * pool->obj_size);
+}
+
+
+
+/*
+ * pool_free - Free the memory of the pool (all the slabs, the allocated
+ * objects too). After the call the pool is empty, it can be used again.
+ *
+ * pool: the pool for work.
+ */
+static inline void pool_free(struct pool_t *pool)
+{
+    struct list_head *slab;
+
+
+    while( !list_empty(&pool->slabs) )
+    {
+        slab = pool->slabs.next;
+        list_pop_front(&pool->slabs);
+        free(slab);
+    }
+
+    stack_init(&pool->free);
+
+    pool->slabs_count = 0;
+    pool->used        = 0;
+}
+
+
+
+
+
+#endif // POOL_H
@@ -38,6 +38,8 @@
 #define PQUEUE_H
 
 #include <stdlib.h>
+#include <stdint.h>
+#include <string.h>
 #include "spqueue.h"
 
 
@@ -59,6 +61,24 @@
  *  pqueue_pop     -   O(ln(n))
  *  pqueue_push    -   O(ln(n))
  *  pqueue_swap    -   O(1)
+ *  pqueue_push_n  -   O(size+n) or O(n*ln(size+n)) (the best for the batch)
+ *  pqueue_reserve        -   O(n)
+ *  pqueue_shrink_to_fit  -   O(n)
+ *  pqueue_free           -   O(1)
+ *
+ *  Growth of capacity in push (when the queue is full):
+ *  grow_factor == 0  - linear: capacity + inc_step, filling n items copies
+ *                      O(n^2/inc_step) pointers
+ *  grow_factor != 0  - geometric: capacity * grow_factor / 100 (at least
+ *                      capacity + inc_step), amortized O(1) per push
+ *
+ *
+ *  d-ary variants (see DEFINE_PQUEUE_DARY), d - arity of the heap:
+ *
+ *  prefix_top     -   O(1)
+ *  prefix_pop     -   O(d*log_d(n))
+ *  prefix_push    -   O(log_d(n))
+ *  prefix_push_n  -   O(size+n) or O(n*log_d(size+n))
  */
 
 
@@ -70,8 +90,9 @@ struct pqueue_t
     void          **items;
     size_t          size;
     size_t          capacity;
-    pqueue_cmp_func cmp_func; // <= for min heap, >= for max heap
-    size_t          inc_step; // increment step for malloc (see insert func)
+    pqueue_cmp_func cmp_func;    // <= for min heap, >= for max heap
+    size_t          inc_step;    // increment step for malloc (see insert func)
+    size_t          grow_factor; // percent, 0 - linear growth by inc_step (see set_grow_factor)
 };
 
 
@@ -80,7 +101,8 @@ struct pqueue_t
  * pqueue_init - init the priority queue.
  *
  * pqueue:   the priority queue for work.
- * inc_step: increment step for realloc in push func (if == 0 realloc dont call)
+ * inc_step: increment step for realloc in push func (if == 0 realloc dont call,
+ *           see pqueue_set_grow_factor for geometric growth)
  * capacity: current capacity of queue
  * cmp_func: compare function for work heap
  *
@@ -96,20 +118,120 @@ static inline int pqueue_init(struct pqueue_t *pqueue, size_t inc_step,
         return -1; // fuck cant get memory
 
 
-    pqueue->size     = 0;
-    pqueue->capacity = capacity;
-    pqueue->cmp_func = cmp_func;
-    pqueue->inc_step = inc_step;
+    pqueue->size        = 0;
+    pqueue->capacity    = capacity;
+    pqueue->cmp_func    = cmp_func;
+    pqueue->inc_step    = inc_step;
+    pqueue->grow_factor = 0;
 
     return 0; //good job
 }
 
 
 
+static inline int sys_pqueue_realloc(struct pqueue_t *pqueue, size_t new_capacity)
+{
+    void* tmp;
+
+
+    if( new_capacity > SIZE_MAX / sizeof(void *) )
+        return -1; //too big
+
+    tmp = realloc(pqueue->items, new_capacity*sizeof(void *));
+    if(!tmp)
+        return -1; //cant get memory
+
+
+    pqueue->items    = tmp;
+    pqueue->capacity = new_capacity;
+
+    return 0;
+}
+
+
+
+// new capacity by the growth policy (inc_step / grow_factor), at least need
+static inline size_t sys_pqueue_new_capacity(size_t capacity, size_t inc_step,
+                                             size_t grow_factor, size_t need)
+{
+    size_t new_capacity = capacity + inc_step;
+
+
+    if( grow_factor )
+    {
+        size_t geometric = capacity;
+
+        if( geometric <= SIZE_MAX / grow_factor )
+            geometric = geometric * grow_factor / 100;
+        else
+            geometric = SIZE_MAX;
+
+        if( geometric > new_capacity )
+            new_capacity = geometric;
+    }
+
+    if( new_capacity < need )
+        new_capacity = need;
+
+
+    return new_capacity;
+}
+
+
+
+// grow capacity by the growth policy (inc_step / grow_factor) to fit need items
+static inline int sys_pqueue_grow(struct pqueue_t *pqueue, size_t need)
+{
+    if( need <= pqueue->capacity )
+        return 0;
+
+    if( !pqueue->inc_step && !pqueue->grow_factor )
+        return -1; //queue is full
+
+
+    return sys_pqueue_realloc(pqueue, sys_pqueue_new_capacity(pqueue->capacity, pqueue->inc_step,
+                                                              pqueue->grow_factor, need));
+}
+
+
+
+// copy n items after the last item (size is not changed)
+static inline int sys_pqueue_append(struct pqueue_t *pqueue, void **items, size_t n)
+{
+    if( n > SIZE_MAX - pqueue->size )
+        return -1;
+
+    if( sys_pqueue_grow(pqueue, pqueue->size + n) )
+        return -1;
+
+
+    memcpy(pqueue->items + pqueue->size, items, n*sizeof(void *));
+
+    return 0;
+}
+
+
+
+// heapify of the whole queue is better than n sift_up: 2*(size+n) < n*log2(size+n)
+static inline int sys_pqueue_need_heapify(size_t size, size_t n)
+{
+    size_t log2 = 0;
+    size_t tmp  = size + n;
+
+
+    while( tmp >>= 1 )
+        log2++;
+
+
+    return 2*(size + n) < n*log2;
+}
+
+
+
 /*
  * pqueue_push - Pushes the given element item to the priority queue.
- * If the priority queue is full and pqueue->inc_step != 0 will be call realloc
- * function for get memory.
+ * If the priority queue is full and pqueue->inc_step != 0 (or
+ * pqueue->grow_factor != 0) will be call realloc function for get memory.
  *
  *
  * pqueue: the priority queue for work.
@@ -120,21 +242,54 @@ static inline int pqueue_init(struct pqueue_t *pqueue, size_t inc_step,
  */
 static inline int pqueue_push(struct pqueue_t *pqueue, void *item)
 {
-    if( (pqueue->size >= pqueue->capacity) && pqueue->inc_step )
-    {
-        size_t new_capacity = pqueue->capacity + pqueue->inc_step;
-        void* tmp = realloc(pqueue->items, new_capacity*sizeof(void *));
+    if( sys_pqueue_grow(pqueue, pqueue->size + 1) )
+        return -1; //cant get memory or queue is full
+
+
+    return spqueue_push((struct spqueue_t *)pqueue, item);
+}
+
+
+
+/*
+ * pqueue_push_n - Pushes n items to the priority queue.
+ * If the batch is large relative to the queue, the items are appended and
+ * the whole heap is rebuilt in O(size+n) (see spqueue_heapify),
+ * else every item is sifted up (O(n*ln(size+n))).
+ * The capacity grows as in pqueue_push (to fit all items at once).
+ *
+ * pqueue: the priority queue for work.
+ * items:  array of items for push
+ * n:      count of items
+ *
+ * ret: -1    //if pqueue is full and cant push (the queue is not changed)
+ * ret: 0     //good job. the items were pushed to the priority queue.
+ */
+static inline int pqueue_push_n(struct pqueue_t *pqueue, void **items, size_t n)
+{
+    size_t i;
+
 
-        if(!tmp)
-            return -1; //cant get memory
+    if( sys_pqueue_append(pqueue, items, n) )
+        return -1; //cant get memory or queue is full
 
 
-        pqueue->items    = tmp;
-        pqueue->capacity = new_capacity;
+    if( sys_pqueue_need_heapify(pqueue->size, n) )
+    {
+        pqueue->size += n;
+        spqueue_heapify((struct spqueue_t *)pqueue);
+    }
+    else
+    {
+        for(i = 0; i < n; i++)
+        {
+            spqueue_sift_up((struct spqueue_t *)pqueue, pqueue->size);
+            pqueue->size += 1;
+        }
     }
 
 
-    return spqueue_push((struct spqueue_t *)pqueue, item);
+    return 0; //good job
 }
 
 
@@ -167,6 +322,94 @@ static inline void pqueue_pop(struct pqueue_t *pqueue)
 
 
 
+/*
+ * pqueue_set_grow_factor - Set the growth policy of the priority queue.
+ *
+ * pqueue:      the priority queue for work.
+ * grow_factor: 0 - linear growth by inc_step (default after pqueue_init)
+ *              > 100 - geometric growth in percent (150 - 1.5x, 200 - 2x),
+ *              the new capacity is at least capacity + inc_step
+ *
+ * ret: -1    //if grow_factor is in range 1..100
+ * ret: 0     //good job.
+ */
+static inline int pqueue_set_grow_factor(struct pqueue_t *pqueue, size_t grow_factor)
+{
+    if( grow_factor && (grow_factor <= 100) )
+        return -1; //capacity will not grow
+
+
+    pqueue->grow_factor = grow_factor;
+
+    return 0; //good job
+}
+
+
+
+/*
+ * pqueue_reserve - Increase the capacity of the priority queue to a value
+ * that's greater or equal to capacity (pre-size for a known peak).
+ * If capacity <= pqueue->capacity the function does nothing.
+ *
+ * pqueue:   the priority queue for work.
+ * capacity: new capacity of the queue
+ *
+ * ret: -1    //if cant get memory (the queue is not changed)
+ * ret: 0     //good job.
+ */
+static inline int pqueue_reserve(struct pqueue_t *pqueue, size_t capacity)
+{
+    if( capacity <= pqueue->capacity )
+        return 0;
+
+
+    return sys_pqueue_realloc(pqueue, capacity);
+}
+
+
+
+/*
+ * pqueue_shrink_to_fit - Reduce the capacity of the priority queue to its size
+ * (reclaim memory after a peak). The capacity is at least 1.
+ *
+ * pqueue: the priority queue for work.
+ *
+ * ret: -1    //if cant get memory (the queue is not changed)
+ * ret: 0     //good job.
+ */
+static inline int pqueue_shrink_to_fit(struct pqueue_t *pqueue)
+{
+    size_t new_capacity = pqueue->size ? pqueue->size : 1;
+
+
+    if( new_capacity >= pqueue->capacity )
+        return 0;
+
+
+    return sys_pqueue_realloc(pqueue, new_capacity);
+}
+
+
+
+/*
+ * pqueue_free - Free the memory of the priority queue.
+ * The items are not freed (the queue does not own them).
+ * After the call the queue is empty with capacity 0,
+ * pqueue_reserve or pqueue_init can be used to work with it again.
+ *
+ * pqueue: the priority queue for work.
+ */
+static inline void pqueue_free(struct pqueue_t *pqueue)
+{
+    free(pqueue->items);
+
+    pqueue->items    = NULL;
+    pqueue->size     = 0;
+    pqueue->capacity = 0;
+}
+
+
+
 /*
  * pqueue_swap - Exchanges the contents of the containers pqueue1 and pqueue2
  *
@@ -183,4 +426,75 @@ static inline void pqueue_swap(struct pqueue_t *pqueue1, struct pqueue_t *pqueue
 
 
 
+/*
+ * DEFINE_PQUEUE_DARY - generate a d-ary heap variant for pqueue_t
+ *
+ * The same as pqueue_* but on top of the d-ary functions generated by
+ * DEFINE_SPQUEUE_DARY (see spqueue.h). Use pqueue_init and pqueue_swap
+ * for the queue, do not mix prefix_* and pqueue_* calls for one queue.
+ *
+ * prefix:         prefix for names of the generated functions
+ * spqueue_prefix: prefix of the functions generated by DEFINE_SPQUEUE_DARY
+ *
+ * Generated functions:
+ *
+ *   int   prefix_push(struct pqueue_t *pqueue, void *item);
+ *   void* prefix_top(struct pqueue_t *pqueue);
+ *   void  prefix_pop(struct pqueue_t *pqueue);
+ *   int   prefix_push_n(struct pqueue_t *pqueue, void **items, size_t n);
+ *
+ * pqueue4_* and pqueue8_* are already defined below.
+ */
+#define DEFINE_PQUEUE_DARY(prefix, spqueue_prefix)                                          \
+                                                                                            \
+static inline int prefix##_push(struct pqueue_t *pqueue, void *item)                        \
+{                                                                                           \
+    if( sys_pqueue_grow(pqueue, pqueue->size + 1) )                                         \
+        return -1; /* cant get memory or queue is full */                                   \
+                                                                                            \
+    return spqueue_prefix##_push((struct spqueue_t *)pqueue, item);                         \
+}                                                                                           \
+                                                                                            \
+static inline void* prefix##_top(struct pqueue_t *pqueue)                                   \
+{                                                                                           \
+    return spqueue_prefix##_top((struct spqueue_t *)pqueue);                                \
+}                                                                                           \
+                                                                                            \
+static inline void prefix##_pop(struct pqueue_t *pqueue)                                    \
+{                                                                                           \
+    spqueue_prefix##_pop((struct spqueue_t *)pqueue);                                       \
+}                                                                                           \
+                                                                                            \
+static inline int prefix##_push_n(struct pqueue_t *pqueue, void **items, size_t n)         \
+{                                                                                           \
+    size_t i;                                                                               \
+                                                                                            \
+    if( sys_pqueue_append(pqueue, items, n) )                                               \
+        return -1; /* cant get memory or queue is full */                                   \
+                                                                                            \
+    if( sys_pqueue_need_heapify(pqueue->size, n) )                                          \
+    {                                                                                       \
+        pqueue->size += n;                                                                  \
+        spqueue_prefix##_heapify((struct spqueue_t *)pqueue);                               \
+        return 0;                                                                           \
+    }                                                                                       \
+                                                                                            \
+    for(i = 0; i < n; i++)                                                                  \
+    {                                                                                       \
+        spqueue_prefix##_sift_up((struct spqueue_t *)pqueue, pqueue->size);                 \
+        pqueue->size += 1;                                                                  \
+    }                                                                                       \
+                                                                                            \
+    return 0;                                                                               \
+}
+
+
+
+DEFINE_PQUEUE_DARY(pqueue4, spqueue4)
+DEFINE_PQUEUE_DARY(pqueue8, spqueue8)
+
+
+
+
+
 #endif // PQUEUE_H
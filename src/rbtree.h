@@ -0,0 +1,850 @@
+/*
+ * rbtree.h
+ *
+ *
+ * BSD 3-Clause License
+ *
+ * Copyright (c) 2017, Koynov Stas - skojnov@yandex.ru
+ *
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice, this
+ *    list of conditions and the following disclaimer.
+ *
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ *    this list of conditions and the following disclaimer in the documentation
+ *    and/or other materials provided with the distribution.
+ *
+ * 3. Neither the name of the copyright holder nor the names of its
+ *    contributors may be used to endorse or promote products derived from
+ *    this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+ * FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ * DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ * SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ * CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+ * OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+
+
+
+#ifndef RBTREE_H
+#define RBTREE_H
+
+#include <stddef.h>
+#include <stdint.h>
+
+
+
+
+
+/*
+ *  rbtree_t - intrusive red-black tree (ordered multiset of the nodes).
+ *
+ *  The node (rbtree_node) is embedded in the struct of data and has three
+ *  words: the pointer to the parent with the colour in the low bit and
+ *  the pointers to the children (the nodes are aligned at least to 2).
+ *
+ *  The tree does not know the keys: cmp_func(node, key) compares the key
+ *  of the node with the key (as strcmp: <0, 0, >0), the caller gives the key
+ *  of the node on insert. The equal keys are kept in order of the inserts.
+ *
+ *
+ *  Algorithmic complexity:
+ *
+ *  rbtree_size         -   O(1)
+ *  rbtree_empty        -   O(1)
+ *  rbtree_first        -   O(log(n))
+ *  rbtree_last         -   O(log(n))
+ *  rbtree_next         -   O(1) amortized, O(log(n)) worst
+ *  rbtree_prev         -   O(1) amortized, O(log(n)) worst
+ *  rbtree_lookup       -   O(log(n))
+ *  rbtree_lower_bound  -   O(log(n))
+ *  rbtree_upper_bound  -   O(log(n))
+ *  rbtree_insert       -   O(log(n))
+ *  rbtree_insert_unique-   O(log(n))
+ *  rbtree_erase        -   O(log(n))
+ */
+
+
+
+
+
+#define RBTREE_RED      0
+#define RBTREE_BLACK    1
+
+
+
+struct rbtree_node
+{
+    uintptr_t           parent_color;   // parent | colour
+    struct rbtree_node *left;
+    struct rbtree_node *right;
+};
+
+
+
+typedef int (*rbtree_cmp_func)(const struct rbtree_node *node, const void *key);
+
+
+
+struct rbtree_t
+{
+    struct rbtree_node *root;
+    size_t              size;
+    rbtree_cmp_func     cmp_func;
+};
+
+
+
+#define INIT_RBTREE(cmp_func) { NULL, 0, cmp_func }
+
+#define DECLARE_RBTREE(name, cmp_func) \
+    struct rbtree_t name = INIT_RBTREE(cmp_func)
+
+
+
+
+
+static inline void rbtree_init(struct rbtree_t *tree, rbtree_cmp_func cmp_func)
+{
+    tree->root     = NULL;
+    tree->size     = 0;
+    tree->cmp_func = cmp_func;
+}
+
+
+
+static inline size_t rbtree_size(const struct rbtree_t *tree)
+{
+    return tree->size;
+}
+
+
+
+static inline int rbtree_empty(const struct rbtree_t *tree)
+{
+    return tree->root == NULL;
+}
+
+
+
+static inline struct rbtree_node* rbtree_parent(const struct rbtree_node *node)
+{
+    return (struct rbtree_node *)(node->parent_color & ~(uintptr_t)1);
+}
+
+
+
+static inline int sys_rbtree_is_black(const struct rbtree_node *node)
+{
+    return !node || (node->parent_color & RBTREE_BLACK);   // NULL leaves are black
+}
+
+
+
+static inline int sys_rbtree_is_red(const struct rbtree_node *node)
+{
+    return !sys_rbtree_is_black(node);
+}
+
+
+
+static inline void sys_rbtree_set_parent(struct rbtree_node *node, struct rbtree_node *parent)
+{
+    node->parent_color = (uintptr_t)parent | (node->parent_color & 1);
+}
+
+
+
+static inline void sys_rbtree_set_color(struct rbtree_node *node, int color)
+{
+    node->parent_color = (node->parent_color & ~(uintptr_t)1) | (uintptr_t)color;
+}
+
+
+
+// replace the child old of the parent (or the root) by the node
+static inline void sys_rbtree_change_child(struct rbtree_t *tree, struct rbtree_node *old,
+                                           struct rbtree_node *node, struct rbtree_node *parent)
+{
+    if( !parent )
+        tree->root = node;
+    else if( parent->left == old )
+        parent->left = node;
+    else
+        parent->right = node;
+}
+
+
+
+/*
+ *      x               y
+ *     / \             / \
+ *    a   y    -->    x   c
+ *       / \         / \
+ *      b   c       a   b
+ */
+static inline void sys_rbtree_rotate_left(struct rbtree_t *tree, struct rbtree_node *x)
+{
+    struct rbtree_node *y = x->right;
+
+
+    x->right = y->left;
+    if( y->left )
+        sys_rbtree_set_parent(y->left, x);
+
+    sys_rbtree_set_parent(y, rbtree_parent(x));
+    sys_rbtree_change_child(tree, x, y, rbtree_parent(x));
+
+    y->left = x;
+    sys_rbtree_set_parent(x, y);
+}
+
+
+
+static inline void sys_rbtree_rotate_right(struct rbtree_t *tree, struct rbtree_node *x)
+{
+    struct rbtree_node *y = x->left;
+
+
+    x->left = y->right;
+    if( y->right )
+        sys_rbtree_set_parent(y->right, x);
+
+    sys_rbtree_set_parent(y, rbtree_parent(x));
+    sys_rbtree_change_child(tree, x, y, rbtree_parent(x));
+
+    y->right = x;
+    sys_rbtree_set_parent(x, y);
+}
+
+
+
+
+
+static inline struct rbtree_node* rbtree_first(const struct rbtree_t *tree)
+{
+    struct rbtree_node *node = tree->root;
+
+
+    if( node )
+        while( node->left )
+            node = node->left;
+
+    return node;
+}
+
+
+
+static inline struct rbtree_node* rbtree_last(const struct rbtree_t *tree)
+{
+    struct rbtree_node *node = tree->root;
+
+
+    if( node )
+        while( node->right )
+            node = node->right;
+
+    return node;
+}
+
+
+
+/*
+ * rbtree_next - Returns the next node in order or NULL if the node is the last.
+ */
+static inline struct rbtree_node* rbtree_next(const struct rbtree_node *node)
+{
+    struct rbtree_node *parent;
+
+
+    if( node->right )
+    {
+        node = node->right;
+        while( node->left )
+            node = node->left;
+
+        return (struct rbtree_node *)node;
+    }
+
+
+    while( (parent = rbtree_parent(node)) && node == parent->right )
+        node = parent;
+
+    return parent;
+}
+
+
+
+/*
+ * rbtree_prev - Returns the previous node in order or NULL if the node is the first.
+ */
+static inline struct rbtree_node* rbtree_prev(const struct rbtree_node *node)
+{
+    struct rbtree_node *parent;
+
+
+    if( node->left )
+    {
+        node = node->left;
+        while( node->right )
+            node = node->right;
+
+        return (struct rbtree_node *)node;
+    }
+
+
+    while( (parent = rbtree_parent(node)) && node == parent->left )
+        node = parent;
+
+    return parent;
+}
+
+
+
+/*
+ * rbtree_lower_bound - Returns the first node with the key >= key.
+ *
+ * tree: the tree for work.
+ * key:  the key for cmp_func
+ *
+ * ret: NULL   //if all the keys of the tree are less than key
+ * ret: *node  //good job ret the node
+ */
+static inline struct rbtree_node* rbtree_lower_bound(const struct rbtree_t *tree, const void *key)
+{
+    struct rbtree_node *node  = tree->root;
+    struct rbtree_node *bound = NULL;
+
+
+    while( node )
+    {
+        if( tree->cmp_func(node, key) >= 0 )
+        {
+            bound = node;
+            node  = node->left;
+        }
+        else
+        {
+            node = node->right;
+        }
+    }
+
+    return bound;
+}
+
+
+
+/*
+ * rbtree_upper_bound - Returns the first node with the key > key.
+ *
+ * tree: the tree for work.
+ * key:  the key for cmp_func
+ *
+ * ret: NULL   //if all the keys of the tree are less or equal to key
+ * ret: *node  //good job ret the node
+ */
+static inline struct rbtree_node* rbtree_upper_bound(const struct rbtree_t *tree, const void *key)
+{
+    struct rbtree_node *node  = tree->root;
+    struct rbtree_node *bound = NULL;
+
+
+    while( node )
+    {
+        if( tree->cmp_func(node, key) > 0 )
+        {
+            bound = node;
+            node  = node->left;
+        }
+        else
+        {
+            node = node->right;
+        }
+    }
+
+    return bound;
+}
+
+
+
+/*
+ * rbtree_lookup - Returns the node with the key (the first inserted
+ * of the equal keys, the others follow it in order: see rbtree_next).
+ *
+ * tree: the tree for work.
+ * key:  the key for cmp_func
+ *
+ * ret: NULL   //if there is no node with the key
+ * ret: *node  //good job ret the node
+ */
+static inline struct rbtree_node* rbtree_lookup(const struct rbtree_t *tree, const void *key)
+{
+    struct rbtree_node *node  = tree->root;
+    struct rbtree_node *found = NULL;
+    int cmp;
+
+
+    while( node )
+    {
+        cmp = tree->cmp_func(node, key);
+
+        if( cmp > 0 )
+        {
+            node = node->left;
+        }
+        else if( cmp < 0 )
+        {
+            node = node->right;
+        }
+        else
+        {
+            found = node;        // go on to the left for the first of the equal keys
+            node  = node->left;
+        }
+    }
+
+    return found;
+}
+
+
+
+
+
+// restore the red-black properties after the insert of the red node
+static inline void sys_rbtree_insert_fixup(struct rbtree_t *tree, struct rbtree_node *node)
+{
+    struct rbtree_node *parent, *gparent, *uncle;
+
+
+    while( (parent = rbtree_parent(node)) && sys_rbtree_is_red(parent) )
+    {
+        gparent = rbtree_parent(parent);        // the red parent is not the root
+
+        if( parent == gparent->left )
+        {
+            uncle = gparent->right;
+
+            if( sys_rbtree_is_red(uncle) )
+            {
+                sys_rbtree_set_color(parent, RBTREE_BLACK);
+                sys_rbtree_set_color(uncle, RBTREE_BLACK);
+                sys_rbtree_set_color(gparent, RBTREE_RED);
+                node = gparent;
+                continue;
+            }
+
+            if( node == parent->right )
+            {
+                sys_rbtree_rotate_left(tree, parent);
+                parent = node;
+            }
+
+            sys_rbtree_set_color(parent, RBTREE_BLACK);
+            sys_rbtree_set_color(gparent, RBTREE_RED);
+            sys_rbtree_rotate_right(tree, gparent);
+            break;                              // the parent is black now
+        }
+        else
+        {
+            uncle = gparent->left;
+
+            if( sys_rbtree_is_red(uncle) )
+            {
+                sys_rbtree_set_color(parent, RBTREE_BLACK);
+                sys_rbtree_set_color(uncle, RBTREE_BLACK);
+                sys_rbtree_set_color(gparent, RBTREE_RED);
+                node = gparent;
+                continue;
+            }
+
+            if( node == parent->left )
+            {
+                sys_rbtree_rotate_right(tree, parent);
+                parent = node;
+            }
+
+            sys_rbtree_set_color(parent, RBTREE_BLACK);
+            sys_rbtree_set_color(gparent, RBTREE_RED);
+            sys_rbtree_rotate_left(tree, gparent);
+            break;                              // the parent is black now
+        }
+    }
+
+    sys_rbtree_set_color(tree->root, RBTREE_BLACK);
+}
+
+
+
+// link the new red node as the child of the parent (left if is_left)
+static inline void sys_rbtree_link(struct rbtree_t *tree, struct rbtree_node *node,
+                                   struct rbtree_node *parent, int is_left)
+{
+    node->parent_color = (uintptr_t)parent | RBTREE_RED;
+    node->left         = NULL;
+    node->right        = NULL;
+
+    if( !parent )
+        tree->root = node;
+    else if( is_left )
+        parent->left = node;
+    else
+        parent->right = node;
+
+    tree->size++;
+    sys_rbtree_insert_fixup(tree, node);
+}
+
+
+
+/*
+ * rbtree_insert - Inserts the node with the key. The node is placed
+ * after the nodes with the equal keys.
+ *
+ * tree: the tree for work.
+ * node: the node for insert (not in a tree)
+ * key:  the key of the node (for cmp_func)
+ */
+static inline void rbtree_insert(struct rbtree_t *tree, struct rbtree_node *node, const void *key)
+{
+    struct rbtree_node *parent = NULL;
+    struct rbtree_node *it     = tree->root;
+    int is_left = 0;
+
+
+    while( it )
+    {
+        parent  = it;
+        is_left = tree->cmp_func(it, key) > 0;
+        it      = is_left ? it->left : it->right;
+    }
+
+    sys_rbtree_link(tree, node, parent, is_left);
+}
+
+
+
+/*
+ * rbtree_insert_unique - Inserts the node with the key if the tree
+ * has no node with the equal key.
+ *
+ * tree: the tree for work.
+ * node: the node for insert (not in a tree)
+ * key:  the key of the node (for cmp_func)
+ *
+ * ret: NULL   //good job the node was inserted
+ * ret: *node  //the node of the tree with the equal key (the node was not inserted)
+ */
+static inline struct rbtree_node* rbtree_insert_unique(struct rbtree_t *tree,
+                                                       struct rbtree_node *node, const void *key)
+{
+    struct rbtree_node *parent = NULL;
+    struct rbtree_node *it     = tree->root;
+    int cmp = 0;
+
+
+    while( it )
+    {
+        cmp = tree->cmp_func(it, key);
+        if( cmp == 0 )
+            return it;
+
+        parent = it;
+        it     = cmp > 0 ? it->left : it->right;
+    }
+
+    sys_rbtree_link(tree, node, parent, cmp > 0);
+
+    return NULL;
+}
+
+
+
+// restore the red-black properties after the erase of a black node,
+// node (can be NULL) has one extra black, parent is its parent
+static inline void sys_rbtree_erase_fixup(struct rbtree_t *tree, struct rbtree_node *node,
+                                          struct rbtree_node *parent)
+{
+    struct rbtree_node *sibling;
+
+
+    while( node != tree->root && sys_rbtree_is_black(node) )
+    {
+        if( node == parent->left )
+        {
+            sibling = parent->right;        // not NULL: it has the black height >= 1
+
+            if( sys_rbtree_is_red(sibling) )
+            {
+                sys_rbtree_set_color(sibling, RBTREE_BLACK);
+                sys_rbtree_set_color(parent, RBTREE_RED);
+                sys_rbtree_rotate_left(tree, parent);
+                sibling = parent->right;
+            }
+
+            if( sys_rbtree_is_black(sibling->left) && sys_rbtree_is_black(sibling->right) )
+            {
+                sys_rbtree_set_color(sibling, RBTREE_RED);
+                node   = parent;
+                parent = rbtree_parent(node);
+                continue;
+            }
+
+            if( sys_rbtree_is_black(sibling->right) )
+            {
+                sys_rbtree_set_color(sibling->left, RBTREE_BLACK);
+                sys_rbtree_set_color(sibling, RBTREE_RED);
+                sys_rbtree_rotate_right(tree, sibling);
+                sibling = parent->right;
+            }
+
+            sys_rbtree_set_color(sibling, parent->parent_color & 1);
+            sys_rbtree_set_color(parent, RBTREE_BLACK);
+            sys_rbtree_set_color(sibling->right, RBTREE_BLACK);
+            sys_rbtree_rotate_left(tree, parent);
+        }
+        else
+        {
+            sibling = parent->left;
+
+            if( sys_rbtree_is_red(sibling) )
+            {
+                sys_rbtree_set_color(sibling, RBTREE_BLACK);
+                sys_rbtree_set_color(parent, RBTREE_RED);
+                sys_rbtree_rotate_right(tree, parent);
+                sibling = parent->left;
+            }
+
+            if( sys_rbtree_is_black(sibling->left) && sys_rbtree_is_black(sibling->right) )
+            {
+                sys_rbtree_set_color(sibling, RBTREE_RED);
+                node   = parent;
+                parent = rbtree_parent(node);
+                continue;
+            }
+
+            if( sys_rbtree_is_black(sibling->left) )
+            {
+                sys_rbtree_set_color(sibling->right, RBTREE_BLACK);
+                sys_rbtree_set_color(sibling, RBTREE_RED);
+                sys_rbtree_rotate_left(tree, sibling);
+                sibling = parent->left;
+            }
+
+            sys_rbtree_set_color(sibling, parent->parent_color & 1);
+            sys_rbtree_set_color(parent, RBTREE_BLACK);
+            sys_rbtree_set_color(sibling->left, RBTREE_BLACK);
+            sys_rbtree_rotate_right(tree, parent);
+        }
+
+        node = tree->root;
+    }
+
+    if( node )
+        sys_rbtree_set_color(node, RBTREE_BLACK);
+}
+
+
+
+/*
+ * rbtree_erase - Removes the node from the tree.
+ *
+ * tree: the tree for work.
+ * node: the node (in the tree) for remove
+ */
+static inline void rbtree_erase(struct rbtree_t *tree, struct rbtree_node *node)
+{
+    struct rbtree_node *parent = rbtree_parent(node);
+    struct rbtree_node *child, *next;
+    int black = sys_rbtree_is_black(node);
+
+
+    if( !node->left || !node->right )
+    {
+        child = node->left ? node->left : node->right;
+
+        sys_rbtree_change_child(tree, node, child, parent);
+        if( child )
+            sys_rbtree_set_parent(child, parent);
+    }
+    else
+    {
+        // the next node (the min of the right subtree) takes the place of the node
+        next = node->right;
+        while( next->left )
+            next = next->left;
+
+        black = sys_rbtree_is_black(next);
+        child = next->right;
+
+        if( rbtree_parent(next) == node )
+        {
+            parent = next;
+        }
+        else
+        {
+            parent       = rbtree_parent(next);
+            parent->left = child;
+            if( child )
+                sys_rbtree_set_parent(child, parent);
+
+            next->right = node->right;
+            sys_rbtree_set_parent(next->right, next);
+        }
+
+        sys_rbtree_change_child(tree, node, next, rbtree_parent(node));
+        next->parent_color = node->parent_color;
+        next->left         = node->left;
+        sys_rbtree_set_parent(next->left, next);
+    }
+
+
+    tree->size--;
+
+    if( black )
+        sys_rbtree_erase_fixup(tree, child, parent);
+}
+
+
+
+
+
+static inline void* sys_rbtree_data_or_null(const struct rbtree_node *node, size_t offset)
+{
+    return node ? (char *)node - offset : NULL;
+}
+
+
+
+/*
+ * rbtree_data - get the struct (data) for this node
+ *
+ * node:   the node.
+ * type:   the type of the struct of data this is embedded in.
+ * member: the name of the node(rbtree_node) within the struct of data.
+ */
+#define rbtree_data(node, type, member) \
+    (type *)( (const char *)node - offsetof(type, member) )
+
+
+
+/*
+ * rbtree_data_or_null - get the struct (data) for this node or NULL if node is NULL
+ * (the node is evaluated once: rbtree_data_or_null(rbtree_lookup(...), ...))
+ *
+ * node:   the node.
+ * type:   the type of the struct of data this is embedded in.
+ * member: the name of the node(rbtree_node) within the struct of data.
+ */
+#define rbtree_data_or_null(node, type, member) \
+    ((type *)sys_rbtree_data_or_null(node, offsetof(type, member)))
+
+
+
+
+
+/*
+ * rbtree_citer - constant iterate over a tree in order
+ *
+ * it:    the &struct rbtree_node to use as a loop cursor(iterator).
+ * tree:  the tree.
+ *
+ * Note You do not have to change tree in this cycle.
+ */
+#define rbtree_citer(it, tree) \
+    for( it = rbtree_first(tree); it; it = rbtree_next(it) )
+
+
+
+/*
+ * rbtree_criter - constant revers iterate over a tree in order
+ *
+ * it:    the &struct rbtree_node to use as a loop cursor(iterator).
+ * tree:  the tree.
+ *
+ * Note You do not have to change tree in this cycle.
+ */
+#define rbtree_criter(it, tree) \
+    for( it = rbtree_last(tree); it; it = rbtree_prev(it) )
+
+
+
+/*
+ * rbtree_iter - iterate over a tree in order safe against erase of the node
+ *
+ * it:     the &struct rbtree_node to use as a loop cursor(iterator).
+ * tmp_it: another &struct rbtree_node to use as temporary cursor(iterator)
+ * tree:   the tree.
+ */
+#define rbtree_iter(it, tmp_it, tree)                                    \
+    for( it = rbtree_first(tree), tmp_it = it ? rbtree_next(it) : NULL;  \
+         it;                                                             \
+         it = tmp_it, tmp_it = it ? rbtree_next(it) : NULL )
+
+
+
+/*
+ * rbtree_data_citer - constant iterate over a tree of given type (data) in order
+ *
+ * it:     the &struct data to use as a loop cursor(iterator).
+ * tree:   the tree.
+ * type:   the type of the struct of data this is embedded in.
+ * member: the name of the node(rbtree_node) within the struct of data.
+ *
+ * Note You do not have to change tree in this cycle.
+ */
+#define rbtree_data_citer(it, tree, type, member)                           \
+    for( it = rbtree_data_or_null(rbtree_first(tree), type, member);        \
+         it;                                                                \
+         it = rbtree_data_or_null(rbtree_next(&it->member), type, member) )
+
+
+
+/*
+ * rbtree_data_criter - constant revers iterate over a tree of given type (data)
+ *
+ * it:     the &struct data to use as a loop cursor(iterator).
+ * tree:   the tree.
+ * type:   the type of the struct of data this is embedded in.
+ * member: the name of the node(rbtree_node) within the struct of data.
+ *
+ * Note You do not have to change tree in this cycle.
+ */
+#define rbtree_data_criter(it, tree, type, member)                          \
+    for( it = rbtree_data_or_null(rbtree_last(tree), type, member);         \
+         it;                                                                \
+         it = rbtree_data_or_null(rbtree_prev(&it->member), type, member) )
+
+
+
+/*
+ * rbtree_data_iter - iterate over a tree of given type safe against erase
+ *
+ * it:     the &struct data to use as a loop cursor(iterator).
+ * tree:   the tree.
+ * tmp_it: another &struct rbtree_node to use as temporary cursor(iterator)
+ * type:   the type of the struct of data this is embedded in.
+ * member: the name of the node(rbtree_node) within the struct of data.
+ */
+#define rbtree_data_iter(it, tree, tmp_it, type, member)                    \
+    for( it = rbtree_data_or_null(rbtree_first(tree), type, member),        \
+         tmp_it = it ? rbtree_next(&it->member) : NULL;                     \
+         it;                                                                \
+         it = rbtree_data_or_null(tmp_it, type, member),                    \
+         tmp_it = it ? rbtree_next(&it->member) : NULL )
+
+
+
+
+
+#endif // RBTREE_H
@@ -0,0 +1,375 @@
+/*
+ * rpqueue.h
+ *
+ *
+ * BSD 3-Clause License
+ *
+ * Copyright (c) 2017, Koynov Stas - skojnov@yandex.ru
+ *
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice, this
+ *    list of conditions and the following disclaimer.
+ *
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ *    this list of conditions and the following disclaimer in the documentation
+ *    and/or other materials provided with the distribution.
+ *
+ * 3. Neither the name of the copyright holder nor the names of its
+ *    contributors may be used to endorse or promote products derived from
+ *    this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+ * FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ * DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ * SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ * CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+ * OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+
+
+#ifndef RPQUEUE_H
+#define RPQUEUE_H
+
+#include <stddef.h>
+#include <stdint.h>
+#include "dlist.h"
+
+
+
+
+
+/*
+ *  rpqueue_t - intrusive radix heap (min heap) for monotone integer keys:
+ *  the keys that are pushed must not be less than the last popped key
+ *  (timers, Dijkstra-like algorithms). A node (rpqueue_node) is embedded
+ *  in the struct of data like dlist_head, the queue does not allocate memory.
+ *
+ *  The nodes are kept in 65 buckets (dlist_head) by the highest bit where
+ *  the key differs from the last popped key (rpqueue_last):
+ *
+ *  bucket 0     - key == last
+ *  bucket i     - the highest differing bit is i-1 (key in [last, last + 2^i))
+ *
+ *  Pop takes the nodes from bucket 0. When it is empty, the min key of
+ *  the first non-empty bucket (bitmap of non-empty buckets) becomes the last
+ *  key and the nodes of the bucket go to the lower buckets. The min key of
+ *  every bucket is kept by push (one comparison), so the bucket is walked
+ *  only once. A node only moves down, so it is moved at most log2(C) + 1
+ *  times (C - the max difference of the keys in the queue). There is no
+ *  cmp_func.
+ *  The nodes with equal keys are popped in FIFO order.
+ *
+ *
+ *  Algorithmic complexity:
+ *
+ *  rpqueue_size       -   O(1)
+ *  rpqueue_empty      -   O(1)
+ *  rpqueue_last       -   O(1)
+ *  rpqueue_push       -   O(1)
+ *  rpqueue_top        -   O(log(C)) amortized
+ *  rpqueue_pop        -   O(log(C)) amortized
+ *  rpqueue_remove     -   O(1)
+ *  rpqueue_update     -   O(1)
+ */
+
+
+
+
+
+#define RPQUEUE_BUCKETS  65
+
+
+
+struct rpqueue_node
+{
+    struct dlist_head list;
+    uint64_t          key;
+};
+
+
+
+struct rpqueue_t
+{
+    struct dlist_head buckets[RPQUEUE_BUCKETS];
+    uint64_t          mins[RPQUEUE_BUCKETS];  // min key of the non-empty bucket (<= after remove)
+    uint64_t          bitmap;  // bit i - bucket i+1 is not empty (bucket 0 is checked by dlist_empty)
+    uint64_t          last;    // the last popped key (min possible key)
+    size_t            size;
+};
+
+
+
+
+
+static inline void rpqueue_init(struct rpqueue_t *rpq)
+{
+    size_t i;
+
+    for(i = 0; i < RPQUEUE_BUCKETS; i++)
+        dlist_init_head(&rpq->buckets[i]);
+
+    rpq->bitmap = 0;
+    rpq->last   = 0;
+    rpq->size   = 0;
+}
+
+
+
+static inline size_t rpqueue_size(const struct rpqueue_t *rpq)
+{
+    return rpq->size;
+}
+
+
+
+static inline int rpqueue_empty(const struct rpqueue_t *rpq)
+{
+    return rpq->size == 0;
+}
+
+
+
+/*
+ * rpqueue_last - Returns the last popped key (0 for new queue).
+ * The keys less than it can not be pushed.
+ *
+ * rpq: the queue for work.
+ */
+static inline uint64_t rpqueue_last(const struct rpqueue_t *rpq)
+{
+    return rpq->last;
+}
+
+
+
+// index of the highest set bit (x != 0)
+static inline unsigned int sys_rpqueue_msb(uint64_t x)
+{
+#if defined(__GNUC__)
+    return 63 - (unsigned int)__builtin_clzll(x);
+#else
+    unsigned int i = 0;
+
+    while( x >>= 1 )
+        i++;
+
+    return i;
+#endif
+}
+
+
+
+// index of the lowest set bit (x != 0)
+static inline unsigned int sys_rpqueue_lsb(uint64_t x)
+{
+#if defined(__GNUC__)
+    return (unsigned int)__builtin_ctzll(x);
+#else
+    unsigned int i = 0;
+
+    while( !(x & 1) )
+    {
+        x >>= 1;
+        i++;
+    }
+
+    return i;
+#endif
+}
+
+
+
+static inline unsigned int sys_rpqueue_bucket(uint64_t key, uint64_t last)
+{
+    return (key == last) ? 0 : sys_rpqueue_msb(key ^ last) + 1;
+}
+
+
+
+static inline void sys_rpqueue_add(struct rpqueue_t *rpq, struct rpqueue_node *node)
+{
+    unsigned int b = sys_rpqueue_bucket(node->key, rpq->last);
+    uint64_t bit;
+
+
+    dlist_push_back(&node->list, &rpq->buckets[b]);
+
+    if( !b )
+        return;
+
+
+    bit = (uint64_t)1 << (b - 1);
+
+    if( !(rpq->bitmap & bit) || node->key < rpq->mins[b] )
+        rpq->mins[b] = node->key;
+
+    rpq->bitmap |= bit;
+}
+
+
+
+// bucket 0 is empty: take the min of the first non-empty bucket as the last key
+// and move the nodes of the bucket to the lower buckets.
+// After remove the min can be less than the real one (the node was removed),
+// then bucket 0 can be empty after the call (all nodes are moved down anyway)
+static inline void sys_rpqueue_redistribute(struct rpqueue_t *rpq)
+{
+    struct dlist_head *bucket, *it, *tmp_it;
+    struct rpqueue_node *node;
+    unsigned int b;
+
+
+    b      = sys_rpqueue_lsb(rpq->bitmap) + 1;
+    bucket = &rpq->buckets[b];
+
+    rpq->last    = rpq->mins[b];
+    rpq->bitmap &= ~((uint64_t)1 << (b - 1));
+
+    dlist_iter(it, tmp_it, bucket)
+    {
+        node = dlist_data(it, struct rpqueue_node, list);
+        sys_rpqueue_add(rpq, node);  // to the bucket < b
+    }
+
+    dlist_init_head(bucket);
+}
+
+
+
+/*
+ * rpqueue_push - Pushes the node with the key to the queue.
+ *
+ * rpq:  the queue for work.
+ * node: the node for push (must not be in a queue)
+ * key:  the key of the node (must be >= rpqueue_last)
+ *
+ * ret: -1  //if key < rpqueue_last (the node is not pushed)
+ * ret:  0  //good job
+ */
+static inline int rpqueue_push(struct rpqueue_t *rpq, struct rpqueue_node *node, uint64_t key)
+{
+    if( key < rpq->last )
+        return -1;
+
+
+    node->key = key;
+    sys_rpqueue_add(rpq, node);
+    rpq->size++;
+
+    return 0;
+}
+
+
+
+/*
+ * rpqueue_top - Returns the node with the min key.
+ * This node will be removed on a call to pop().
+ * After the call rpqueue_last is equal to the key of the node.
+ *
+ * rpq: the queue for work.
+ *
+ * ret: NULL   //if queue is empty
+ * ret: *node  //good job ret top node.
+ */
+static inline struct rpqueue_node* rpqueue_top(struct rpqueue_t *rpq)
+{
+    if( !rpq->size )
+        return NULL;
+
+
+    while( dlist_empty(&rpq->buckets[0]) )
+        sys_rpqueue_redistribute(rpq);
+
+    return dlist_data(rpq->buckets[0].next, struct rpqueue_node, list);
+}
+
+
+
+/*
+ * rpqueue_pop - Removes the node with the min key from the queue.
+ *
+ * rpq: the queue for work.
+ */
+static inline void rpqueue_pop(struct rpqueue_t *rpq)
+{
+    struct rpqueue_node *top = rpqueue_top(rpq);
+
+
+    if( !top )
+        return;
+
+
+    dlist_del(&top->list);
+    rpq->size--;
+}
+
+
+
+/*
+ * rpqueue_remove - Removes the node from the queue.
+ *
+ * rpq:  the queue for work.
+ * node: the node (in the queue) for remove
+ */
+static inline void rpqueue_remove(struct rpqueue_t *rpq, struct rpqueue_node *node)
+{
+    unsigned int b = sys_rpqueue_bucket(node->key, rpq->last);
+
+
+    dlist_del(&node->list);
+    rpq->size--;
+
+    if( b && dlist_empty(&rpq->buckets[b]) )
+        rpq->bitmap &= ~((uint64_t)1 << (b - 1));
+}
+
+
+
+/*
+ * rpqueue_update - Changes the key of the node in the queue
+ * (decrease key for Dijkstra-like algorithms, in any direction in fact).
+ *
+ * rpq:  the queue for work.
+ * node: the node (in the queue) with the old key
+ * key:  the new key of the node (must be >= rpqueue_last)
+ *
+ * ret: -1  //if key < rpqueue_last (the node is not changed)
+ * ret:  0  //good job
+ */
+static inline int rpqueue_update(struct rpqueue_t *rpq, struct rpqueue_node *node, uint64_t key)
+{
+    if( key < rpq->last )
+        return -1;
+
+
+    rpqueue_remove(rpq, node);
+
+    return rpqueue_push(rpq, node, key);
+}
+
+
+
+/*
+ * rpqueue_data - get the struct (data) for this node
+ *
+ * node:   the node.
+ * type:   the type of the struct of data this is embedded in.
+ * member: the name of the node(rpqueue_node) within the struct of data.
+ */
+#define rpqueue_data(node, type, member) \
+    (type *)( (const char *)node - offsetof(type, member) )
+
+
+
+
+
+#endif // RPQUEUE_H
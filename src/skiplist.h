@@ -0,0 +1,636 @@
+/*
+ * skiplist.h
+ *
+ *
+ * BSD 3-Clause License
+ *
+ * Copyright (c) 2017, Koynov Stas - skojnov@yandex.ru
+ *
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice, this
+ *    list of conditions and the following disclaimer.
+ *
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ *    this list of conditions and the following disclaimer in the documentation
+ *    and/or other materials provided with the distribution.
+ *
+ * 3. Neither the name of the copyright holder nor the names of its
+ *    contributors may be used to endorse or promote products derived from
+ *    this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+ * FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ * DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ * SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ * CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+ * OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+
+
+
+#ifndef SKIPLIST_H
+#define SKIPLIST_H
+
+#include <stddef.h>
+#include <stdint.h>
+#include <stdlib.h>
+#include "dlist.h"
+
+
+
+
+
+/*
+ *  skiplist_t - intrusive skip list (ordered multiset of the nodes).
+ *
+ *  Level 0 is a circular dlist_head list in order of the keys: the head is
+ *  skiplist_t.head and the node (skiplist_node) has the dlist_head member
+ *  list, so the dlist iterators and algorithms which do not change the list
+ *  (dlist_citer, dlist_data_citer, dlist_find, ...) work on it. The list must
+ *  be changed only by the skiplist functions.
+ *
+ *  The upper levels of the node (tower) are allocated by skiplist_insert
+ *  if the height of the node > 1 (p = 1/4: 3/4 of the nodes have no tower)
+ *  and are freed by skiplist_erase. The heights are taken from xorshift64
+ *  generator with the seed of skiplist_init (the same seed - the same shape).
+ *
+ *  If SKIPLIST_SPANS is 1 (default) every link has the count of level-0
+ *  steps it skips and skiplist_at finds the node by the index in O(log(n)).
+ *  SKIPLIST_SPANS and SKIPLIST_MAX_LEVEL (default 16, for 4^16 nodes)
+ *  can be defined before the include.
+ *
+ *  The skip list does not know the keys: cmp_func(node, key) compares the key
+ *  of the node with the key (as strcmp: <0, 0, >0), the caller gives the key
+ *  of the node on insert and erase. The equal keys are kept in order of
+ *  the inserts.
+ *
+ *
+ *  Algorithmic complexity (expected):
+ *
+ *  skiplist_size        -   O(1)
+ *  skiplist_empty       -   O(1)
+ *  skiplist_first       -   O(1)
+ *  skiplist_last        -   O(1)
+ *  skiplist_next        -   O(1)
+ *  skiplist_prev        -   O(1)
+ *  skiplist_lookup      -   O(log(n))
+ *  skiplist_lower_bound -   O(log(n))
+ *  skiplist_insert      -   O(log(n))
+ *  skiplist_erase       -   O(log(n) + k), k - count of the equal keys before the node
+ *  skiplist_at          -   O(log(n))
+ *  skiplist_clear       -   O(n)
+ */
+
+
+
+
+
+#ifndef SKIPLIST_MAX_LEVEL
+#define SKIPLIST_MAX_LEVEL  16
+#endif
+
+#ifndef SKIPLIST_SPANS
+#define SKIPLIST_SPANS  1
+#endif
+
+
+#if SKIPLIST_MAX_LEVEL < 2
+#error "SKIPLIST_MAX_LEVEL must be >= 2"
+#endif
+
+
+
+struct skiplist_node;
+
+struct skiplist_link
+{
+    struct skiplist_node *next;     // NULL - the end
+#if SKIPLIST_SPANS
+    size_t                span;     // count of level-0 steps to next (to the last node if NULL)
+#endif
+};
+
+
+
+struct skiplist_node
+{
+    struct dlist_head     list;     // level 0
+    struct skiplist_link *tower;    // levels 1 .. height-1 (NULL if height == 1)
+    unsigned int          height;
+};
+
+
+
+typedef int (*skiplist_cmp_func)(const struct skiplist_node *node, const void *key);
+
+
+
+struct skiplist_t
+{
+    struct dlist_head     head;                          // level 0
+    struct skiplist_link  links[SKIPLIST_MAX_LEVEL - 1]; // levels 1 .. level-1
+    unsigned int          level;                         // max height of the nodes (>= 1)
+    size_t                size;
+    uint64_t              seed;
+    skiplist_cmp_func     cmp_func;
+};
+
+
+
+
+
+/*
+ * skiplist_init - init the skip list.
+ *
+ * sl:       the skip list for work.
+ * cmp_func: compare function of the keys
+ * seed:     seed of the generator of the heights (0 - the default seed)
+ */
+static inline void skiplist_init(struct skiplist_t *sl, skiplist_cmp_func cmp_func, uint64_t seed)
+{
+    unsigned int i;
+
+
+    dlist_init_head(&sl->head);
+
+    for(i = 0; i < SKIPLIST_MAX_LEVEL - 1; i++)
+    {
+        sl->links[i].next = NULL;
+#if SKIPLIST_SPANS
+        sl->links[i].span = 0;
+#endif
+    }
+
+    sl->level    = 1;
+    sl->size     = 0;
+    sl->seed     = seed ? seed : 0x9E3779B97F4A7C15ull;
+    sl->cmp_func = cmp_func;
+}
+
+
+
+static inline size_t skiplist_size(const struct skiplist_t *sl)
+{
+    return sl->size;
+}
+
+
+
+static inline int skiplist_empty(const struct skiplist_t *sl)
+{
+    return sl->size == 0;
+}
+
+
+
+static inline struct skiplist_node* sys_skiplist_node(const struct skiplist_t *sl,
+                                                      const struct dlist_head *it)
+{
+    return it == &sl->head ? NULL : dlist_data(it, struct skiplist_node, list);
+}
+
+
+
+// ret the first node or NULL if the skip list is empty
+static inline struct skiplist_node* skiplist_first(const struct skiplist_t *sl)
+{
+    return sys_skiplist_node(sl, sl->head.next);
+}
+
+
+
+// ret the last node or NULL if the skip list is empty
+static inline struct skiplist_node* skiplist_last(const struct skiplist_t *sl)
+{
+    return sys_skiplist_node(sl, sl->head.prev);
+}
+
+
+
+// ret the next node in order or NULL if the node is the last
+static inline struct skiplist_node* skiplist_next(const struct skiplist_t *sl,
+                                                  const struct skiplist_node *node)
+{
+    return sys_skiplist_node(sl, node->list.next);
+}
+
+
+
+// ret the previous node in order or NULL if the node is the first
+static inline struct skiplist_node* skiplist_prev(const struct skiplist_t *sl,
+                                                  const struct skiplist_node *node)
+{
+    return sys_skiplist_node(sl, node->list.prev);
+}
+
+
+
+// the link of the level (>= 1) of the node (NULL - the head)
+static inline struct skiplist_link* sys_skiplist_link(struct skiplist_t *sl,
+                                                      struct skiplist_node *node,
+                                                      unsigned int level)
+{
+    return node ? &node->tower[level - 1] : &sl->links[level - 1];
+}
+
+
+
+// height of the new node: 1 + count of the pairs of zero bits (p = 1/4)
+static inline unsigned int sys_skiplist_height(struct skiplist_t *sl)
+{
+    uint64_t x = sl->seed;
+    unsigned int height = 1;
+
+
+    x ^= x >> 12;
+    x ^= x << 25;
+    x ^= x >> 27;
+    sl->seed = x;
+    x *= 0x2545F4914F6CDD1Dull;
+
+    while( height < SKIPLIST_MAX_LEVEL && (x & 3) == 0 )
+    {
+        height++;
+        x >>= 2;
+    }
+
+    return height;
+}
+
+
+
+/*
+ * sys_skiplist_find - Finds the position of the key: the last node of every
+ * level with the key < key (or <= key if after_equal).
+ *
+ * update: the nodes of the levels 1 .. level-1 (NULL - the head)
+ * rank:   the indexes + 1 of the nodes of update (0 - the head), can be NULL
+ * rank0:  the index + 1 of the ret node (if rank != NULL)
+ *
+ * ret: the dlist_head of level 0 after which the key is (can be the head)
+ */
+static inline struct dlist_head* sys_skiplist_find(struct skiplist_t *sl, const void *key,
+                                                   int after_equal,
+                                                   struct skiplist_node **update,
+                                                   size_t *rank, size_t *rank0)
+{
+    struct skiplist_node *node = NULL;
+    struct skiplist_node *stop = NULL;     // the node is after the key (is compared)
+    struct skiplist_link *link;
+    struct dlist_head *it;
+    size_t r = 0;
+    unsigned int level;
+    int cmp;
+
+
+    for(level = sl->level - 1; level > 0; level--)
+    {
+        link = sys_skiplist_link(sl, node, level);
+
+        while( link->next && link->next != stop &&
+               ((cmp = sl->cmp_func(link->next, key)) < 0 || (after_equal && cmp == 0)) )
+        {
+#if SKIPLIST_SPANS
+            r += link->span;
+#endif
+            node = link->next;
+            link = sys_skiplist_link(sl, node, level);
+        }
+
+        stop          = link->next;
+        update[level] = node;
+        if( rank )
+            rank[level] = r;
+    }
+
+
+    it = node ? &node->list : &sl->head;
+
+    while( it->next != &sl->head && (!stop || it->next != &stop->list) &&
+           ((cmp = sl->cmp_func(dlist_data(it->next, struct skiplist_node, list), key)) < 0 ||
+            (after_equal && cmp == 0)) )
+    {
+        it = it->next;
+        r++;
+    }
+
+    if( rank )
+        *rank0 = r;
+
+    return it;
+}
+
+
+
+/*
+ * skiplist_lower_bound - Returns the first node with the key >= key.
+ *
+ * sl:  the skip list for work.
+ * key: the key for cmp_func
+ *
+ * ret: NULL   //if all the keys are less than key
+ * ret: *node  //good job ret the node
+ */
+static inline struct skiplist_node* skiplist_lower_bound(struct skiplist_t *sl, const void *key)
+{
+    struct skiplist_node *update[SKIPLIST_MAX_LEVEL];
+
+    return sys_skiplist_node(sl, sys_skiplist_find(sl, key, 0, update, NULL, NULL)->next);
+}
+
+
+
+/*
+ * skiplist_lookup - Returns the node with the key (the first inserted
+ * of the equal keys, the others follow it: see skiplist_next).
+ *
+ * sl:  the skip list for work.
+ * key: the key for cmp_func
+ *
+ * ret: NULL   //if there is no node with the key
+ * ret: *node  //good job ret the node
+ */
+static inline struct skiplist_node* skiplist_lookup(struct skiplist_t *sl, const void *key)
+{
+    struct skiplist_node *node = skiplist_lower_bound(sl, key);
+
+    return node && sl->cmp_func(node, key) == 0 ? node : NULL;
+}
+
+
+
+/*
+ * skiplist_insert - Inserts the node with the key after the nodes
+ * with the equal keys.
+ *
+ * sl:   the skip list for work.
+ * node: the node for insert (not in a skip list)
+ * key:  the key of the node (for cmp_func)
+ *
+ * ret: -1    //if cant get memory for the tower of the node
+ * ret: 0     //good job
+ */
+static inline int skiplist_insert(struct skiplist_t *sl, struct skiplist_node *node,
+                                  const void *key)
+{
+    struct skiplist_node *update[SKIPLIST_MAX_LEVEL];
+    size_t rank[SKIPLIST_MAX_LEVEL], rank0;
+    struct skiplist_link *link;
+    struct dlist_head *prev;
+    unsigned int height, level;
+
+
+    height = sys_skiplist_height(sl);
+
+    node->tower  = NULL;
+    node->height = height;
+
+    if( height > 1 )
+    {
+        node->tower = malloc((height - 1) * sizeof(struct skiplist_link));
+        if( !node->tower )
+            return -1;
+    }
+
+
+    prev = sys_skiplist_find(sl, key, 1, update, rank, &rank0);
+
+    for(level = sl->level; level < height; level++)
+    {
+        update[level] = NULL;
+        rank[level]   = 0;
+#if SKIPLIST_SPANS
+        sl->links[level - 1].span = sl->size;
+#endif
+    }
+
+    if( height > sl->level )
+        sl->level = height;
+
+
+    for(level = 1; level < height; level++)
+    {
+        link = sys_skiplist_link(sl, update[level], level);
+
+        node->tower[level - 1].next = link->next;
+        link->next                  = node;
+#if SKIPLIST_SPANS
+        node->tower[level - 1].span = link->span - (rank0 - rank[level]);
+        link->span                  = rank0 - rank[level] + 1;
+#endif
+    }
+
+#if SKIPLIST_SPANS
+    for(; level < sl->level; level++)
+        sys_skiplist_link(sl, update[level], level)->span++;
+#else
+    (void)rank;
+#endif
+
+
+    dlist_push_front(&node->list, prev);
+    sl->size++;
+
+    return 0;
+}
+
+
+
+/*
+ * skiplist_erase - Removes the node from the skip list and frees its tower.
+ * The predecessors of the node with the equal keys are walked at level 0.
+ *
+ * sl:   the skip list for work.
+ * node: the node (in the skip list) for remove
+ * key:  the key of the node (for cmp_func)
+ */
+static inline void skiplist_erase(struct skiplist_t *sl, struct skiplist_node *node,
+                                  const void *key)
+{
+    struct skiplist_node *update[SKIPLIST_MAX_LEVEL];
+    struct skiplist_node *prev;
+    struct skiplist_link *link;
+    struct dlist_head *it;
+    unsigned int level;
+
+
+    it = sys_skiplist_find(sl, key, 0, update, NULL, NULL)->next;
+
+    // the equal keys before the node are its predecessors on their levels
+    for(; it != &node->list; it = it->next)
+    {
+        prev = dlist_data(it, struct skiplist_node, list);
+
+        for(level = 1; level < prev->height; level++)
+            update[level] = prev;
+    }
+
+
+    for(level = 1; level < sl->level; level++)
+    {
+        link = sys_skiplist_link(sl, update[level], level);
+
+        if( link->next == node )
+        {
+#if SKIPLIST_SPANS
+            link->span += node->tower[level - 1].span - 1;
+#endif
+            link->next  = node->tower[level - 1].next;
+        }
+#if SKIPLIST_SPANS
+        else
+        {
+            link->span--;
+        }
+#endif
+    }
+
+    while( sl->level > 1 && !sl->links[sl->level - 2].next )
+        sl->level--;
+
+
+    dlist_del(&node->list);
+    sl->size--;
+
+    free(node->tower);
+    node->tower  = NULL;
+    node->height = 1;
+}
+
+
+
+#if SKIPLIST_SPANS
+/*
+ * skiplist_at - Returns the node by the index in order (0 - the first).
+ *
+ * sl:    the skip list for work.
+ * index: the index of the node
+ *
+ * ret: NULL   //if index >= size
+ * ret: *node  //good job ret the node
+ */
+static inline struct skiplist_node* skiplist_at(struct skiplist_t *sl, size_t index)
+{
+    struct skiplist_node *node = NULL;
+    struct skiplist_link *link;
+    struct dlist_head *it;
+    size_t r = 0;
+    unsigned int level;
+
+
+    if( index >= sl->size )
+        return NULL;
+
+
+    index++;                        // the rank of the node (0 - the head)
+
+    for(level = sl->level - 1; level > 0; level--)
+    {
+        link = sys_skiplist_link(sl, node, level);
+
+        while( link->next && r + link->span <= index )
+        {
+            r   += link->span;
+            node = link->next;
+            link = sys_skiplist_link(sl, node, level);
+        }
+    }
+
+
+    for(it = node ? &node->list : &sl->head; r < index; r++)
+        it = it->next;
+
+    return dlist_data(it, struct skiplist_node, list);
+}
+#endif
+
+
+
+/*
+ * skiplist_clear - Removes all the nodes and frees their towers
+ * (the nodes are not freed).
+ *
+ * sl: the skip list for work.
+ */
+static inline void skiplist_clear(struct skiplist_t *sl)
+{
+    struct dlist_head *it, *tmp_it;
+    struct skiplist_node *node;
+    unsigned int i;
+
+
+    dlist_iter(it, tmp_it, &sl->head)
+    {
+        node = dlist_data(it, struct skiplist_node, list);
+        free(node->tower);
+        node->tower  = NULL;
+        node->height = 1;
+    }
+
+    dlist_init_head(&sl->head);
+
+    for(i = 0; i < SKIPLIST_MAX_LEVEL - 1; i++)
+        sl->links[i].next = NULL;
+
+    sl->level = 1;
+    sl->size  = 0;
+}
+
+
+
+/*
+ * skiplist_data - get the struct (data) for this node
+ *
+ * node:   the node.
+ * type:   the type of the struct of data this is embedded in.
+ * member: the name of the node(skiplist_node) within the struct of data.
+ */
+#define skiplist_data(node, type, member) \
+    (type *)( (const char *)node - offsetof(type, member) )
+
+
+
+
+
+/*
+ * skiplist_data_citer - constant iterate over a skip list of given type (data)
+ * in order (dlist_data_citer on level 0)
+ *
+ * it:     the &struct data to use as a loop cursor(iterator).
+ * sl:     the skip list.
+ * type:   the type of the struct of data this is embedded in.
+ * member: the name of the node(skiplist_node) within the struct of data.
+ *
+ * Note You do not have to change skip list in this cycle.
+ */
+#define skiplist_data_citer(it, sl, type, member) \
+    dlist_data_citer(it, &(sl)->head, type, member.list)
+
+
+
+/*
+ * skiplist_data_iter - iterate over a skip list of given type safe against erase
+ *
+ * it:     the &struct data to use as a loop cursor(iterator).
+ * sl:     the skip list.
+ * tmp_it: another &struct dlist_head to use as temporary cursor(iterator)
+ * type:   the type of the struct of data this is embedded in.
+ * member: the name of the node(skiplist_node) within the struct of data.
+ */
+#define skiplist_data_iter(it, sl, tmp_it, type, member) \
+    dlist_data_iter(it, &(sl)->head, tmp_it, type, member.list)
+
+
+
+
+
+#endif // SKIPLIST_H
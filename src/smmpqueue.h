@@ -0,0 +1,378 @@
+/*
+ * smmpqueue.h
+ *
+ *
+ * BSD 3-Clause License
+ *
+ * Copyright (c) 2017, Koynov Stas - skojnov@yandex.ru
+ *
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice, this
+ *    list of conditions and the following disclaimer.
+ *
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ *    this list of conditions and the following disclaimer in the documentation
+ *    and/or other materials provided with the distribution.
+ *
+ * 3. Neither the name of the copyright holder nor the names of its
+ *    contributors may be used to endorse or promote products derived from
+ *    this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+ * FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ * DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ * SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ * CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+ * OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+
+#ifndef SMMPQUEUE_H
+#define SMMPQUEUE_H
+
+#include <stddef.h>
+#include "spqueue.h"  // pqueue_cmp_func, PQUEUE_LEFT/RIGHT/PARENT
+
+
+
+
+
+/*
+ *  A double-ended priority queue is a container that provides constant time
+ *  lookup of the smallest and the largest element, at the expense of
+ *  logarithmic insertion and extraction of both.
+ *
+ *  smmpqueue_t - static min-max heap based on static array (the same layout
+ *  as spqueue_t). The levels of the tree are min levels (even: 0, 2, ...)
+ *  and max levels (odd): a node on a min level is less than or equal to all
+ *  its descendants, a node on a max level is greater than or equal to them.
+ *  So the min is the root and the max is one of its children.
+ *
+ *  cmp_func must be "less or equal" (<=): it is used for both ends
+ *  (cmp_func(a, b) - a goes to the min end before b).
+ *
+ *  Algorithmic complexity:
+ *
+ *  smmpqueue_size     -   O(1)
+ *  smmpqueue_min      -   O(1)
+ *  smmpqueue_max      -   O(1)
+ *  smmpqueue_pop_min  -   O(ln(n))
+ *  smmpqueue_pop_max  -   O(ln(n))
+ *  smmpqueue_push     -   O(ln(n))
+ *  smmpqueue_swap     -   O(1)
+ */
+
+
+
+
+
+struct smmpqueue_t
+{
+    void          **items;
+    size_t          size;
+    size_t          capacity;
+    pqueue_cmp_func cmp_func; // <= (see above)
+};
+
+
+
+#define DECLARE_SMMPQUEUE(name, capacity, cmp_func)   \
+    void* mmpqueue_ ## name ## _items[capacity];      \
+    struct smmpqueue_t name = { mmpqueue_ ## name ## _items, 0, capacity, cmp_func }
+
+
+
+
+
+static inline void smmpqueue_init(struct smmpqueue_t *pqueue, void **items,
+                                  size_t capacity, pqueue_cmp_func cmp_func)
+{
+    pqueue->items    = items;
+    pqueue->size     = 0;
+    pqueue->capacity = capacity;
+    pqueue->cmp_func = cmp_func;
+}
+
+
+
+static inline size_t smmpqueue_size(const struct smmpqueue_t *pqueue)
+{
+    return pqueue->size;
+}
+
+
+
+static inline int sys_smmpqueue_is_min_level(size_t i)
+{
+    int level = 0;
+
+    for(i += 1; i > 1; i >>= 1)
+        level++;
+
+    return !(level & 1);
+}
+
+
+
+static inline void sys_smmpqueue_swap(struct smmpqueue_t *pqueue, size_t i, size_t j)
+{
+    void* tmp        = pqueue->items[i];
+    pqueue->items[i] = pqueue->items[j];
+    pqueue->items[j] = tmp;
+}
+
+
+
+// a before b for the min (is_min) or for the max (!is_min) end, strict
+static inline int sys_smmpqueue_before(struct smmpqueue_t *pqueue, int is_min, size_t a, size_t b)
+{
+    if( is_min )
+        return !pqueue->cmp_func(pqueue->items[b], pqueue->items[a]);  // a < b
+
+    return !pqueue->cmp_func(pqueue->items[a], pqueue->items[b]);      // a > b
+}
+
+
+
+// move the item i up by the grandparents (on the levels of one kind)
+static inline void sys_smmpqueue_bubble_up(struct smmpqueue_t *pqueue, int is_min, size_t i)
+{
+    while( i > 2 )  // i has a grandparent
+    {
+        size_t grandparent = PQUEUE_PARENT(PQUEUE_PARENT(i));
+
+        if( !sys_smmpqueue_before(pqueue, is_min, i, grandparent) )
+            break;
+
+        sys_smmpqueue_swap(pqueue, i, grandparent);
+        i = grandparent;
+    }
+}
+
+
+
+static inline void sys_smmpqueue_push_up(struct smmpqueue_t *pqueue, size_t i)
+{
+    int    is_min;
+    size_t parent;
+
+
+    if( i == 0 )
+        return;
+
+
+    is_min = sys_smmpqueue_is_min_level(i);
+    parent = PQUEUE_PARENT(i);
+
+    if( sys_smmpqueue_before(pqueue, !is_min, i, parent) )
+    {
+        // the item belongs to the levels of the other kind
+        sys_smmpqueue_swap(pqueue, i, parent);
+        sys_smmpqueue_bubble_up(pqueue, !is_min, parent);
+    }
+    else
+    {
+        sys_smmpqueue_bubble_up(pqueue, is_min, i);
+    }
+}
+
+
+
+// x before y for the min (is_min) or for the max (!is_min) end, strict
+static inline int sys_smmpqueue_item_before(struct smmpqueue_t *pqueue, int is_min, void *x, void *y)
+{
+    if( is_min )
+        return !pqueue->cmp_func(y, x);  // x < y
+
+    return !pqueue->cmp_func(x, y);      // x > y
+}
+
+
+
+// move the item i down (to the min end if is_min, else to the max end)
+static inline void sys_smmpqueue_push_down(struct smmpqueue_t *pqueue, int is_min, size_t i)
+{
+    void *item = pqueue->items[i];  //moves down, the best descendants move up to the hole
+
+
+    while( PQUEUE_LEFT(i) < pqueue->size )
+    {
+        // m - the best of the children and the grandchildren
+        size_t m     = PQUEUE_LEFT(i);
+        size_t first = PQUEUE_LEFT(PQUEUE_LEFT(i));
+        size_t j;
+
+        if( (PQUEUE_RIGHT(i) < pqueue->size) &&
+            sys_smmpqueue_before(pqueue, is_min, PQUEUE_RIGHT(i), m) )
+            m = PQUEUE_RIGHT(i);
+
+        for(j = first; (j < first + 4) && (j < pqueue->size); j++)
+        {
+            if( sys_smmpqueue_before(pqueue, is_min, j, m) )
+                m = j;
+        }
+
+
+        if( !sys_smmpqueue_item_before(pqueue, is_min, pqueue->items[m], item) )
+            break;
+
+        pqueue->items[i] = pqueue->items[m];
+        i = m;
+
+        if( m < first )
+            break;  // m is a child: its subtree has no more levels of this kind
+
+
+        // m is a grandchild: the parent of m is on the levels of the other kind
+        if( sys_smmpqueue_item_before(pqueue, !is_min, item, pqueue->items[PQUEUE_PARENT(m)]) )
+        {
+            void *tmp                         = pqueue->items[PQUEUE_PARENT(m)];
+            pqueue->items[PQUEUE_PARENT(m)]   = item;
+            item                              = tmp;
+        }
+    }
+
+    pqueue->items[i] = item;
+}
+
+
+
+// index of the max item (size > 0)
+static inline size_t sys_smmpqueue_max_index(struct smmpqueue_t *pqueue)
+{
+    if( pqueue->size == 1 )
+        return 0;
+
+    if( (pqueue->size > 2) && pqueue->cmp_func(pqueue->items[1], pqueue->items[2]) )
+        return 2;
+
+    return 1;
+}
+
+
+
+// remove the item i (the min or the max)
+static inline void sys_smmpqueue_remove(struct smmpqueue_t *pqueue, int is_min, size_t i)
+{
+    pqueue->size--;
+    pqueue->items[i]            = pqueue->items[pqueue->size];
+    pqueue->items[pqueue->size] = NULL;  //clear old value if size == 0 min == NULL
+
+    if( i < pqueue->size )
+        sys_smmpqueue_push_down(pqueue, is_min, i);
+}
+
+
+
+/*
+ * smmpqueue_push - Pushes the given element item to the priority queue.
+ *
+ * pqueue: the priority queue for work.
+ *
+ * ret: -1    //if pqueue is full
+ * ret: 0     //good job. item was pushed to the priority queue.
+ */
+static inline int smmpqueue_push(struct smmpqueue_t *pqueue, void *item)
+{
+    if(pqueue->size >= pqueue->capacity)
+        return -1; //queue is full
+
+
+    pqueue->items[pqueue->size] = item;
+    sys_smmpqueue_push_up(pqueue, pqueue->size);
+    pqueue->size += 1;
+
+    return 0; //good job
+}
+
+
+
+/*
+ * smmpqueue_min - Returns reference to the smallest element in the priority queue.
+ * This element will be removed on a call to pop_min().
+ *
+ * pqueue: the priority queue for work.
+ *
+ * ret: NULL   //if pqueue is empty
+ * ret: *Item  //good job ret min item.
+ */
+static inline void* smmpqueue_min(struct smmpqueue_t *pqueue)
+{
+    return pqueue->size ? pqueue->items[0] : NULL;
+}
+
+
+
+/*
+ * smmpqueue_max - Returns reference to the largest element in the priority queue.
+ * This element will be removed on a call to pop_max().
+ *
+ * pqueue: the priority queue for work.
+ *
+ * ret: NULL   //if pqueue is empty
+ * ret: *Item  //good job ret max item.
+ */
+static inline void* smmpqueue_max(struct smmpqueue_t *pqueue)
+{
+    return pqueue->size ? pqueue->items[sys_smmpqueue_max_index(pqueue)] : NULL;
+}
+
+
+
+/*
+ * smmpqueue_pop_min - Removes the smallest element from the priority queue.
+ *
+ * pqueue: the priority queue for work.
+ */
+static inline void smmpqueue_pop_min(struct smmpqueue_t *pqueue)
+{
+    if(pqueue->size == 0)
+        return;
+
+
+    sys_smmpqueue_remove(pqueue, 1, 0);
+}
+
+
+
+/*
+ * smmpqueue_pop_max - Removes the largest element from the priority queue.
+ *
+ * pqueue: the priority queue for work.
+ */
+static inline void smmpqueue_pop_max(struct smmpqueue_t *pqueue)
+{
+    if(pqueue->size == 0)
+        return;
+
+
+    sys_smmpqueue_remove(pqueue, 0, sys_smmpqueue_max_index(pqueue));
+}
+
+
+
+/*
+ * smmpqueue_swap - Exchanges the contents of the containers pqueue1 and pqueue2
+ *
+ * pqueue1/2: the priority queues for work.
+ */
+static inline void smmpqueue_swap(struct smmpqueue_t *pqueue1, struct smmpqueue_t *pqueue2)
+{
+    struct smmpqueue_t tmp = *pqueue1;
+    *pqueue1               = *pqueue2;
+    *pqueue2               = tmp;
+}
+
+
+
+
+
+#endif // SMMPQUEUE_H
@@ -57,6 +57,17 @@
  *  spqueue_pop     -   O(ln(n))
  *  spqueue_push    -   O(ln(n))
  *  spqueue_swap    -   O(1)
+ *  spqueue_heapify   - O(n)
+ *  spqueue_make_heap - O(n)
+ *
+ *
+ *  d-ary variants (see DEFINE_SPQUEUE_DARY), d - arity of the heap:
+ *
+ *  prefix_top      -   O(1)
+ *  prefix_pop      -   O(d*log_d(n))
+ *  prefix_push     -   O(log_d(n))
+ *  prefix_heapify   -  O(n)
+ *  prefix_make_heap -  O(n)
  */
 
 
@@ -112,6 +123,8 @@ static inline void spqueue_item_swap(struct spqueue_t *pqueue, size_t i, size_t
 
 static inline void spqueue_sift_down(struct spqueue_t *pqueue, size_t i)
 {
+    void *item = pqueue->items[i];  //moves down, the children move up to the hole
+
 
     while(PQUEUE_LEFT(i) < pqueue->size)
     {
@@ -122,13 +135,15 @@ static inline void spqueue_sift_down(struct spqueue_t *pqueue, size_t i)
         if( (right < pqueue->size) && pqueue->cmp_func(pqueue->items[right], pqueue->items[left]) )
             j = right;
 
-        if( pqueue->cmp_func(pqueue->items[i], pqueue->items[j]) )
+        if( pqueue->cmp_func(item, pqueue->items[j]) )
             break;
 
-        spqueue_item_swap(pqueue, i, j);
+        pqueue->items[i] = pqueue->items[j];
 
         i = j;
     }
+
+    pqueue->items[i] = item;
 }
 
 
@@ -174,12 +189,12 @@ static inline int spqueue_push(struct spqueue_t *pqueue, void *item)
  *
  * pqueue: the priority queue for work.
  *
- * ret: NULL   //if pqueue is empty (see pop func (clear old val))
+ * ret: NULL   //if pqueue is empty
  * ret: *Item  //good job ret top item.
  */
 static inline void* spqueue_top(struct spqueue_t *pqueue)
 {
-    return pqueue->items[0];
+    return pqueue->size ? pqueue->items[0] : NULL;
 }
 
 
@@ -204,6 +219,49 @@ static inline void spqueue_pop(struct spqueue_t *pqueue)
 
 
 
+/*
+ * spqueue_heapify - Rebuilds the heap from the items[0 .. size-1] in any order
+ * (Floyd's bottom-up construction: sift_down of every internal node from the
+ * last to the root). It is O(n), n pushes are O(n*ln(n)).
+ *
+ * pqueue: the priority queue for work.
+ */
+static inline void spqueue_heapify(struct spqueue_t *pqueue)
+{
+    size_t i;
+
+
+    if(pqueue->size < 2)
+        return;
+
+
+    for(i = PQUEUE_PARENT(pqueue->size - 1) + 1; i > 0; i--)
+        spqueue_sift_down(pqueue, i - 1);
+}
+
+
+
+/*
+ * spqueue_make_heap - init the priority queue by the existing array of items
+ * (the array is adopted, not copied) and make the heap from them in O(n).
+ *
+ * pqueue:   the priority queue for work.
+ * items:    array of items (size <= capacity), it is the storage of the queue
+ * size:     count of items in the array
+ * capacity: capacity of the array
+ * cmp_func: compare function for work heap
+ */
+static inline void spqueue_make_heap(struct spqueue_t *pqueue, void **items, size_t size,
+                                     size_t capacity, pqueue_cmp_func cmp_func)
+{
+    spqueue_init(pqueue, items, capacity, cmp_func);
+
+    pqueue->size = size;
+    spqueue_heapify(pqueue);
+}
+
+
+
 /*
  * spqueue_swap - Exchanges the contents of the containers pqueue1 and pqueue2
  *
@@ -220,4 +278,145 @@ static inline void spqueue_swap(struct spqueue_t *pqueue1, struct spqueue_t *pqu
 
 
 
+/*
+ * DEFINE_SPQUEUE_DARY - generate a d-ary heap variant for spqueue_t
+ *
+ * spqueue_* is a binary heap: for 10^6 items it has 20 levels and sift_down
+ * gets a cache miss on every level. In a d-ary heap the children of the node i
+ * are d adjacent items (d*i+1 .. d*i+d), so the tree is log2(d) times lower
+ * and the children of a node sit on one or two cache lines
+ * (4-ary - 32 bytes, 8-ary - 64 bytes on 64-bit targets).
+ * pop makes more comparisons per level (d-1 instead of 1), push makes fewer.
+ *
+ * The generated functions work with struct spqueue_t (and DECLARE_SPQUEUE,
+ * spqueue_init, spqueue_swap) and have the same semantics as spqueue_*
+ * (push returns -1 if the queue is full, pop clears the old slot so top
+ * returns NULL for an empty queue).
+ * The layout of items is different, so do not mix prefix_* and spqueue_*
+ * calls for one queue.
+ *
+ * prefix: prefix for names of the generated functions
+ * arity:  count of children of each node (constant expression > 1)
+ *
+ * Generated functions:
+ *
+ *   void  prefix_sift_down(struct spqueue_t *pqueue, size_t i);
+ *   void  prefix_sift_up(struct spqueue_t *pqueue, size_t i);
+ *   int   prefix_push(struct spqueue_t *pqueue, void *item);
+ *   void* prefix_top(struct spqueue_t *pqueue);
+ *   void  prefix_pop(struct spqueue_t *pqueue);
+ *   void  prefix_heapify(struct spqueue_t *pqueue);
+ *   void  prefix_make_heap(struct spqueue_t *pqueue, void **items, size_t size,
+ *                          size_t capacity, pqueue_cmp_func cmp_func);
+ *
+ * spqueue4_* and spqueue8_* are already defined below.
+ */
+#define DEFINE_SPQUEUE_DARY(prefix, arity)                                                  \
+                                                                                            \
+static inline void prefix##_sift_down(struct spqueue_t *pqueue, size_t i)                   \
+{                                                                                           \
+    void *item = pqueue->items[i];                                                          \
+                                                                                            \
+    while( (arity)*i + 1 < pqueue->size )                                                   \
+    {                                                                                       \
+        size_t first = (arity)*i + 1;                                                       \
+        size_t last  = first + (arity);                                                     \
+        size_t j     = first;                                                               \
+                                                                                            \
+        if( last > pqueue->size )                                                           \
+            last = pqueue->size;                                                            \
+                                                                                            \
+        for(size_t c = first + 1; c < last; c++)                                            \
+        {                                                                                   \
+            if( pqueue->cmp_func(pqueue->items[c], pqueue->items[j]) )                      \
+                j = c;                                                                      \
+        }                                                                                   \
+                                                                                            \
+        if( pqueue->cmp_func(item, pqueue->items[j]) )                                      \
+            break;                                                                          \
+                                                                                            \
+        pqueue->items[i] = pqueue->items[j];                                                \
+        i = j;                                                                              \
+    }                                                                                       \
+                                                                                            \
+    pqueue->items[i] = item;                                                                \
+}                                                                                           \
+                                                                                            \
+static inline void prefix##_sift_up(struct spqueue_t *pqueue, size_t i)                     \
+{                                                                                           \
+    void *item = pqueue->items[i];                                                          \
+                                                                                            \
+    while( i > 0 )  /* i == 0 is root */                                                    \
+    {                                                                                       \
+        size_t parent = (i - 1) / (arity);                                                  \
+                                                                                            \
+        if( !pqueue->cmp_func(item, pqueue->items[parent]) )                                \
+            break;                                                                          \
+                                                                                            \
+        pqueue->items[i] = pqueue->items[parent];                                           \
+        i = parent;                                                                         \
+    }                                                                                       \
+                                                                                            \
+    pqueue->items[i] = item;                                                                \
+}                                                                                           \
+                                                                                            \
+static inline int prefix##_push(struct spqueue_t *pqueue, void *item)                       \
+{                                                                                           \
+    if(pqueue->size >= pqueue->capacity)                                                    \
+        return -1; /* queue is full */                                                      \
+                                                                                            \
+    pqueue->items[pqueue->size] = item;                                                     \
+    prefix##_sift_up(pqueue, pqueue->size);                                                 \
+    pqueue->size += 1;                                                                      \
+                                                                                            \
+    return 0;                                                                               \
+}                                                                                           \
+                                                                                            \
+static inline void* prefix##_top(struct spqueue_t *pqueue)                                  \
+{                                                                                           \
+    return pqueue->size ? pqueue->items[0] : NULL;                                          \
+}                                                                                           \
+                                                                                            \
+static inline void prefix##_pop(struct spqueue_t *pqueue)                                   \
+{                                                                                           \
+    if(pqueue->size == 0)                                                                   \
+        return;                                                                             \
+                                                                                            \
+    pqueue->size--;                                                                         \
+    pqueue->items[0]            = pqueue->items[pqueue->size];                              \
+    pqueue->items[pqueue->size] = NULL; /* if size == 0 top == NULL */                      \
+                                                                                            \
+    if(pqueue->size)                                                                        \
+        prefix##_sift_down(pqueue, 0);                                                      \
+}                                                                                           \
+                                                                                            \
+static inline void prefix##_heapify(struct spqueue_t *pqueue)                               \
+{                                                                                           \
+    size_t i;                                                                               \
+                                                                                            \
+    if(pqueue->size < 2)                                                                    \
+        return;                                                                             \
+                                                                                            \
+    for(i = (pqueue->size - 2) / (arity) + 1; i > 0; i--)                                   \
+        prefix##_sift_down(pqueue, i - 1);                                                  \
+}                                                                                           \
+                                                                                            \
+static inline void prefix##_make_heap(struct spqueue_t *pqueue, void **items, size_t size,  \
+                                      size_t capacity, pqueue_cmp_func cmp_func)            \
+{                                                                                           \
+    spqueue_init(pqueue, items, capacity, cmp_func);                                        \
+                                                                                            \
+    pqueue->size = size;                                                                    \
+    prefix##_heapify(pqueue);                                                               \
+}
+
+
+
+DEFINE_SPQUEUE_DARY(spqueue4, 4)
+DEFINE_SPQUEUE_DARY(spqueue8, 8)
+
+
+
+
+
 #endif // SPQUEUE_H
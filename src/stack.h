@@ -53,6 +53,7 @@
  *  Algorithmic complexity:
  *
  *  stack_size    -   O(1)
+ *  stack_empty   -   O(1)
  *  stack_top     -   O(1)
  *  stack_push    -   O(1)
  *  stack_pop     -   O(1)
@@ -85,6 +86,20 @@ static inline void stack_init(struct stack_t *stack)
 
 
 
+static inline size_t stack_size(const struct stack_t *stack)
+{
+    return stack->size;
+}
+
+
+
+static inline int stack_empty(const struct stack_t *stack)
+{
+    return stack->size == 0;
+}
+
+
+
 /*
  * stack_top - Returns pointer to the top element in the stack.
  * This is the most recently pushed element.
@@ -0,0 +1,491 @@
+/*
+ * tcpool.h
+ *
+ *
+ * BSD 3-Clause License
+ *
+ * Copyright (c) 2017, Koynov Stas - skojnov@yandex.ru
+ *
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice, this
+ *    list of conditions and the following disclaimer.
+ *
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ *    this list of conditions and the following disclaimer in the documentation
+ *    and/or other materials provided with the distribution.
+ *
+ * 3. Neither the name of the copyright holder nor the names of its
+ *    contributors may be used to endorse or promote products derived from
+ *    this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+ * FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ * DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ * SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ * CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+ * OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+
+
+
+#ifndef TCPOOL_H
+#define TCPOOL_H
+
+#include <stddef.h>
+#include <stdlib.h>
+#include <pthread.h>    //need -pthread (see tests/Makefile)
+#include "stack.h"
+#include "pool.h"
+
+
+
+
+
+/*
+ *  tcpool_t - thread-caching pool of the objects of the fixed size
+ *  (magazine allocator on pool_t).
+ *
+ *  Every thread has its own cache (tcpool_cache) with two magazines:
+ *  a magazine is a stack of up to mag_size free objects (stack_t on the
+ *  list_head in the memory of the free object). tcpool_alloc and
+ *  tcpool_release work only with the magazines of the cache of the thread:
+ *  no locks, no atomics, no shared cache lines.
+ *
+ *  The global depot (guarded by the mutex) keeps the full and the empty
+ *  magazines. When both magazines of the cache are empty (alloc) or full
+ *  (release), the cache exchanges one magazine with the depot: the whole
+ *  magazine (mag_size objects) is moved by one stack_push/stack_pop,
+ *  so the mutex is taken at most once per mag_size operations.
+ *  The depot fills the magazines from pool_t (the slabs) when it has
+ *  no full magazines. The objects released by one thread can be
+ *  allocated by the other thread via the depot (producer/consumer).
+ *
+ *  A cache must be used by one thread only (e.g. in the TLS or in the
+ *  context of the thread). tcpool_cache_free returns its objects to the
+ *  pool, it must be called before the end of the thread.
+ *
+ *
+ *  Algorithmic complexity:
+ *
+ *  tcpool_alloc        -   O(1) (+ the mutex and O(mag_size) once per mag_size allocs)
+ *  tcpool_release      -   O(1) (+ the mutex once per mag_size releases)
+ *  tcpool_cache_init   -   O(1)
+ *  tcpool_cache_free   -   O(mag_size)
+ *  tcpool_get_stats    -   O(1)
+ *  tcpool_free         -   O(slabs + magazines)
+ */
+
+
+
+
+
+#ifndef TCPOOL_MAG_SIZE
+#define TCPOOL_MAG_SIZE  64     // count of objects in the magazine if mag_size == 0
+#endif
+
+
+
+struct tcpool_mag
+{
+    struct list_head list;      // in the depot (full or empty magazines)
+    struct stack_t   objs;      // free objects
+};
+
+
+
+struct tcpool_t
+{
+    pthread_mutex_t  lock;      // guards all the fields below
+    struct pool_t    pool;
+    struct stack_t   full;      // full magazines (mag_size objects)
+    struct stack_t   empty;     // empty magazines
+    size_t           mag_size;
+    size_t           mags;      // count of allocated magazines
+    size_t           fills;     // count of magazines filled from the pool
+    size_t           gets;      // count of full magazines taken from the depot
+    size_t           puts;      // count of full magazines returned to the depot
+};
+
+
+
+// the cache of one thread
+struct tcpool_cache
+{
+    struct tcpool_t   *tcp;
+    struct tcpool_mag *loaded;  // alloc and release work with it
+    struct tcpool_mag *prev;    // full or empty (for the swap with loaded)
+    size_t             allocs;
+    size_t             releases;
+};
+
+
+
+struct tcpool_stats
+{
+    struct pool_stats pool;     // the slabs (pool.used counts the objects of the magazines too)
+    size_t mags;                // count of magazines
+    size_t depot_full;          // count of full magazines in the depot
+    size_t depot_empty;         // count of empty magazines in the depot
+    size_t fills;
+    size_t gets;
+    size_t puts;
+};
+
+
+
+
+
+/*
+ * tcpool_init - init the pool.
+ *
+ * tcp:       the pool for work.
+ * obj_size:  size of the object
+ * slab_objs: count of objects in a slab (0 - see pool_init)
+ * mag_size:  count of objects in a magazine (0 - TCPOOL_MAG_SIZE)
+ *
+ * ret: -1    //if the size is invalid or the mutex is not init
+ * ret: 0     //good job. the pool was init.
+ */
+static inline int tcpool_init(struct tcpool_t *tcp, size_t obj_size, size_t slab_objs,
+                              size_t mag_size)
+{
+    if( pool_init(&tcp->pool, obj_size, slab_objs) )
+        return -1;
+
+    if( pthread_mutex_init(&tcp->lock, NULL) )
+        return -1;
+
+
+    stack_init(&tcp->full);
+    stack_init(&tcp->empty);
+
+    tcp->mag_size = mag_size ? mag_size : TCPOOL_MAG_SIZE;
+    tcp->mags     = 0;
+    tcp->fills    = 0;
+    tcp->gets     = 0;
+    tcp->puts     = 0;
+
+    return 0;
+}
+
+
+
+static inline struct tcpool_mag* sys_tcpool_mag_data(struct list_head *node)
+{
+    return (struct tcpool_mag *)( (char *)node - offsetof(struct tcpool_mag, list) );
+}
+
+
+
+// take the empty magazine from the depot or allocate a new one (under lock)
+static inline struct tcpool_mag* sys_tcpool_get_empty(struct tcpool_t *tcp)
+{
+    struct tcpool_mag *mag;
+
+
+    if( !stack_empty(&tcp->empty) )
+    {
+        mag = sys_tcpool_mag_data(stack_top(&tcp->empty));
+        stack_pop(&tcp->empty);
+
+        return mag;
+    }
+
+
+    mag = malloc(sizeof(struct tcpool_mag));
+    if( mag )
+    {
+        stack_init(&mag->objs);
+        tcp->mags++;
+    }
+
+    return mag;
+}
+
+
+
+// return the objects of the magazine to the pool (under lock)
+static inline void sys_tcpool_drain(struct tcpool_t *tcp, struct tcpool_mag *mag)
+{
+    while( !stack_empty(&mag->objs) )
+    {
+        struct list_head *obj = stack_top(&mag->objs);
+
+        stack_pop(&mag->objs);
+        pool_release(&tcp->pool, obj);
+    }
+}
+
+
+
+/*
+ * tcpool_cache_init - init the cache of the thread.
+ *
+ * cache: the cache for work.
+ * tcp:   the pool (init)
+ *
+ * ret: -1    //if cant get memory
+ * ret: 0     //good job. the cache was init.
+ */
+static inline int tcpool_cache_init(struct tcpool_cache *cache, struct tcpool_t *tcp)
+{
+    pthread_mutex_lock(&tcp->lock);
+
+    cache->loaded = sys_tcpool_get_empty(tcp);
+    cache->prev   = cache->loaded ? sys_tcpool_get_empty(tcp) : NULL;
+
+    if( cache->loaded && !cache->prev )
+        stack_push(&cache->loaded->list, &tcp->empty);
+
+    pthread_mutex_unlock(&tcp->lock);
+
+
+    cache->tcp      = tcp;
+    cache->allocs   = 0;
+    cache->releases = 0;
+
+    return cache->prev ? 0 : -1;
+}
+
+
+
+/*
+ * tcpool_cache_free - Returns the magazines of the cache to the depot
+ * (the partial magazines are returned to the pool).
+ * tcpool_cache_init must be called to work with the cache again.
+ *
+ * cache: the cache for work.
+ */
+static inline void tcpool_cache_free(struct tcpool_cache *cache)
+{
+    struct tcpool_t *tcp = cache->tcp;
+    struct tcpool_mag *mags[2] = { cache->loaded, cache->prev };
+    int i;
+
+
+    pthread_mutex_lock(&tcp->lock);
+
+    for(i = 0; i < 2; i++)
+    {
+        if( stack_size(&mags[i]->objs) == tcp->mag_size )
+        {
+            stack_push(&mags[i]->list, &tcp->full);
+            tcp->puts++;
+            continue;
+        }
+
+        sys_tcpool_drain(tcp, mags[i]);
+        stack_push(&mags[i]->list, &tcp->empty);
+    }
+
+    pthread_mutex_unlock(&tcp->lock);
+
+
+    cache->loaded = NULL;
+    cache->prev   = NULL;
+}
+
+
+
+// loaded and prev are empty: exchange loaded for a full magazine of the depot
+static inline int sys_tcpool_refill(struct tcpool_cache *cache)
+{
+    struct tcpool_t *tcp = cache->tcp;
+    struct tcpool_mag *mag;
+    void *obj;
+
+
+    pthread_mutex_lock(&tcp->lock);
+
+    if( !stack_empty(&tcp->full) )
+    {
+        mag = sys_tcpool_mag_data(stack_top(&tcp->full));
+        stack_pop(&tcp->full);
+        tcp->gets++;
+
+        stack_push(&cache->loaded->list, &tcp->empty);
+        cache->loaded = mag;
+    }
+    else
+    {
+        // fill loaded from the slabs
+        while( stack_size(&cache->loaded->objs) < tcp->mag_size &&
+               (obj = pool_alloc(&tcp->pool)) )
+            stack_push((struct list_head *)obj, &cache->loaded->objs);
+
+        tcp->fills++;
+    }
+
+    pthread_mutex_unlock(&tcp->lock);
+
+
+    return stack_empty(&cache->loaded->objs) ? -1 : 0;
+}
+
+
+
+/*
+ * tcpool_alloc - Allocates the object from the cache of the thread.
+ * The memory of the object is not initialized.
+ *
+ * cache: the cache of the thread.
+ *
+ * ret: NULL  //if cant get memory
+ * ret: ptr   //good job ret the object
+ */
+static inline void* tcpool_alloc(struct tcpool_cache *cache)
+{
+    struct tcpool_mag *mag = cache->loaded;
+    struct list_head *obj;
+
+
+    if( stack_empty(&mag->objs) )
+    {
+        if( !stack_empty(&cache->prev->objs) )
+        {
+            cache->loaded = cache->prev;
+            cache->prev   = mag;
+        }
+        else if( sys_tcpool_refill(cache) )
+            return NULL;
+
+        mag = cache->loaded;
+    }
+
+
+    obj = stack_top(&mag->objs);
+    stack_pop(&mag->objs);
+    cache->allocs++;
+
+    return obj;
+}
+
+
+
+// loaded and prev are full: give prev to the depot, take the empty magazine
+static inline void sys_tcpool_unload(struct tcpool_cache *cache, void *obj)
+{
+    struct tcpool_t *tcp = cache->tcp;
+    struct tcpool_mag *mag;
+
+
+    pthread_mutex_lock(&tcp->lock);
+
+    mag = sys_tcpool_get_empty(tcp);
+    if( mag )
+    {
+        stack_push(&cache->prev->list, &tcp->full);
+        tcp->puts++;
+
+        cache->prev   = cache->loaded;
+        cache->loaded = mag;
+        stack_push((struct list_head *)obj, &mag->objs);
+    }
+    else
+        pool_release(&tcp->pool, obj);    // no memory for the magazine
+
+    pthread_mutex_unlock(&tcp->lock);
+}
+
+
+
+/*
+ * tcpool_release - Returns the object to the cache of the thread.
+ * The object can be allocated by any cache of the pool.
+ *
+ * cache: the cache of the thread.
+ * obj:   the object of the pool (allocated by tcpool_alloc)
+ */
+static inline void tcpool_release(struct tcpool_cache *cache, void *obj)
+{
+    struct tcpool_mag *mag = cache->loaded;
+    size_t mag_size        = cache->tcp->mag_size;
+
+
+    cache->releases++;
+
+    if( stack_size(&mag->objs) == mag_size )
+    {
+        if( stack_size(&cache->prev->objs) == mag_size )
+        {
+            sys_tcpool_unload(cache, obj);
+            return;
+        }
+
+        cache->loaded = cache->prev;
+        cache->prev   = mag;
+        mag           = cache->loaded;
+    }
+
+    stack_push((struct list_head *)obj, &mag->objs);
+}
+
+
+
+// count of objects in the magazines of the cache
+static inline size_t tcpool_cache_size(const struct tcpool_cache *cache)
+{
+    return stack_size(&cache->loaded->objs) + stack_size(&cache->prev->objs);
+}
+
+
+
+static inline void tcpool_get_stats(struct tcpool_t *tcp, struct tcpool_stats *stats)
+{
+    pthread_mutex_lock(&tcp->lock);
+
+    pool_get_stats(&tcp->pool, &stats->pool);
+
+    stats->mags        = tcp->mags;
+    stats->depot_full  = stack_size(&tcp->full);
+    stats->depot_empty = stack_size(&tcp->empty);
+    stats->fills       = tcp->fills;
+    stats->gets        = tcp->gets;
+    stats->puts        = tcp->puts;
+
+    pthread_mutex_unlock(&tcp->lock);
+}
+
+
+
+/*
+ * tcpool_free - Free the memory of the pool (the slabs and the magazines).
+ * All the caches must be freed before (tcpool_cache_free).
+ *
+ * tcp: the pool for work.
+ */
+static inline void tcpool_free(struct tcpool_t *tcp)
+{
+    struct stack_t *depots[2] = { &tcp->full, &tcp->empty };
+    struct list_head *node;
+    int i;
+
+
+    for(i = 0; i < 2; i++)
+        while( !stack_empty(depots[i]) )
+        {
+            node = stack_top(depots[i]);
+            stack_pop(depots[i]);
+            free(sys_tcpool_mag_data(node));
+        }
+
+    pool_free(&tcp->pool);
+    pthread_mutex_destroy(&tcp->lock);
+
+    tcp->mags = 0;
+}
+
+
+
+
+
+#endif // TCPOOL_H
@@ -0,0 +1,874 @@
+/*
+ * tlist.h
+ *
+ *
+ * BSD 3-Clause License
+ *
+ * Copyright (c) 2017, Koynov Stas - skojnov@yandex.ru
+ *
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice, this
+ *    list of conditions and the following disclaimer.
+ *
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ *    this list of conditions and the following disclaimer in the documentation
+ *    and/or other materials provided with the distribution.
+ *
+ * 3. Neither the name of the copyright holder nor the names of its
+ *    contributors may be used to endorse or promote products derived from
+ *    this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+ * FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ * DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ * SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ * CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+ * OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+
+#ifndef TLIST_HEADER
+#define TLIST_HEADER
+
+#include "list.h"
+
+
+
+
+
+/*
+ * Circular linked list with a cached pointer to the last node.
+ *
+ * Definitions and designations:
+ *
+ *
+ *   next: -->
+ *   tail: ==>
+ *
+ *
+ *   empty list:                       tail == &head
+ *       ______
+ *      |      |
+ *   -->| head |---
+ *   |  |______|  |
+ *   |            |
+ *   |____________|
+ *
+ *
+ *
+ *   list with nodes:                  tail == &node1
+ *       ______     _______     _______
+ *      |      |   |       |   |       |
+ *   -->| head |-->| node0 |-->| node1 |---
+ *   |  |______|   |_______|   |_______|  |
+ *   |     ||                      /\     |
+ *   |     ||======================||     |
+ *   |____________________________________|
+ *
+ *
+ *
+ * The nodes are the same struct list_head as in list.h, so a Node
+ * costs one pointer. Only the head is bigger (head + tail), in exchange
+ * all operations on the back of the list (push_back, last, splice)
+ * do not walk the ring.
+ *
+ * All changes of the list must be done by tlist_* functions,
+ * they keep the tail in sync. Read-only functions of list.h
+ * can be used with &tlist->head.
+ *
+ *
+ *  Algorithmic complexity:
+ *
+ *  tlist_size            -     O(n)
+ *  tlist_empty           -     O(1)  use it for check
+ *  tlist_is_first        -     O(1)
+ *  tlist_is_last         -     O(1)
+ *  tlist_is_singular     -     O(1)
+ *  tlist_first           -     O(1)
+ *  tlist_last            -     O(1)
+ *  tlist_prev            -     O(n)
+ *
+ *  tlist_push_front      -     O(1)
+ *  tlist_pop_front       -     O(1)
+ *  tlist_push_back       -     O(1)
+ *  tlist_pop_back        -     O(n)
+ *  tlist_del             -     O(n)
+ *  tlist_replace         -     O(n)
+ *  tlist_replace_init    -     O(n)
+ *  tlist_move_to_front   -     O(n)
+ *  tlist_move_to_back    -     O(n)
+ *  tlist_rotate_left     -     O(1)
+ *  tlist_rotate_right    -     O(n)
+ *  tlist_splice_front    -     O(1)
+ *  tlist_splice_back     -     O(1)
+ *  tlist_reverse         -     O(n)
+ *  tlist_swap            -     O(1)
+ *
+ *  //Get Data from node
+ *  tlist_data            -     O(1)
+ *  tlist_first_data      -     O(1)
+ *  tlist_last_data       -     O(1)
+ *
+ *  //Iterator
+ *  tlist_citer           -     O(n)
+ *  tlist_iter            -     O(n)
+ *  tlist_data_citer      -     O(n)
+ *  tlist_data_iter       -     O(n)
+ *
+ *  //Algorithm
+ *  tlist_for_each        -     O(n)
+ *  tlist_min             -     O(n)
+ *  tlist_max             -     O(n)
+ *  tlist_minmax          -     O(n)
+ *  tlist_find            -     O(n)
+ *  tlist_find2           -     O(n)
+ *  tlist_sort            -     O(n*ln(n))
+ */
+
+
+
+
+
+struct tlist_head
+{
+    struct list_head  head;
+    struct list_head *tail;  // last node of the list or &head if list is empty
+};
+
+
+
+
+
+#define INIT_TLIST_HEAD(name) { { &(name.head) }, &(name.head) }
+
+#define DECLARE_TLIST_HEAD(name) \
+    struct tlist_head name = INIT_TLIST_HEAD(name)
+
+
+
+static inline void tlist_init_head(struct tlist_head *tlist)
+{
+    list_init_head(&tlist->head);
+    tlist->tail = &tlist->head;
+}
+
+
+
+/*
+ * tlist_empty - tests whether a list is empty
+ *
+ * tlist: the list to test.
+ *
+ * ret: true  //if the container size is 0
+ * ret: false //otherwise.
+ */
+static inline int tlist_empty(const struct tlist_head *tlist)
+{
+    return list_empty(&tlist->head);
+}
+
+
+
+/*
+ * tlist_is_first - tests whether node is the first node in list
+ *
+ * node:  the node to test
+ * tlist: the list
+ *
+ *  ret: true   // if [...] -> [head] -> [node] -> [...]
+ *  ret: false  // else
+ */
+static inline int tlist_is_first(const struct list_head  *node,
+                                 const struct tlist_head *tlist)
+{
+    return tlist->head.next == node;
+}
+
+
+
+/*
+ * tlist_is_last - tests whether node is the last node in list
+ *
+ * node:  the node to test
+ * tlist: the list
+ *
+ *  ret: true   // if [...] -> [node] -> [head] -> [...]
+ *  ret: false  // else
+ */
+static inline int tlist_is_last(const struct list_head  *node,
+                                const struct tlist_head *tlist)
+{
+    return tlist->tail == node;
+}
+
+
+
+/*
+ * tlist_is_singular - tests whether a list has just one node.
+ *
+ * tlist: the list to test.
+ *
+ * ret: true  //if the container size == 1
+ * ret: false //if the container size != 1
+ */
+static inline int tlist_is_singular(const struct tlist_head *tlist)
+{
+    return !tlist_empty(tlist) && (tlist->head.next == tlist->tail);
+}
+
+
+
+/*
+ * tlist_size - Returns the number of elements in the list container.
+ *
+ * tlist: the list to test.
+ * ret:   the number of elements in the list
+ */
+static inline size_t tlist_size(const struct tlist_head *tlist)
+{
+    return list_size(&tlist->head);
+}
+
+
+
+/*
+ * tlist_first - Returns the first node of the list.
+ *
+ * tlist: the list
+ * ret:   the first node of the list //if list dont empty
+ * ret:   &tlist->head               //if list empty
+ */
+static inline struct list_head *tlist_first(const struct tlist_head *tlist)
+{
+    return tlist->head.next;
+}
+
+
+
+/*
+ * tlist_last - Returns the last node of the list.
+ *
+ * tlist: the list
+ * ret:   the last node of the list //if list dont empty
+ * ret:   &tlist->head              //if list empty
+ */
+static inline struct list_head *tlist_last(const struct tlist_head *tlist)
+{
+    return tlist->tail;
+}
+
+
+
+/*
+ * tlist_prev - Returns the previous node of the node.
+ *
+ * node:  the node (or &tlist->head)
+ * tlist: the list that contains the node
+ *
+ * ret: the previous node of the node
+ */
+static inline struct list_head *tlist_prev(const struct list_head  *node,
+                                           const struct tlist_head *tlist)
+{
+    if( node == &tlist->head )
+        return tlist->tail;
+
+    return list_prev(node);
+}
+
+
+
+/*
+ * tlist_push_front - add a new node
+ *
+ * node:  new node to be added
+ * tlist: list to add it after head
+ *
+ * Inserts a new node at the beginning of the list,
+ * before its current first element.
+ *
+ * before:  [prev] -> [head] -> [next]
+ * after:   [prev] -> [head] -> [node] -> [next]
+ */
+static inline void tlist_push_front(struct list_head *node, struct tlist_head *tlist)
+{
+    if( tlist_empty(tlist) )
+        tlist->tail = node;
+
+    sys_list_add(node, &tlist->head);
+}
+
+
+
+/*
+ * tlist_push_back - add a new node
+ *
+ * node:  new node to be added
+ * tlist: list to add it before head
+ *
+ * Insert a new node at the end of the list,
+ * after its current last element.
+ *
+ * before:  [tail] -> [head] -> [next]
+ * after:   [tail] -> [node] -> [head] -> [next]
+ */
+static inline void tlist_push_back(struct list_head *node, struct tlist_head *tlist)
+{
+    sys_list_add(node, tlist->tail);
+    tlist->tail = node;
+}
+
+
+
+/*
+ * tlist_pop_front - Delete first element
+ *
+ * Removes the first element in the list container,
+ * effectively reducing its size by one.
+ *
+ * tlist: the list
+ *
+ * Note: list_empty() on first node return true after this
+ */
+static inline void tlist_pop_front(struct tlist_head *tlist)
+{
+    struct list_head *first_node = tlist->head.next;
+
+    if( first_node == tlist->tail )
+        tlist->tail = &tlist->head;
+
+    tlist->head.next = first_node->next;
+    list_init_head(first_node);
+}
+
+
+
+/*
+ * tlist_del - deletes node from list.
+ *
+ * node:  the element to delete from the list.
+ * tlist: the list that contains the node
+ *
+ * Note: list_empty() on node return true after this
+ *
+ * before:  [prev] -> [node] -> [next]
+ * after:   [prev] -> [next];              [node] -> self
+ */
+static inline void tlist_del(struct list_head *node, struct tlist_head *tlist)
+{
+    struct list_head *prev = list_prev(node);
+
+    if( node == tlist->tail )
+        tlist->tail = prev;
+
+    sys_list_del(prev, node->next);
+    list_init_head(node);
+}
+
+
+
+/*
+ * tlist_pop_back - Delete last element
+ *
+ * Removes the last element in the list container,
+ * effectively reducing its size by one.
+ *
+ * tlist: the list
+ *
+ * Note: list_empty() on last node return true after this
+ */
+static inline void tlist_pop_back(struct tlist_head *tlist)
+{
+    if( !tlist_empty(tlist) )
+        tlist_del(tlist->tail, tlist);
+}
+
+
+
+/*
+ * tlist_replace - replace old node by new node
+ *
+ * old_node: the element to be replaced
+ * new_node: the new element to insert
+ * tlist:    the list that contains the old_node
+ *
+ * If old_node was empty, it will be overwritten for _init variant
+ *
+ * Note: new_node should be free. out of the list.
+ */
+static inline void tlist_replace(struct list_head  *old_node,
+                                 struct list_head  *new_node,
+                                 struct tlist_head *tlist)
+{
+    if( old_node == tlist->tail )
+        tlist->tail = new_node;
+
+    list_replace(old_node, new_node);
+}
+
+static inline void tlist_replace_init(struct list_head  *old_node,
+                                      struct list_head  *new_node,
+                                      struct tlist_head *tlist)
+{
+    tlist_replace(old_node, new_node, tlist);
+    list_init_head(old_node);
+}
+
+
+
+/*
+ * tlist_move_to_front - move node to front
+ *
+ * node:  the node to move
+ * tlist: the list that contains our node
+ */
+static inline void tlist_move_to_front(struct list_head *node, struct tlist_head *tlist)
+{
+    tlist_del(node, tlist);
+    tlist_push_front(node, tlist);
+}
+
+
+
+/*
+ * tlist_move_to_back - move node to back
+ *
+ * node:  the node to move
+ * tlist: the list that contains our node
+ */
+static inline void tlist_move_to_back(struct list_head *node, struct tlist_head *tlist)
+{
+    if( node == tlist->head.next )
+        tlist_pop_front(tlist);        //O(1) for the first node
+    else
+        tlist_del(node, tlist);
+
+    tlist_push_back(node, tlist);
+}
+
+
+
+/*
+ * tlist_rotate_left - rotate the list to the left
+ *
+ * tlist: the list
+ *
+ * before:  [...] -> [nodeN] -> [head]  -> [node1] -> [node2]  -> [...]
+ * after:   [...] -> [nodeN] -> [node1] -> [head]  -> [node2]  -> [...]
+ */
+static inline void tlist_rotate_left(struct tlist_head *tlist)
+{
+    if( !tlist_empty(tlist) )
+        tlist_move_to_back(tlist->head.next, tlist);
+}
+
+
+
+/*
+ * tlist_rotate_right - rotate the list to the right
+ *
+ * tlist: the list
+ *
+ * before:  [...] -> [nodeN] -> [head]  -> [node1] -> [node2] -> [...]
+ * after:   [...] -> [head]  -> [nodeN] -> [node1] -> [node2] -> [...]
+ */
+static inline void tlist_rotate_right(struct tlist_head *tlist)
+{
+    if( !tlist_empty(tlist) )
+        tlist_move_to_front(tlist->tail, tlist);
+}
+
+
+
+/*
+ * Insert the nodes of src between two known consecutive nodes.
+ *
+ * This is only for internal list manipulation where we know
+ * the prev/next nodes already!
+ *
+ * before:  [prev] -> [next]
+ * after:   [prev] -> [src first] -> ... -> [src tail] -> [next]
+ */
+static inline void sys_tlist_splice(struct tlist_head *src,
+                                    struct list_head  *prev,
+                                    struct list_head  *next)
+{
+    prev->next      = src->head.next;
+    src->tail->next = next;
+}
+
+
+
+/*
+ * tlist_splice_front - transfers all the elements of src into the container(dest)
+ *                      this is designed for stacks
+ *
+ * dest: list to copy to  (copy to front)
+ * src:  list to copy from
+ */
+static inline void tlist_splice_front(struct tlist_head *src,
+                                      struct tlist_head *dest)
+{
+    if( !tlist_empty(src) )
+    {
+        if( tlist_empty(dest) )
+            dest->tail = src->tail;
+
+        sys_tlist_splice(src, &dest->head, dest->head.next);
+        tlist_init_head(src);
+    }
+}
+
+
+
+/*
+ * tlist_splice_back - transfers all the elements of src into the container(dest)
+ *                     this is designed for queue
+ *
+ * dest: list to copy to  (copy to back)
+ * src:  list to copy from
+ */
+static inline void tlist_splice_back(struct tlist_head *src,
+                                     struct tlist_head *dest)
+{
+    if( !tlist_empty(src) )
+    {
+        sys_tlist_splice(src, dest->tail, &dest->head);
+        dest->tail = src->tail;
+        tlist_init_head(src);
+    }
+}
+
+
+
+/*
+ * tlist_reverse - reverse the list
+ *
+ * tlist: the list
+ *
+ * before:  [...] -> [N] -> [head] -> [1] -> [2] -> [3] -> [...]
+ * after:   [...] -> [3] -> [2] -> [1] -> [head] -> [N] -> [...]
+ */
+static inline void tlist_reverse(struct tlist_head *tlist)
+{
+    struct list_head *first = tlist->head.next;
+
+    list_reverse(&tlist->head);
+
+    if( !tlist_empty(tlist) )
+        tlist->tail = first;
+}
+
+
+
+/*
+ * tlist_swap - Exchanges the contents of the containers.
+ * Does not invoke any move, copy, or swap operations on individual elements.
+ */
+static inline void tlist_swap(struct tlist_head *tlist1, struct tlist_head *tlist2)
+{
+    if(tlist1 == tlist2)
+        return;
+
+    DECLARE_TLIST_HEAD(tmp);
+
+    tlist_splice_front(tlist1, &tmp);
+    tlist_splice_front(tlist2, tlist1);
+    tlist_splice_front(&tmp, tlist2);
+}
+
+
+
+
+
+//---------------- Get Data from node ----------------
+
+
+
+
+
+/*
+ * tlist_data - get the struct (data) for this node
+ *
+ * node:   the node.
+ * type:   the type of the struct of data this is embedded in.
+ * member: the name of the node(list_head) within the struct of data.
+ */
+#define tlist_data(node, type, member) \
+    list_data(node, type, member)
+
+
+
+/*
+ * tlist_data_or_null - get the struct (data) for this node
+ *
+ * node:   the node.
+ * type:   the type of the struct of data this is embedded in.
+ * member: the name of the node(list_head) within the struct of data.
+ *
+ * Note it returns NULL if the node is empty (not in list).
+ */
+#define tlist_data_or_null(node, type, member) \
+    list_data_or_null(node, type, member)
+
+
+
+/*
+ * tlist_first_data - get the first struct (data) from a list
+ *
+ * tlist:  the list to take the element from.
+ * type:   the type of the struct of data this is embedded in.
+ * member: the name of the node(list_head) within the struct of data.
+ *
+ * Note - list don't have to  be empty.
+ */
+#define tlist_first_data(tlist, type, member) \
+    list_data((tlist)->head.next, type, member)
+
+
+
+/*
+ * tlist_last_data - get the last struct (data) from a list
+ *
+ * tlist:  the list to take the element from.
+ * type:   the type of the struct of data this is embedded in.
+ * member: the name of the node(list_head) within the struct of data.
+ *
+ * Note - list don't have to  be empty.
+ */
+#define tlist_last_data(tlist, type, member) \
+    list_data((tlist)->tail, type, member)
+
+
+
+/*
+ * tlist_first_data_or_null - get the first struct (data) from a list
+ *
+ * tlist:  the list to take the element from.
+ * type:   the type of the struct of data this is embedded in.
+ * member: the name of the node(list_head) within the struct of data.
+ *
+ * Note it returns NULL if the list is empty.
+ */
+#define tlist_first_data_or_null(tlist, type, member) \
+    (tlist_empty(tlist) ? NULL : tlist_first_data(tlist, type, member))
+
+
+
+/*
+ * tlist_last_data_or_null - get the last struct (data) from a list
+ *
+ * tlist:  the list to take the element from.
+ * type:   the type of the struct of data this is embedded in.
+ * member: the name of the node(list_head) within the struct of data.
+ *
+ * Note it returns NULL if the list is empty.
+ */
+#define tlist_last_data_or_null(tlist, type, member) \
+    (tlist_empty(tlist) ? NULL : tlist_last_data(tlist, type, member))
+
+
+
+
+
+//---------------- Iterator ----------------
+
+
+
+
+
+/*
+ * tlist_begin - Return begin iterator for list.
+ */
+static inline struct list_head* tlist_begin(struct tlist_head *tlist)
+{
+    return tlist->head.next;
+}
+
+
+
+/*
+ * tlist_end - Return end iterator for list.
+ */
+static inline struct list_head* tlist_end(struct tlist_head *tlist)
+{
+    return &tlist->head;
+}
+
+
+
+/*
+ * tlist_citer - constant iterate over a list
+ *
+ * it:    the &struct list_head to use as a loop cursor(iterator).
+ * tlist: the list for work.
+ *
+ * Note: You do not have to change list in this cycle.
+ */
+#define tlist_citer(it, tlist) \
+    list_citer(it, &(tlist)->head)
+
+
+
+/*
+ * tlist_iter - iterate over a list safe against removal of list node
+ *
+ * it:     the &struct list_head to use as a loop cursor(iterator).
+ * tmp_it: another &struct list_head to use as temporary cursor(iterator)
+ * tlist:  the list for work.
+ */
+#define tlist_iter(it, tmp_it, tlist) \
+    list_iter(it, tmp_it, &(tlist)->head)
+
+
+
+/*
+ * tlist_data_citer - constant iterate over list of given type (data)
+ *
+ * it:     the &struct data to use as a loop cursor(iterator).
+ * tlist:  the list for work.
+ * type:   the type of the struct of data this is embedded in.
+ * member: the name of the node(list_head) within the struct of data.
+ *
+ * Note You do not have to change list in this cycle.
+ */
+#define tlist_data_citer(it, tlist, type, member) \
+    list_data_citer(it, &(tlist)->head, type, member)
+
+
+
+/*
+ * tlist_data_iter - iterate over list of given type
+ *
+ * it:     the &struct data to use as a loop cursor(iterator).
+ * tlist:  the list for work.
+ * tmp_it: another &struct list_head to use as temporary cursor(iterator)
+ * type:   the type of the struct of data this is embedded in.
+ * member: the name of the node(list_head) within the struct of data.
+ */
+#define tlist_data_iter(it, tlist, tmp_it, type, member) \
+    list_data_iter(it, &(tlist)->head, tmp_it, type, member)
+
+
+
+
+
+//---------------- Algorithm ----------------
+
+
+
+
+
+/*
+ * tlist_for_each - Applies function fn to each of the elements in the range [first,last)
+ *
+ * first:  the &list_head to use as a first element
+ * last:   the &list_head to use as a last element.
+ * fn:     Unary function that accepts an element in the range as argument.
+ *
+ * see list_for_each
+ */
+static inline void tlist_for_each(struct list_head *first, struct list_head *last,
+                                  void (*fn) (struct list_head *node))
+{
+    list_for_each(first, last, fn);
+}
+
+
+
+/*
+ * tlist_min - Return smallest element in range [first,last)
+ *
+ * see list_min
+ */
+static inline struct list_head* tlist_min(struct list_head *first, struct list_head *last,
+                                          int (*comp) (const struct list_head *n1, const struct list_head *n2) )
+{
+    return list_min(first, last, comp);
+}
+
+
+
+/*
+ * tlist_max - Return largest element in range [first,last)
+ *
+ * see list_max
+ */
+static inline struct list_head* tlist_max(struct list_head *first, struct list_head *last,
+                                          int (*comp) (const struct list_head *n1, const struct list_head *n2) )
+{
+    return list_max(first, last, comp);
+}
+
+
+
+/*
+ * tlist_minmax - Return the smallest and largest element in the range [first, last).
+ *
+ * res:    res[0] - min
+ *         res[1] - max
+ *
+ * see list_minmax
+ */
+static inline void tlist_minmax(struct list_head *first, struct list_head *last,
+                                int (*comp) (const struct list_head *n1, const struct list_head *n2),
+                                struct list_head *res[2])
+{
+    list_minmax(first, last, comp, res);
+}
+
+
+
+/*
+ * tlist_find - Find element in range [first,last)
+ *
+ * see list_find
+ */
+static inline struct list_head* tlist_find(struct list_head *first, struct list_head *last,
+                                           int (*pred) (const struct list_head *node) )
+{
+    return list_find(first, last, pred);
+}
+
+
+
+/*
+ * tlist_find2 - Find element in range [first,last)
+ *
+ * see list_find2
+ */
+static inline struct list_head* tlist_find2(struct list_head *first, struct list_head *last,
+                                            int (*pred) (const struct list_head *node, void *data), void *data)
+{
+    return list_find2(first, last, pred, data);
+}
+
+
+
+/*
+ * tlist_sort - Sorts the elements of the list (stable)
+ *
+ * tlist: the list
+ * comp:  Binary function, returns true if the first argument is less than the second.
+ *
+ * see list_sort
+ */
+static inline void tlist_sort(struct tlist_head *tlist,
+                              int (*comp) (const struct list_head *n1, const struct list_head *n2) )
+{
+    tlist->tail = sys_list_sort(&tlist->head, comp);
+}
+
+
+
+
+
+#endif  //TLIST_HEADER
@@ -0,0 +1,478 @@
+/*
+ * twheel.h
+ *
+ *
+ * BSD 3-Clause License
+ *
+ * Copyright (c) 2017, Koynov Stas - skojnov@yandex.ru
+ *
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice, this
+ *    list of conditions and the following disclaimer.
+ *
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ *    this list of conditions and the following disclaimer in the documentation
+ *    and/or other materials provided with the distribution.
+ *
+ * 3. Neither the name of the copyright holder nor the names of its
+ *    contributors may be used to endorse or promote products derived from
+ *    this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+ * FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ * DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ * SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ * CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+ * OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+
+
+#ifndef TWHEEL_H
+#define TWHEEL_H
+
+#include <stddef.h>
+#include <stdint.h>
+#include "dqueue.h"
+
+
+
+
+
+/*
+ *  twheel_t - hierarchical timer wheel (timing wheel). A timer (twheel_timer)
+ *  is embedded in the struct of data like dlist_head, the wheel does not
+ *  allocate memory. The time is counted in ticks (uint64_t), the unit of
+ *  a tick is chosen by the caller.
+ *
+ *  The wheel has TWHEEL_LEVELS levels of 64 slots (dqueue_t), a slot of
+ *  level L covers 64^L ticks:
+ *
+ *  level 0   - the timers which expire in the next 64 ticks (one slot per tick)
+ *  level L   - the timers which expire in less than 64^(L+1) ticks
+ *
+ *  When the time reaches the slot of level L > 0, its timers are moved
+ *  (cascaded) to the lower levels. The slot of level 0 of the tick contains
+ *  only expired timers, it is spliced to the dqueue_t of the caller in O(1).
+ *  The timers after 64^TWHEEL_LEVELS - 1 ticks (2^36 by default) wait
+ *  on the last level and are cascaded again.
+ *
+ *  Cancel of a timer is O(1) (dqueue_del), so the timers which are mostly
+ *  cancelled before they expire (timeouts) cost only add + cancel.
+ *
+ *  The expired timers are in the dqueue_t of the caller after twheel_advance,
+ *  they are not pending (twheel_cancel does nothing for them), the caller
+ *  must remove a timer from this dqueue_t before it is added again.
+ *
+ *  TWHEEL_LEVELS (default 6) can be defined before the include.
+ *
+ *
+ *  Algorithmic complexity:
+ *
+ *  twheel_now         -   O(1)
+ *  twheel_size        -   O(1)
+ *  twheel_empty       -   O(1)
+ *  twheel_pending     -   O(1)
+ *  twheel_add         -   O(1)
+ *  twheel_cancel      -   O(1)
+ *  twheel_mod         -   O(1)
+ *  twheel_advance     -   O(e*L + k*L) amortized, e - count of ticks with expiry
+ *                         or cascade, k - count of timers, L - TWHEEL_LEVELS
+ *  twheel_tick        -   O(1) amortized
+ */
+
+
+
+
+
+#ifndef TWHEEL_LEVELS
+#define TWHEEL_LEVELS      6
+#endif
+
+#define TWHEEL_SLOT_BITS   6
+#define TWHEEL_SLOTS       (1 << TWHEEL_SLOT_BITS)
+#define TWHEEL_SLOT_MASK   (TWHEEL_SLOTS - 1)
+#define TWHEEL_MAX_DELTA   (((uint64_t)1 << (TWHEEL_LEVELS * TWHEEL_SLOT_BITS)) - 1)
+
+
+
+struct twheel_timer
+{
+    struct dlist_head list;
+    uint64_t          expires;  // the tick of expiry
+    struct dqueue_t  *slot;     // the slot of the wheel (NULL if not added)
+};
+
+
+
+struct twheel_t
+{
+    struct dqueue_t slots[TWHEEL_LEVELS][TWHEEL_SLOTS];
+    uint64_t        bitmap[TWHEEL_LEVELS];  // bit i - slot i of the level is not empty
+    uint64_t        now;                    // the last processed tick
+    size_t          size;
+};
+
+
+
+
+
+/*
+ * twheel_init - Initializes the empty wheel.
+ *
+ * tw:  the wheel for work.
+ * now: the current tick.
+ */
+static inline void twheel_init(struct twheel_t *tw, uint64_t now)
+{
+    size_t level, i;
+
+
+    for(level = 0; level < TWHEEL_LEVELS; level++)
+    {
+        for(i = 0; i < TWHEEL_SLOTS; i++)
+            dqueue_init(&tw->slots[level][i]);
+
+        tw->bitmap[level] = 0;
+    }
+
+    tw->now  = now;
+    tw->size = 0;
+}
+
+
+
+static inline void twheel_init_timer(struct twheel_timer *timer)
+{
+    dlist_init_head(&timer->list);
+    timer->expires = 0;
+    timer->slot    = NULL;
+}
+
+
+
+static inline uint64_t twheel_now(const struct twheel_t *tw)
+{
+    return tw->now;
+}
+
+
+
+static inline size_t twheel_size(const struct twheel_t *tw)
+{
+    return tw->size;
+}
+
+
+
+static inline int twheel_empty(const struct twheel_t *tw)
+{
+    return tw->size == 0;
+}
+
+
+
+/*
+ * twheel_pending - tests whether the timer is in the wheel (added and not
+ * expired or cancelled).
+ *
+ * tw:    the wheel.
+ * timer: the timer (initialized by twheel_init_timer)
+ */
+static inline int twheel_pending(const struct twheel_t *tw, const struct twheel_timer *timer)
+{
+    return timer->slot && timer->expires > tw->now;
+}
+
+
+
+// index of the lowest set bit (x != 0)
+static inline unsigned int sys_twheel_lsb(uint64_t x)
+{
+#if defined(__GNUC__)
+    return (unsigned int)__builtin_ctzll(x);
+#else
+    unsigned int i = 0;
+
+    while( !(x & 1) )
+    {
+        x >>= 1;
+        i++;
+    }
+
+    return i;
+#endif
+}
+
+
+
+static inline uint64_t sys_twheel_rotr(uint64_t x, unsigned int shift)
+{
+    return shift ? (x >> shift) | (x << (64 - shift)) : x;
+}
+
+
+
+// put the timer to the slot by its expiry (expires >= base), base - the next tick to process
+static inline void sys_twheel_place(struct twheel_t *tw, struct twheel_timer *timer,
+                                    uint64_t base)
+{
+    uint64_t expires = timer->expires;
+    uint64_t delta   = expires - base;
+    unsigned int level = 0, idx;
+
+
+    if( delta > TWHEEL_MAX_DELTA )
+    {
+        delta   = TWHEEL_MAX_DELTA;
+        expires = base + TWHEEL_MAX_DELTA;  // wait on the last level
+    }
+
+    while( delta >= TWHEEL_SLOTS )
+    {
+        delta >>= TWHEEL_SLOT_BITS;
+        level++;
+    }
+
+    idx         = (expires >> (level * TWHEEL_SLOT_BITS)) & TWHEEL_SLOT_MASK;
+    timer->slot = &tw->slots[level][idx];
+
+    dqueue_push_back(&timer->list, timer->slot);
+    tw->bitmap[level] |= (uint64_t)1 << idx;
+}
+
+
+
+// move the timers of the slot to the lower levels
+static inline void sys_twheel_cascade(struct twheel_t *tw, unsigned int level,
+                                      unsigned int idx, uint64_t base)
+{
+    struct dqueue_t tmp;
+    struct dlist_head *it, *tmp_it;
+
+
+    if( !(tw->bitmap[level] & ((uint64_t)1 << idx)) )
+        return;
+
+
+    // the timers of the last level can come back to the same slot
+    dqueue_init(&tmp);
+    dqueue_splice_back(&tw->slots[level][idx], &tmp);
+    tw->bitmap[level] &= ~((uint64_t)1 << idx);
+
+    dqueue_iter(it, tmp_it, &tmp)
+        sys_twheel_place(tw, dlist_data(it, struct twheel_timer, list), base);
+}
+
+
+
+// process the tick (> tw->now): cascade and move the expired timers to expired
+static inline void sys_twheel_tick(struct twheel_t *tw, uint64_t tick, struct dqueue_t *expired)
+{
+    unsigned int level, idx = tick & TWHEEL_SLOT_MASK;
+
+
+    if( !idx )
+    {
+        for(level = 1; level < TWHEEL_LEVELS; level++)
+        {
+            unsigned int cidx = (tick >> (level * TWHEEL_SLOT_BITS)) & TWHEEL_SLOT_MASK;
+
+            sys_twheel_cascade(tw, level, cidx, tick);
+
+            if( cidx )
+                break;
+        }
+    }
+
+
+    if( tw->bitmap[0] & ((uint64_t)1 << idx) )
+    {
+        tw->size -= tw->slots[0][idx].size;
+        dqueue_splice_back(&tw->slots[0][idx], expired);
+        tw->bitmap[0] &= ~((uint64_t)1 << idx);
+    }
+
+    tw->now = tick;
+}
+
+
+
+// the first tick (> tw->now) with the expiry of level 0 or the cascade
+// of a non-empty slot (the wheel is not empty)
+static inline uint64_t sys_twheel_next_event(const struct twheel_t *tw)
+{
+    uint64_t tick = tw->now + 1;
+    uint64_t best = UINT64_MAX, block, t;
+    unsigned int level, shift;
+
+
+    for(level = 0; level < TWHEEL_LEVELS; level++)
+    {
+        if( !tw->bitmap[level] )
+            continue;
+
+        // the first block of the level which starts at or after tick
+        shift = level * TWHEEL_SLOT_BITS;
+        block = (tick + (((uint64_t)1 << shift) - 1)) >> shift;
+        t     = block + sys_twheel_lsb(sys_twheel_rotr(tw->bitmap[level], block & TWHEEL_SLOT_MASK));
+        t   <<= shift;
+
+        if( t < best )
+            best = t;
+    }
+
+    return best;
+}
+
+
+
+/*
+ * twheel_add - Adds the timer to the wheel.
+ * The timer with expires <= twheel_now expires on the next tick
+ * (expires is set to twheel_now + 1).
+ *
+ * tw:      the wheel for work.
+ * timer:   the timer for add (not pending, not in a dqueue of expired timers)
+ * expires: the tick of expiry
+ *
+ * ret: -1  //if the timer is pending (use twheel_mod)
+ * ret:  0  //good job
+ */
+static inline int twheel_add(struct twheel_t *tw, struct twheel_timer *timer, uint64_t expires)
+{
+    if( twheel_pending(tw, timer) )
+        return -1;
+
+
+    timer->expires = (expires > tw->now) ? expires : tw->now + 1;
+    sys_twheel_place(tw, timer, tw->now + 1);
+    tw->size++;
+
+    return 0;
+}
+
+
+
+/*
+ * twheel_cancel - Removes the pending timer from the wheel.
+ *
+ * tw:    the wheel for work.
+ * timer: the timer for cancel
+ *
+ * ret: -1  //if the timer is not pending (expired or not added), nothing is done
+ * ret:  0  //good job
+ */
+static inline int twheel_cancel(struct twheel_t *tw, struct twheel_timer *timer)
+{
+    size_t n;
+
+
+    if( !twheel_pending(tw, timer) )
+        return -1;
+
+
+    dqueue_del(&timer->list, timer->slot);
+
+    if( dqueue_empty(timer->slot) )
+    {
+        n = (size_t)(timer->slot - &tw->slots[0][0]);
+        tw->bitmap[n / TWHEEL_SLOTS] &= ~((uint64_t)1 << (n % TWHEEL_SLOTS));
+    }
+
+    timer->slot = NULL;
+    tw->size--;
+
+    return 0;
+}
+
+
+
+/*
+ * twheel_mod - Changes the expiry of the timer (cancel if pending and add).
+ *
+ * tw:      the wheel for work.
+ * timer:   the timer (pending or not, not in a dqueue of expired timers)
+ * expires: the new tick of expiry
+ */
+static inline void twheel_mod(struct twheel_t *tw, struct twheel_timer *timer, uint64_t expires)
+{
+    twheel_cancel(tw, timer);
+    twheel_add(tw, timer, expires);
+}
+
+
+
+/*
+ * twheel_advance - Moves the time of the wheel to now, the expired timers
+ * (expires <= now) are moved to the back of expired (by slots, in bulk).
+ * The ticks without expiry and cascade are skipped (by the bitmaps).
+ *
+ * tw:      the wheel for work.
+ * now:     the new current tick (<= twheel_now does nothing)
+ * expired: the dqueue for the expired timers (nodes - twheel_timer.list)
+ *
+ * ret: the count of expired timers
+ */
+static inline size_t twheel_advance(struct twheel_t *tw, uint64_t now, struct dqueue_t *expired)
+{
+    size_t count = dqueue_size(expired);
+    uint64_t next;
+
+
+    while( tw->now < now )
+    {
+        next = tw->size ? sys_twheel_next_event(tw) : now + 1;
+
+        if( next > now )
+        {
+            tw->now = now;
+            break;
+        }
+
+        sys_twheel_tick(tw, next, expired);
+    }
+
+    return dqueue_size(expired) - count;
+}
+
+
+
+/*
+ * twheel_tick - Moves the time of the wheel by one tick (see twheel_advance).
+ *
+ * tw:      the wheel for work.
+ * expired: the dqueue for the expired timers
+ *
+ * ret: the count of expired timers
+ */
+static inline size_t twheel_tick(struct twheel_t *tw, struct dqueue_t *expired)
+{
+    return twheel_advance(tw, tw->now + 1, expired);
+}
+
+
+
+/*
+ * twheel_data - get the struct (data) for this timer
+ *
+ * timer:  the timer.
+ * type:   the type of the struct of data this is embedded in.
+ * member: the name of the timer(twheel_timer) within the struct of data.
+ */
+#define twheel_data(timer, type, member) \
+    (type *)( (const char *)timer - offsetof(type, member) )
+
+
+
+
+
+#endif // TWHEEL_H
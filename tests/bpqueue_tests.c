@@ -0,0 +1,218 @@
+#include "stest.h"
+#include "bpqueue.h"
+
+
+
+
+
+struct tmp_data
+{
+   int                 id;
+   struct bpqueue_node node;
+};
+
+
+
+static int pop_id(struct bpqueue_t *bpq)
+{
+    struct bpqueue_node *node = bpqueue_pop(bpq);
+    struct tmp_data *d;
+
+
+    if( !node )
+        return -1;
+
+    d = bpqueue_data(node, struct tmp_data, node);
+
+    return d->id;
+}
+
+
+
+// pop all and check the order (by prio, FIFO by id inside prio), ret count of nodes or -1
+static int pop_sorted(struct bpqueue_t *bpq)
+{
+    struct bpqueue_node *node;
+    struct tmp_data *d;
+    unsigned int prev_prio = 0;
+    int prev_id = -1;
+    int count   = 0;
+
+
+    while( !bpqueue_empty(bpq) )
+    {
+        node = bpqueue_peek(bpq);
+        d    = bpqueue_data(node, struct tmp_data, node);
+
+        if( bpqueue_pop(bpq) != node || node->prio < prev_prio )
+            return -1;
+
+        if( node->prio == prev_prio && d->id < prev_id )
+            return -1;
+
+        prev_prio = node->prio;
+        prev_id   = d->id;
+        count++;
+    }
+
+    return count;
+}
+
+
+
+
+
+TEST(test_bpqueue_init)
+{
+    struct bpqueue_t tmp_bpq;
+
+    bpqueue_init(&tmp_bpq);
+
+
+    TEST_ASSERT(bpqueue_empty(&tmp_bpq));
+    TEST_ASSERT(bpqueue_size(&tmp_bpq) == 0);
+    TEST_ASSERT(bpqueue_peek(&tmp_bpq) == NULL);
+    TEST_ASSERT(bpqueue_pop(&tmp_bpq) == NULL);  //pop from empty queue
+    TEST_ASSERT(bpqueue_size(&tmp_bpq) == 0);
+
+
+    TEST_PASS(NULL);
+}
+
+
+
+TEST(test_bpqueue_push_pop)
+{
+    const int SIZE = 1000;
+
+    struct bpqueue_t tmp_bpq;
+    struct tmp_data items[SIZE];
+
+    unsigned int seed = 1;
+
+    bpqueue_init(&tmp_bpq);
+
+
+    for(int i = 0; i < SIZE; i++)
+    {
+        seed = seed * 1103515245 + 12345;
+        items[i].id = i;
+        TEST_ASSERT(bpqueue_push(&tmp_bpq, &items[i].node, (seed >> 16) % BPQUEUE_PRIOS) == 0);
+    }
+
+    TEST_ASSERT(bpqueue_size(&tmp_bpq) == (size_t)SIZE);
+    TEST_ASSERT(pop_sorted(&tmp_bpq) == SIZE);
+    TEST_ASSERT(bpqueue_peek(&tmp_bpq) == NULL);
+
+
+    //invalid priority
+    TEST_ASSERT(bpqueue_push(&tmp_bpq, &items[0].node, BPQUEUE_PRIOS) == -1);
+    TEST_ASSERT(bpqueue_empty(&tmp_bpq));
+
+
+    //the bounds of the words of the bitmap, FIFO inside a priority
+    bpqueue_push(&tmp_bpq, &items[0].node, BPQUEUE_PRIOS - 1);
+    bpqueue_push(&tmp_bpq, &items[1].node, 64);
+    bpqueue_push(&tmp_bpq, &items[2].node, 63);
+    bpqueue_push(&tmp_bpq, &items[3].node, 64);
+    bpqueue_push(&tmp_bpq, &items[4].node, 0);
+
+    TEST_ASSERT(bpqueue_peek(&tmp_bpq) == &items[4].node);
+    TEST_ASSERT(pop_id(&tmp_bpq) == 4);
+    TEST_ASSERT(pop_id(&tmp_bpq) == 2);
+    TEST_ASSERT(pop_id(&tmp_bpq) == 1);
+    TEST_ASSERT(pop_id(&tmp_bpq) == 3);
+    TEST_ASSERT(pop_id(&tmp_bpq) == 0);
+    TEST_ASSERT(pop_id(&tmp_bpq) == -1);
+    TEST_ASSERT(bpqueue_size(&tmp_bpq) == 0);
+
+
+    TEST_PASS(NULL);
+}
+
+
+
+TEST(test_bpqueue_remove_requeue)
+{
+    const int SIZE = 500;
+
+    struct bpqueue_t tmp_bpq;
+    struct tmp_data items[SIZE];
+
+    unsigned int seed = 5;
+
+    bpqueue_init(&tmp_bpq);
+
+
+    for(int i = 0; i < SIZE; i++)
+    {
+        seed = seed * 1103515245 + 12345;
+        items[i].id = i;
+        bpqueue_push(&tmp_bpq, &items[i].node, (seed >> 16) % 100);
+    }
+
+    for(int i = 0; i < SIZE; i += 3)
+        bpqueue_remove(&tmp_bpq, &items[i].node);
+
+    TEST_ASSERT(bpqueue_size(&tmp_bpq) == (size_t)(SIZE - (SIZE + 2) / 3));
+
+
+    //requeue to the same or other priority: the node goes to the back
+    for(int i = 1; i < SIZE; i += 3)
+    {
+        seed = seed * 1103515245 + 12345;
+        TEST_ASSERT(bpqueue_requeue(&tmp_bpq, &items[i].node, BPQUEUE_PRIOS) == -1);
+        TEST_ASSERT(bpqueue_requeue(&tmp_bpq, &items[i].node, (seed >> 16) % 100) == 0);
+    }
+
+    TEST_ASSERT(bpqueue_size(&tmp_bpq) == (size_t)(SIZE - (SIZE + 2) / 3));
+
+    int count = 0;
+
+    while( !bpqueue_empty(&tmp_bpq) )
+    {
+        struct bpqueue_node *node = bpqueue_pop(&tmp_bpq);
+        struct tmp_data *d        = bpqueue_data(node, struct tmp_data, node);
+
+        TEST_ASSERT(d->id % 3 != 0);
+        count++;
+    }
+
+    TEST_ASSERT(count == SIZE - (SIZE + 2) / 3);
+
+
+    //round robin: requeue the top to its own priority
+    for(int i = 0; i < 3; i++)
+        bpqueue_push(&tmp_bpq, &items[i].node, 7);
+
+    bpqueue_requeue(&tmp_bpq, bpqueue_peek(&tmp_bpq), 7);
+    TEST_ASSERT(pop_id(&tmp_bpq) == 1);
+    TEST_ASSERT(pop_id(&tmp_bpq) == 2);
+    TEST_ASSERT(pop_id(&tmp_bpq) == 0);
+
+    //requeue the last node of a bucket clears the bucket
+    bpqueue_push(&tmp_bpq, &items[0].node, 3);
+    bpqueue_push(&tmp_bpq, &items[1].node, 5);
+    bpqueue_requeue(&tmp_bpq, &items[0].node, 9);
+    TEST_ASSERT(pop_id(&tmp_bpq) == 1);
+    TEST_ASSERT(pop_id(&tmp_bpq) == 0);
+    TEST_ASSERT(bpqueue_empty(&tmp_bpq));
+
+
+    TEST_PASS(NULL);
+}
+
+
+
+ptest_func tests[] =
+{
+    test_bpqueue_init,
+    test_bpqueue_push_pop,
+    test_bpqueue_remove_requeue,
+};
+
+
+
+
+
+MAIN_TESTS(tests)
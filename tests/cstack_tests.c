@@ -0,0 +1,218 @@
+#include <pthread.h>
+
+#include "stest.h"
+#include "cstack.h"
+
+
+
+
+
+struct tmp_data
+{
+   struct list_head list;
+   int              data;
+};
+
+
+
+#define DECLARE_TMP_DATA(name) \
+    struct tmp_data name = { {NULL}, 0}
+
+
+
+
+
+TEST(test_cstack_empty)
+{
+    DECLARE_CSTACK(tmp_stack);
+    DECLARE_TMP_DATA(d1);
+
+
+    TEST_ASSERT(cstack_empty(&tmp_stack));          //stack must be empty
+    TEST_ASSERT(cstack_pop(&tmp_stack) == NULL);
+
+
+    cstack_push(&d1.list, &tmp_stack);
+    TEST_ASSERT(!cstack_empty(&tmp_stack));         //now stack is NOT empty
+
+
+    cstack_init(&tmp_stack);
+    TEST_ASSERT(cstack_empty(&tmp_stack));
+
+
+    TEST_PASS(NULL);
+}
+
+
+
+TEST(test_cstack_push_pop)
+{
+    DECLARE_CSTACK(tmp_stack);
+
+    DECLARE_TMP_DATA(d1);
+    DECLARE_TMP_DATA(d2);
+    DECLARE_TMP_DATA(d3);
+
+
+
+    cstack_push(&d1.list, &tmp_stack);
+    cstack_push(&d2.list, &tmp_stack);
+    cstack_push(&d3.list, &tmp_stack);
+
+
+    TEST_ASSERT(cstack_pop(&tmp_stack) == &d3.list);  //LIFO
+    TEST_ASSERT(list_empty(&d3.list));                //poped node is empty
+
+    TEST_ASSERT(cstack_pop(&tmp_stack) == &d2.list);
+    TEST_ASSERT(list_empty(&d2.list));
+
+    TEST_ASSERT(cstack_pop(&tmp_stack) == &d1.list);
+    TEST_ASSERT(list_empty(&d1.list));
+
+    TEST_ASSERT(cstack_pop(&tmp_stack) == NULL);      //stack is empty
+    TEST_ASSERT(cstack_empty(&tmp_stack));
+
+
+    TEST_PASS(NULL);
+}
+
+
+
+TEST(test_cstack_pop_all)
+{
+    DECLARE_CSTACK(tmp_stack);
+    DECLARE_LIST_HEAD(tmp_list);
+
+    DECLARE_TMP_DATA(d0);
+    DECLARE_TMP_DATA(d1);
+    DECLARE_TMP_DATA(d2);
+    DECLARE_TMP_DATA(d3);
+
+
+
+    TEST_ASSERT(cstack_pop_all(&tmp_stack, &tmp_list) == 0);
+    TEST_ASSERT(list_empty(&tmp_list));
+
+
+    list_push_front(&d0.list, &tmp_list);   //list is not empty (d0)
+
+    cstack_push(&d1.list, &tmp_stack);
+    cstack_push(&d2.list, &tmp_stack);
+    cstack_push(&d3.list, &tmp_stack);
+
+
+    TEST_ASSERT(cstack_pop_all(&tmp_stack, &tmp_list) == 3);
+    TEST_ASSERT(cstack_empty(&tmp_stack));
+
+
+    //order of pops (d3, d2, d1) in the front of the list
+    TEST_ASSERT(list_size(&tmp_list) == 4);
+    TEST_ASSERT(tmp_list.next == &d3.list);
+    TEST_ASSERT(d3.list.next  == &d2.list);
+    TEST_ASSERT(d2.list.next  == &d1.list);
+    TEST_ASSERT(d1.list.next  == &d0.list);
+    TEST_ASSERT(d0.list.next  == &tmp_list);
+
+
+    TEST_PASS(NULL);
+}
+
+
+
+#define COUNT_THREADS      4
+#define NODES_PER_THREAD   64
+#define ROUNDS             20000
+
+
+
+struct thread_data
+{
+    struct cstack_t *stack;
+    struct tmp_data *nodes;
+    int              id;
+};
+
+
+
+//every thread pushes own nodes, and pops any nodes (of any thread) and pushes them back
+static void* thread_func(void *arg)
+{
+    struct thread_data *td = arg;
+    struct list_head   *node;
+    int i, j;
+
+
+    for(i = 0; i < NODES_PER_THREAD; i++)
+        cstack_push(&td->nodes[i].list, td->stack);
+
+
+    for(i = 0; i < ROUNDS; i++)
+    {
+        for(j = 0; j < 4; j++)
+        {
+            node = cstack_pop(td->stack);
+            if( node )
+                cstack_push(node, td->stack);
+        }
+    }
+
+    return NULL;
+}
+
+
+
+TEST(test_cstack_threads)
+{
+    DECLARE_CSTACK(tmp_stack);
+    DECLARE_LIST_HEAD(tmp_list);
+
+    static struct tmp_data nodes[COUNT_THREADS * NODES_PER_THREAD];
+    struct thread_data td[COUNT_THREADS];
+    pthread_t          threads[COUNT_THREADS];
+    struct tmp_data    *it;
+    int i, count[COUNT_THREADS * NODES_PER_THREAD] = {0};
+
+
+    for(i = 0; i < COUNT_THREADS * NODES_PER_THREAD; i++)
+        nodes[i].data = i;
+
+
+    for(i = 0; i < COUNT_THREADS; i++)
+    {
+        td[i].stack = &tmp_stack;
+        td[i].nodes = &nodes[i * NODES_PER_THREAD];
+        td[i].id    = i;
+
+        TEST_ASSERT(pthread_create(&threads[i], NULL, thread_func, &td[i]) == 0);
+    }
+
+    for(i = 0; i < COUNT_THREADS; i++)
+        pthread_join(threads[i], NULL);
+
+
+    //all nodes must be in the stack exactly one time
+    TEST_ASSERT(cstack_pop_all(&tmp_stack, &tmp_list) == COUNT_THREADS * NODES_PER_THREAD);
+
+    list_data_citer(it, &tmp_list, struct tmp_data, list)
+        count[it->data]++;
+
+    for(i = 0; i < COUNT_THREADS * NODES_PER_THREAD; i++)
+        TEST_ASSERT(count[i] == 1);
+
+
+    TEST_PASS(NULL);
+}
+
+
+
+ptest_func tests[] =
+{
+    test_cstack_empty,
+    test_cstack_push_pop,
+    test_cstack_pop_all,
+    test_cstack_threads,
+};
+
+
+
+MAIN_TESTS(tests)
@@ -564,6 +564,127 @@ TEST(test_list_splice_back)
 
 
 
+
+//the list must contain the data [expected, expected+size) with valid prev links
+static int is_list_equal(struct dlist_head *head, const int *expected, size_t size)
+{
+    struct dlist_head *it, *prev = head;
+    struct tmp_data   *d;
+    size_t count = 0;
+
+
+    dlist_citer(it, head)
+    {
+        if( (it->prev != prev) || (count >= size) )
+            return 0;
+
+        d = dlist_data(it, struct tmp_data, list);
+        if( d->data != expected[count] )
+            return 0;
+
+        prev = it;
+        count++;
+    }
+
+    return (head->prev == prev) && (count == size);
+}
+
+
+
+TEST(test_list_splice_range)
+{
+    DECLARE_DLIST_HEAD(list1);
+    DECLARE_DLIST_HEAD(list2);
+
+    const int COUNT_NODES = 10;
+    int i;
+    struct tmp_data  nodes[COUNT_NODES];
+
+    const int res1[] = {0, 1, 7, 8, 9};
+    const int res2[] = {2, 3, 4, 5, 6};
+    const int res3[] = {0, 1, 7, 8, 9, 2, 3, 4, 5, 6};
+    const int res4[] = {0, 1, 7, 8, 9, 4, 5, 6, 2, 3};
+
+
+    for(i=0; i < COUNT_NODES; i++)
+    {
+        nodes[i].data = i;
+        dlist_push_back(&nodes[i].list, &list1);
+    }
+
+
+    //empty range
+    dlist_splice_range(&nodes[3].list, &nodes[3].list, &list2);
+    TEST_ASSERT( dlist_empty(&list2) );
+    TEST_ASSERT( dlist_size(&list1) == COUNT_NODES );
+
+
+    //[2, 7) to the other (empty) list
+    dlist_splice_range(&nodes[2].list, &nodes[7].list, &list2);
+    TEST_ASSERT( is_list_equal(&list1, res1, 5) );
+    TEST_ASSERT( is_list_equal(&list2, res2, 5) );
+
+
+    //all nodes of list2 to the back of list1 (last == head)
+    dlist_splice_range(list2.next, &list2, &list1);
+    TEST_ASSERT( dlist_empty(&list2) );
+    TEST_ASSERT( is_list_equal(&list1, res3, 10) );
+
+
+    //in the same list: [2, 4) to the back
+    dlist_splice_range(&nodes[2].list, &nodes[4].list, &list1);
+    TEST_ASSERT( is_list_equal(&list1, res4, 10) );
+
+
+    //pos == last (nothing to do)
+    dlist_splice_range(&nodes[7].list, &nodes[4].list, &nodes[4].list);
+    TEST_ASSERT( is_list_equal(&list1, res4, 10) );
+
+
+    TEST_PASS(NULL);
+}
+
+
+
+TEST(test_list_cut_position)
+{
+    DECLARE_DLIST_HEAD(list1);
+    DECLARE_DLIST_HEAD(list2);
+
+    const int COUNT_NODES = 10;
+    int i;
+    struct tmp_data  nodes[COUNT_NODES];
+
+    const int res1[] = {4, 5, 6, 7, 8, 9};
+    const int res2[] = {0, 1, 2, 3};
+
+
+    for(i=0; i < COUNT_NODES; i++)
+    {
+        nodes[i].data = i;
+        dlist_push_back(&nodes[i].list, &list1);
+    }
+
+
+    dlist_cut_position(&list1, &list1, &list2);  //node == head (nothing to do)
+    TEST_ASSERT( dlist_empty(&list2) );
+    TEST_ASSERT( dlist_size(&list1) == COUNT_NODES );
+
+
+    dlist_cut_position(&nodes[3].list, &list1, &list2);
+    TEST_ASSERT( is_list_equal(&list1, res1, 6) );
+    TEST_ASSERT( is_list_equal(&list2, res2, 4) );
+
+
+    dlist_cut_position(list1.prev, &list1, &list2);  //all nodes
+    TEST_ASSERT( dlist_empty(&list1) );
+    TEST_ASSERT( dlist_size(&list2) == COUNT_NODES );
+
+
+    TEST_PASS(NULL);
+}
+
+
 TEST(test_list_reverse)
 {
     DECLARE_DLIST_HEAD(tmp_list);
@@ -1326,6 +1447,241 @@ TEST(test_list_find2)
 
 
 
+static size_t count_comp;
+
+int comp_less_key(const struct dlist_head *n1,const struct dlist_head *n2)
+{
+    struct tmp_data *d1 = dlist_data(n1, struct tmp_data, list);
+    struct tmp_data *d2 = dlist_data(n2, struct tmp_data, list);
+
+    count_comp++;
+
+    return (d1->data / 16) < (d2->data / 16);  //many equal keys
+}
+
+
+
+//check order, stability (equal keys in order of address), prev links and size
+static int is_sorted_list(struct dlist_head *head, size_t size)
+{
+    struct dlist_head *it, *prev = head;
+    struct tmp_data   *d1, *d2;
+    size_t count = 0;
+
+
+    dlist_citer(it, head)
+    {
+        if( it->prev != prev )
+            return 0;
+
+        if( prev != head )
+        {
+            d1 = dlist_data(prev, struct tmp_data, list);
+            d2 = dlist_data(it,   struct tmp_data, list);
+
+            if( d1->data / 16 > d2->data / 16 )
+                return 0;
+
+            if( (d1->data / 16 == d2->data / 16) && (d1 > d2) )
+                return 0;
+        }
+
+        prev = it;
+        count++;
+    }
+
+
+    return (head->prev == prev) && (count == size);
+}
+
+
+
+TEST(test_list_sort)
+{
+    DECLARE_DLIST_HEAD(tmp_list);
+
+    const int COUNT_NODES = 2000;
+    int i, k;
+    struct tmp_data  nodes[COUNT_NODES];
+
+
+    dlist_sort(&tmp_list, comp_less_key);        //empty list
+    TEST_ASSERT(dlist_empty(&tmp_list));
+
+
+    dlist_push_back(&nodes[0].list, &tmp_list);  //singular list
+    dlist_sort(&tmp_list, comp_less_key);
+    TEST_ASSERT(dlist_is_singular(&tmp_list));
+    TEST_ASSERT(tmp_list.prev == &nodes[0].list);
+
+
+    //patterns of data
+    for(k = 0; k < 6; k++)
+    {
+        dlist_init_head(&tmp_list);
+
+        for(i=0; i < COUNT_NODES; i++)
+        {
+            switch(k)
+            {
+                case 0:  nodes[i].data = (i * 7919) % COUNT_NODES;    break; //random
+                case 1:  nodes[i].data = i;                           break; //sorted
+                case 2:  nodes[i].data = COUNT_NODES - i;             break; //reversed
+                case 3:  nodes[i].data = i + ((i * 7919) % 64);       break; //almost sorted
+                case 4:  nodes[i].data = (i % 100) * 16 + i / 100;    break; //sorted runs
+                default: nodes[i].data = (i & 1) ? i : COUNT_NODES*2 + i; break; //two interleaved runs
+            }
+
+            dlist_push_back(&nodes[i].list, &tmp_list);
+        }
+
+
+        dlist_sort(&tmp_list, comp_less_key);
+
+        TEST_ASSERT(is_sorted_list(&tmp_list, COUNT_NODES));
+    }
+
+
+    TEST_PASS(NULL);
+}
+
+
+
+TEST(test_list_sort_adaptive)
+{
+    DECLARE_DLIST_HEAD(tmp_list);
+
+    const int COUNT_NODES = 2000;
+    int i;
+    struct tmp_data  nodes[COUNT_NODES];
+
+
+    //sorted list: one run, n-1 comparisons
+    for(i=0; i < COUNT_NODES; i++)
+    {
+        nodes[i].data = i;
+        dlist_push_back(&nodes[i].list, &tmp_list);
+    }
+
+    count_comp = 0;
+    dlist_sort(&tmp_list, comp_less_key);
+
+    TEST_ASSERT(count_comp == (size_t)COUNT_NODES - 1);
+    TEST_ASSERT(is_sorted_list(&tmp_list, COUNT_NODES));
+
+
+    //strictly descending list: one reversed run
+    dlist_init_head(&tmp_list);
+
+    for(i=0; i < COUNT_NODES; i++)
+    {
+        nodes[i].data = (COUNT_NODES - i) * 16;
+        dlist_push_back(&nodes[i].list, &tmp_list);
+    }
+
+    count_comp = 0;
+    dlist_sort(&tmp_list, comp_less_key);
+
+    TEST_ASSERT(count_comp == (size_t)COUNT_NODES - 1);
+    TEST_ASSERT(is_sorted_list(&tmp_list, COUNT_NODES));
+
+
+    //two sorted halves: the merge must gallop over the blocks
+    dlist_init_head(&tmp_list);
+
+    for(i=0; i < COUNT_NODES; i++)
+    {
+        nodes[i].data = (i < COUNT_NODES/2) ? (COUNT_NODES + i) * 16 : i * 16;
+        dlist_push_back(&nodes[i].list, &tmp_list);
+    }
+
+    count_comp = 0;
+    dlist_sort(&tmp_list, comp_less_key);
+
+    TEST_ASSERT(count_comp < (size_t)COUNT_NODES + 100);
+    TEST_ASSERT(is_sorted_list(&tmp_list, COUNT_NODES));
+
+
+    TEST_PASS(NULL);
+}
+
+
+DEFINE_DLIST_ALGOS(tmp, struct tmp_data, list, a->data < b->data,
+                 data ? a->data == *(int *)data : a->data == 50)
+
+
+
+TEST(test_list_algos)
+{
+    DECLARE_DLIST_HEAD(tmp_list);
+
+    const int COUNT_NODES = 100;
+    int i, key;
+    struct tmp_data  nodes[COUNT_NODES];
+    struct tmp_data  *it;
+    struct dlist_head *res[2], *res2[2];
+
+
+    TEST_ASSERT(tmp_min(tmp_list.next, &tmp_list) == &tmp_list);  //empty
+    TEST_ASSERT(tmp_max(tmp_list.next, &tmp_list) == &tmp_list);
+    TEST_ASSERT(tmp_find(tmp_list.next, &tmp_list) == &tmp_list);
+
+    tmp_minmax(tmp_list.next, &tmp_list, res);
+    TEST_ASSERT(res[0] == &tmp_list);
+    TEST_ASSERT(res[1] == &tmp_list);
+
+
+    for(i=0; i < COUNT_NODES; i++)
+    {
+        nodes[i].data = (i * 37) % COUNT_NODES;  //permutation of [0, COUNT_NODES)
+        dlist_push_back(&nodes[i].list, &tmp_list);
+    }
+
+
+    //must be the same as the algorithms with a pointer to function
+    TEST_ASSERT(tmp_min(tmp_list.next, &tmp_list) == dlist_min(tmp_list.next, &tmp_list, comp_less));
+    TEST_ASSERT(tmp_max(tmp_list.next, &tmp_list) == dlist_max(tmp_list.next, &tmp_list, comp_less));
+
+    tmp_minmax(tmp_list.next, &tmp_list, res);
+    dlist_minmax(tmp_list.next, &tmp_list, comp_less, res2);
+    TEST_ASSERT(res[0] == res2[0]);
+    TEST_ASSERT(res[1] == res2[1]);
+
+    it = dlist_data(res[0], struct tmp_data, list);
+    TEST_ASSERT(it->data == 0);
+    it = dlist_data(res[1], struct tmp_data, list);
+    TEST_ASSERT(it->data == COUNT_NODES-1);
+
+
+    TEST_ASSERT(tmp_find(tmp_list.next, &tmp_list) == dlist_find(tmp_list.next, &tmp_list, pred_50));
+    it = dlist_data(tmp_find(tmp_list.next, &tmp_list), struct tmp_data, list);
+    TEST_ASSERT(it->data == 50);
+
+    key = 7;
+    it = dlist_data(tmp_find2(tmp_list.next, &tmp_list, &key), struct tmp_data, list);
+    TEST_ASSERT(it->data == 7);
+
+    key = COUNT_NODES;
+    TEST_ASSERT(tmp_find2(tmp_list.next, &tmp_list, &key) == &tmp_list);
+
+
+    dlist_sort(&tmp_list, tmp_less);
+
+    i=0;
+    dlist_data_citer(it, &tmp_list, struct tmp_data, list)
+    {
+        TEST_ASSERT(it->data == i);
+        i++;
+    }
+
+    TEST_ASSERT(i == COUNT_NODES);
+
+
+    TEST_PASS(NULL);
+}
+
+
+
 ptest_func tests[] =
 {
     test_list_empty,
@@ -1343,6 +1699,8 @@ ptest_func tests[] =
     test_list_rotate_right,
     test_list_splice_front,
     test_list_splice_back,
+    test_list_splice_range,
+    test_list_cut_position,
     test_list_reverse,
     test_list_swap,
 
@@ -1369,6 +1727,9 @@ ptest_func tests[] =
     test_list_minmax,
     test_list_find,
     test_list_find2,
+    test_list_sort,
+    test_list_sort_adaptive,
+    test_list_algos,
 };
 
 
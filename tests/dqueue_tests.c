@@ -565,6 +565,134 @@ TEST(test_dqueue_splice_back)
 
 
 
+
+//the dqueue must contain the data [expected, expected+size) with valid prev links
+static int is_dqueue_equal(struct dqueue_t *dqueue, const int *expected, size_t size)
+{
+    dqueue_node     *it, *prev = &dqueue->head;
+    struct tmp_data *d;
+    size_t count = 0;
+
+
+    dqueue_citer(it, dqueue)
+    {
+        if( (it->prev != prev) || (count >= size) )
+            return 0;
+
+        d = dqueue_data(it, struct tmp_data, node);
+        if( d->data != expected[count] )
+            return 0;
+
+        prev = it;
+        count++;
+    }
+
+    return (dqueue->head.prev == prev) && (count == size) && (dqueue_size(dqueue) == size);
+}
+
+
+
+TEST(test_dqueue_splice_range)
+{
+    DECLARE_DQUEUE(dqueue1);
+    DECLARE_DQUEUE(dqueue2);
+
+    const int COUNT_NODES = 10;
+    int i;
+    struct tmp_data  nodes[COUNT_NODES];
+
+    const int res1[] = {0, 1, 7, 8, 9};
+    const int res2[] = {2, 3, 4, 5, 6};
+    const int res3[] = {2, 3, 4, 0, 1, 7, 8, 9};
+    const int res4[] = {5, 6};
+    const int res5[] = {0, 1, 7, 8, 2, 3, 4, 9};
+
+
+    for(i=0; i < COUNT_NODES; i++)
+    {
+        nodes[i].data = i;
+        dqueue_push_back(&nodes[i].node, &dqueue1);
+    }
+
+
+    //empty range
+    dqueue_splice_range(&nodes[3].node, &nodes[3].node, &dqueue1, dqueue_end(&dqueue2), &dqueue2);
+    TEST_ASSERT( dqueue_empty(&dqueue2) );
+    TEST_ASSERT( dqueue_size(&dqueue1) == COUNT_NODES );
+
+
+    //[2, 7) to the other (empty) dqueue
+    dqueue_splice_range(&nodes[2].node, &nodes[7].node, &dqueue1, dqueue_end(&dqueue2), &dqueue2);
+    TEST_ASSERT( is_dqueue_equal(&dqueue1, res1, 5) );
+    TEST_ASSERT( is_dqueue_equal(&dqueue2, res2, 5) );
+
+
+    //[2, 5) to the front of dqueue1 (known count)
+    dqueue_splice_range_n(&nodes[2].node, &nodes[5].node, 3, &dqueue2, dqueue_begin(&dqueue1), &dqueue1);
+    TEST_ASSERT( is_dqueue_equal(&dqueue1, res3, 8) );
+    TEST_ASSERT( is_dqueue_equal(&dqueue2, res4, 2) );
+
+
+    //in the same dqueue: [2, 0) before 9
+    dqueue_splice_range(&nodes[2].node, &nodes[0].node, &dqueue1, &nodes[9].node, &dqueue1);
+    TEST_ASSERT( is_dqueue_equal(&dqueue1, res5, 8) );
+
+
+    TEST_PASS(NULL);
+}
+
+
+
+TEST(test_dqueue_cut_position)
+{
+    DECLARE_DQUEUE(dqueue1);
+    DECLARE_DQUEUE(dqueue2);
+
+    const int COUNT_NODES = 10;
+    int i;
+    struct tmp_data  nodes[COUNT_NODES];
+
+    const int res1[] = {3, 4, 5, 6, 7, 8, 9};
+    const int res2[] = {0, 1, 2};
+    const int res3[] = {9};
+    const int res4[] = {0, 1, 2, 3, 4, 5, 6, 7, 8};
+
+
+    for(i=0; i < COUNT_NODES; i++)
+    {
+        nodes[i].data = i;
+        dqueue_push_back(&nodes[i].node, &dqueue1);
+    }
+
+
+    dqueue_cut_position(dqueue_end(&dqueue1), &dqueue1, &dqueue2);  //nothing to do
+    TEST_ASSERT( dqueue_empty(&dqueue2) );
+    TEST_ASSERT( dqueue_size(&dqueue1) == COUNT_NODES );
+
+
+    //k < n-k
+    dqueue_cut_position(&nodes[2].node, &dqueue1, &dqueue2);
+    TEST_ASSERT( is_dqueue_equal(&dqueue1, res1, 7) );
+    TEST_ASSERT( is_dqueue_equal(&dqueue2, res2, 3) );
+
+
+    //k > n-k
+    dqueue_cut_position(&nodes[8].node, &dqueue1, &dqueue2);
+    TEST_ASSERT( is_dqueue_equal(&dqueue1, res3, 1) );
+    TEST_ASSERT( is_dqueue_equal(&dqueue2, res4, 9) );
+
+
+    //all nodes
+    dqueue_cut_position(&nodes[9].node, &dqueue1, &dqueue2);
+    TEST_ASSERT( dqueue_empty(&dqueue1) );
+    TEST_ASSERT( dqueue_size(&dqueue1) == 0 );
+    TEST_ASSERT( dqueue_size(&dqueue2) == COUNT_NODES );
+
+
+    TEST_PASS(NULL);
+}
+
+
 TEST(test_dqueue_reverse)
 {
     DECLARE_DQUEUE(dqueue);
@@ -1333,6 +1461,127 @@ TEST(test_dqueue_find2)
 
 
 
+TEST(test_dqueue_sort)
+{
+    DECLARE_DQUEUE(dqueue);
+
+    const int COUNT_NODES = 1000;
+    int i;
+    struct tmp_data  nodes[COUNT_NODES];
+    dqueue_node *it, *prev;
+
+
+    dqueue_sort(&dqueue, comp_less);  //empty dqueue
+    TEST_ASSERT(dqueue_empty(&dqueue));
+
+
+    //almost sorted data
+    for(i=0; i < COUNT_NODES; i++)
+    {
+        nodes[i].data = i * 4 + (i * 7919) % 17;
+        dqueue_push_back(&nodes[i].node, &dqueue);
+    }
+
+
+    dqueue_sort(&dqueue, comp_less);
+
+    TEST_ASSERT(dqueue_size(&dqueue) == (size_t)COUNT_NODES);
+
+
+    prev = dqueue_end(&dqueue);
+    dqueue_citer(it, &dqueue)
+    {
+        TEST_ASSERT(it->prev == prev);
+
+        if( prev != dqueue_end(&dqueue) )
+            TEST_ASSERT(!comp_less(it, prev));
+
+        prev = it;
+    }
+
+    TEST_ASSERT(dqueue.head.prev == prev);
+
+
+    TEST_PASS(NULL);
+}
+
+
+DEFINE_DQUEUE_ALGOS(tmp, struct tmp_data, node, a->data < b->data,
+                 data ? a->data == *(int *)data : a->data == 50)
+
+
+
+TEST(test_dqueue_algos)
+{
+    DECLARE_DQUEUE(dqueue);
+
+    const int COUNT_NODES = 100;
+    int i, key;
+    struct tmp_data  nodes[COUNT_NODES];
+    struct tmp_data  *it;
+    dqueue_node *res[2], *res2[2];
+
+
+    TEST_ASSERT(tmp_min(dqueue_begin(&dqueue), dqueue_end(&dqueue)) == dqueue_end(&dqueue));  //empty
+    TEST_ASSERT(tmp_max(dqueue_begin(&dqueue), dqueue_end(&dqueue)) == dqueue_end(&dqueue));
+    TEST_ASSERT(tmp_find(dqueue_begin(&dqueue), dqueue_end(&dqueue)) == dqueue_end(&dqueue));
+
+    tmp_minmax(dqueue_begin(&dqueue), dqueue_end(&dqueue), res);
+    TEST_ASSERT(res[0] == dqueue_end(&dqueue));
+    TEST_ASSERT(res[1] == dqueue_end(&dqueue));
+
+
+    for(i=0; i < COUNT_NODES; i++)
+    {
+        nodes[i].data = (i * 37) % COUNT_NODES;  //permutation of [0, COUNT_NODES)
+        dqueue_push_back(&nodes[i].node, &dqueue);
+    }
+
+
+    //must be the same as the algorithms with a pointer to function
+    TEST_ASSERT(tmp_min(dqueue_begin(&dqueue), dqueue_end(&dqueue)) == dqueue_min(dqueue_begin(&dqueue), dqueue_end(&dqueue), comp_less));
+    TEST_ASSERT(tmp_max(dqueue_begin(&dqueue), dqueue_end(&dqueue)) == dqueue_max(dqueue_begin(&dqueue), dqueue_end(&dqueue), comp_less));
+
+    tmp_minmax(dqueue_begin(&dqueue), dqueue_end(&dqueue), res);
+    dqueue_minmax(dqueue_begin(&dqueue), dqueue_end(&dqueue), comp_less, res2);
+    TEST_ASSERT(res[0] == res2[0]);
+    TEST_ASSERT(res[1] == res2[1]);
+
+    it = dqueue_data(res[0], struct tmp_data, node);
+    TEST_ASSERT(it->data == 0);
+    it = dqueue_data(res[1], struct tmp_data, node);
+    TEST_ASSERT(it->data == COUNT_NODES-1);
+
+
+    TEST_ASSERT(tmp_find(dqueue_begin(&dqueue), dqueue_end(&dqueue)) == dqueue_find(dqueue_begin(&dqueue), dqueue_end(&dqueue), pred_50));
+    it = dqueue_data(tmp_find(dqueue_begin(&dqueue), dqueue_end(&dqueue)), struct tmp_data, node);
+    TEST_ASSERT(it->data == 50);
+
+    key = 7;
+    it = dqueue_data(tmp_find2(dqueue_begin(&dqueue), dqueue_end(&dqueue), &key), struct tmp_data, node);
+    TEST_ASSERT(it->data == 7);
+
+    key = COUNT_NODES;
+    TEST_ASSERT(tmp_find2(dqueue_begin(&dqueue), dqueue_end(&dqueue), &key) == dqueue_end(&dqueue));
+
+
+    dqueue_sort(&dqueue, tmp_less);
+
+    i=0;
+    dqueue_data_citer(it, &dqueue, struct tmp_data, node)
+    {
+        TEST_ASSERT(it->data == i);
+        i++;
+    }
+
+    TEST_ASSERT(i == COUNT_NODES);
+
+
+    TEST_PASS(NULL);
+}
+
+
+
 ptest_func tests[] =
 {
     test_dqueue_empty,
@@ -1350,6 +1599,8 @@ ptest_func tests[] =
     test_dqueue_rotate_right,
     test_dqueue_splice_front,
     test_dqueue_splice_back,
+    test_dqueue_splice_range,
+    test_dqueue_cut_position,
     test_dqueue_reverse,
     test_dqueue_swap,
 
@@ -1376,6 +1627,8 @@ ptest_func tests[] =
     test_dqueue_minmax,
     test_dqueue_find,
     test_dqueue_find2,
+    test_dqueue_sort,
+    test_dqueue_algos,
 };
 
 
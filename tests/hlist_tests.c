@@ -0,0 +1,239 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <stdint.h>
+
+
+
+#include "stest.h"
+#include "hlist.h"
+
+
+
+
+
+struct tmp_data
+{
+   struct hlist_node node;
+   int               data;
+};
+
+
+
+#define DECLARE_TMP_DATA(name, data) \
+    struct tmp_data name = { {NULL, NULL}, data }
+
+
+
+// check the links (pprev of every node) and the order of the data
+static int check_list(struct hlist_head *head, const int *data, int size)
+{
+    struct hlist_node **pprev = &head->first;
+    struct hlist_node *it;
+    struct tmp_data *d;
+    int i = 0;
+
+
+    hlist_citer(it, head)
+    {
+        d = hlist_data(it, struct tmp_data, node);
+
+        if( i >= size || it->pprev != pprev || d->data != data[i] )
+            return 0;
+
+        pprev = &it->next;
+        i++;
+    }
+
+    return i == size;
+}
+
+
+
+
+
+TEST(test_hlist_empty)
+{
+    DECLARE_HLIST_HEAD(tmp_list);
+    DECLARE_TMP_DATA(d1, 1);
+
+
+    TEST_ASSERT(hlist_empty(&tmp_list));
+    TEST_ASSERT(!hlist_is_singular(&tmp_list));
+    TEST_ASSERT(hlist_size(&tmp_list) == 0);
+    TEST_ASSERT(hlist_unhashed(&d1.node));
+
+    hlist_push_front(&d1.node, &tmp_list);
+
+    TEST_ASSERT(!hlist_empty(&tmp_list));
+    TEST_ASSERT(hlist_is_singular(&tmp_list));
+    TEST_ASSERT(!hlist_unhashed(&d1.node));
+    TEST_ASSERT(hlist_size(&tmp_list) == 1);
+
+
+    TEST_PASS(NULL);
+}
+
+
+
+TEST(test_hlist_push_del)
+{
+    DECLARE_HLIST_HEAD(tmp_list);
+    DECLARE_TMP_DATA(d1, 1);
+    DECLARE_TMP_DATA(d2, 2);
+    DECLARE_TMP_DATA(d3, 3);
+
+
+    hlist_push_front(&d3.node, &tmp_list);
+    hlist_push_front(&d2.node, &tmp_list);
+    hlist_push_front(&d1.node, &tmp_list);
+    TEST_ASSERT(check_list(&tmp_list, (int[]){1, 2, 3}, 3));
+    TEST_ASSERT(hlist_size(&tmp_list) == 3);
+
+    hlist_del(&d2.node);                    //middle
+    TEST_ASSERT(hlist_unhashed(&d2.node));
+    TEST_ASSERT(check_list(&tmp_list, (int[]){1, 3}, 2));
+
+    hlist_del(&d3.node);                    //last
+    TEST_ASSERT(check_list(&tmp_list, (int[]){1}, 1));
+
+    hlist_push_front(&d3.node, &tmp_list);
+    hlist_del(&d3.node);                    //first
+    TEST_ASSERT(check_list(&tmp_list, (int[]){1}, 1));
+
+    hlist_pop_front(&tmp_list);
+    TEST_ASSERT(hlist_empty(&tmp_list));
+    hlist_pop_front(&tmp_list);             //pop from empty list is no-op
+    TEST_ASSERT(hlist_empty(&tmp_list));
+
+
+    TEST_PASS(NULL);
+}
+
+
+
+TEST(test_hlist_insert)
+{
+    DECLARE_HLIST_HEAD(tmp_list);
+    DECLARE_TMP_DATA(d1, 1);
+    DECLARE_TMP_DATA(d2, 2);
+    DECLARE_TMP_DATA(d3, 3);
+    DECLARE_TMP_DATA(d4, 4);
+    DECLARE_TMP_DATA(d5, 5);
+
+
+    hlist_push_front(&d3.node, &tmp_list);
+    hlist_insert_before(&d1.node, &d3.node);    //before the first
+    hlist_insert_after(&d5.node, &d3.node);     //after the last
+    hlist_insert_before(&d2.node, &d3.node);
+    hlist_insert_after(&d4.node, &d3.node);
+
+    TEST_ASSERT(check_list(&tmp_list, (int[]){1, 2, 3, 4, 5}, 5));
+
+
+    TEST_PASS(NULL);
+}
+
+
+
+TEST(test_hlist_replace_move)
+{
+    DECLARE_HLIST_HEAD(tmp_list);
+    DECLARE_HLIST_HEAD(tmp_list2);
+    DECLARE_TMP_DATA(d1, 1);
+    DECLARE_TMP_DATA(d2, 2);
+    DECLARE_TMP_DATA(d3, 3);
+    DECLARE_TMP_DATA(d4, 4);
+
+
+    hlist_push_front(&d3.node, &tmp_list);
+    hlist_push_front(&d2.node, &tmp_list);
+    hlist_push_front(&d1.node, &tmp_list);
+
+    hlist_replace(&d2.node, &d4.node);
+    TEST_ASSERT(hlist_unhashed(&d2.node));
+    TEST_ASSERT(check_list(&tmp_list, (int[]){1, 4, 3}, 3));
+
+    hlist_replace(&d1.node, &d2.node);
+    hlist_replace(&d3.node, &d1.node);
+    TEST_ASSERT(check_list(&tmp_list, (int[]){2, 4, 1}, 3));
+
+
+    hlist_move(&tmp_list, &tmp_list2);
+    TEST_ASSERT(hlist_empty(&tmp_list));
+    TEST_ASSERT(check_list(&tmp_list2, (int[]){2, 4, 1}, 3));
+
+    hlist_move(&tmp_list, &tmp_list2);          //move of empty list
+    TEST_ASSERT(hlist_empty(&tmp_list2));
+
+
+    TEST_PASS(NULL);
+}
+
+
+
+TEST(test_hlist_iter)
+{
+    DECLARE_HLIST_HEAD(tmp_list);
+    struct tmp_data items[10];
+    struct hlist_node *it, *tmp_it;
+    struct tmp_data *d;
+    int sum = 0;
+
+
+    hlist_data_citer(d, &tmp_list, struct tmp_data, node)  //empty list
+        sum++;
+
+    TEST_ASSERT(sum == 0);
+
+
+    for(int i = 0; i < 10; i++)
+    {
+        items[i].data = i;
+        hlist_push_front(&items[i].node, &tmp_list);
+    }
+
+    hlist_data_citer(d, &tmp_list, struct tmp_data, node)
+        sum += d->data;
+
+    TEST_ASSERT(sum == 45);
+    TEST_ASSERT(hlist_first_data(&tmp_list, struct tmp_data, node) == &items[9]);
+
+
+    //remove the odd in the cycle
+    hlist_iter(it, tmp_it, &tmp_list)
+    {
+        d = hlist_data(it, struct tmp_data, node);
+
+        if( d->data & 1 )
+            hlist_del(it);
+    }
+
+    TEST_ASSERT(check_list(&tmp_list, (int[]){8, 6, 4, 2, 0}, 5));
+
+
+    //remove all in the cycle
+    hlist_data_iter(d, &tmp_list, it, struct tmp_data, node)
+        hlist_del(&d->node);
+
+    TEST_ASSERT(hlist_empty(&tmp_list));
+
+
+    TEST_PASS(NULL);
+}
+
+
+
+ptest_func tests[] =
+{
+    test_hlist_empty,
+    test_hlist_push_del,
+    test_hlist_insert,
+    test_hlist_replace_move,
+    test_hlist_iter,
+};
+
+
+
+
+
+MAIN_TESTS(tests)
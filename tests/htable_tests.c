@@ -0,0 +1,267 @@
+#include "stest.h"
+#include "htable.h"
+
+
+
+
+
+struct tmp_data
+{
+   int                key;
+   int                value;
+   struct htable_node node;
+};
+
+
+
+static int tmp_eq(const struct htable_node *node, const void *key)
+{
+    const struct tmp_data *d = htable_data(node, const struct tmp_data, node);
+
+    return d->key == *(const int *)key;
+}
+
+
+
+// bad hash (many collisions in the low bits) for the check of the chains
+static size_t tmp_hash(int key)
+{
+    return (size_t)key * 16;
+}
+
+
+
+static struct tmp_data* lookup_data(struct htable_t *ht, int key)
+{
+    struct htable_node *node = htable_lookup(ht, tmp_hash(key), &key);
+
+    return node ? htable_data(node, struct tmp_data, node) : NULL;
+}
+
+
+
+static int visited;
+
+static void count_node(struct htable_node *node)
+{
+    struct tmp_data *d = htable_data(node, struct tmp_data, node);
+
+    visited += d->key;
+}
+
+
+
+
+
+TEST(test_htable_init)
+{
+    struct htable_t tmp_ht;
+
+
+    TEST_ASSERT(htable_init(&tmp_ht, 0, tmp_eq) == 0);
+    TEST_ASSERT(htable_empty(&tmp_ht));
+    TEST_ASSERT(htable_size(&tmp_ht) == 0);
+    TEST_ASSERT(htable_buckets(&tmp_ht) == HTABLE_MIN_BUCKETS);
+    TEST_ASSERT(!htable_rehashing(&tmp_ht));
+    TEST_ASSERT(lookup_data(&tmp_ht, 1) == NULL);
+    htable_free(&tmp_ht);
+
+
+    TEST_ASSERT(htable_init(&tmp_ht, 100, tmp_eq) == 0);
+    TEST_ASSERT(htable_buckets(&tmp_ht) == 128);
+    htable_free(&tmp_ht);
+
+    TEST_ASSERT(htable_init(&tmp_ht, SIZE_MAX, tmp_eq) == -1);
+
+
+    TEST_PASS(NULL);
+}
+
+
+
+TEST(test_htable_insert_lookup_remove)
+{
+    const int SIZE = 1000;
+
+    struct htable_t tmp_ht;
+    struct tmp_data items[SIZE];
+
+
+    TEST_ASSERT(htable_init(&tmp_ht, 0, tmp_eq) == 0);
+
+    for(int i = 0; i < SIZE; i++)
+    {
+        items[i].key   = i;
+        items[i].value = i * 10;
+        htable_insert(&tmp_ht, &items[i].node, tmp_hash(i));
+    }
+
+    TEST_ASSERT(htable_size(&tmp_ht) == (size_t)SIZE);
+    TEST_ASSERT(htable_buckets(&tmp_ht) >= (size_t)SIZE / 2);
+
+
+    for(int i = 0; i < SIZE; i++)
+        TEST_ASSERT(lookup_data(&tmp_ht, i) == &items[i]);
+
+    TEST_ASSERT(lookup_data(&tmp_ht, SIZE) == NULL);
+    TEST_ASSERT(lookup_data(&tmp_ht, -1) == NULL);
+
+
+    for(int i = 0; i < SIZE; i += 2)
+        htable_remove(&tmp_ht, &items[i].node);
+
+    TEST_ASSERT(htable_size(&tmp_ht) == (size_t)SIZE / 2);
+
+    for(int i = 0; i < SIZE; i++)
+        TEST_ASSERT(lookup_data(&tmp_ht, i) == ((i & 1) ? &items[i] : NULL));
+
+
+    //duplicates: the last inserted is found first
+    struct tmp_data dup = { 1, -1, {{NULL, NULL}, 0} };
+
+    htable_insert(&tmp_ht, &dup.node, tmp_hash(1));
+    TEST_ASSERT(lookup_data(&tmp_ht, 1) == &dup);
+    htable_remove(&tmp_ht, &dup.node);
+    TEST_ASSERT(lookup_data(&tmp_ht, 1) == &items[1]);
+
+    htable_free(&tmp_ht);
+
+
+    TEST_PASS(NULL);
+}
+
+
+
+TEST(test_htable_incremental_rehash)
+{
+    const int SIZE = 4096;
+
+    struct htable_t tmp_ht;
+    struct tmp_data items[SIZE];
+    int in_table[SIZE];
+    int was_rehashing = 0;
+
+
+    TEST_ASSERT(htable_init(&tmp_ht, 0, tmp_eq) == 0);
+
+    //all the keys are found at every step of the grow
+    for(int i = 0; i < SIZE; i++)
+    {
+        items[i].key = i;
+        in_table[i]  = 1;
+        htable_insert(&tmp_ht, &items[i].node, tmp_hash(i));
+
+        if( htable_rehashing(&tmp_ht) )
+        {
+            was_rehashing = 1;
+
+            for(int j = 0; j <= i; j++)
+                TEST_ASSERT(lookup_data(&tmp_ht, j) == &items[j]);
+        }
+    }
+
+    TEST_ASSERT(was_rehashing);
+
+
+    //remove while rehash (the nodes of the old array)
+    TEST_ASSERT(htable_resize(&tmp_ht, 4 * SIZE) == 0);
+    TEST_ASSERT(htable_rehashing(&tmp_ht));
+    TEST_ASSERT(htable_buckets(&tmp_ht) == (size_t)4 * SIZE);
+
+    for(int i = SIZE - 1; i >= 0; i -= 3)
+    {
+        htable_remove(&tmp_ht, &items[i].node);
+        in_table[i] = 0;
+    }
+
+    for(int i = 0; i < SIZE; i++)
+        TEST_ASSERT(lookup_data(&tmp_ht, i) == (in_table[i] ? &items[i] : NULL));
+
+
+    //finish the rehash on demand
+    while( htable_rehash_step(&tmp_ht, 16) )
+        ;
+
+    TEST_ASSERT(!htable_rehashing(&tmp_ht));
+    TEST_ASSERT(htable_rehash_step(&tmp_ht, 16) == 0);
+
+    for(int i = 0; i < SIZE; i++)
+        TEST_ASSERT(lookup_data(&tmp_ht, i) == (in_table[i] ? &items[i] : NULL));
+
+    htable_free(&tmp_ht);
+
+
+    TEST_PASS(NULL);
+}
+
+
+
+TEST(test_htable_resize_for_each)
+{
+    const int SIZE = 500;
+
+    struct htable_t tmp_ht;
+    struct tmp_data items[SIZE];
+    int sum = 0;
+
+
+    TEST_ASSERT(htable_init(&tmp_ht, 2 * SIZE, tmp_eq) == 0);
+
+    for(int i = 0; i < SIZE; i++)
+    {
+        items[i].key = i;
+        sum += i;
+        htable_insert(&tmp_ht, &items[i].node, tmp_hash(i));
+    }
+
+    TEST_ASSERT(!htable_rehashing(&tmp_ht));
+    TEST_ASSERT(htable_buckets(&tmp_ht) == 1024);
+
+
+    //shrink: for_each visits the moved and not moved nodes
+    TEST_ASSERT(htable_resize(&tmp_ht, 16) == 0);
+    TEST_ASSERT(htable_buckets(&tmp_ht) == 16);
+    htable_rehash_step(&tmp_ht, 100);
+    TEST_ASSERT(htable_rehashing(&tmp_ht));
+
+    visited = 0;
+    htable_for_each(&tmp_ht, count_node);
+    TEST_ASSERT(visited == sum);
+
+    for(int i = 0; i < SIZE; i++)
+        TEST_ASSERT(lookup_data(&tmp_ht, i) == &items[i]);
+
+
+    //resize to the same count finishes the rehash only
+    TEST_ASSERT(htable_resize(&tmp_ht, 16) == 0);
+    TEST_ASSERT(!htable_rehashing(&tmp_ht));
+    TEST_ASSERT(htable_buckets(&tmp_ht) == 16);
+
+    visited = 0;
+    htable_for_each(&tmp_ht, count_node);
+    TEST_ASSERT(visited == sum);
+
+    TEST_ASSERT(htable_resize(&tmp_ht, SIZE_MAX) == -1);
+    TEST_ASSERT(htable_buckets(&tmp_ht) == 16);
+
+    htable_free(&tmp_ht);
+
+
+    TEST_PASS(NULL);
+}
+
+
+
+ptest_func tests[] =
+{
+    test_htable_init,
+    test_htable_insert_lookup_remove,
+    test_htable_incremental_rehash,
+    test_htable_resize_for_each,
+};
+
+
+
+
+
+MAIN_TESTS(tests)
@@ -0,0 +1,259 @@
+#include "stest.h"
+#include "idlist.h"
+
+
+
+
+
+struct tmp_data
+{
+   int                data;
+   struct idlist_node list;
+};
+
+
+
+#define SIZE  100
+
+static struct tmp_data nodes[SIZE];
+
+
+
+// check the indexes of the list in both directions
+static int check_list(const struct idlist_base *base, const struct idlist_head *head,
+                      const uint32_t *expect, size_t n)
+{
+    size_t i = 0;
+    uint32_t it;
+
+
+    idlist_citer(it, base, head)
+    {
+        if( i >= n || it != expect[i] )
+            return 0;
+
+        i++;
+    }
+
+    if( i != n )
+        return 0;
+
+
+    idlist_criter(it, base, head)
+    {
+        if( i == 0 || it != expect[i-1] )
+            return 0;
+
+        i--;
+    }
+
+    return i == 0 && idlist_size(base, head) == n;
+}
+
+
+
+static int pred_data(uint32_t idx, void *data)
+{
+    return nodes[idx].data == *(int *)data;
+}
+
+
+
+static void sum_data(uint32_t idx, void *data)
+{
+    *(int *)data += nodes[idx].data;
+}
+
+
+
+
+
+TEST(test_idlist_init)
+{
+    DECLARE_IDLIST_BASE(base, nodes, struct tmp_data, list);
+    DECLARE_IDLIST_HEAD(head);
+    struct idlist_base base2;
+
+
+    TEST_ASSERT(sizeof(struct idlist_node) == 8);
+    TEST_ASSERT(idlist_empty(&head));
+    TEST_ASSERT(!idlist_is_singular(&head));
+    TEST_ASSERT(idlist_size(&base, &head) == 0);
+    TEST_ASSERT(idlist_first(&head) == IDLIST_NIL && idlist_last(&head) == IDLIST_NIL);
+    TEST_ASSERT(idlist_pop_front(&base, &head) == IDLIST_NIL);
+    TEST_ASSERT(idlist_pop_back(&base, &head) == IDLIST_NIL);
+
+    idlist_init_base(&base2, nodes, sizeof(struct tmp_data), offsetof(struct tmp_data, list));
+    TEST_ASSERT(idlist_node(&base2, 7) == &nodes[7].list);
+    TEST_ASSERT(idlist_node(&base, 7) == &nodes[7].list);
+    TEST_ASSERT(idlist_data(&base, 7, struct tmp_data) == &nodes[7]);
+
+
+    TEST_PASS(NULL);
+}
+
+
+
+TEST(test_idlist_push_pop_del)
+{
+    DECLARE_IDLIST_BASE(base, nodes, struct tmp_data, list);
+    DECLARE_IDLIST_HEAD(head);
+    const uint32_t expect[]  = { 2, 1, 0, 3, 4 };
+    const uint32_t expect2[] = { 6, 1, 5, 3 };
+    const uint32_t expect3[] = { 3, 5, 6, 1 };
+
+
+    idlist_push_front(&base, 0, &head);
+    TEST_ASSERT(idlist_is_singular(&head));
+    idlist_push_front(&base, 1, &head);
+    idlist_push_front(&base, 2, &head);
+    idlist_push_back(&base, 3, &head);
+    idlist_push_back(&base, 4, &head);
+
+    TEST_ASSERT(check_list(&base, &head, expect, 5));
+    TEST_ASSERT(idlist_is_first(2, &head) && idlist_is_last(4, &head));
+    TEST_ASSERT(idlist_prev(&base, 2) == IDLIST_NIL && idlist_next(&base, 4) == IDLIST_NIL);
+
+
+    TEST_ASSERT(idlist_pop_back(&base, &head) == 4);
+    TEST_ASSERT(idlist_next(&base, 4) == 4 && idlist_prev(&base, 4) == 4);
+    idlist_del(&base, 0, &head);
+    idlist_insert_after(&base, 5, 1, &head);
+    idlist_del(&base, 2, &head);
+    idlist_insert_before(&base, 6, 1, &head);
+    TEST_ASSERT(check_list(&base, &head, expect2, 4));
+
+
+    idlist_move_to_back(&base, 6, &head, &head);
+    idlist_move_to_back(&base, 1, &head, &head);
+    idlist_move_to_front(&base, 3, &head, &head);
+    TEST_ASSERT(check_list(&base, &head, expect3, 4));
+
+    TEST_ASSERT(idlist_pop_front(&base, &head) == 3);
+    TEST_ASSERT(idlist_pop_back(&base, &head) == 1);
+    TEST_ASSERT(idlist_pop_front(&base, &head) == 5);
+    TEST_ASSERT(idlist_pop_back(&base, &head) == 6);
+    TEST_ASSERT(idlist_empty(&head) && idlist_last(&head) == IDLIST_NIL);
+
+
+    TEST_PASS(NULL);
+}
+
+
+
+TEST(test_idlist_splice_reverse)
+{
+    DECLARE_IDLIST_BASE(base, nodes, struct tmp_data, list);
+    DECLARE_IDLIST_HEAD(head1);
+    DECLARE_IDLIST_HEAD(head2);
+    uint32_t expect[SIZE];
+    uint32_t it, tmp_it;
+    uint32_t i;
+
+
+    for(i = 0; i < 10; i++)
+        idlist_push_back(&base, i, &head1);
+
+    for(i = 10; i < 20; i++)
+        idlist_push_back(&base, i, &head2);
+
+
+    idlist_splice_back(&base, &head2, &head1);
+    TEST_ASSERT(idlist_empty(&head2));
+
+    for(i = 0; i < 20; i++)
+        expect[i] = i;
+
+    TEST_ASSERT(check_list(&base, &head1, expect, 20));
+
+
+    idlist_reverse(&base, &head1);
+
+    for(i = 0; i < 20; i++)
+        expect[i] = 19 - i;
+
+    TEST_ASSERT(check_list(&base, &head1, expect, 20));
+
+
+    //move the even nodes to head2 (safe reverse iterator), splice them to the front
+    idlist_riter(it, tmp_it, &base, &head1)
+        if( it % 2 == 0 )
+            idlist_move_to_back(&base, it, &head1, &head2);
+
+    idlist_iter(it, tmp_it, &base, &head1)
+        if( it == 19 )
+            idlist_del(&base, it, &head1);
+
+    TEST_ASSERT(idlist_size(&base, &head1) == 9 && idlist_size(&base, &head2) == 10);
+
+    idlist_splice_front(&base, &head2, &head1);
+    TEST_ASSERT(idlist_empty(&head2));
+
+    for(i = 0; i < 10; i++)
+        expect[i] = 2 * i;
+
+    for(i = 0; i < 9; i++)
+        expect[10 + i] = 17 - 2 * i;
+
+    TEST_ASSERT(check_list(&base, &head1, expect, 19));
+
+
+    idlist_swap(&head1, &head2);
+    TEST_ASSERT(idlist_empty(&head1));
+    TEST_ASSERT(check_list(&base, &head2, expect, 19));
+
+    idlist_splice_front(&base, &head2, &head1);     //to empty list
+    TEST_ASSERT(check_list(&base, &head1, expect, 19));
+    idlist_splice_back(&base, &head2, &head1);      //from empty list
+    TEST_ASSERT(check_list(&base, &head1, expect, 19));
+
+
+    TEST_PASS(NULL);
+}
+
+
+
+TEST(test_idlist_algos)
+{
+    DECLARE_IDLIST_BASE(base, nodes, struct tmp_data, list);
+    DECLARE_IDLIST_HEAD(head);
+    int key, sum = 0;
+    uint32_t i;
+
+
+    for(i = 0; i < SIZE; i++)
+    {
+        nodes[i].data = (int)i * 3;
+        idlist_push_back(&base, i, &head);
+    }
+
+
+    idlist_for_each(&base, idlist_first(&head), IDLIST_NIL, sum_data, &sum);
+    TEST_ASSERT(sum == 3 * SIZE * (SIZE - 1) / 2);
+
+    key = 30;
+    TEST_ASSERT(idlist_find(&base, idlist_first(&head), IDLIST_NIL, pred_data, &key) == 10);
+    TEST_ASSERT(idlist_find(&base, idlist_first(&head), 5, pred_data, &key) == 5);
+
+    key = 31;
+    TEST_ASSERT(idlist_find(&base, idlist_first(&head), IDLIST_NIL, pred_data, &key) == IDLIST_NIL);
+
+
+    TEST_PASS(NULL);
+}
+
+
+
+ptest_func tests[] =
+{
+    test_idlist_init,
+    test_idlist_push_pop_del,
+    test_idlist_splice_reverse,
+    test_idlist_algos,
+};
+
+
+
+
+
+MAIN_TESTS(tests)
@@ -0,0 +1,240 @@
+#include "stest.h"
+#include "ilist.h"
+
+
+
+
+
+struct tmp_data
+{
+   int               data;
+   struct ilist_node list;
+};
+
+
+
+#define SIZE  100
+
+static struct tmp_data nodes[SIZE];
+
+
+
+// check the indexes of the list (ILIST_NIL-terminated array expect)
+static int check_list(const struct ilist_base *base, const struct ilist_head *head,
+                      const uint32_t *expect, size_t n)
+{
+    size_t i = 0;
+    uint32_t it;
+
+
+    ilist_citer(it, base, head)
+    {
+        if( i >= n || it != expect[i] )
+            return 0;
+
+        i++;
+    }
+
+    return i == n && ilist_size(base, head) == n;
+}
+
+
+
+static int pred_data(uint32_t idx, void *data)
+{
+    return nodes[idx].data == *(int *)data;
+}
+
+
+
+static void sum_data(uint32_t idx, void *data)
+{
+    *(int *)data += nodes[idx].data;
+}
+
+
+
+
+
+TEST(test_ilist_init)
+{
+    DECLARE_ILIST_BASE(base, nodes, struct tmp_data, list);
+    DECLARE_ILIST_HEAD(head);
+    struct ilist_base base2;
+
+
+    TEST_ASSERT(sizeof(struct ilist_node) == 4);
+    TEST_ASSERT(ilist_empty(&head));
+    TEST_ASSERT(ilist_size(&base, &head) == 0);
+    TEST_ASSERT(ilist_last(&base, &head) == ILIST_NIL);
+    TEST_ASSERT(ilist_pop_front(&base, &head) == ILIST_NIL);
+    TEST_ASSERT(ilist_pop_back(&base, &head) == ILIST_NIL);
+
+    ilist_init_base(&base2, nodes, sizeof(struct tmp_data), offsetof(struct tmp_data, list));
+    TEST_ASSERT(ilist_node(&base2, 7) == &nodes[7].list);
+    TEST_ASSERT(ilist_node(&base, 7) == &nodes[7].list);
+    TEST_ASSERT(ilist_data(&base, 7, struct tmp_data) == &nodes[7]);
+
+
+    TEST_PASS(NULL);
+}
+
+
+
+TEST(test_ilist_push_pop)
+{
+    DECLARE_ILIST_BASE(base, nodes, struct tmp_data, list);
+    DECLARE_ILIST_HEAD(head);
+    const uint32_t expect[] = { 2, 1, 0, 3, 4 };
+    const uint32_t expect2[] = { 2, 1, 5, 3 };
+
+
+    ilist_push_front(&base, 0, &head);
+    TEST_ASSERT(ilist_is_singular(&base, &head));
+    ilist_push_front(&base, 1, &head);
+    ilist_push_front(&base, 2, &head);
+    ilist_push_back(&base, 3, &head);
+    ilist_push_back(&base, 4, &head);
+
+    TEST_ASSERT(check_list(&base, &head, expect, 5));
+    TEST_ASSERT(ilist_first(&head) == 2 && ilist_is_first(2, &head));
+    TEST_ASSERT(ilist_last(&base, &head) == 4 && ilist_is_last(&base, 4));
+    TEST_ASSERT(!ilist_is_singular(&base, &head));
+
+
+    TEST_ASSERT(ilist_pop_back(&base, &head) == 4);
+    TEST_ASSERT(ilist_next(&base, 4) == 4);          //the deleted node is linked to self
+    ilist_del(&base, 0, &head);
+    TEST_ASSERT(ilist_next(&base, 0) == 0);
+    ilist_insert_after(&base, 5, 1);
+    TEST_ASSERT(check_list(&base, &head, expect2, 4));
+
+    TEST_ASSERT(ilist_pop_front(&base, &head) == 2);
+    TEST_ASSERT(ilist_pop_front(&base, &head) == 1);
+    TEST_ASSERT(ilist_pop_front(&base, &head) == 5);
+    TEST_ASSERT(ilist_pop_front(&base, &head) == 3);
+    TEST_ASSERT(ilist_empty(&head));
+
+
+    TEST_PASS(NULL);
+}
+
+
+
+TEST(test_ilist_splice_reverse)
+{
+    DECLARE_ILIST_BASE(base, nodes, struct tmp_data, list);
+    DECLARE_ILIST_HEAD(head1);
+    DECLARE_ILIST_HEAD(head2);
+    uint32_t expect[SIZE];
+    uint32_t it, tmp_it;
+    uint32_t i;
+
+
+    for(i = 0; i < 10; i++)
+        ilist_push_back(&base, i, &head1);
+
+    for(i = 10; i < 20; i++)
+        ilist_push_back(&base, i, &head2);
+
+
+    ilist_splice_back(&base, &head2, &head1);
+    TEST_ASSERT(ilist_empty(&head2));
+
+    for(i = 0; i < 20; i++)
+        expect[i] = i;
+
+    TEST_ASSERT(check_list(&base, &head1, expect, 20));
+
+
+    ilist_reverse(&base, &head1);
+
+    for(i = 0; i < 20; i++)
+        expect[i] = 19 - i;
+
+    TEST_ASSERT(check_list(&base, &head1, expect, 20));
+
+
+    //move the even nodes to head2 (safe iterator), splice them to the front
+    ilist_iter(it, tmp_it, &base, &head1)
+        if( it % 2 == 0 )
+        {
+            ilist_del(&base, it, &head1);
+            ilist_push_front(&base, it, &head2);
+        }
+
+    TEST_ASSERT(ilist_size(&base, &head1) == 10 && ilist_size(&base, &head2) == 10);
+
+    ilist_splice_front(&base, &head2, &head1);
+    TEST_ASSERT(ilist_empty(&head2));
+
+    for(i = 0; i < 10; i++)
+    {
+        expect[i]      = 2 * i;
+        expect[10 + i] = 19 - 2 * i;
+    }
+
+    TEST_ASSERT(check_list(&base, &head1, expect, 20));
+
+
+    ilist_swap(&head1, &head2);
+    TEST_ASSERT(ilist_empty(&head1));
+    TEST_ASSERT(check_list(&base, &head2, expect, 20));
+
+    ilist_splice_back(&base, &head2, &head1);       //to empty list
+    TEST_ASSERT(check_list(&base, &head1, expect, 20));
+    ilist_splice_front(&base, &head2, &head1);      //from empty list
+    TEST_ASSERT(check_list(&base, &head1, expect, 20));
+
+
+    TEST_PASS(NULL);
+}
+
+
+
+TEST(test_ilist_algos)
+{
+    DECLARE_ILIST_BASE(base, nodes, struct tmp_data, list);
+    DECLARE_ILIST_HEAD(head);
+    int key, sum = 0;
+    uint32_t i;
+
+
+    for(i = 0; i < SIZE; i++)
+    {
+        nodes[i].data = (int)i * 3;
+        ilist_push_front(&base, i, &head);
+    }
+
+
+    ilist_for_each(&base, ilist_first(&head), ILIST_NIL, sum_data, &sum);
+    TEST_ASSERT(sum == 3 * SIZE * (SIZE - 1) / 2);
+
+    key = 30;
+    TEST_ASSERT(ilist_find(&base, ilist_first(&head), ILIST_NIL, pred_data, &key) == 10);
+
+    //not in the range [first, 20)
+    TEST_ASSERT(ilist_find(&base, ilist_first(&head), 20, pred_data, &key) == 20);
+
+    key = 31;
+    TEST_ASSERT(ilist_find(&base, ilist_first(&head), ILIST_NIL, pred_data, &key) == ILIST_NIL);
+
+
+    TEST_PASS(NULL);
+}
+
+
+
+ptest_func tests[] =
+{
+    test_ilist_init,
+    test_ilist_push_pop,
+    test_ilist_splice_reverse,
+    test_ilist_algos,
+};
+
+
+
+
+
+MAIN_TESTS(tests)
@@ -0,0 +1,287 @@
+#include <stddef.h>
+
+#include "stest.h"
+#include "ipqueue.h"
+
+
+
+
+
+struct tmp_data
+{
+   int    key;
+   size_t pos;
+};
+
+
+
+#define DECLARE_TMP_DATA(name, key) \
+    struct tmp_data name = { key, IPQUEUE_INVALID_POS }
+
+
+int compare_keys(void* item1, void* item2) {
+
+    int key1_v = ((struct tmp_data *)item1)->key;
+    int key2_v = ((struct tmp_data *)item2)->key;
+
+
+    if (key1_v <= key2_v)
+        return 1;
+
+    return 0;
+}
+
+
+
+// every item knows its position and the heap property holds
+static int is_valid_heap(struct ipqueue_t *pqueue)
+{
+    for(size_t i = 0; i < pqueue->size; i++)
+    {
+        struct tmp_data *item = pqueue->items[i];
+
+        if( item->pos != i )
+            return 0;
+
+        if( (i > 0) && !compare_keys(pqueue->items[PQUEUE_PARENT(i)], item) )
+            return 0;
+    }
+
+    return 1;
+}
+
+
+
+
+
+TEST(test_ipqueue_init)
+{
+    struct ipqueue_t tmp_pqueue;
+
+    TEST_ASSERT(ipqueue_init(&tmp_pqueue, 0, 4, compare_keys, offsetof(struct tmp_data, pos)) == 0);
+    TEST_ASSERT(tmp_pqueue.size       == 0);
+    TEST_ASSERT(tmp_pqueue.capacity   == 4);
+    TEST_ASSERT(tmp_pqueue.pos_offset == offsetof(struct tmp_data, pos));
+    TEST_ASSERT(ipqueue_top(&tmp_pqueue) == NULL);
+
+    DECLARE_TMP_DATA(d1, 1);
+
+    TEST_ASSERT(ipqueue_contains(&tmp_pqueue, &d1) == 0);
+
+
+    pqueue_free((struct pqueue_t *)&tmp_pqueue);
+
+    //the freed queue is empty: top and pop do not touch the items
+    TEST_ASSERT(ipqueue_top(&tmp_pqueue) == NULL);
+    ipqueue_pop(&tmp_pqueue);
+    TEST_ASSERT(tmp_pqueue.size == 0);
+
+    TEST_PASS(NULL);
+}
+
+
+
+TEST(test_ipqueue_push_pop)
+{
+    struct ipqueue_t tmp_pqueue;
+
+    TEST_ASSERT(ipqueue_init(&tmp_pqueue, 0, 4, compare_keys, offsetof(struct tmp_data, pos)) == 0);
+
+    DECLARE_TMP_DATA(d1, 3);
+    DECLARE_TMP_DATA(d2, 1);
+    DECLARE_TMP_DATA(d3, 4);
+    DECLARE_TMP_DATA(d4, 2);
+    DECLARE_TMP_DATA(d5, 0);
+
+
+    TEST_ASSERT(ipqueue_push(&tmp_pqueue, &d1) == 0);
+    TEST_ASSERT(ipqueue_push(&tmp_pqueue, &d2) == 0);
+    TEST_ASSERT(ipqueue_push(&tmp_pqueue, &d3) == 0);
+    TEST_ASSERT(ipqueue_push(&tmp_pqueue, &d4) == 0);
+    TEST_ASSERT(ipqueue_push(&tmp_pqueue, &d5) == -1);   //queue is full, inc_step == 0
+    TEST_ASSERT(tmp_pqueue.size == 4);
+    TEST_ASSERT(is_valid_heap(&tmp_pqueue));
+
+    TEST_ASSERT(ipqueue_contains(&tmp_pqueue, &d1) == 1);
+    TEST_ASSERT(ipqueue_contains(&tmp_pqueue, &d5) == 0);
+
+
+    TEST_ASSERT(ipqueue_top(&tmp_pqueue) == &d2);
+    ipqueue_pop(&tmp_pqueue);
+    TEST_ASSERT(d2.pos == IPQUEUE_INVALID_POS);
+    TEST_ASSERT(ipqueue_contains(&tmp_pqueue, &d2) == 0);
+    TEST_ASSERT(is_valid_heap(&tmp_pqueue));
+
+    TEST_ASSERT(ipqueue_top(&tmp_pqueue) == &d4);
+    ipqueue_pop(&tmp_pqueue);
+    TEST_ASSERT(ipqueue_top(&tmp_pqueue) == &d1);
+    ipqueue_pop(&tmp_pqueue);
+    TEST_ASSERT(ipqueue_top(&tmp_pqueue) == &d3);
+    ipqueue_pop(&tmp_pqueue);
+
+    TEST_ASSERT(tmp_pqueue.size == 0);
+    TEST_ASSERT(ipqueue_top(&tmp_pqueue) == NULL);
+
+    ipqueue_pop(&tmp_pqueue);           //pop from empty queue is no-op
+    TEST_ASSERT(tmp_pqueue.size == 0);
+
+
+    pqueue_free((struct pqueue_t *)&tmp_pqueue);
+
+    TEST_PASS(NULL);
+}
+
+
+
+TEST(test_ipqueue_update)
+{
+    struct ipqueue_t tmp_pqueue;
+
+    TEST_ASSERT(ipqueue_init(&tmp_pqueue, 4, 4, compare_keys, offsetof(struct tmp_data, pos)) == 0);
+
+    DECLARE_TMP_DATA(d1, 10);
+    DECLARE_TMP_DATA(d2, 20);
+    DECLARE_TMP_DATA(d3, 30);
+    DECLARE_TMP_DATA(d4, 40);
+    DECLARE_TMP_DATA(d5, 50);
+    DECLARE_TMP_DATA(d6, 60);
+
+
+    TEST_ASSERT(ipqueue_update(&tmp_pqueue, &d1) == -1);   //not in queue
+
+    ipqueue_push(&tmp_pqueue, &d1);
+    ipqueue_push(&tmp_pqueue, &d2);
+    ipqueue_push(&tmp_pqueue, &d3);
+    ipqueue_push(&tmp_pqueue, &d4);
+    ipqueue_push(&tmp_pqueue, &d5);
+    TEST_ASSERT(tmp_pqueue.size == 5);
+
+
+    d5.key = 5;                        //decrease-key
+    TEST_ASSERT(ipqueue_update(&tmp_pqueue, &d5) == 0);
+    TEST_ASSERT(ipqueue_top(&tmp_pqueue) == &d5);
+    TEST_ASSERT(is_valid_heap(&tmp_pqueue));
+
+    d5.key = 100;                      //increase-key
+    TEST_ASSERT(ipqueue_update(&tmp_pqueue, &d5) == 0);
+    TEST_ASSERT(ipqueue_top(&tmp_pqueue) == &d1);
+    TEST_ASSERT(is_valid_heap(&tmp_pqueue));
+
+    d1.key = 35;
+    TEST_ASSERT(ipqueue_update(&tmp_pqueue, &d1) == 0);
+    TEST_ASSERT(is_valid_heap(&tmp_pqueue));
+
+    TEST_ASSERT(ipqueue_update(&tmp_pqueue, &d6) == -1);
+
+
+    //order: d2(20) d3(30) d1(35) d4(40) d5(100)
+    TEST_ASSERT(ipqueue_top(&tmp_pqueue) == &d2);
+    ipqueue_pop(&tmp_pqueue);
+    TEST_ASSERT(ipqueue_top(&tmp_pqueue) == &d3);
+    ipqueue_pop(&tmp_pqueue);
+    TEST_ASSERT(ipqueue_top(&tmp_pqueue) == &d1);
+    ipqueue_pop(&tmp_pqueue);
+    TEST_ASSERT(ipqueue_top(&tmp_pqueue) == &d4);
+    ipqueue_pop(&tmp_pqueue);
+    TEST_ASSERT(ipqueue_top(&tmp_pqueue) == &d5);
+    ipqueue_pop(&tmp_pqueue);
+    TEST_ASSERT(tmp_pqueue.size == 0);
+
+
+    pqueue_free((struct pqueue_t *)&tmp_pqueue);
+
+    TEST_PASS(NULL);
+}
+
+
+
+TEST(test_ipqueue_remove)
+{
+    const size_t SIZE = 500;
+
+    struct ipqueue_t tmp_pqueue;
+
+    struct tmp_data items[SIZE];
+
+    unsigned int seed = 11;
+
+
+    TEST_ASSERT(ipqueue_init(&tmp_pqueue, 0, 8, compare_keys, offsetof(struct tmp_data, pos)) == 0);
+    TEST_ASSERT(pqueue_set_grow_factor((struct pqueue_t *)&tmp_pqueue, 200) == 0);
+
+    for(size_t i = 0; i < SIZE; i++)
+    {
+        seed = seed * 1103515245 + 12345;
+        items[i].key = (seed >> 16) % 1000;
+        items[i].pos = IPQUEUE_INVALID_POS;
+
+        TEST_ASSERT(ipqueue_push(&tmp_pqueue, &items[i]) == 0);
+    }
+
+    TEST_ASSERT(tmp_pqueue.size == SIZE);
+    TEST_ASSERT(is_valid_heap(&tmp_pqueue));
+
+
+    //remove every third item, change keys of every fifth
+    for(size_t i = 0; i < SIZE; i += 3)
+    {
+        TEST_ASSERT(ipqueue_remove(&tmp_pqueue, &items[i]) == 0);
+        TEST_ASSERT(items[i].pos == IPQUEUE_INVALID_POS);
+        TEST_ASSERT(ipqueue_remove(&tmp_pqueue, &items[i]) == -1);   //already removed
+    }
+
+    TEST_ASSERT(is_valid_heap(&tmp_pqueue));
+
+    for(size_t i = 1; i < SIZE; i += 5)
+    {
+        if( !ipqueue_contains(&tmp_pqueue, &items[i]) )
+            continue;
+
+        seed = seed * 1103515245 + 12345;
+        items[i].key = (seed >> 16) % 1000;
+        TEST_ASSERT(ipqueue_update(&tmp_pqueue, &items[i]) == 0);
+    }
+
+    TEST_ASSERT(is_valid_heap(&tmp_pqueue));
+    TEST_ASSERT(tmp_pqueue.size == SIZE - (SIZE + 2)/3);
+
+
+    //remove the last item of the array (no sift)
+    struct tmp_data *last = tmp_pqueue.items[tmp_pqueue.size - 1];
+    TEST_ASSERT(ipqueue_remove(&tmp_pqueue, last) == 0);
+    TEST_ASSERT(is_valid_heap(&tmp_pqueue));
+
+
+    int prev = -1;
+
+    while( tmp_pqueue.size )
+    {
+        struct tmp_data *top = ipqueue_top(&tmp_pqueue);
+
+        TEST_ASSERT(top->key >= prev);
+        prev = top->key;
+
+        ipqueue_pop(&tmp_pqueue);
+    }
+
+
+    pqueue_free((struct pqueue_t *)&tmp_pqueue);
+
+    TEST_PASS(NULL);
+}
+
+
+
+ptest_func tests[] =
+{
+    test_ipqueue_init,
+    test_ipqueue_push_pop,
+    test_ipqueue_update,
+    test_ipqueue_remove,
+};
+
+
+
+
+
+MAIN_TESTS(tests)
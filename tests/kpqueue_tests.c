@@ -0,0 +1,234 @@
+#include "stest.h"
+#include "kpqueue.h"
+
+
+
+
+
+struct tmp_data
+{
+   int key;
+   int seq;   //order of push (tiebreak)
+};
+
+
+
+//FIFO for equal keys
+DEFINE_KPQUEUE(tmp_fifo, int, 2,
+               a->key < b->key ||
+               (a->key == b->key && ((struct tmp_data *)a->item)->seq < ((struct tmp_data *)b->item)->seq))
+
+
+//max heap
+DEFINE_KPQUEUE(tmp_max, int, 8, a->key > b->key)
+
+
+
+
+
+TEST(test_kpqueue_init)
+{
+    struct kpqueue_u64_t tmp_pqueue;
+
+    TEST_ASSERT(kpqueue_u64_init(&tmp_pqueue, 0, 4) == 0);
+    TEST_ASSERT(kpqueue_u64_size(&tmp_pqueue) == 0);
+    TEST_ASSERT(kpqueue_u64_empty(&tmp_pqueue));
+    TEST_ASSERT(tmp_pqueue.capacity == 4);
+    TEST_ASSERT(kpqueue_u64_top(&tmp_pqueue) == NULL);
+
+    kpqueue_u64_pop(&tmp_pqueue);          //pop from empty queue is no-op
+    TEST_ASSERT(kpqueue_u64_size(&tmp_pqueue) == 0);
+
+
+    struct tmp_data d1;
+
+    TEST_ASSERT(kpqueue_u64_push(&tmp_pqueue, 4, &d1) == 0);
+    TEST_ASSERT(kpqueue_u64_push(&tmp_pqueue, 3, &d1) == 0);
+    TEST_ASSERT(kpqueue_u64_push(&tmp_pqueue, 2, &d1) == 0);
+    TEST_ASSERT(kpqueue_u64_push(&tmp_pqueue, 1, &d1) == 0);
+    TEST_ASSERT(kpqueue_u64_push(&tmp_pqueue, 0, &d1) == -1);  //queue is full
+    TEST_ASSERT(kpqueue_u64_top_key(&tmp_pqueue) == 1);
+
+
+    kpqueue_u64_free(&tmp_pqueue);
+    TEST_ASSERT(tmp_pqueue.entries  == NULL);
+    TEST_ASSERT(tmp_pqueue.capacity == 0);
+
+
+    TEST_PASS(NULL);
+}
+
+
+
+TEST(test_kpqueue_u64)
+{
+    const size_t SIZE = 1000;
+
+    struct kpqueue_u64_t tmp_pqueue;
+
+    struct tmp_data items[SIZE];
+
+    uint64_t seed = 1;
+
+
+    TEST_ASSERT(kpqueue_u64_init(&tmp_pqueue, 16, 0) == 0);
+
+    for(size_t i = 0; i < SIZE; i++)
+    {
+        seed = seed * 6364136223846793005ull + 1442695040888963407ull;
+        items[i].key = i;
+
+        TEST_ASSERT(kpqueue_u64_push(&tmp_pqueue, seed >> 1, &items[i]) == 0);
+    }
+
+    TEST_ASSERT(kpqueue_u64_size(&tmp_pqueue) == SIZE);
+    TEST_ASSERT(tmp_pqueue.capacity >= SIZE);
+
+
+    uint64_t prev = 0;
+
+    for(size_t i = 0; i < SIZE; i++)
+    {
+        uint64_t key = kpqueue_u64_top_key(&tmp_pqueue);
+
+        TEST_ASSERT(key >= prev);
+        TEST_ASSERT(kpqueue_u64_top(&tmp_pqueue) != NULL);
+        prev = key;
+
+        kpqueue_u64_pop(&tmp_pqueue);
+    }
+
+    TEST_ASSERT(kpqueue_u64_empty(&tmp_pqueue));
+    TEST_ASSERT(kpqueue_u64_top(&tmp_pqueue) == NULL);
+
+
+    kpqueue_u64_free(&tmp_pqueue);
+
+    TEST_PASS(NULL);
+}
+
+
+
+TEST(test_kpqueue_i64_dbl)
+{
+    struct kpqueue_i64_t tmp_pqueue_i64;
+    struct kpqueue_dbl_t tmp_pqueue_dbl;
+
+    struct tmp_data items[100];
+
+
+    TEST_ASSERT(kpqueue_i64_init(&tmp_pqueue_i64, 0, 1) == 0);
+    TEST_ASSERT(kpqueue_i64_set_grow_factor(&tmp_pqueue_i64, 100) == -1);
+    TEST_ASSERT(kpqueue_i64_set_grow_factor(&tmp_pqueue_i64, 200) == 0);
+
+    TEST_ASSERT(kpqueue_dbl_init(&tmp_pqueue_dbl, 4, 4) == 0);
+
+
+    for(int i = 0; i < 100; i++)
+    {
+        items[i].key = (i * 37) % 100 - 50;   //-50 .. 49
+
+        TEST_ASSERT(kpqueue_i64_push(&tmp_pqueue_i64, items[i].key, &items[i]) == 0);
+        TEST_ASSERT(kpqueue_dbl_push(&tmp_pqueue_dbl, items[i].key / 4.0, &items[i]) == 0);
+    }
+
+    TEST_ASSERT(tmp_pqueue_i64.capacity == 128);  //1, 2, 4, ... 128
+
+
+    for(int i = -50; i < 50; i++)
+    {
+        struct tmp_data *top = kpqueue_i64_top(&tmp_pqueue_i64);
+
+        TEST_ASSERT(kpqueue_i64_top_key(&tmp_pqueue_i64) == i);
+        TEST_ASSERT(top->key == i);
+        TEST_ASSERT(kpqueue_dbl_top_key(&tmp_pqueue_dbl) == i / 4.0);
+        TEST_ASSERT(kpqueue_dbl_top(&tmp_pqueue_dbl) == top);
+
+        kpqueue_i64_pop(&tmp_pqueue_i64);
+        kpqueue_dbl_pop(&tmp_pqueue_dbl);
+    }
+
+
+    kpqueue_i64_free(&tmp_pqueue_i64);
+    kpqueue_dbl_free(&tmp_pqueue_dbl);
+
+    TEST_PASS(NULL);
+}
+
+
+
+TEST(test_kpqueue_tiebreak)
+{
+    const int SIZE = 300;
+
+    struct tmp_fifo_t tmp_pqueue;
+    struct tmp_max_t  tmp_pqueue_max;
+
+    struct tmp_data items[SIZE];
+
+
+    TEST_ASSERT(tmp_fifo_init(&tmp_pqueue, 64, 64) == 0);
+    TEST_ASSERT(tmp_max_init(&tmp_pqueue_max, 64, 64) == 0);
+    TEST_ASSERT(tmp_fifo_reserve(&tmp_pqueue, SIZE) == 0);
+    TEST_ASSERT(tmp_pqueue.capacity == (size_t)SIZE);
+
+
+    for(int i = 0; i < SIZE; i++)
+    {
+        items[i].key = (i * 7) % 3;  //only 3 different keys
+        items[i].seq = i;
+
+        TEST_ASSERT(tmp_fifo_push(&tmp_pqueue, items[i].key, &items[i]) == 0);
+        TEST_ASSERT(tmp_max_push(&tmp_pqueue_max, i, &items[i]) == 0);
+    }
+
+
+    //equal keys are popped in order of push
+    int prev_key = -1, prev_seq = -1;
+
+    for(int i = 0; i < SIZE; i++)
+    {
+        struct tmp_data *top = tmp_fifo_top(&tmp_pqueue);
+
+        TEST_ASSERT(top->key >= prev_key);
+
+        if( top->key == prev_key )
+        {
+            TEST_ASSERT(top->seq > prev_seq);
+        }
+
+        prev_key = top->key;
+        prev_seq = top->seq;
+
+        tmp_fifo_pop(&tmp_pqueue);
+    }
+
+
+    for(int i = SIZE - 1; i >= 0; i--)
+    {
+        TEST_ASSERT(tmp_max_top(&tmp_pqueue_max) == &items[i]);
+        tmp_max_pop(&tmp_pqueue_max);
+    }
+
+
+    tmp_fifo_free(&tmp_pqueue);
+    tmp_max_free(&tmp_pqueue_max);
+
+    TEST_PASS(NULL);
+}
+
+
+
+ptest_func tests[] =
+{
+    test_kpqueue_init,
+    test_kpqueue_u64,
+    test_kpqueue_i64_dbl,
+    test_kpqueue_tiebreak,
+};
+
+
+
+
+
+MAIN_TESTS(tests)
@@ -1167,6 +1167,196 @@ TEST(test_list_find2)
 
 
 
+int comp_less_key(const struct list_head *n1,const struct list_head *n2)
+{
+    struct tmp_data *d1 = list_data(n1, struct tmp_data, list);
+    struct tmp_data *d2 = list_data(n2, struct tmp_data, list);
+
+    return (d1->data / 16) < (d2->data / 16);  //many equal keys
+}
+
+
+
+TEST(test_list_sort)
+{
+    DECLARE_LIST_HEAD(tmp_list);
+
+    const int COUNT_NODES = 1000;
+    int i;
+    struct tmp_data  nodes[COUNT_NODES];
+    struct tmp_data  *it;
+
+
+    list_sort(&tmp_list, comp_less);             //empty list
+    TEST_ASSERT(list_empty(&tmp_list));
+
+
+    list_push_back(&nodes[0].list, &tmp_list);   //singular list
+    list_sort(&tmp_list, comp_less);
+    TEST_ASSERT(list_is_singular(&tmp_list));
+    TEST_ASSERT(list_is_first(&nodes[0].list, &tmp_list));
+
+
+    list_init_head(&tmp_list);  //clear
+
+    for(i=0; i < COUNT_NODES; i++)
+    {
+        nodes[i].data = (i * 7919) % COUNT_NODES;  //permutation of [0, COUNT_NODES)
+        list_push_back(&nodes[i].list, &tmp_list);
+    }
+
+
+    list_sort(&tmp_list, comp_less);
+
+    TEST_ASSERT(list_size(&tmp_list) == (size_t)COUNT_NODES);
+
+    i=0;
+    list_data_citer(it, &tmp_list, struct tmp_data, list)
+    {
+        TEST_ASSERT(it->data == i);
+        i++;
+    }
+
+    TEST_ASSERT(i == COUNT_NODES);
+
+    it = list_last_data(&tmp_list, struct tmp_data, list);
+    TEST_ASSERT(it->data == COUNT_NODES-1);      //the ring must be closed by the last node
+
+
+    //reverse order
+    list_sort(&tmp_list, comp_less);  //sorted list
+    list_reverse(&tmp_list);
+    list_sort(&tmp_list, comp_less);
+
+    i=0;
+    list_data_citer(it, &tmp_list, struct tmp_data, list)
+    {
+        TEST_ASSERT(it->data == i);
+        i++;
+    }
+
+
+    TEST_PASS(NULL);
+}
+
+
+
+TEST(test_list_sort_stable)
+{
+    DECLARE_LIST_HEAD(tmp_list);
+
+    const int COUNT_NODES = 1000;
+    int i;
+    struct tmp_data  nodes[COUNT_NODES];
+    struct tmp_data  *it, *prev;
+
+
+    for(i=0; i < COUNT_NODES; i++)
+    {
+        nodes[i].data = (i * 7919) % COUNT_NODES;
+        list_push_back(&nodes[i].list, &tmp_list);
+    }
+
+
+    list_sort(&tmp_list, comp_less_key);
+
+
+    //nodes with equal keys must keep the order of the insertion (address of node)
+    prev = NULL;
+    list_data_citer(it, &tmp_list, struct tmp_data, list)
+    {
+        if( prev )
+        {
+            TEST_ASSERT(prev->data / 16 <= it->data / 16);
+
+            if( prev->data / 16 == it->data / 16 )
+                TEST_ASSERT(prev < it);
+        }
+
+        prev = it;
+    }
+
+
+    TEST_PASS(NULL);
+}
+
+
+DEFINE_LIST_ALGOS(tmp, struct tmp_data, list, a->data < b->data,
+                 data ? a->data == *(int *)data : a->data == 50)
+
+
+
+TEST(test_list_algos)
+{
+    DECLARE_LIST_HEAD(tmp_list);
+
+    const int COUNT_NODES = 100;
+    int i, key;
+    struct tmp_data  nodes[COUNT_NODES];
+    struct tmp_data  *it;
+    struct list_head *res[2], *res2[2];
+
+
+    TEST_ASSERT(tmp_min(tmp_list.next, &tmp_list) == &tmp_list);  //empty
+    TEST_ASSERT(tmp_max(tmp_list.next, &tmp_list) == &tmp_list);
+    TEST_ASSERT(tmp_find(tmp_list.next, &tmp_list) == &tmp_list);
+
+    tmp_minmax(tmp_list.next, &tmp_list, res);
+    TEST_ASSERT(res[0] == &tmp_list);
+    TEST_ASSERT(res[1] == &tmp_list);
+
+
+    for(i=0; i < COUNT_NODES; i++)
+    {
+        nodes[i].data = (i * 37) % COUNT_NODES;  //permutation of [0, COUNT_NODES)
+        list_push_back(&nodes[i].list, &tmp_list);
+    }
+
+
+    //must be the same as the algorithms with a pointer to function
+    TEST_ASSERT(tmp_min(tmp_list.next, &tmp_list) == list_min(tmp_list.next, &tmp_list, comp_less));
+    TEST_ASSERT(tmp_max(tmp_list.next, &tmp_list) == list_max(tmp_list.next, &tmp_list, comp_less));
+
+    tmp_minmax(tmp_list.next, &tmp_list, res);
+    list_minmax(tmp_list.next, &tmp_list, comp_less, res2);
+    TEST_ASSERT(res[0] == res2[0]);
+    TEST_ASSERT(res[1] == res2[1]);
+
+    it = list_data(res[0], struct tmp_data, list);
+    TEST_ASSERT(it->data == 0);
+    it = list_data(res[1], struct tmp_data, list);
+    TEST_ASSERT(it->data == COUNT_NODES-1);
+
+
+    TEST_ASSERT(tmp_find(tmp_list.next, &tmp_list) == list_find(tmp_list.next, &tmp_list, pred_50));
+    it = list_data(tmp_find(tmp_list.next, &tmp_list), struct tmp_data, list);
+    TEST_ASSERT(it->data == 50);
+
+    key = 7;
+    it = list_data(tmp_find2(tmp_list.next, &tmp_list, &key), struct tmp_data, list);
+    TEST_ASSERT(it->data == 7);
+
+    key = COUNT_NODES;
+    TEST_ASSERT(tmp_find2(tmp_list.next, &tmp_list, &key) == &tmp_list);
+
+
+    list_sort(&tmp_list, tmp_less);
+
+    i=0;
+    list_data_citer(it, &tmp_list, struct tmp_data, list)
+    {
+        TEST_ASSERT(it->data == i);
+        i++;
+    }
+
+    TEST_ASSERT(i == COUNT_NODES);
+
+
+    TEST_PASS(NULL);
+}
+
+
+
 ptest_func tests[] =
 {
     test_list_empty,
@@ -1206,6 +1396,9 @@ ptest_func tests[] =
     test_list_minmax,
     test_list_find,
     test_list_find2,
+    test_list_sort,
+    test_list_sort_stable,
+    test_list_algos,
 };
 
 
@@ -0,0 +1,278 @@
+#include "stest.h"
+#include "lru.h"
+
+
+
+
+
+struct tmp_data
+{
+   int             key;
+   int             evicted;
+   struct lru_node node;
+};
+
+
+
+static int tmp_eq(const struct htable_node *hnode, const void *key)
+{
+    const struct tmp_data *d = lru_hash_data(hnode, const struct tmp_data, node);
+
+    return d->key == *(const int *)key;
+}
+
+
+
+static size_t tmp_hash(int key)
+{
+    return (size_t)key * 2654435761u;
+}
+
+
+
+static struct tmp_data* lookup_data(struct lru_t *lru, int key)
+{
+    struct lru_node *node = lru_lookup(lru, tmp_hash(key), &key);
+
+    return node ? lru_data(node, struct tmp_data, node) : NULL;
+}
+
+
+
+static void tmp_evict(struct lru_node *node, void *arg)
+{
+    struct tmp_data *d = lru_data(node, struct tmp_data, node);
+
+    d->evicted = ++*(int *)arg;
+}
+
+
+
+// check the recency order: keys from the most recently used
+static int check_order(struct lru_t *lru, const int *keys, int size)
+{
+    struct tmp_data *d;
+    int i = 0;
+
+
+    if( lru_size(lru) != (size_t)size )
+        return 0;
+
+    dqueue_data_citer(d, &lru->queue, struct tmp_data, node.list)
+    {
+        if( d->key != keys[i++] )
+            return 0;
+    }
+
+    return 1;
+}
+
+
+
+
+
+TEST(test_lru_init)
+{
+    struct lru_t tmp_lru;
+
+
+    TEST_ASSERT(lru_init(&tmp_lru, 4, tmp_eq, NULL, NULL) == 0);
+    TEST_ASSERT(lru_empty(&tmp_lru));
+    TEST_ASSERT(lru_size(&tmp_lru) == 0);
+    TEST_ASSERT(lru_capacity(&tmp_lru) == 4);
+    TEST_ASSERT(lru_victim(&tmp_lru) == NULL);
+    TEST_ASSERT(lookup_data(&tmp_lru, 1) == NULL);
+    TEST_ASSERT(lru_hits(&tmp_lru) == 0);
+    TEST_ASSERT(lru_misses(&tmp_lru) == 1);
+    TEST_ASSERT(lru_evictions(&tmp_lru) == 0);
+
+    lru_free(&tmp_lru);
+
+
+    TEST_PASS(NULL);
+}
+
+
+
+TEST(test_lru_lookup_insert)
+{
+    struct lru_t tmp_lru;
+    struct tmp_data items[8];
+    int evicted = 0;
+
+
+    TEST_ASSERT(lru_init(&tmp_lru, 4, tmp_eq, tmp_evict, &evicted) == 0);
+
+    for(int i = 0; i < 8; i++)
+    {
+        items[i].key     = i;
+        items[i].evicted = 0;
+    }
+
+    for(int i = 0; i < 4; i++)
+        TEST_ASSERT(lru_insert(&tmp_lru, &items[i].node, tmp_hash(i)) == 0);
+
+    TEST_ASSERT(check_order(&tmp_lru, (int[]){3, 2, 1, 0}, 4));
+    TEST_ASSERT(lru_victim(&tmp_lru) == &items[0].node);
+
+
+    //hits move the nodes to the front
+    TEST_ASSERT(lookup_data(&tmp_lru, 0) == &items[0]);
+    TEST_ASSERT(lookup_data(&tmp_lru, 2) == &items[2]);
+    TEST_ASSERT(lookup_data(&tmp_lru, 7) == NULL);
+    TEST_ASSERT(check_order(&tmp_lru, (int[]){2, 0, 3, 1}, 4));
+    TEST_ASSERT(lru_hits(&tmp_lru) == 2);
+    TEST_ASSERT(lru_misses(&tmp_lru) == 1);
+
+
+    //peek does not change the order and the counters
+    TEST_ASSERT(lru_peek(&tmp_lru, tmp_hash(1), &items[1].key) == &items[1].node);
+    TEST_ASSERT(check_order(&tmp_lru, (int[]){2, 0, 3, 1}, 4));
+    TEST_ASSERT(lru_hits(&tmp_lru) == 2);
+
+
+    //insert above the capacity evicts the least recently used
+    TEST_ASSERT(lru_insert(&tmp_lru, &items[4].node, tmp_hash(4)) == 1);
+    TEST_ASSERT(items[1].evicted == 1);
+    TEST_ASSERT(lru_insert(&tmp_lru, &items[5].node, tmp_hash(5)) == 1);
+    TEST_ASSERT(items[3].evicted == 2);
+    TEST_ASSERT(check_order(&tmp_lru, (int[]){5, 4, 2, 0}, 4));
+    TEST_ASSERT(lru_evictions(&tmp_lru) == 2);
+    TEST_ASSERT(lookup_data(&tmp_lru, 1) == NULL);
+    TEST_ASSERT(lookup_data(&tmp_lru, 3) == NULL);
+
+
+    //touch and remove
+    lru_touch(&tmp_lru, &items[0].node);
+    lru_remove(&tmp_lru, &items[4].node);
+    TEST_ASSERT(check_order(&tmp_lru, (int[]){0, 5, 2}, 3));
+    TEST_ASSERT(lookup_data(&tmp_lru, 4) == NULL);
+    TEST_ASSERT(items[4].evicted == 0);
+
+
+    lru_reset_stats(&tmp_lru);
+    TEST_ASSERT(lru_hits(&tmp_lru) == 0 && lru_misses(&tmp_lru) == 0);
+    TEST_ASSERT(lru_evictions(&tmp_lru) == 0);
+
+    lru_free(&tmp_lru);
+
+
+    TEST_PASS(NULL);
+}
+
+
+
+TEST(test_lru_evict)
+{
+    const int SIZE = 100;
+
+    struct lru_t tmp_lru;
+    struct tmp_data items[SIZE];
+    struct tmp_data *d;
+    DECLARE_DQUEUE(victims);
+    int key;
+
+
+    TEST_ASSERT(lru_init(&tmp_lru, SIZE, tmp_eq, NULL, NULL) == 0);
+
+    for(int i = 0; i < SIZE; i++)
+    {
+        items[i].key = i;
+        lru_insert(&tmp_lru, &items[i].node, tmp_hash(i));
+    }
+
+    TEST_ASSERT(lru_evict(&tmp_lru, SIZE, &victims) == 0);
+    TEST_ASSERT(lru_evict(&tmp_lru, 2 * SIZE, &victims) == 0);
+    TEST_ASSERT(dqueue_empty(&victims));
+
+
+    //evict to 30: the victims are 0..69, the least recently used is the last
+    TEST_ASSERT(lru_evict(&tmp_lru, 30, &victims) == (size_t)SIZE - 30);
+    TEST_ASSERT(lru_size(&tmp_lru) == 30);
+    TEST_ASSERT(dqueue_size(&victims) == (size_t)SIZE - 30);
+    TEST_ASSERT(lru_evictions(&tmp_lru) == (size_t)SIZE - 30);
+
+    key = SIZE - 31;
+    dqueue_data_citer(d, &victims, struct tmp_data, node.list)
+    {
+        TEST_ASSERT(d->key == key);
+        key--;
+    }
+
+    TEST_ASSERT(key == -1);
+
+    for(int i = 0; i < SIZE; i++)
+        TEST_ASSERT(lookup_data(&tmp_lru, i) == (i >= SIZE - 30 ? &items[i] : NULL));
+
+
+    //the victims can be inserted again
+    while( !dqueue_empty(&victims) )
+    {
+        d = dqueue_first_data(&victims, struct tmp_data, node.list);
+        dqueue_pop_front(&victims);
+        lru_insert(&tmp_lru, &d->node, tmp_hash(d->key));
+    }
+
+    TEST_ASSERT(lru_size(&tmp_lru) == (size_t)SIZE);
+    TEST_ASSERT(lru_victim(&tmp_lru) == &items[SIZE - 30].node);
+
+
+    //evict all
+    TEST_ASSERT(lru_evict(&tmp_lru, 0, &victims) == (size_t)SIZE);
+    TEST_ASSERT(lru_empty(&tmp_lru));
+    TEST_ASSERT(htable_empty(&tmp_lru.index));
+    TEST_ASSERT(dqueue_size(&victims) == (size_t)SIZE);
+
+    lru_free(&tmp_lru);
+
+
+    TEST_PASS(NULL);
+}
+
+
+
+TEST(test_lru_index_size)
+{
+    const int CAPACITY = 64;    //power of 2: the index has CAPACITY buckets
+
+    struct lru_t tmp_lru;
+    struct tmp_data items[4 * CAPACITY];
+
+
+    TEST_ASSERT(lru_init(&tmp_lru, CAPACITY, tmp_eq, NULL, NULL) == 0);
+    TEST_ASSERT(htable_buckets(&tmp_lru.index) == (size_t)CAPACITY);
+
+    //the full cache evicts before insert, the index does not grow
+    for(int i = 0; i < 4 * CAPACITY; i++)
+    {
+        items[i].key = i;
+        TEST_ASSERT(lru_insert(&tmp_lru, &items[i].node, tmp_hash(i)) == (i >= CAPACITY));
+        TEST_ASSERT(!htable_rehashing(&tmp_lru.index));
+    }
+
+    TEST_ASSERT(lru_size(&tmp_lru) == (size_t)CAPACITY);
+    TEST_ASSERT(htable_buckets(&tmp_lru.index) == (size_t)CAPACITY);
+    TEST_ASSERT(lookup_data(&tmp_lru, 4 * CAPACITY - 1) == &items[4 * CAPACITY - 1]);
+    TEST_ASSERT(lookup_data(&tmp_lru, 3 * CAPACITY - 1) == NULL);
+
+    lru_free(&tmp_lru);
+
+
+    TEST_PASS(NULL);
+}
+
+
+
+ptest_func tests[] =
+{
+    test_lru_init,
+    test_lru_lookup_insert,
+    test_lru_evict,
+    test_lru_index_size,
+};
+
+
+
+
+
+MAIN_TESTS(tests)
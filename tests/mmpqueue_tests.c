@@ -0,0 +1,115 @@
+#include "stest.h"
+#include "mmpqueue.h"
+
+
+
+
+
+struct tmp_data
+{
+   int key;
+   int data;
+};
+
+
+
+int compare_int_keys(void* key1, void* key2) {
+
+    int key1_v = *((int*)key1);
+    int key2_v = *((int*)key2);
+
+
+    if (key1_v <= key2_v)
+        return 1;
+
+    return 0;
+}
+
+
+
+
+
+TEST(test_mmpqueue_init)
+{
+    struct mmpqueue_t tmp_pqueue;
+
+    TEST_ASSERT(mmpqueue_init(&tmp_pqueue, 0, 2, compare_int_keys) == 0);
+    TEST_ASSERT(mmpqueue_size(&tmp_pqueue) == 0);
+    TEST_ASSERT(tmp_pqueue.capacity == 2);
+    TEST_ASSERT(mmpqueue_min(&tmp_pqueue) == NULL);
+    TEST_ASSERT(mmpqueue_max(&tmp_pqueue) == NULL);
+
+
+    struct tmp_data d1 = { 1, 0 };
+
+    TEST_ASSERT(mmpqueue_push(&tmp_pqueue, &d1.key) == 0);
+    TEST_ASSERT(mmpqueue_push(&tmp_pqueue, &d1.key) == 0);
+    TEST_ASSERT(mmpqueue_push(&tmp_pqueue, &d1.key) == -1);  //queue is full, inc_step == 0
+
+
+    pqueue_free((struct pqueue_t *)&tmp_pqueue);
+    TEST_ASSERT(tmp_pqueue.items == NULL);
+
+    TEST_PASS(NULL);
+}
+
+
+
+TEST(test_mmpqueue_push_pop)
+{
+    const int SIZE = 1000;
+
+    struct mmpqueue_t tmp_pqueue;
+
+    struct tmp_data items[SIZE];
+
+
+    TEST_ASSERT(mmpqueue_init(&tmp_pqueue, 16, 0, compare_int_keys) == 0);
+    TEST_ASSERT(pqueue_set_grow_factor((struct pqueue_t *)&tmp_pqueue, 200) == 0);
+
+
+    for(int i = 0; i < SIZE; i++)
+    {
+        items[i].key = (i * 7919) % SIZE;   //permutation of 0..999
+
+        TEST_ASSERT(mmpqueue_push(&tmp_pqueue, &items[i].key) == 0);
+    }
+
+    TEST_ASSERT(mmpqueue_size(&tmp_pqueue) == (size_t)SIZE);
+    TEST_ASSERT(tmp_pqueue.capacity >= (size_t)SIZE);
+
+
+    for(int i = 0; i < SIZE/2; i++)
+    {
+        TEST_ASSERT(*(int *)mmpqueue_min(&tmp_pqueue) == i);
+        TEST_ASSERT(*(int *)mmpqueue_max(&tmp_pqueue) == SIZE - 1 - i);
+
+        mmpqueue_pop_min(&tmp_pqueue);
+        mmpqueue_pop_max(&tmp_pqueue);
+    }
+
+    TEST_ASSERT(mmpqueue_size(&tmp_pqueue) == 0);
+    TEST_ASSERT(mmpqueue_min(&tmp_pqueue) == NULL);
+
+
+    TEST_ASSERT(pqueue_shrink_to_fit((struct pqueue_t *)&tmp_pqueue) == 0);
+    TEST_ASSERT(tmp_pqueue.capacity == 1);
+
+    pqueue_free((struct pqueue_t *)&tmp_pqueue);
+
+    TEST_PASS(NULL);
+}
+
+
+
+ptest_func tests[] =
+{
+    test_mmpqueue_init,
+    test_mmpqueue_push_pop,
+};
+
+
+
+
+
+MAIN_TESTS(tests)
@@ -0,0 +1,243 @@
+#include <pthread.h>
+#include <sched.h>  //sched_yield
+
+#include "stest.h"
+#include "mpscq.h"
+
+
+
+
+
+struct tmp_data
+{
+   struct list_head list;
+   int              data;
+   int              producer;
+};
+
+
+
+#define DECLARE_TMP_DATA(name) \
+    struct tmp_data name = { {NULL}, 0, 0}
+
+
+
+
+
+TEST(test_mpscq_empty)
+{
+    DECLARE_MPSCQ(tmp_queue);
+    DECLARE_TMP_DATA(d1);
+
+
+    TEST_ASSERT(mpscq_empty(&tmp_queue));           //queue must be empty
+    TEST_ASSERT(mpscq_pop(&tmp_queue) == NULL);
+
+
+    mpscq_push(&d1.list, &tmp_queue);
+    TEST_ASSERT(!mpscq_empty(&tmp_queue));          //now queue is NOT empty
+
+
+    TEST_ASSERT(mpscq_pop(&tmp_queue) == &d1.list);
+    TEST_ASSERT(mpscq_empty(&tmp_queue));
+
+
+    mpscq_init(&tmp_queue);
+    TEST_ASSERT(mpscq_empty(&tmp_queue));
+    TEST_ASSERT(mpscq_pop(&tmp_queue) == NULL);
+
+
+    TEST_PASS(NULL);
+}
+
+
+
+TEST(test_mpscq_push_pop)
+{
+    DECLARE_MPSCQ(tmp_queue);
+
+    DECLARE_TMP_DATA(d1);
+    DECLARE_TMP_DATA(d2);
+    DECLARE_TMP_DATA(d3);
+
+
+
+    mpscq_push(&d1.list, &tmp_queue);
+    mpscq_push(&d2.list, &tmp_queue);
+    mpscq_push(&d3.list, &tmp_queue);
+
+
+    TEST_ASSERT(mpscq_pop(&tmp_queue) == &d1.list);  //FIFO
+    TEST_ASSERT(list_empty(&d1.list));               //poped node is empty
+
+    TEST_ASSERT(mpscq_pop(&tmp_queue) == &d2.list);
+    TEST_ASSERT(list_empty(&d2.list));
+
+
+    mpscq_push(&d1.list, &tmp_queue);                //push again (d3, d1)
+
+    TEST_ASSERT(mpscq_pop(&tmp_queue) == &d3.list);
+    TEST_ASSERT(mpscq_pop(&tmp_queue) == &d1.list);
+
+    TEST_ASSERT(mpscq_pop(&tmp_queue) == NULL);      //queue is empty
+    TEST_ASSERT(mpscq_empty(&tmp_queue));
+
+
+    TEST_PASS(NULL);
+}
+
+
+
+TEST(test_mpscq_drain)
+{
+    DECLARE_MPSCQ(tmp_queue);
+    DECLARE_LIST_HEAD(tmp_list);
+    DECLARE_TLIST_HEAD(tmp_tlist);
+
+    const int COUNT_NODES = 10;
+    int i;
+    struct tmp_data nodes[COUNT_NODES];
+    struct tmp_data *it;
+
+
+
+    TEST_ASSERT(mpscq_drain(&tmp_queue, &tmp_list) == 0);
+    TEST_ASSERT(list_empty(&tmp_list));
+
+
+    for(i=0; i < COUNT_NODES; i++)
+    {
+        nodes[i].data = i;
+        mpscq_push(&nodes[i].list, &tmp_queue);
+    }
+
+    TEST_ASSERT(mpscq_drain(&tmp_queue, &tmp_list) == (size_t)COUNT_NODES);
+    TEST_ASSERT(mpscq_empty(&tmp_queue));
+    TEST_ASSERT(list_size(&tmp_list) == (size_t)COUNT_NODES);
+
+    i=0;
+    list_data_citer(it, &tmp_list, struct tmp_data, list)  //FIFO order
+    {
+        TEST_ASSERT(it->data == i);
+        i++;
+    }
+
+
+
+    list_init_head(&tmp_list);
+
+    for(i=0; i < COUNT_NODES; i++)
+        mpscq_push(&nodes[i].list, &tmp_queue);
+
+    TEST_ASSERT(mpscq_drain_tlist(&tmp_queue, &tmp_tlist) == (size_t)COUNT_NODES);
+    TEST_ASSERT(mpscq_empty(&tmp_queue));
+    TEST_ASSERT(tlist_size(&tmp_tlist) == (size_t)COUNT_NODES);
+    TEST_ASSERT(tlist_last(&tmp_tlist) == &nodes[COUNT_NODES-1].list);
+
+    i=0;
+    list_data_citer(it, &tmp_tlist.head, struct tmp_data, list)
+    {
+        TEST_ASSERT(it->data == i);
+        i++;
+    }
+
+
+    TEST_PASS(NULL);
+}
+
+
+
+#define COUNT_PRODUCERS    4
+#define NODES_PER_PRODUCER 20000
+
+
+
+struct producer_data
+{
+    struct mpscq_t  *queue;
+    struct tmp_data *nodes;
+};
+
+
+
+static void* producer_func(void *arg)
+{
+    struct producer_data *pd = arg;
+    int i;
+
+    for(i = 0; i < NODES_PER_PRODUCER; i++)
+        mpscq_push(&pd->nodes[i].list, pd->queue);
+
+    return NULL;
+}
+
+
+
+TEST(test_mpscq_threads)
+{
+    DECLARE_MPSCQ(tmp_queue);
+
+    static struct tmp_data nodes[COUNT_PRODUCERS * NODES_PER_PRODUCER];
+    struct producer_data pd[COUNT_PRODUCERS];
+    pthread_t            threads[COUNT_PRODUCERS];
+    struct list_head     *node;
+    struct tmp_data      *it;
+    int i, count = 0, next_data[COUNT_PRODUCERS] = {0};
+
+
+    for(i = 0; i < COUNT_PRODUCERS * NODES_PER_PRODUCER; i++)
+    {
+        nodes[i].data     = i % NODES_PER_PRODUCER;
+        nodes[i].producer = i / NODES_PER_PRODUCER;
+    }
+
+
+    for(i = 0; i < COUNT_PRODUCERS; i++)
+    {
+        pd[i].queue = &tmp_queue;
+        pd[i].nodes = &nodes[i * NODES_PER_PRODUCER];
+
+        TEST_ASSERT(pthread_create(&threads[i], NULL, producer_func, &pd[i]) == 0);
+    }
+
+
+    //consumer: every node exactly one time, FIFO order for every producer
+    while( count < COUNT_PRODUCERS * NODES_PER_PRODUCER )
+    {
+        node = mpscq_pop(&tmp_queue);
+        if( !node )
+        {
+            sched_yield();
+            continue;
+        }
+
+        it = list_data(node, struct tmp_data, list);
+        TEST_ASSERT(it->data == next_data[it->producer]);
+        next_data[it->producer]++;
+        count++;
+    }
+
+
+    for(i = 0; i < COUNT_PRODUCERS; i++)
+        pthread_join(threads[i], NULL);
+
+    TEST_ASSERT(mpscq_pop(&tmp_queue) == NULL);
+    TEST_ASSERT(mpscq_empty(&tmp_queue));
+
+
+    TEST_PASS(NULL);
+}
+
+
+
+ptest_func tests[] =
+{
+    test_mpscq_empty,
+    test_mpscq_push_pop,
+    test_mpscq_drain,
+    test_mpscq_threads,
+};
+
+
+
+MAIN_TESTS(tests)
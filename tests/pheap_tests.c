@@ -0,0 +1,308 @@
+#include "stest.h"
+#include "pheap.h"
+
+
+
+
+
+struct tmp_data
+{
+   int               key;
+   struct pheap_node node;
+};
+
+
+
+int compare_int_keys(void* node1, void* node2) {
+
+    struct tmp_data *d1 = pheap_data(node1, struct tmp_data, node);
+    struct tmp_data *d2 = pheap_data(node2, struct tmp_data, node);
+
+
+    if (d1->key <= d2->key)
+        return 1;
+
+    return 0;
+}
+
+
+
+int compare_int_keys_gt(void* node1, void* node2) {
+
+    struct tmp_data *d1 = pheap_data(node1, struct tmp_data, node);
+    struct tmp_data *d2 = pheap_data(node2, struct tmp_data, node);
+
+
+    if (d1->key >= d2->key)
+        return 1;
+
+    return 0;
+}
+
+
+
+static int top_key(struct pheap_t *pheap)
+{
+    struct tmp_data *d = pheap_data(pheap_top(pheap), struct tmp_data, node);
+
+    return d->key;
+}
+
+
+
+// pop all and check the order, ret count of nodes or -1
+static int pop_sorted(struct pheap_t *pheap)
+{
+    int count = 0;
+    int prev  = -1;
+
+
+    while( !pheap_empty(pheap) )
+    {
+        int key = top_key(pheap);
+
+        if( key < prev )
+            return -1;
+
+        prev = key;
+        pheap_pop(pheap);
+        count++;
+    }
+
+    return count;
+}
+
+
+
+
+
+TEST(test_pheap_init)
+{
+    DECLARE_PHEAP(tmp_pheap, compare_int_keys);
+    struct pheap_t tmp_pheap2;
+
+    pheap_init(&tmp_pheap2, compare_int_keys);
+
+
+    TEST_ASSERT(pheap_empty(&tmp_pheap));
+    TEST_ASSERT(pheap_size(&tmp_pheap) == 0);
+    TEST_ASSERT(pheap_top(&tmp_pheap) == NULL);
+
+    TEST_ASSERT(pheap_empty(&tmp_pheap2));
+    TEST_ASSERT(tmp_pheap2.cmp_func == compare_int_keys);
+
+    pheap_pop(&tmp_pheap);              //pop from empty heap is no-op
+    TEST_ASSERT(pheap_size(&tmp_pheap) == 0);
+
+
+    TEST_PASS(NULL);
+}
+
+
+
+TEST(test_pheap_push_pop)
+{
+    const int SIZE = 1000;
+
+    DECLARE_PHEAP(tmp_pheap, compare_int_keys);
+
+    struct tmp_data items[SIZE];
+
+    unsigned int seed = 1;
+
+
+    for(int i = 0; i < SIZE; i++)
+    {
+        seed = seed * 1103515245 + 12345;
+        items[i].key = (seed >> 16) % 100;
+
+        pheap_push(&tmp_pheap, &items[i].node);
+    }
+
+    TEST_ASSERT(pheap_size(&tmp_pheap) == (size_t)SIZE);
+    TEST_ASSERT(pop_sorted(&tmp_pheap) == SIZE);
+    TEST_ASSERT(pheap_size(&tmp_pheap) == 0);
+    TEST_ASSERT(pheap_top(&tmp_pheap) == NULL);
+
+
+    //max heap
+    pheap_init(&tmp_pheap, compare_int_keys_gt);
+
+    for(int i = 0; i < 64; i++)
+    {
+        items[i].key = (i * 37) % 64;   //permutation of 0..63
+        pheap_push(&tmp_pheap, &items[i].node);
+    }
+
+    for(int i = 63; i >= 0; i--)
+    {
+        TEST_ASSERT(top_key(&tmp_pheap) == i);
+        pheap_pop(&tmp_pheap);
+    }
+
+    TEST_ASSERT(pheap_empty(&tmp_pheap));
+
+
+    TEST_PASS(NULL);
+}
+
+
+
+TEST(test_pheap_meld)
+{
+    DECLARE_PHEAP(tmp_pheap1, compare_int_keys);
+    DECLARE_PHEAP(tmp_pheap2, compare_int_keys);
+
+    struct tmp_data items[100];
+
+
+    for(int i = 0; i < 100; i++)
+    {
+        items[i].key = 100 - i;
+        pheap_push((i & 1) ? &tmp_pheap1 : &tmp_pheap2, &items[i].node);
+    }
+
+    pheap_meld(&tmp_pheap2, &tmp_pheap1);
+    TEST_ASSERT(pheap_size(&tmp_pheap1) == 100);
+    TEST_ASSERT(pheap_empty(&tmp_pheap2));
+    TEST_ASSERT(pheap_size(&tmp_pheap2) == 0);
+
+    pheap_meld(&tmp_pheap2, &tmp_pheap1);     //meld of empty heap
+    TEST_ASSERT(pheap_size(&tmp_pheap1) == 100);
+
+
+    for(int i = 1; i <= 100; i++)
+    {
+        TEST_ASSERT(top_key(&tmp_pheap1) == i);
+        pheap_pop(&tmp_pheap1);
+    }
+
+
+    //meld to empty heap
+    pheap_push(&tmp_pheap1, &items[0].node);
+    pheap_meld(&tmp_pheap1, &tmp_pheap2);
+    TEST_ASSERT(pheap_top(&tmp_pheap2) == &items[0].node);
+    TEST_ASSERT(pheap_size(&tmp_pheap2) == 1);
+
+
+    TEST_PASS(NULL);
+}
+
+
+
+TEST(test_pheap_decrease_key)
+{
+    const int SIZE = 500;
+
+    DECLARE_PHEAP(tmp_pheap, compare_int_keys);
+
+    struct tmp_data items[SIZE];
+
+    unsigned int seed = 3;
+
+
+    for(int i = 0; i < SIZE; i++)
+    {
+        seed = seed * 1103515245 + 12345;
+        items[i].key = 1000 + (seed >> 16) % 1000;
+        pheap_push(&tmp_pheap, &items[i].node);
+    }
+
+    struct pheap_node *top = pheap_top(&tmp_pheap);
+
+    pheap_pop(&tmp_pheap);  //make a tree (after push all nodes are children of root)
+    pheap_push(&tmp_pheap, top);
+
+
+    for(int i = 0; i < SIZE; i += 7)
+    {
+        seed = seed * 1103515245 + 12345;
+        items[i].key -= 1 + (seed >> 16) % 1000;
+        pheap_decrease_key(&tmp_pheap, &items[i].node);
+    }
+
+    items[10].key = 0;
+    pheap_decrease_key(&tmp_pheap, &items[10].node);
+    TEST_ASSERT(pheap_top(&tmp_pheap) == &items[10].node);
+
+    items[10].key = -1;     //the root
+    pheap_decrease_key(&tmp_pheap, &items[10].node);
+    TEST_ASSERT(pheap_top(&tmp_pheap) == &items[10].node);
+
+
+    TEST_ASSERT(pop_sorted(&tmp_pheap) == SIZE);
+
+
+    TEST_PASS(NULL);
+}
+
+
+
+TEST(test_pheap_remove_update)
+{
+    const int SIZE = 500;
+
+    DECLARE_PHEAP(tmp_pheap, compare_int_keys);
+
+    struct tmp_data items[SIZE];
+
+    unsigned int seed = 5;
+
+
+    for(int i = 0; i < SIZE; i++)
+    {
+        seed = seed * 1103515245 + 12345;
+        items[i].key = (seed >> 16) % 1000;
+        pheap_push(&tmp_pheap, &items[i].node);
+    }
+
+    pheap_pop(&tmp_pheap);
+    pheap_pop(&tmp_pheap);
+
+    int removed = 0;
+
+    for(int i = 0; i < SIZE; i += 3)
+    {
+        if( items[i].node.prev == NULL && pheap_top(&tmp_pheap) != &items[i].node )
+            continue;   //popped
+
+        pheap_remove(&tmp_pheap, &items[i].node);
+        removed++;
+    }
+
+    TEST_ASSERT(pheap_size(&tmp_pheap) == (size_t)(SIZE - 2 - removed));
+
+
+    //update: increase and decrease
+    for(int i = 1; i < SIZE; i += 3)
+    {
+        if( items[i].node.prev == NULL && pheap_top(&tmp_pheap) != &items[i].node )
+            continue;
+
+        seed = seed * 1103515245 + 12345;
+        items[i].key = (seed >> 16) % 1000;
+        pheap_update(&tmp_pheap, &items[i].node);
+    }
+
+    TEST_ASSERT(pop_sorted(&tmp_pheap) == SIZE - 2 - removed);
+
+
+    TEST_PASS(NULL);
+}
+
+
+
+ptest_func tests[] =
+{
+    test_pheap_init,
+    test_pheap_push_pop,
+    test_pheap_meld,
+    test_pheap_decrease_key,
+    test_pheap_remove_update,
+};
+
+
+
+
+
+MAIN_TESTS(tests)
@@ -0,0 +1,172 @@
+#include "stest.h"
+#include "pool.h"
+#include "dqueue.h"
+
+
+
+
+
+struct tmp_data
+{
+   dqueue_node list;
+   int         data;
+   char        payload[13];
+};
+
+
+
+
+
+TEST(test_pool_init)
+{
+    struct pool_t tmp_pool;
+    struct pool_stats stats;
+
+
+    TEST_ASSERT(pool_init(&tmp_pool, 0, 0) == -1);
+    TEST_ASSERT(pool_init(&tmp_pool, SIZE_MAX, 0) == -1);
+
+    //small objects are rounded up for the list_head of the free list
+    TEST_ASSERT(pool_init(&tmp_pool, 1, 0) == 0);
+    TEST_ASSERT(pool_obj_size(&tmp_pool) >= sizeof(struct list_head));
+    TEST_ASSERT(pool_obj_size(&tmp_pool) % POOL_ALIGN == 0);
+    TEST_ASSERT(tmp_pool.slab_objs * pool_obj_size(&tmp_pool) <= POOL_SLAB_SIZE);
+
+    TEST_ASSERT(pool_init(&tmp_pool, sizeof(struct tmp_data), 10) == 0);
+    TEST_ASSERT(pool_used(&tmp_pool) == 0);
+    TEST_ASSERT(pool_capacity(&tmp_pool) == 0);
+
+    pool_get_stats(&tmp_pool, &stats);
+    TEST_ASSERT(stats.slabs == 0 && stats.capacity == 0 && stats.free == 0 && stats.bytes == 0);
+
+    pool_free(&tmp_pool);
+
+
+    TEST_PASS(NULL);
+}
+
+
+
+TEST(test_pool_alloc_release)
+{
+    const int SIZE = 95;
+
+    struct pool_t tmp_pool;
+    struct pool_stats stats;
+    struct tmp_data *objs[SIZE];
+    DECLARE_DQUEUE(tmp_dqueue);
+
+
+    TEST_ASSERT(pool_init(&tmp_pool, sizeof(struct tmp_data), 10) == 0);
+
+    for(int i = 0; i < SIZE; i++)
+    {
+        objs[i] = pool_alloc(&tmp_pool);
+        TEST_ASSERT(objs[i] != NULL);
+        TEST_ASSERT((uintptr_t)objs[i] % POOL_ALIGN == 0);
+
+        objs[i]->data = i;
+        dqueue_push_back(&objs[i]->list, &tmp_dqueue);
+
+        //the objects of a slab are allocated in order of memory
+        if( i % 10 )
+        {
+            TEST_ASSERT((char *)objs[i] - (char *)objs[i-1] == (ptrdiff_t)pool_obj_size(&tmp_pool));
+        }
+    }
+
+    TEST_ASSERT(pool_used(&tmp_pool) == (size_t)SIZE);
+    TEST_ASSERT(pool_capacity(&tmp_pool) == 100);
+
+    pool_get_stats(&tmp_pool, &stats);
+    TEST_ASSERT(stats.slabs == 10 && stats.used == (size_t)SIZE && stats.free == 5);
+    TEST_ASSERT(stats.bytes >= stats.capacity * sizeof(struct tmp_data));
+
+
+    //the objects are not overlapped
+    int i = 0;
+    struct tmp_data *d;
+
+    dqueue_data_citer(d, &tmp_dqueue, struct tmp_data, list)
+        TEST_ASSERT(d->data == i++);
+
+    TEST_ASSERT(i == SIZE);
+
+
+    //the last released is allocated first
+    pool_release(&tmp_pool, objs[7]);
+    pool_release(&tmp_pool, objs[3]);
+    TEST_ASSERT(pool_used(&tmp_pool) == (size_t)SIZE - 2);
+    TEST_ASSERT(pool_alloc(&tmp_pool) == objs[3]);
+    TEST_ASSERT(pool_alloc(&tmp_pool) == objs[7]);
+    TEST_ASSERT(pool_used(&tmp_pool) == (size_t)SIZE);
+
+    pool_free(&tmp_pool);
+    TEST_ASSERT(pool_used(&tmp_pool) == 0 && pool_capacity(&tmp_pool) == 0);
+
+    //the pool can be used after pool_free
+    TEST_ASSERT(pool_alloc(&tmp_pool) != NULL);
+    pool_free(&tmp_pool);
+
+
+    TEST_PASS(NULL);
+}
+
+
+
+TEST(test_pool_bulk)
+{
+    const int SIZE = 50;
+
+    struct pool_t tmp_pool;
+    void *objs[SIZE];
+    void *objs2[SIZE];
+
+
+    TEST_ASSERT(pool_init(&tmp_pool, 24, 16) == 0);
+
+    TEST_ASSERT(pool_reserve(&tmp_pool, 40) == 0);
+    TEST_ASSERT(pool_capacity(&tmp_pool) == 48);
+    TEST_ASSERT(pool_used(&tmp_pool) == 0);
+
+
+    TEST_ASSERT(pool_alloc_bulk(&tmp_pool, objs, SIZE) == (size_t)SIZE);
+    TEST_ASSERT(pool_used(&tmp_pool) == (size_t)SIZE);
+    TEST_ASSERT(pool_capacity(&tmp_pool) == 64);
+
+    for(int i = 0; i < SIZE; i++)
+        for(int j = 0; j < i; j++)
+            TEST_ASSERT(objs[i] != objs[j]);
+
+
+    //the first of the array is allocated first
+    pool_release_bulk(&tmp_pool, objs + 10, 20);
+    TEST_ASSERT(pool_used(&tmp_pool) == (size_t)SIZE - 20);
+
+    TEST_ASSERT(pool_alloc_bulk(&tmp_pool, objs2, 20) == 20);
+
+    for(int i = 0; i < 20; i++)
+        TEST_ASSERT(objs2[i] == objs[10 + i]);
+
+    TEST_ASSERT(pool_capacity(&tmp_pool) == 64);
+
+    pool_free(&tmp_pool);
+
+
+    TEST_PASS(NULL);
+}
+
+
+
+ptest_func tests[] =
+{
+    test_pool_init,
+    test_pool_alloc_release,
+    test_pool_bulk,
+};
+
+
+
+
+
+MAIN_TESTS(tests)
@@ -298,6 +298,325 @@ TEST(test_pqueue_top3)
 
 
 
+TEST(test_pqueue_dary)
+{
+    const size_t SIZE = 1000;
+
+    struct pqueue_t tmp_pqueue4, tmp_pqueue8;
+
+    struct tmp_data items[SIZE];
+
+    unsigned int seed = 1;
+
+
+    TEST_ASSERT(pqueue_init(&tmp_pqueue4, 16, 4, compare_int_keys) == 0);
+    TEST_ASSERT(pqueue_init(&tmp_pqueue8, 16, 4, compare_int_keys) == 0);
+
+
+    for(size_t i = 0; i < SIZE; i++)
+    {
+        seed = seed * 1103515245 + 12345;
+        items[i].key = (seed >> 16) % 100;
+
+        TEST_ASSERT(pqueue4_push(&tmp_pqueue4, &items[i].key) == 0);
+        TEST_ASSERT(pqueue8_push(&tmp_pqueue8, &items[i].key) == 0);
+    }
+
+    TEST_ASSERT(tmp_pqueue4.size == SIZE);
+    TEST_ASSERT(tmp_pqueue8.size == SIZE);
+    TEST_ASSERT(tmp_pqueue4.capacity >= SIZE);
+
+
+    int prev = -1;
+
+    for(size_t i = 0; i < SIZE; i++)
+    {
+        int *top4 = pqueue4_top(&tmp_pqueue4);
+        int *top8 = pqueue8_top(&tmp_pqueue8);
+
+        TEST_ASSERT(*top4 >= prev);
+        TEST_ASSERT(*top4 == *top8);
+
+        prev = *top4;
+
+        pqueue4_pop(&tmp_pqueue4);
+        pqueue8_pop(&tmp_pqueue8);
+    }
+
+    TEST_ASSERT(tmp_pqueue4.size == 0);
+    TEST_ASSERT(pqueue4_top(&tmp_pqueue4) == NULL);
+    TEST_ASSERT(pqueue8_top(&tmp_pqueue8) == NULL);
+
+
+    free(tmp_pqueue4.items);
+    free(tmp_pqueue8.items);
+
+    TEST_PASS(NULL);
+}
+
+
+
+TEST(test_pqueue_grow_factor)
+{
+    struct pqueue_t tmp_pqueue;
+
+    struct tmp_data items[100];
+
+
+    TEST_ASSERT(pqueue_init(&tmp_pqueue, 0, 4, compare_int_keys) == 0);
+    TEST_ASSERT(tmp_pqueue.grow_factor == 0);
+
+    TEST_ASSERT(pqueue_set_grow_factor(&tmp_pqueue, 50)  == -1);  //capacity will not grow
+    TEST_ASSERT(pqueue_set_grow_factor(&tmp_pqueue, 100) == -1);
+    TEST_ASSERT(tmp_pqueue.grow_factor == 0);
+    TEST_ASSERT(pqueue_set_grow_factor(&tmp_pqueue, 200) == 0);
+
+
+    for(size_t i = 0; i < 4; i++)
+    {
+        items[i].key = 100 - i;
+        TEST_ASSERT(pqueue_push(&tmp_pqueue, &items[i].key) == 0);
+    }
+
+    TEST_ASSERT(tmp_pqueue.capacity == 4);
+
+    items[4].key = 96;
+    TEST_ASSERT(pqueue_push(&tmp_pqueue, &items[4].key) == 0);  //grow 4 -> 8
+    TEST_ASSERT(tmp_pqueue.capacity == 8);
+
+
+    for(size_t i = 5; i < 100; i++)
+    {
+        items[i].key = 100 - i;
+        TEST_ASSERT(pqueue_push(&tmp_pqueue, &items[i].key) == 0);
+    }
+
+    TEST_ASSERT(tmp_pqueue.size == 100);
+    TEST_ASSERT(tmp_pqueue.capacity == 128);
+
+
+    for(size_t i = 0; i < 100; i++)
+    {
+        TEST_ASSERT(pqueue_top(&tmp_pqueue) == &items[99-i].key);
+        pqueue_pop(&tmp_pqueue);
+    }
+
+
+    //geometric growth is at least inc_step
+    pqueue_free(&tmp_pqueue);
+    TEST_ASSERT(pqueue_init(&tmp_pqueue, 10, 1, compare_int_keys) == 0);
+    TEST_ASSERT(pqueue_set_grow_factor(&tmp_pqueue, 150) == 0);
+
+    TEST_ASSERT(pqueue_push(&tmp_pqueue, &items[0].key) == 0);
+    TEST_ASSERT(pqueue_push(&tmp_pqueue, &items[1].key) == 0);
+    TEST_ASSERT(tmp_pqueue.capacity == 11);
+
+
+    //1.5x of capacity 1 is 1, capacity must grow anyway
+    pqueue_free(&tmp_pqueue);
+    TEST_ASSERT(pqueue_init(&tmp_pqueue, 0, 1, compare_int_keys) == 0);
+    TEST_ASSERT(pqueue_set_grow_factor(&tmp_pqueue, 150) == 0);
+
+    TEST_ASSERT(pqueue_push(&tmp_pqueue, &items[0].key) == 0);
+    TEST_ASSERT(pqueue_push(&tmp_pqueue, &items[1].key) == 0);
+    TEST_ASSERT(tmp_pqueue.capacity == 2);
+
+
+    pqueue_free(&tmp_pqueue);
+
+    TEST_PASS(NULL);
+}
+
+
+
+TEST(test_pqueue_reserve)
+{
+    struct pqueue_t tmp_pqueue;
+
+    struct tmp_data items[100];
+
+
+    TEST_ASSERT(pqueue_init(&tmp_pqueue, 0, 4, compare_int_keys) == 0);
+
+    TEST_ASSERT(pqueue_reserve(&tmp_pqueue, 2) == 0);      //nothing to do
+    TEST_ASSERT(tmp_pqueue.capacity == 4);
+
+    TEST_ASSERT(pqueue_reserve(&tmp_pqueue, 100) == 0);
+    TEST_ASSERT(tmp_pqueue.capacity == 100);
+
+
+    for(size_t i = 0; i < 100; i++)
+    {
+        items[i].key = i;
+        TEST_ASSERT(pqueue_push(&tmp_pqueue, &items[i].key) == 0);
+    }
+
+    TEST_ASSERT(pqueue_push(&tmp_pqueue, &items[0].key) == -1);  //inc_step == 0
+    TEST_ASSERT(tmp_pqueue.capacity == 100);
+
+
+    //reserve keeps the items
+    TEST_ASSERT(pqueue_reserve(&tmp_pqueue, 200) == 0);
+    TEST_ASSERT(tmp_pqueue.size == 100);
+
+    for(size_t i = 0; i < 100; i++)
+    {
+        TEST_ASSERT(pqueue_top(&tmp_pqueue) == &items[i].key);
+        pqueue_pop(&tmp_pqueue);
+    }
+
+
+    pqueue_free(&tmp_pqueue);
+    TEST_ASSERT(tmp_pqueue.items    == NULL);
+    TEST_ASSERT(tmp_pqueue.size     == 0);
+    TEST_ASSERT(tmp_pqueue.capacity == 0);
+
+    //the freed queue is empty: top and pop do not touch the items
+    TEST_ASSERT(pqueue_top(&tmp_pqueue) == NULL);
+    pqueue_pop(&tmp_pqueue);
+    TEST_ASSERT(tmp_pqueue.size == 0);
+
+
+    //after free the queue can be used with reserve
+    TEST_ASSERT(pqueue_reserve(&tmp_pqueue, 1) == 0);
+    TEST_ASSERT(pqueue_push(&tmp_pqueue, &items[5].key) == 0);
+    TEST_ASSERT(pqueue_top(&tmp_pqueue) == &items[5].key);
+
+
+    pqueue_free(&tmp_pqueue);
+    pqueue_free(&tmp_pqueue);   //double free is safe
+
+    TEST_PASS(NULL);
+}
+
+
+
+TEST(test_pqueue_shrink_to_fit)
+{
+    struct pqueue_t tmp_pqueue;
+
+    struct tmp_data items[100];
+
+
+    TEST_ASSERT(pqueue_init(&tmp_pqueue, 0, 100, compare_int_keys) == 0);
+
+
+    for(size_t i = 0; i < 100; i++)
+    {
+        items[i].key = 100 - i;
+        TEST_ASSERT(pqueue_push(&tmp_pqueue, &items[i].key) == 0);
+    }
+
+    for(size_t i = 0; i < 90; i++)
+        pqueue_pop(&tmp_pqueue);
+
+
+    TEST_ASSERT(pqueue_shrink_to_fit(&tmp_pqueue) == 0);
+    TEST_ASSERT(tmp_pqueue.capacity == 10);
+    TEST_ASSERT(tmp_pqueue.size == 10);
+
+    for(size_t i = 0; i < 10; i++)
+    {
+        TEST_ASSERT(pqueue_top(&tmp_pqueue) == &items[9-i].key);
+        pqueue_pop(&tmp_pqueue);
+    }
+
+
+    TEST_ASSERT(pqueue_shrink_to_fit(&tmp_pqueue) == 0);    //at least 1 slot
+    TEST_ASSERT(tmp_pqueue.capacity == 1);
+    TEST_ASSERT(pqueue_top(&tmp_pqueue) == NULL);
+
+
+    pqueue_free(&tmp_pqueue);
+
+    TEST_PASS(NULL);
+}
+
+
+
+TEST(test_pqueue_push_n)
+{
+    const size_t SIZE = 1000;
+
+    struct pqueue_t tmp_pqueue, tmp_pqueue8;
+
+    struct tmp_data items[SIZE];
+
+    void *batch[SIZE];
+
+    unsigned int seed = 5;
+
+
+    for(size_t i = 0; i < SIZE; i++)
+    {
+        seed = seed * 1103515245 + 12345;
+        items[i].key = (seed >> 16) % 10000;
+        batch[i] = &items[i].key;
+    }
+
+
+    TEST_ASSERT(pqueue_init(&tmp_pqueue, 0, 10, compare_int_keys) == 0);
+    TEST_ASSERT(pqueue_push_n(&tmp_pqueue, batch, 11) == -1);    //full, inc_step == 0
+    TEST_ASSERT(tmp_pqueue.size == 0);
+    TEST_ASSERT(tmp_pqueue.capacity == 10);
+    pqueue_free(&tmp_pqueue);
+
+
+    TEST_ASSERT(pqueue_init(&tmp_pqueue,  16, 4, compare_int_keys) == 0);
+    TEST_ASSERT(pqueue_init(&tmp_pqueue8, 16, 4, compare_int_keys) == 0);
+
+    TEST_ASSERT(pqueue_push_n(&tmp_pqueue, batch, 0) == 0);
+    TEST_ASSERT(tmp_pqueue.size == 0);
+
+
+    //large batch (heapify), then small batches (sift_up) and single pushes
+    TEST_ASSERT(pqueue_push_n(&tmp_pqueue,  batch, 900) == 0);
+    TEST_ASSERT(pqueue8_push_n(&tmp_pqueue8, batch, 900) == 0);
+    TEST_ASSERT(tmp_pqueue.size == 900);
+    TEST_ASSERT(tmp_pqueue.capacity >= 900);
+
+    for(size_t i = 900; i < 990; i += 10)
+    {
+        TEST_ASSERT(pqueue_push_n(&tmp_pqueue,  batch + i, 10) == 0);
+        TEST_ASSERT(pqueue8_push_n(&tmp_pqueue8, batch + i, 10) == 0);
+    }
+
+    for(size_t i = 990; i < SIZE; i++)
+    {
+        TEST_ASSERT(pqueue_push(&tmp_pqueue,   batch[i]) == 0);
+        TEST_ASSERT(pqueue8_push(&tmp_pqueue8, batch[i]) == 0);
+    }
+
+    TEST_ASSERT(tmp_pqueue.size  == SIZE);
+    TEST_ASSERT(tmp_pqueue8.size == SIZE);
+
+
+    int prev = -1;
+
+    for(size_t i = 0; i < SIZE; i++)
+    {
+        int *top  = pqueue_top(&tmp_pqueue);
+        int *top8 = pqueue8_top(&tmp_pqueue8);
+
+        TEST_ASSERT(*top >= prev);
+        TEST_ASSERT(*top == *top8);
+        prev = *top;
+
+        pqueue_pop(&tmp_pqueue);
+        pqueue8_pop(&tmp_pqueue8);
+    }
+
+    TEST_ASSERT(pqueue_top(&tmp_pqueue) == NULL);
+
+
+    pqueue_free(&tmp_pqueue);
+    pqueue_free(&tmp_pqueue8);
+
+    TEST_PASS(NULL);
+}
+
+
+
 ptest_func tests[] =
 {
     test_pqueue_size,
@@ -305,6 +624,11 @@ ptest_func tests[] =
     test_pqueue_top,
     test_pqueue_top2,
     test_pqueue_top3,
+    test_pqueue_dary,
+    test_pqueue_grow_factor,
+    test_pqueue_reserve,
+    test_pqueue_shrink_to_fit,
+    test_pqueue_push_n,
 };
 
 
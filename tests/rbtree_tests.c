@@ -0,0 +1,364 @@
+#include "stest.h"
+#include "rbtree.h"
+
+
+
+
+
+struct tmp_data
+{
+   int                key;
+   int                id;
+   struct rbtree_node node;
+};
+
+
+
+static int tmp_cmp(const struct rbtree_node *node, const void *key)
+{
+    const struct tmp_data *d = rbtree_data(node, const struct tmp_data, node);
+    int k = *(const int *)key;
+
+    return (d->key > k) - (d->key < k);
+}
+
+
+
+static int color(const struct rbtree_node *node)
+{
+    return node ? (int)(node->parent_color & 1) : RBTREE_BLACK;
+}
+
+
+
+// ret black height of the subtree or -1 if the red-black properties are broken
+static int check_subtree(const struct rbtree_node *node, const struct rbtree_node *parent)
+{
+    int left, right;
+
+
+    if( !node )
+        return 1;
+
+    if( rbtree_parent(node) != parent )
+        return -1;
+
+    if( color(node) == RBTREE_RED && (color(node->left) == RBTREE_RED ||
+                                      color(node->right) == RBTREE_RED) )
+        return -1;
+
+    left  = check_subtree(node->left, node);
+    right = check_subtree(node->right, node);
+
+    if( left < 0 || left != right )
+        return -1;
+
+    return left + (color(node) == RBTREE_BLACK);
+}
+
+
+
+// check the red-black properties, the order of the keys and the size
+static int check_tree(const struct rbtree_t *tree)
+{
+    struct rbtree_node *it;
+    struct tmp_data *d, *prev = NULL;
+    size_t count = 0;
+
+
+    if( color(tree->root) != RBTREE_BLACK || check_subtree(tree->root, NULL) < 0 )
+        return 0;
+
+    rbtree_citer(it, tree)
+    {
+        d = rbtree_data(it, struct tmp_data, node);
+
+        if( prev && (prev->key > d->key || (prev->key == d->key && prev->id > d->id)) )
+            return 0;
+
+        prev = d;
+        count++;
+    }
+
+    return count == rbtree_size(tree);
+}
+
+
+
+
+
+TEST(test_rbtree_init)
+{
+    DECLARE_RBTREE(tmp_tree, tmp_cmp);
+    struct rbtree_t tmp_tree2;
+    int key = 1;
+
+
+    rbtree_init(&tmp_tree2, tmp_cmp);
+
+    TEST_ASSERT(rbtree_empty(&tmp_tree));
+    TEST_ASSERT(rbtree_empty(&tmp_tree2));
+    TEST_ASSERT(rbtree_size(&tmp_tree) == 0);
+    TEST_ASSERT(rbtree_first(&tmp_tree) == NULL);
+    TEST_ASSERT(rbtree_last(&tmp_tree) == NULL);
+    TEST_ASSERT(rbtree_lookup(&tmp_tree, &key) == NULL);
+    TEST_ASSERT(rbtree_lower_bound(&tmp_tree, &key) == NULL);
+    TEST_ASSERT(sizeof(struct rbtree_node) == 3 * sizeof(void *));
+
+
+    TEST_PASS(NULL);
+}
+
+
+
+TEST(test_rbtree_insert_lookup)
+{
+    const int SIZE = 1000;
+
+    DECLARE_RBTREE(tmp_tree, tmp_cmp);
+    struct tmp_data items[SIZE];
+    struct tmp_data *d;
+    int key;
+
+    unsigned int seed = 1;
+
+
+    //keys 0, 2, 4, ... in random order
+    for(int i = 0; i < SIZE; i++)
+    {
+        items[i].key = 2 * i;
+        items[i].id  = 0;
+    }
+
+    for(int i = SIZE - 1; i > 0; i--)
+    {
+        seed = seed * 1103515245 + 12345;
+        int j = (seed >> 16) % (i + 1);
+        int tmp = items[i].key;
+        items[i].key = items[j].key;
+        items[j].key = tmp;
+    }
+
+    for(int i = 0; i < SIZE; i++)
+        TEST_ASSERT(rbtree_insert_unique(&tmp_tree, &items[i].node, &items[i].key) == NULL);
+
+    TEST_ASSERT(rbtree_size(&tmp_tree) == (size_t)SIZE);
+    TEST_ASSERT(check_tree(&tmp_tree));
+
+
+    for(key = -1; key <= 2 * SIZE; key++)
+    {
+        d = rbtree_data_or_null(rbtree_lookup(&tmp_tree, &key), struct tmp_data, node);
+        TEST_ASSERT( (key >= 0 && key < 2 * SIZE && key % 2 == 0) ? (d && d->key == key) : d == NULL );
+
+        //lower_bound: the first even key >= key, upper_bound: > key
+        d = rbtree_data_or_null(rbtree_lower_bound(&tmp_tree, &key), struct tmp_data, node);
+        if( key < 2 * SIZE - 1 )
+        {
+            TEST_ASSERT(d && d->key == (key < 0 ? 0 : (key + 1) / 2 * 2));
+        }
+        else
+        {
+            TEST_ASSERT(d == NULL);
+        }
+
+        d = rbtree_data_or_null(rbtree_upper_bound(&tmp_tree, &key), struct tmp_data, node);
+        if( key < 2 * SIZE - 2 )
+        {
+            TEST_ASSERT(d && d->key == (key < 0 ? 0 : (key + 2) / 2 * 2));
+        }
+        else
+        {
+            TEST_ASSERT(d == NULL);
+        }
+    }
+
+
+    //the duplicate is not inserted
+    struct tmp_data dup = { 10, 1, { 0, NULL, NULL } };
+
+    TEST_ASSERT(rbtree_insert_unique(&tmp_tree, &dup.node, &dup.key) != NULL);
+    TEST_ASSERT(rbtree_size(&tmp_tree) == (size_t)SIZE);
+
+
+    TEST_PASS(NULL);
+}
+
+
+
+TEST(test_rbtree_duplicates)
+{
+    const int SIZE = 300;
+
+    DECLARE_RBTREE(tmp_tree, tmp_cmp);
+    struct tmp_data items[SIZE];
+    struct rbtree_node *it;
+    struct tmp_data *d;
+    int key = 1, id = 0;
+
+
+    //keys 0, 1, 2: equal keys are kept in order of the inserts (id)
+    for(int i = 0; i < SIZE; i++)
+    {
+        items[i].key = (i * 7) % 3;
+        items[i].id  = i;
+        rbtree_insert(&tmp_tree, &items[i].node, &items[i].key);
+    }
+
+    TEST_ASSERT(check_tree(&tmp_tree));
+
+    it = rbtree_lookup(&tmp_tree, &key);
+    TEST_ASSERT(it == rbtree_lower_bound(&tmp_tree, &key));
+
+    for(; it != rbtree_upper_bound(&tmp_tree, &key); it = rbtree_next(it))
+    {
+        d = rbtree_data(it, struct tmp_data, node);
+        TEST_ASSERT(d->key == 1 && d->id >= id);
+        id = d->id;
+    }
+
+    TEST_ASSERT(id == SIZE - 2);     //the last i with (i * 7) % 3 == 1
+
+
+    TEST_PASS(NULL);
+}
+
+
+
+TEST(test_rbtree_erase)
+{
+    const int SIZE = 2000;
+
+    DECLARE_RBTREE(tmp_tree, tmp_cmp);
+    struct tmp_data items[SIZE];
+    int in_tree[SIZE];
+
+    unsigned int seed = 3;
+
+
+    for(int i = 0; i < SIZE; i++)
+    {
+        seed = seed * 1103515245 + 12345;
+        items[i].key = (seed >> 16) % 500;       //with duplicates
+        items[i].id  = i;
+        in_tree[i]   = 1;
+        rbtree_insert(&tmp_tree, &items[i].node, &items[i].key);
+    }
+
+    //random erase and insert back
+    for(int step = 0; step < 20000; step++)
+    {
+        seed = seed * 1103515245 + 12345;
+        int i = (seed >> 16) % SIZE;
+
+        if( in_tree[i] )
+        {
+            rbtree_erase(&tmp_tree, &items[i].node);
+        }
+        else
+        {
+            items[i].id = SIZE + step;          //the last of the equal keys
+            rbtree_insert(&tmp_tree, &items[i].node, &items[i].key);
+        }
+
+        in_tree[i] = !in_tree[i];
+
+        if( step % 1000 == 0 )
+            TEST_ASSERT(check_tree(&tmp_tree));
+    }
+
+    TEST_ASSERT(check_tree(&tmp_tree));
+
+
+    //erase all in the cycle
+    struct rbtree_node *it, *tmp_it;
+    size_t size = rbtree_size(&tmp_tree);
+
+    rbtree_iter(it, tmp_it, &tmp_tree)
+    {
+        rbtree_erase(&tmp_tree, it);
+        size--;
+
+        TEST_ASSERT(rbtree_size(&tmp_tree) == size);
+        if( size % 100 == 0 )
+            TEST_ASSERT(check_tree(&tmp_tree));
+    }
+
+    TEST_ASSERT(rbtree_empty(&tmp_tree));
+
+
+    TEST_PASS(NULL);
+}
+
+
+
+TEST(test_rbtree_iter)
+{
+    const int SIZE = 100;
+
+    DECLARE_RBTREE(tmp_tree, tmp_cmp);
+    struct tmp_data items[SIZE];
+    struct rbtree_node *tmp_it;
+    struct tmp_data *d;
+    int key;
+
+
+    rbtree_data_citer(d, &tmp_tree, struct tmp_data, node)     //empty tree
+        TEST_ASSERT(0);
+
+    for(int i = 0; i < SIZE; i++)
+    {
+        items[i].key = (i * 37) % SIZE;
+        rbtree_insert(&tmp_tree, &items[i].node, &items[i].key);
+    }
+
+
+    key = 0;
+    rbtree_data_citer(d, &tmp_tree, struct tmp_data, node)
+        TEST_ASSERT(d->key == key++);
+
+    TEST_ASSERT(key == SIZE);
+
+    rbtree_data_criter(d, &tmp_tree, struct tmp_data, node)
+        TEST_ASSERT(d->key == --key);
+
+    TEST_ASSERT(key == 0);
+
+
+    //erase the odd keys in the cycle
+    rbtree_data_iter(d, &tmp_tree, tmp_it, struct tmp_data, node)
+    {
+        if( d->key & 1 )
+            rbtree_erase(&tmp_tree, &d->node);
+    }
+
+    TEST_ASSERT(rbtree_size(&tmp_tree) == (size_t)SIZE / 2);
+    TEST_ASSERT(check_tree(&tmp_tree));
+
+    key = 0;
+    rbtree_data_citer(d, &tmp_tree, struct tmp_data, node)
+    {
+        TEST_ASSERT(d->key == key);
+        key += 2;
+    }
+
+
+    TEST_PASS(NULL);
+}
+
+
+
+ptest_func tests[] =
+{
+    test_rbtree_init,
+    test_rbtree_insert_lookup,
+    test_rbtree_duplicates,
+    test_rbtree_erase,
+    test_rbtree_iter,
+};
+
+
+
+
+
+MAIN_TESTS(tests)
@@ -0,0 +1,309 @@
+#include "stest.h"
+#include "rpqueue.h"
+
+
+
+
+
+struct tmp_data
+{
+   int                 id;
+   struct rpqueue_node node;
+};
+
+
+
+static struct tmp_data* top_data(struct rpqueue_t *rpq)
+{
+    struct rpqueue_node *top = rpqueue_top(rpq);
+
+    return top ? rpqueue_data(top, struct tmp_data, node) : NULL;
+}
+
+
+
+// pop all and check the order, ret count of nodes or -1
+static int pop_sorted(struct rpqueue_t *rpq)
+{
+    struct rpqueue_node *top;
+    uint64_t prev = rpqueue_last(rpq);
+    int count     = 0;
+
+
+    while( !rpqueue_empty(rpq) )
+    {
+        top = rpqueue_top(rpq);
+
+        if( top->key < prev || rpqueue_last(rpq) != top->key )
+            return -1;
+
+        prev = top->key;
+        rpqueue_pop(rpq);
+        count++;
+    }
+
+    return count;
+}
+
+
+
+
+
+TEST(test_rpqueue_init)
+{
+    struct rpqueue_t tmp_rpq;
+
+    rpqueue_init(&tmp_rpq);
+
+
+    TEST_ASSERT(rpqueue_empty(&tmp_rpq));
+    TEST_ASSERT(rpqueue_size(&tmp_rpq) == 0);
+    TEST_ASSERT(rpqueue_last(&tmp_rpq) == 0);
+    TEST_ASSERT(rpqueue_top(&tmp_rpq) == NULL);
+
+    rpqueue_pop(&tmp_rpq);              //pop from empty queue is no-op
+    TEST_ASSERT(rpqueue_size(&tmp_rpq) == 0);
+
+
+    TEST_PASS(NULL);
+}
+
+
+
+TEST(test_rpqueue_push_pop)
+{
+    const int SIZE = 1000;
+
+    struct rpqueue_t tmp_rpq;
+    struct tmp_data items[SIZE];
+
+    unsigned int seed = 1;
+
+    rpqueue_init(&tmp_rpq);
+
+
+    for(int i = 0; i < SIZE; i++)
+    {
+        seed = seed * 1103515245 + 12345;
+        TEST_ASSERT(rpqueue_push(&tmp_rpq, &items[i].node, (seed >> 16) % 100000) == 0);
+    }
+
+    TEST_ASSERT(rpqueue_size(&tmp_rpq) == (size_t)SIZE);
+    TEST_ASSERT(pop_sorted(&tmp_rpq) == SIZE);
+    TEST_ASSERT(rpqueue_top(&tmp_rpq) == NULL);
+
+
+    //the keys less than the last popped key are rejected
+    uint64_t last = rpqueue_last(&tmp_rpq);
+
+    TEST_ASSERT(last > 0);
+    TEST_ASSERT(rpqueue_push(&tmp_rpq, &items[0].node, last - 1) == -1);
+    TEST_ASSERT(rpqueue_size(&tmp_rpq) == 0);
+    TEST_ASSERT(rpqueue_push(&tmp_rpq, &items[0].node, last) == 0);
+    TEST_ASSERT(rpqueue_top(&tmp_rpq) == &items[0].node);
+    rpqueue_pop(&tmp_rpq);
+
+
+    //equal keys are popped in FIFO order
+    for(int i = 0; i < 64; i++)
+    {
+        items[i].id = i;
+        rpqueue_push(&tmp_rpq, &items[i].node, last + 10 + (i & 1));
+    }
+
+    for(int i = 0; i < 64; i += 2)
+    {
+        TEST_ASSERT(top_data(&tmp_rpq)->id == i);
+        rpqueue_pop(&tmp_rpq);
+    }
+
+    for(int i = 1; i < 64; i += 2)
+    {
+        TEST_ASSERT(top_data(&tmp_rpq)->id == i);
+        rpqueue_pop(&tmp_rpq);
+    }
+
+    TEST_ASSERT(rpqueue_empty(&tmp_rpq));
+
+
+    TEST_PASS(NULL);
+}
+
+
+
+TEST(test_rpqueue_wide_keys)
+{
+    struct rpqueue_t tmp_rpq;
+    struct tmp_data items[66];
+
+    rpqueue_init(&tmp_rpq);
+
+
+    //one key for every bucket (and the max key)
+    for(int i = 63; i >= 0; i--)
+        rpqueue_push(&tmp_rpq, &items[i].node, (uint64_t)1 << i);
+
+    rpqueue_push(&tmp_rpq, &items[64].node, 0);
+    rpqueue_push(&tmp_rpq, &items[65].node, UINT64_MAX);
+
+    TEST_ASSERT(rpqueue_size(&tmp_rpq) == 66);
+    TEST_ASSERT(rpqueue_top(&tmp_rpq) == &items[64].node);
+    rpqueue_pop(&tmp_rpq);
+
+    for(int i = 0; i < 64; i++)
+    {
+        TEST_ASSERT(rpqueue_top(&tmp_rpq) == &items[i].node);
+        TEST_ASSERT(rpqueue_last(&tmp_rpq) == (uint64_t)1 << i);
+        rpqueue_pop(&tmp_rpq);
+    }
+
+    TEST_ASSERT(rpqueue_top(&tmp_rpq) == &items[65].node);
+    TEST_ASSERT(rpqueue_last(&tmp_rpq) == UINT64_MAX);
+    rpqueue_pop(&tmp_rpq);
+    TEST_ASSERT(rpqueue_empty(&tmp_rpq));
+
+
+    TEST_PASS(NULL);
+}
+
+
+
+TEST(test_rpqueue_remove_update)
+{
+    const int SIZE = 500;
+
+    struct rpqueue_t tmp_rpq;
+    struct tmp_data items[SIZE];
+    int in_queue[SIZE];
+
+    unsigned int seed = 5;
+
+    rpqueue_init(&tmp_rpq);
+
+
+    for(int i = 0; i < SIZE; i++)
+    {
+        seed = seed * 1103515245 + 12345;
+        rpqueue_push(&tmp_rpq, &items[i].node, 1000 + (seed >> 16) % 100000);
+        in_queue[i] = 1;
+    }
+
+    //pops make last > 0 and spread the nodes over the buckets
+    for(int i = 0; i < 10; i++)
+    {
+        in_queue[rpqueue_data(rpqueue_top(&tmp_rpq), struct tmp_data, node) - items] = 0;
+        rpqueue_pop(&tmp_rpq);
+    }
+
+
+    int removed = 0;
+
+    for(int i = 0; i < SIZE; i += 3)
+    {
+        if( !in_queue[i] )
+            continue;
+
+        rpqueue_remove(&tmp_rpq, &items[i].node);
+        in_queue[i] = 0;
+        removed++;
+    }
+
+    TEST_ASSERT(rpqueue_size(&tmp_rpq) == (size_t)(SIZE - 10 - removed));
+
+
+    //update: decrease (not below last), increase and invalid
+    uint64_t last = rpqueue_last(&tmp_rpq);
+
+    for(int i = 1; i < SIZE; i += 3)
+    {
+        if( !in_queue[i] )
+            continue;
+
+        TEST_ASSERT(rpqueue_update(&tmp_rpq, &items[i].node, last - 1) == -1);
+
+        seed = seed * 1103515245 + 12345;
+        TEST_ASSERT(rpqueue_update(&tmp_rpq, &items[i].node, last + (seed >> 16) % 200000) == 0);
+    }
+
+    TEST_ASSERT(rpqueue_size(&tmp_rpq) == (size_t)(SIZE - 10 - removed));
+    TEST_ASSERT(pop_sorted(&tmp_rpq) == SIZE - 10 - removed);
+
+
+    //remove the min of the bucket: the next top is the real min
+    last = rpqueue_last(&tmp_rpq);
+
+    rpqueue_push(&tmp_rpq, &items[0].node, last + 1000);
+    rpqueue_push(&tmp_rpq, &items[1].node, last + 1010);
+    rpqueue_push(&tmp_rpq, &items[2].node, last + 1020);
+    rpqueue_remove(&tmp_rpq, &items[0].node);
+
+    TEST_ASSERT(rpqueue_top(&tmp_rpq) == &items[1].node);
+    TEST_ASSERT(rpqueue_last(&tmp_rpq) == last + 1010);
+    TEST_ASSERT(pop_sorted(&tmp_rpq) == 2);
+
+
+    TEST_PASS(NULL);
+}
+
+
+
+TEST(test_rpqueue_monotone)
+{
+    const int SIZE = 200;
+
+    struct rpqueue_t tmp_rpq;
+    struct tmp_data items[SIZE];
+    uint64_t keys[SIZE];
+
+    unsigned int seed = 7;
+
+    rpqueue_init(&tmp_rpq);
+
+
+    for(int i = 0; i < SIZE; i++)
+    {
+        items[i].id = i;
+        keys[i]     = i;
+        rpqueue_push(&tmp_rpq, &items[i].node, keys[i]);
+    }
+
+    //hold: pop the min and push it back with a later key, check with linear search
+    for(int step = 0; step < 20000; step++)
+    {
+        struct tmp_data *top = top_data(&tmp_rpq);
+        uint64_t min = UINT64_MAX;
+
+        for(int i = 0; i < SIZE; i++)
+            if( keys[i] < min )
+                min = keys[i];
+
+        TEST_ASSERT(keys[top->id] == min);
+        rpqueue_pop(&tmp_rpq);
+
+        seed = seed * 1103515245 + 12345;
+        keys[top->id] = min + ((seed >> 16) % 5000);
+        TEST_ASSERT(rpqueue_push(&tmp_rpq, &top->node, keys[top->id]) == 0);
+    }
+
+    TEST_ASSERT(pop_sorted(&tmp_rpq) == SIZE);
+
+
+    TEST_PASS(NULL);
+}
+
+
+
+ptest_func tests[] =
+{
+    test_rpqueue_init,
+    test_rpqueue_push_pop,
+    test_rpqueue_wide_keys,
+    test_rpqueue_remove_update,
+    test_rpqueue_monotone,
+};
+
+
+
+
+
+MAIN_TESTS(tests)
@@ -0,0 +1,316 @@
+#include "stest.h"
+#include "skiplist.h"
+
+
+
+
+
+struct tmp_data
+{
+   int                  key;
+   int                  id;
+   struct skiplist_node node;
+};
+
+
+
+static int tmp_cmp(const struct skiplist_node *node, const void *key)
+{
+    const struct tmp_data *d = skiplist_data(node, const struct tmp_data, node);
+    int k = *(const int *)key;
+
+    return (d->key > k) - (d->key < k);
+}
+
+
+
+// check the order (key, id) on every level, the spans (by skiplist_at) and the size
+static int check_list(struct skiplist_t *sl)
+{
+    struct tmp_data *d, *prev = NULL;
+    struct skiplist_node *node, *it;
+    size_t count = 0;
+
+
+    skiplist_data_citer(d, sl, struct tmp_data, node)
+    {
+        if( prev && (prev->key > d->key || (prev->key == d->key && prev->id > d->id)) )
+            return 0;
+
+        if( skiplist_at(sl, count) != &d->node || d->node.height > sl->level )
+            return 0;
+
+        prev = d;
+        count++;
+    }
+
+    if( count != skiplist_size(sl) || skiplist_at(sl, count) != NULL )
+        return 0;
+
+
+    //every level is a sublist of level 0 (in the same order)
+    for(unsigned int level = 1; level < sl->level; level++)
+    {
+        it = skiplist_first(sl);
+
+        for(node = sl->links[level - 1].next; node; node = node->tower[level - 1].next)
+        {
+            while( it && it != node )
+                it = skiplist_next(sl, it);
+
+            if( !it || node->height <= level )
+                return 0;
+        }
+    }
+
+    return 1;
+}
+
+
+
+
+
+TEST(test_skiplist_init)
+{
+    struct skiplist_t tmp_sl;
+    int key = 1;
+
+
+    skiplist_init(&tmp_sl, tmp_cmp, 0);
+
+    TEST_ASSERT(skiplist_empty(&tmp_sl));
+    TEST_ASSERT(skiplist_size(&tmp_sl) == 0);
+    TEST_ASSERT(skiplist_first(&tmp_sl) == NULL);
+    TEST_ASSERT(skiplist_last(&tmp_sl) == NULL);
+    TEST_ASSERT(skiplist_lookup(&tmp_sl, &key) == NULL);
+    TEST_ASSERT(skiplist_lower_bound(&tmp_sl, &key) == NULL);
+    TEST_ASSERT(skiplist_at(&tmp_sl, 0) == NULL);
+    TEST_ASSERT(check_list(&tmp_sl));
+
+
+    TEST_PASS(NULL);
+}
+
+
+
+TEST(test_skiplist_insert_lookup)
+{
+    const int SIZE = 2000;
+
+    struct skiplist_t tmp_sl;
+    struct tmp_data items[SIZE];
+    struct tmp_data *d;
+    struct skiplist_node *node;
+
+    unsigned int seed = 1;
+
+
+    skiplist_init(&tmp_sl, tmp_cmp, 1);
+
+    //keys 0, 2, 4, ... in random order
+    for(int i = 0; i < SIZE; i++)
+        items[i].key = 2 * i;
+
+    for(int i = SIZE - 1; i > 0; i--)
+    {
+        seed = seed * 1103515245 + 12345;
+        int j = (seed >> 16) % (i + 1);
+        int tmp = items[i].key;
+        items[i].key = items[j].key;
+        items[j].key = tmp;
+    }
+
+    for(int i = 0; i < SIZE; i++)
+    {
+        items[i].id = 0;
+        TEST_ASSERT(skiplist_insert(&tmp_sl, &items[i].node, &items[i].key) == 0);
+    }
+
+    TEST_ASSERT(skiplist_size(&tmp_sl) == (size_t)SIZE);
+    TEST_ASSERT(tmp_sl.level > 1);
+    TEST_ASSERT(check_list(&tmp_sl));
+
+
+    for(int key = -1; key <= 2 * SIZE; key++)
+    {
+        node = skiplist_lookup(&tmp_sl, &key);
+        d    = node ? skiplist_data(node, struct tmp_data, node) : NULL;
+
+        if( key >= 0 && key < 2 * SIZE && key % 2 == 0 )
+        {
+            TEST_ASSERT(d && d->key == key);
+            TEST_ASSERT(skiplist_at(&tmp_sl, key / 2) == node);
+        }
+        else
+        {
+            TEST_ASSERT(d == NULL);
+        }
+
+        node = skiplist_lower_bound(&tmp_sl, &key);
+        d    = node ? skiplist_data(node, struct tmp_data, node) : NULL;
+
+        if( key < 2 * SIZE - 1 )
+        {
+            TEST_ASSERT(d && d->key == (key < 0 ? 0 : (key + 1) / 2 * 2));
+        }
+        else
+        {
+            TEST_ASSERT(d == NULL);
+        }
+    }
+
+
+    //the first, the last, next and prev
+    d = skiplist_data(skiplist_first(&tmp_sl), struct tmp_data, node);
+    TEST_ASSERT(d->key == 0);
+    d = skiplist_data(skiplist_last(&tmp_sl), struct tmp_data, node);
+    TEST_ASSERT(d->key == 2 * SIZE - 2);
+    TEST_ASSERT(skiplist_next(&tmp_sl, &d->node) == NULL);
+    TEST_ASSERT(skiplist_prev(&tmp_sl, skiplist_first(&tmp_sl)) == NULL);
+    TEST_ASSERT(skiplist_prev(&tmp_sl, &d->node) == skiplist_at(&tmp_sl, SIZE - 2));
+
+
+    skiplist_clear(&tmp_sl);
+    TEST_ASSERT(skiplist_empty(&tmp_sl));
+    TEST_ASSERT(check_list(&tmp_sl));
+
+
+    TEST_PASS(NULL);
+}
+
+
+
+TEST(test_skiplist_erase)
+{
+    const int SIZE = 2000;
+
+    struct skiplist_t tmp_sl;
+    struct tmp_data items[SIZE];
+    int in_list[SIZE];
+
+    unsigned int seed = 3;
+
+
+    skiplist_init(&tmp_sl, tmp_cmp, 3);
+
+    for(int i = 0; i < SIZE; i++)
+    {
+        seed = seed * 1103515245 + 12345;
+        items[i].key = (seed >> 16) % 200;       //many duplicates
+        items[i].id  = i;
+        in_list[i]   = 1;
+        TEST_ASSERT(skiplist_insert(&tmp_sl, &items[i].node, &items[i].key) == 0);
+    }
+
+    TEST_ASSERT(check_list(&tmp_sl));
+
+
+    //random erase (in the middle of the equal keys) and insert back
+    for(int step = 0; step < 20000; step++)
+    {
+        seed = seed * 1103515245 + 12345;
+        int i = (seed >> 16) % SIZE;
+
+        if( in_list[i] )
+        {
+            skiplist_erase(&tmp_sl, &items[i].node, &items[i].key);
+        }
+        else
+        {
+            items[i].id = SIZE + step;           //the last of the equal keys
+            TEST_ASSERT(skiplist_insert(&tmp_sl, &items[i].node, &items[i].key) == 0);
+        }
+
+        in_list[i] = !in_list[i];
+
+        if( step % 1000 == 0 )
+            TEST_ASSERT(check_list(&tmp_sl));
+    }
+
+    TEST_ASSERT(check_list(&tmp_sl));
+
+
+    //erase all in the cycle
+    struct tmp_data *d;
+    struct dlist_head *tmp_it;
+    size_t size = skiplist_size(&tmp_sl);
+
+    skiplist_data_iter(d, &tmp_sl, tmp_it, struct tmp_data, node)
+    {
+        skiplist_erase(&tmp_sl, &d->node, &d->key);
+        size--;
+
+        TEST_ASSERT(skiplist_size(&tmp_sl) == size);
+        if( size % 100 == 0 )
+            TEST_ASSERT(check_list(&tmp_sl));
+    }
+
+    TEST_ASSERT(skiplist_empty(&tmp_sl));
+    TEST_ASSERT(tmp_sl.level == 1);
+
+
+    TEST_PASS(NULL);
+}
+
+
+
+TEST(test_skiplist_seed)
+{
+    const int SIZE = 500;
+
+    struct skiplist_t tmp_sl1, tmp_sl2;
+    struct tmp_data items1[SIZE], items2[SIZE];
+    int same = 1;
+
+
+    //the same seed - the same heights
+    skiplist_init(&tmp_sl1, tmp_cmp, 42);
+    skiplist_init(&tmp_sl2, tmp_cmp, 42);
+
+    for(int i = 0; i < SIZE; i++)
+    {
+        items1[i].key = items2[i].key = i;
+        items1[i].id  = items2[i].id  = 0;
+        skiplist_insert(&tmp_sl1, &items1[i].node, &items1[i].key);
+        skiplist_insert(&tmp_sl2, &items2[i].node, &items2[i].key);
+        same = same && items1[i].node.height == items2[i].node.height;
+    }
+
+    TEST_ASSERT(same);
+    TEST_ASSERT(tmp_sl1.level == tmp_sl2.level);
+
+
+    //other seed - other heights
+    skiplist_clear(&tmp_sl2);
+    skiplist_init(&tmp_sl2, tmp_cmp, 43);
+
+    for(int i = 0; i < SIZE; i++)
+    {
+        skiplist_insert(&tmp_sl2, &items2[i].node, &items2[i].key);
+        same = same && items1[i].node.height == items2[i].node.height;
+    }
+
+    TEST_ASSERT(!same);
+
+    skiplist_clear(&tmp_sl1);
+    skiplist_clear(&tmp_sl2);
+
+
+    TEST_PASS(NULL);
+}
+
+
+
+ptest_func tests[] =
+{
+    test_skiplist_init,
+    test_skiplist_insert_lookup,
+    test_skiplist_erase,
+    test_skiplist_seed,
+};
+
+
+
+
+
+MAIN_TESTS(tests)
@@ -0,0 +1,234 @@
+#include "stest.h"
+#include "smmpqueue.h"
+
+
+
+
+
+struct tmp_data
+{
+   int key;
+   int data;
+};
+
+
+
+int compare_int_keys(void* key1, void* key2) {
+
+    int key1_v = *((int*)key1);
+    int key2_v = *((int*)key2);
+
+
+    if (key1_v <= key2_v)
+        return 1;
+
+    return 0;
+}
+
+
+
+// check the min-max property of every node
+static int is_valid_heap(struct smmpqueue_t *pqueue)
+{
+    for(size_t i = 1; i < pqueue->size; i++)
+    {
+        int key = *(int *)pqueue->items[i];
+
+        for(size_t a = PQUEUE_PARENT(i); ; a = PQUEUE_PARENT(a))
+        {
+            int akey = *(int *)pqueue->items[a];
+            int is_min_level = 1;
+
+            for(size_t t = a + 1; t > 1; t >>= 1)
+                is_min_level = !is_min_level;
+
+            if( is_min_level && (akey > key) )
+                return 0;
+
+            if( !is_min_level && (akey < key) )
+                return 0;
+
+            if( a == 0 )
+                break;
+        }
+    }
+
+    return 1;
+}
+
+
+
+
+
+TEST(test_smmpqueue_init)
+{
+    DECLARE_SMMPQUEUE(tmp_pqueue, 4, compare_int_keys);
+    struct smmpqueue_t tmp_pqueue2;
+    void *buf[4];
+
+    smmpqueue_init(&tmp_pqueue2, buf, 4, compare_int_keys);
+
+
+    TEST_ASSERT(smmpqueue_size(&tmp_pqueue) == 0);
+    TEST_ASSERT(smmpqueue_min(&tmp_pqueue) == NULL);
+    TEST_ASSERT(smmpqueue_max(&tmp_pqueue) == NULL);
+    TEST_ASSERT(tmp_pqueue2.items == buf);
+    TEST_ASSERT(tmp_pqueue2.capacity == 4);
+
+    smmpqueue_pop_min(&tmp_pqueue);     //pop from empty queue is no-op
+    smmpqueue_pop_max(&tmp_pqueue);
+    TEST_ASSERT(smmpqueue_size(&tmp_pqueue) == 0);
+
+
+    struct tmp_data d1 = { 1, 0 };
+    struct tmp_data d2 = { 2, 0 };
+
+    TEST_ASSERT(smmpqueue_push(&tmp_pqueue, &d1.key) == 0);
+    TEST_ASSERT(smmpqueue_min(&tmp_pqueue) == &d1.key);
+    TEST_ASSERT(smmpqueue_max(&tmp_pqueue) == &d1.key);
+
+    TEST_ASSERT(smmpqueue_push(&tmp_pqueue, &d2.key) == 0);
+    TEST_ASSERT(smmpqueue_min(&tmp_pqueue) == &d1.key);
+    TEST_ASSERT(smmpqueue_max(&tmp_pqueue) == &d2.key);
+
+    TEST_ASSERT(smmpqueue_push(&tmp_pqueue, &d2.key) == 0);
+    TEST_ASSERT(smmpqueue_push(&tmp_pqueue, &d2.key) == 0);
+    TEST_ASSERT(smmpqueue_push(&tmp_pqueue, &d2.key) == -1);  //queue is full
+
+
+    TEST_PASS(NULL);
+}
+
+
+
+TEST(test_smmpqueue_pop_min_max)
+{
+    const size_t SIZE = 1000;
+
+    DECLARE_SMMPQUEUE(tmp_pqueue, 1000, compare_int_keys);
+
+    struct tmp_data items[SIZE];
+
+    int count[100] = { 0 };
+
+    unsigned int seed = 1;
+
+
+    for(size_t i = 0; i < SIZE; i++)
+    {
+        seed = seed * 1103515245 + 12345;
+        items[i].key = (seed >> 16) % 100;
+        count[items[i].key]++;
+
+        TEST_ASSERT(smmpqueue_push(&tmp_pqueue, &items[i].key) == 0);
+    }
+
+    TEST_ASSERT(smmpqueue_size(&tmp_pqueue) == SIZE);
+    TEST_ASSERT(is_valid_heap(&tmp_pqueue));
+
+
+    //pop from both ends: min grows, max falls
+    int lo = 0, hi = 99;
+
+    for(size_t i = 0; i < SIZE; i++)
+    {
+        while( !count[lo] ) lo++;
+        while( !count[hi] ) hi--;
+
+        if( (seed >> 16) & 1 )
+        {
+            TEST_ASSERT(*(int *)smmpqueue_min(&tmp_pqueue) == lo);
+            smmpqueue_pop_min(&tmp_pqueue);
+            count[lo]--;
+        }
+        else
+        {
+            TEST_ASSERT(*(int *)smmpqueue_max(&tmp_pqueue) == hi);
+            smmpqueue_pop_max(&tmp_pqueue);
+            count[hi]--;
+        }
+
+        seed = seed * 1103515245 + 12345;
+
+        if( (i % 64) == 0 )
+        {
+            TEST_ASSERT(is_valid_heap(&tmp_pqueue));
+        }
+    }
+
+    TEST_ASSERT(smmpqueue_size(&tmp_pqueue) == 0);
+    TEST_ASSERT(smmpqueue_min(&tmp_pqueue) == NULL);
+
+
+    TEST_PASS(NULL);
+}
+
+
+
+TEST(test_smmpqueue_mixed)
+{
+    const size_t SIZE = 500;
+
+    DECLARE_SMMPQUEUE(tmp_pqueue, 500, compare_int_keys);
+
+    struct tmp_data items[SIZE];
+
+    unsigned int seed = 9;
+    size_t pushed = 0;
+
+
+    //push and pop in random order (sorted keys and random keys)
+    while( pushed < SIZE )
+    {
+        seed = seed * 1103515245 + 12345;
+
+        if( ((seed >> 16) % 3) && (pushed < SIZE) )
+        {
+            items[pushed].key = (pushed & 1) ? (int)pushed : (int)((seed >> 8) % 1000);
+            TEST_ASSERT(smmpqueue_push(&tmp_pqueue, &items[pushed].key) == 0);
+            pushed++;
+        }
+        else if( (seed >> 20) & 1 )
+        {
+            smmpqueue_pop_min(&tmp_pqueue);
+        }
+        else
+        {
+            smmpqueue_pop_max(&tmp_pqueue);
+        }
+
+        TEST_ASSERT(is_valid_heap(&tmp_pqueue));
+    }
+
+
+    int prev = -1;
+
+    while( smmpqueue_size(&tmp_pqueue) )
+    {
+        int key = *(int *)smmpqueue_min(&tmp_pqueue);
+
+        TEST_ASSERT(key >= prev);
+        TEST_ASSERT(*(int *)smmpqueue_max(&tmp_pqueue) >= key);
+        prev = key;
+
+        smmpqueue_pop_min(&tmp_pqueue);
+    }
+
+
+    TEST_PASS(NULL);
+}
+
+
+
+ptest_func tests[] =
+{
+    test_smmpqueue_init,
+    test_smmpqueue_pop_min_max,
+    test_smmpqueue_mixed,
+};
+
+
+
+
+
+MAIN_TESTS(tests)
@@ -323,6 +323,219 @@ TEST(test_spqueue_init)
 
 
 
+TEST(test_spqueue_dary)
+{
+    const size_t SIZE = 1000;
+
+    struct spqueue_t tmp_pqueue4, tmp_pqueue8;
+
+    void *buf4[SIZE];
+    void *buf8[SIZE];
+
+    struct tmp_data items[SIZE];
+
+    unsigned int seed = 1;
+
+
+    spqueue_init(&tmp_pqueue4, buf4, SIZE, compare_int_keys);
+    spqueue_init(&tmp_pqueue8, buf8, SIZE, compare_int_keys);
+
+
+    for(size_t i = 0; i < SIZE; i++)
+    {
+        seed = seed * 1103515245 + 12345;
+        items[i].key = (seed >> 16) % 100;   //many equal keys
+
+        TEST_ASSERT(spqueue4_push(&tmp_pqueue4, &items[i].key) == 0);
+        TEST_ASSERT(spqueue8_push(&tmp_pqueue8, &items[i].key) == 0);
+    }
+
+    TEST_ASSERT(tmp_pqueue4.size == SIZE);
+    TEST_ASSERT(tmp_pqueue8.size == SIZE);
+    TEST_ASSERT(spqueue4_push(&tmp_pqueue4, &items[0].key) == -1);  //queue is full
+    TEST_ASSERT(spqueue8_push(&tmp_pqueue8, &items[0].key) == -1);
+
+
+    int prev = -1;
+
+    for(size_t i = 0; i < SIZE; i++)
+    {
+        int *top4 = spqueue4_top(&tmp_pqueue4);
+        int *top8 = spqueue8_top(&tmp_pqueue8);
+
+        TEST_ASSERT(*top4 >= prev);
+        TEST_ASSERT(*top4 == *top8);
+
+        prev = *top4;
+
+        spqueue4_pop(&tmp_pqueue4);
+        spqueue8_pop(&tmp_pqueue8);
+    }
+
+    TEST_ASSERT(tmp_pqueue4.size == 0);
+    TEST_ASSERT(tmp_pqueue8.size == 0);
+    TEST_ASSERT(spqueue4_top(&tmp_pqueue4) == NULL);
+    TEST_ASSERT(spqueue8_top(&tmp_pqueue8) == NULL);
+
+    spqueue4_pop(&tmp_pqueue4);             //pop from empty queue is no-op
+    TEST_ASSERT(tmp_pqueue4.size == 0);
+
+
+    TEST_PASS(NULL);
+}
+
+
+
+TEST(test_spqueue_dary_gt)
+{
+    DECLARE_SPQUEUE(tmp_pqueue, 64, compare_int_keys_gt);
+
+    struct tmp_data items[64];
+
+
+    for(size_t i = 0; i < 64; i++)
+    {
+        items[i].key = (i * 37) % 64;    //permutation of 0..63
+        TEST_ASSERT(spqueue8_push(&tmp_pqueue, &items[i].key) == 0);
+    }
+
+
+    for(int i = 63; i >= 0; i--)
+    {
+        int *top = spqueue8_top(&tmp_pqueue);
+
+        TEST_ASSERT(*top == i);
+        spqueue8_pop(&tmp_pqueue);
+    }
+
+    TEST_ASSERT(tmp_pqueue.size == 0);
+
+
+    TEST_PASS(NULL);
+}
+
+
+
+TEST(test_spqueue_make_heap)
+{
+    const size_t SIZE = 1000;
+
+    struct spqueue_t tmp_pqueue;
+
+    void *buf[SIZE];
+
+    struct tmp_data items[SIZE];
+
+    unsigned int seed = 7;
+
+
+    spqueue_make_heap(&tmp_pqueue, buf, 0, SIZE, compare_int_keys);   //empty
+    TEST_ASSERT(tmp_pqueue.size == 0);
+    TEST_ASSERT(tmp_pqueue.capacity == SIZE);
+
+
+    for(size_t n = 1; n <= SIZE; n = n*3 + 1)   //1, 4, 13, 40, 121, 364
+    {
+        for(size_t i = 0; i < n; i++)
+        {
+            seed = seed * 1103515245 + 12345;
+            items[i].key = (seed >> 16) % 100;
+            buf[i] = &items[i].key;
+        }
+
+        spqueue_make_heap(&tmp_pqueue, buf, n, SIZE, compare_int_keys);
+        TEST_ASSERT(tmp_pqueue.size == n);
+        TEST_ASSERT(tmp_pqueue.items == buf);
+
+
+        int prev = -1;
+
+        for(size_t i = 0; i < n; i++)
+        {
+            int *top = spqueue_top(&tmp_pqueue);
+
+            TEST_ASSERT(*top >= prev);
+            prev = *top;
+
+            spqueue_pop(&tmp_pqueue);
+        }
+
+        TEST_ASSERT(spqueue_top(&tmp_pqueue) == NULL);
+    }
+
+
+    //push after make_heap
+    for(size_t i = 0; i < 10; i++)
+    {
+        items[i].key = 10 - i;
+        buf[i] = &items[i].key;
+    }
+
+    spqueue_make_heap(&tmp_pqueue, buf, 10, SIZE, compare_int_keys);
+
+    items[10].key = 0;
+    TEST_ASSERT(spqueue_push(&tmp_pqueue, &items[10].key) == 0);
+    TEST_ASSERT(spqueue_top(&tmp_pqueue) == &items[10].key);
+
+
+    TEST_PASS(NULL);
+}
+
+
+
+TEST(test_spqueue_dary_make_heap)
+{
+    const size_t SIZE = 1000;
+
+    struct spqueue_t tmp_pqueue4, tmp_pqueue8;
+
+    void *buf4[SIZE];
+    void *buf8[SIZE];
+
+    struct tmp_data items[SIZE];
+
+    unsigned int seed = 3;
+
+
+    for(size_t n = 1; n <= SIZE; n = n*3 + 1)
+    {
+        for(size_t i = 0; i < n; i++)
+        {
+            seed = seed * 1103515245 + 12345;
+            items[i].key = (seed >> 16) % 100;
+            buf4[i] = &items[i].key;
+            buf8[i] = &items[i].key;
+        }
+
+        spqueue4_make_heap(&tmp_pqueue4, buf4, n, SIZE, compare_int_keys);
+        spqueue8_make_heap(&tmp_pqueue8, buf8, n, SIZE, compare_int_keys);
+
+
+        int prev = -1;
+
+        for(size_t i = 0; i < n; i++)
+        {
+            int *top4 = spqueue4_top(&tmp_pqueue4);
+            int *top8 = spqueue8_top(&tmp_pqueue8);
+
+            TEST_ASSERT(*top4 >= prev);
+            TEST_ASSERT(*top4 == *top8);
+            prev = *top4;
+
+            spqueue4_pop(&tmp_pqueue4);
+            spqueue8_pop(&tmp_pqueue8);
+        }
+
+        TEST_ASSERT(tmp_pqueue4.size == 0);
+        TEST_ASSERT(tmp_pqueue8.size == 0);
+    }
+
+
+    TEST_PASS(NULL);
+}
+
+
+
 ptest_func tests[] =
 {
     test_spqueue_size,
@@ -330,6 +543,10 @@ ptest_func tests[] =
     test_spqueue_top2,
     test_spqueue_top3,
     test_spqueue_init,
+    test_spqueue_dary,
+    test_spqueue_dary_gt,
+    test_spqueue_make_heap,
+    test_spqueue_dary_make_heap,
 };
 
 
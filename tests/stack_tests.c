@@ -27,11 +27,15 @@ TEST(test_stack_empty)
 
 
     TEST_ASSERT(tmp_stack.size == 0);    //stack must be empty
+    TEST_ASSERT(stack_empty(&tmp_stack));
+    TEST_ASSERT(stack_size(&tmp_stack) == 0);
 
 
     stack_push(&d1.list, &tmp_stack);    //now d1 is first
 
     TEST_ASSERT(tmp_stack.size == 1);    //now stack is NOT empty
+    TEST_ASSERT(!stack_empty(&tmp_stack));
+    TEST_ASSERT(stack_size(&tmp_stack) == 1);
 
 
     TEST_PASS(NULL);
@@ -0,0 +1,297 @@
+#include <pthread.h>
+
+#include "stest.h"
+#include "tcpool.h"
+#include "dqueue.h"
+
+
+
+
+
+struct tmp_data
+{
+   dqueue_node list;
+   int         data;
+};
+
+
+
+
+
+TEST(test_tcpool_init)
+{
+    struct tcpool_t tmp_tcp;
+    struct tcpool_cache tmp_cache;
+    struct tcpool_stats stats;
+
+
+    TEST_ASSERT(tcpool_init(&tmp_tcp, 0, 0, 0) == -1);
+
+    TEST_ASSERT(tcpool_init(&tmp_tcp, sizeof(struct tmp_data), 0, 0) == 0);
+    TEST_ASSERT(tmp_tcp.mag_size == TCPOOL_MAG_SIZE);
+
+    TEST_ASSERT(tcpool_cache_init(&tmp_cache, &tmp_tcp) == 0);
+    TEST_ASSERT(tcpool_cache_size(&tmp_cache) == 0);
+
+    tcpool_get_stats(&tmp_tcp, &stats);
+    TEST_ASSERT(stats.mags == 2 && stats.depot_full == 0 && stats.depot_empty == 0);
+    TEST_ASSERT(stats.pool.slabs == 0 && stats.fills == 0);
+
+    //the magazines go back to the depot and are reused by the next cache
+    tcpool_cache_free(&tmp_cache);
+    tcpool_get_stats(&tmp_tcp, &stats);
+    TEST_ASSERT(stats.depot_empty == 2);
+
+    TEST_ASSERT(tcpool_cache_init(&tmp_cache, &tmp_tcp) == 0);
+    tcpool_get_stats(&tmp_tcp, &stats);
+    TEST_ASSERT(stats.mags == 2 && stats.depot_empty == 0);
+
+    tcpool_cache_free(&tmp_cache);
+    tcpool_free(&tmp_tcp);
+
+
+    TEST_PASS(NULL);
+}
+
+
+
+TEST(test_tcpool_alloc_release)
+{
+    const int SIZE = 100;
+    const size_t MAG = 8;
+
+    struct tcpool_t tmp_tcp;
+    struct tcpool_cache tmp_cache, tmp_cache2;
+    struct tcpool_stats stats;
+    struct tmp_data *objs[SIZE];
+    DECLARE_DQUEUE(tmp_dqueue);
+
+
+    TEST_ASSERT(tcpool_init(&tmp_tcp, sizeof(struct tmp_data), 32, MAG) == 0);
+    TEST_ASSERT(tcpool_cache_init(&tmp_cache, &tmp_tcp) == 0);
+
+    for(int i = 0; i < SIZE; i++)
+    {
+        objs[i] = tcpool_alloc(&tmp_cache);
+        TEST_ASSERT(objs[i] != NULL);
+
+        objs[i]->data = i;
+        dqueue_push_back(&objs[i]->list, &tmp_dqueue);
+    }
+
+    //the depot is empty: every magazine is filled from the slabs
+    tcpool_get_stats(&tmp_tcp, &stats);
+    TEST_ASSERT(stats.fills == (SIZE + MAG - 1) / MAG);
+    TEST_ASSERT(stats.gets == 0 && stats.puts == 0);
+    TEST_ASSERT(stats.pool.used == stats.fills * MAG);
+    TEST_ASSERT(tcpool_cache_size(&tmp_cache) == stats.fills * MAG - SIZE);
+    TEST_ASSERT(tmp_cache.allocs == (size_t)SIZE);
+
+    for(int i = 0; i < SIZE; i++)
+    {
+        struct tmp_data *obj = dqueue_data(dqueue_begin(&tmp_dqueue), struct tmp_data, list);
+
+        TEST_ASSERT(obj->data == i);
+        dqueue_pop_front(&tmp_dqueue);
+        tcpool_release(&tmp_cache, obj);
+    }
+
+    //the cache keeps two magazines, the rest are full in the depot
+    tcpool_get_stats(&tmp_tcp, &stats);
+    TEST_ASSERT(tcpool_cache_size(&tmp_cache) <= 2 * MAG);
+    TEST_ASSERT(stats.depot_full == stats.puts);
+    TEST_ASSERT(stats.depot_full * MAG + tcpool_cache_size(&tmp_cache) == stats.pool.used);
+    TEST_ASSERT(tmp_cache.releases == (size_t)SIZE);
+
+
+    //the other cache takes the full magazines of the depot
+    TEST_ASSERT(tcpool_cache_init(&tmp_cache2, &tmp_tcp) == 0);
+
+    size_t fills = stats.fills;
+    size_t full  = stats.depot_full;
+
+    TEST_ASSERT(full * MAG <= (size_t)SIZE);
+
+    for(size_t i = 0; i < full * MAG; i++)
+        objs[i] = tcpool_alloc(&tmp_cache2);
+
+    tcpool_get_stats(&tmp_tcp, &stats);
+    TEST_ASSERT(stats.fills == fills && stats.gets == full && stats.depot_full == 0);
+
+
+    for(size_t i = 0; i < full * MAG; i++)
+        tcpool_release(&tmp_cache2, objs[i]);
+
+
+    //the partial magazines go back to the slabs
+    tcpool_cache_free(&tmp_cache);
+    tcpool_cache_free(&tmp_cache2);
+
+    tcpool_get_stats(&tmp_tcp, &stats);
+    TEST_ASSERT(stats.pool.used == stats.depot_full * MAG);
+
+    tcpool_free(&tmp_tcp);
+
+
+    TEST_PASS(NULL);
+}
+
+
+
+
+
+
+#define COUNT_THREADS   4
+#define ROUNDS          2000
+#define BATCH           50
+
+
+
+struct thread_data
+{
+    struct tcpool_t *tcp;
+    pthread_mutex_t *lock;
+    struct stack_t  *shared;    // objects released by the other threads
+    int              id;
+    int              errors;
+};
+
+
+
+//every thread allocs a batch, checks it and releases it (half of the batch
+//goes to the shared stack and is released by any thread)
+static void* thread_func(void *arg)
+{
+    struct thread_data *td = arg;
+    struct tcpool_cache cache;
+    struct tmp_data *obj;
+    struct list_head *node;
+    DECLARE_DQUEUE(tmp_dqueue);
+    int i, j;
+
+
+    if( tcpool_cache_init(&cache, td->tcp) )
+    {
+        td->errors++;
+        return NULL;
+    }
+
+
+    for(i = 0; i < ROUNDS; i++)
+    {
+        for(j = 0; j < BATCH; j++)
+        {
+            obj = tcpool_alloc(&cache);
+            if( !obj )
+            {
+                td->errors++;
+                break;
+            }
+
+            obj->data = td->id * BATCH + j;
+            dqueue_push_back(&obj->list, &tmp_dqueue);
+        }
+
+        for(j = 0; !dqueue_empty(&tmp_dqueue); j++)
+        {
+            obj = dqueue_data(dqueue_begin(&tmp_dqueue), struct tmp_data, list);
+            dqueue_pop_front(&tmp_dqueue);
+
+            if( obj->data != td->id * BATCH + j )
+                td->errors++;
+
+            if( j & 1 )
+            {
+                tcpool_release(&cache, obj);
+                continue;
+            }
+
+            pthread_mutex_lock(td->lock);
+            stack_push((struct list_head *)obj, td->shared);
+            node = stack_top(td->shared);
+            stack_pop(td->shared);
+            pthread_mutex_unlock(td->lock);
+
+            tcpool_release(&cache, node);
+        }
+    }
+
+    tcpool_cache_free(&cache);
+
+    return NULL;
+}
+
+
+
+TEST(test_tcpool_threads)
+{
+    struct tcpool_t tmp_tcp;
+    struct tcpool_cache tmp_cache;
+    struct tcpool_stats stats;
+    pthread_mutex_t lock;
+    DECLARE_STACK(shared);
+
+    struct thread_data td[COUNT_THREADS];
+    pthread_t          threads[COUNT_THREADS];
+    int i;
+
+
+    TEST_ASSERT(tcpool_init(&tmp_tcp, sizeof(struct tmp_data), 0, 16) == 0);
+    pthread_mutex_init(&lock, NULL);
+
+    for(i = 0; i < COUNT_THREADS; i++)
+    {
+        td[i].tcp    = &tmp_tcp;
+        td[i].lock   = &lock;
+        td[i].shared = &shared;
+        td[i].id     = i;
+        td[i].errors = 0;
+
+        TEST_ASSERT(pthread_create(&threads[i], NULL, thread_func, &td[i]) == 0);
+    }
+
+    for(i = 0; i < COUNT_THREADS; i++)
+    {
+        pthread_join(threads[i], NULL);
+        TEST_ASSERT(td[i].errors == 0);
+    }
+
+    TEST_ASSERT(stack_empty(&shared));
+
+
+    //all the objects are free: in the full magazines of the depot or in the slabs
+    tcpool_get_stats(&tmp_tcp, &stats);
+    TEST_ASSERT(stats.pool.used == stats.depot_full * 16);
+    TEST_ASSERT(stats.pool.used <= stats.pool.capacity);
+    TEST_ASSERT(stats.gets + stats.fills > 0);
+
+    //the objects released by a thread are allocated by the other
+    TEST_ASSERT(tcpool_cache_init(&tmp_cache, &tmp_tcp) == 0);
+    for(size_t n = 0; n < stats.depot_full * 16; n++)
+        TEST_ASSERT(tcpool_alloc(&tmp_cache) != NULL);
+
+    tcpool_get_stats(&tmp_tcp, &stats);
+    TEST_ASSERT(stats.depot_full == 0);
+
+    tcpool_cache_free(&tmp_cache);
+    tcpool_free(&tmp_tcp);
+    pthread_mutex_destroy(&lock);
+
+
+    TEST_PASS(NULL);
+}
+
+
+
+ptest_func tests[] =
+{
+    test_tcpool_init,
+    test_tcpool_alloc_release,
+    test_tcpool_threads,
+};
+
+
+
+
+
+MAIN_TESTS(tests)
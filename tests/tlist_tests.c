@@ -0,0 +1,782 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <stdint.h>
+
+
+
+#include "stest.h"
+#include "tlist.h"
+
+
+
+
+
+struct tmp_data
+{
+   struct list_head list;
+   int              data;
+};
+
+
+
+#define DECLARE_TMP_DATA(name) \
+    struct tmp_data name = { {NULL}, 0}
+
+
+
+//the cached tail must always be the real last node of the ring
+static int tail_is_valid(const struct tlist_head *tlist)
+{
+    return tlist->tail == list_last(&tlist->head);
+}
+
+
+
+
+
+TEST(test_tlist_empty)
+{
+    DECLARE_TLIST_HEAD(tmp_list);
+    DECLARE_TMP_DATA(d1);
+
+
+    TEST_ASSERT(tlist_empty(&tmp_list));          //list must be empty
+    TEST_ASSERT(tlist_last(&tmp_list) == &tmp_list.head);
+
+
+    tlist_push_front(&d1.list, &tmp_list);        //now d1 is first
+
+    TEST_ASSERT(!tlist_empty(&tmp_list));         //now list is NOT empty
+    TEST_ASSERT(tlist_last(&tmp_list) == &d1.list);
+
+
+    TEST_PASS(NULL);
+}
+
+
+
+TEST(test_tlist_is_first_last)
+{
+    DECLARE_TLIST_HEAD(tmp_list);
+
+    DECLARE_TMP_DATA(d1);
+    DECLARE_TMP_DATA(d2);
+    DECLARE_TMP_DATA(d3);
+
+
+    tlist_push_front(&d1.list, &tmp_list);              //[head] -> [d1]
+
+    TEST_ASSERT(tlist_is_first(&d1.list, &tmp_list));
+    TEST_ASSERT(tlist_is_last(&d1.list, &tmp_list));
+
+
+    tlist_push_back(&d2.list, &tmp_list);               //[head] -> [d1] -> [d2]
+
+    TEST_ASSERT(tlist_is_first(&d1.list, &tmp_list));
+    TEST_ASSERT(tlist_is_last(&d2.list, &tmp_list));
+    TEST_ASSERT(!tlist_is_last(&d1.list, &tmp_list));
+
+
+    tlist_push_front(&d3.list, &tmp_list);              //[head] -> [d3] -> [d1] -> [d2]
+
+    TEST_ASSERT(tlist_is_first(&d3.list, &tmp_list));
+    TEST_ASSERT(tlist_is_last(&d2.list, &tmp_list));
+    TEST_ASSERT(tail_is_valid(&tmp_list));
+
+
+    TEST_PASS(NULL);
+}
+
+
+
+TEST(test_tlist_is_singular)
+{
+    DECLARE_TLIST_HEAD(tmp_list);
+
+    DECLARE_TMP_DATA(d1);
+    DECLARE_TMP_DATA(d2);
+
+
+    TEST_ASSERT(!tlist_is_singular(&tmp_list));  //list must be empty (not singular)
+
+    tlist_push_back(&d1.list, &tmp_list);
+    TEST_ASSERT(tlist_is_singular(&tmp_list));   //in list only d1
+
+    tlist_push_back(&d2.list, &tmp_list);
+    TEST_ASSERT(!tlist_is_singular(&tmp_list));  //in list d1,d2
+
+
+    TEST_PASS(NULL);
+}
+
+
+
+TEST(test_tlist_size)
+{
+    DECLARE_TLIST_HEAD(tmp_list);
+
+    DECLARE_TMP_DATA(d1);
+    DECLARE_TMP_DATA(d2);
+    DECLARE_TMP_DATA(d3);
+
+
+    TEST_ASSERT(tlist_size(&tmp_list) == 0);
+
+    tlist_push_back(&d1.list, &tmp_list);
+    TEST_ASSERT(tlist_size(&tmp_list) == 1);
+
+    tlist_push_back(&d2.list, &tmp_list);
+    TEST_ASSERT(tlist_size(&tmp_list) == 2);
+
+    tlist_push_front(&d3.list, &tmp_list);
+    TEST_ASSERT(tlist_size(&tmp_list) == 3);
+
+
+    tlist_pop_back(&tmp_list);
+    TEST_ASSERT(tlist_size(&tmp_list) == 2);
+    TEST_ASSERT(tail_is_valid(&tmp_list));
+
+    tlist_pop_front(&tmp_list);
+    TEST_ASSERT(tlist_size(&tmp_list) == 1);
+    TEST_ASSERT(tail_is_valid(&tmp_list));
+
+    tlist_pop_front(&tmp_list);
+    TEST_ASSERT(tlist_size(&tmp_list) == 0);
+    TEST_ASSERT(tlist_last(&tmp_list) == &tmp_list.head);
+
+    tlist_pop_back(&tmp_list);                  //pop from empty list
+    TEST_ASSERT(tlist_size(&tmp_list) == 0);
+    TEST_ASSERT(tlist_last(&tmp_list) == &tmp_list.head);
+
+
+    TEST_PASS(NULL);
+}
+
+
+
+TEST(test_tlist_prev)
+{
+    DECLARE_TLIST_HEAD(tmp_list);
+
+    DECLARE_TMP_DATA(d1);
+    DECLARE_TMP_DATA(d2);
+
+
+    TEST_ASSERT(tlist_prev(&tmp_list.head, &tmp_list) == &tmp_list.head);
+
+    tlist_push_back(&d1.list, &tmp_list);
+    tlist_push_back(&d2.list, &tmp_list);       //[head] -> [d1] -> [d2]
+
+    TEST_ASSERT(tlist_prev(&tmp_list.head, &tmp_list) == &d2.list);
+    TEST_ASSERT(tlist_prev(&d2.list, &tmp_list) == &d1.list);
+    TEST_ASSERT(tlist_prev(&d1.list, &tmp_list) == &tmp_list.head);
+
+
+    TEST_PASS(NULL);
+}
+
+
+
+TEST(test_tlist_push_pop)
+{
+    DECLARE_TLIST_HEAD(tmp_list);
+
+    const int COUNT_NODES = 100;
+    int i;
+    struct tmp_data  nodes[COUNT_NODES];
+    struct tmp_data  *it;
+
+
+    for(i=0; i < COUNT_NODES; i++)
+    {
+        nodes[i].data = i;
+        tlist_push_back(&nodes[i].list, &tmp_list);
+        TEST_ASSERT(tlist_last(&tmp_list) == &nodes[i].list);
+    }
+
+
+    i=0;
+    tlist_data_citer(it, &tmp_list, struct tmp_data, list)
+    {
+        TEST_ASSERT(it->data == i);
+        i++;
+    }
+    TEST_ASSERT(i == COUNT_NODES);
+
+
+    //FIFO
+    for(i=0; i < COUNT_NODES; i++)
+    {
+        it = tlist_first_data(&tmp_list, struct tmp_data, list);
+        TEST_ASSERT(it->data == i);
+        tlist_pop_front(&tmp_list);
+        TEST_ASSERT(list_empty(&nodes[i].list));
+        TEST_ASSERT(tail_is_valid(&tmp_list));
+    }
+
+    TEST_ASSERT(tlist_empty(&tmp_list));
+    TEST_ASSERT(tlist_last(&tmp_list) == &tmp_list.head);
+
+
+    TEST_PASS(NULL);
+}
+
+
+
+TEST(test_tlist_del)
+{
+    DECLARE_TLIST_HEAD(tmp_list);
+
+    DECLARE_TMP_DATA(d1);
+    DECLARE_TMP_DATA(d2);
+    DECLARE_TMP_DATA(d3);
+
+
+    tlist_push_back(&d1.list, &tmp_list);
+    tlist_push_back(&d2.list, &tmp_list);
+    tlist_push_back(&d3.list, &tmp_list);       //[head] -> [d1] -> [d2] -> [d3]
+
+
+    tlist_del(&d2.list, &tmp_list);             //[head] -> [d1] -> [d3]
+    TEST_ASSERT(list_empty(&d2.list));
+    TEST_ASSERT(tlist_last(&tmp_list) == &d3.list);
+    TEST_ASSERT(tlist_size(&tmp_list) == 2);
+
+    tlist_del(&d3.list, &tmp_list);             //[head] -> [d1]
+    TEST_ASSERT(tlist_last(&tmp_list) == &d1.list);
+    TEST_ASSERT(tail_is_valid(&tmp_list));
+
+    tlist_del(&d1.list, &tmp_list);             //[head]
+    TEST_ASSERT(tlist_empty(&tmp_list));
+    TEST_ASSERT(tlist_last(&tmp_list) == &tmp_list.head);
+
+
+    //the list must be usable after that
+    tlist_push_back(&d2.list, &tmp_list);
+    TEST_ASSERT(tlist_is_first(&d2.list, &tmp_list));
+    TEST_ASSERT(tlist_is_last(&d2.list, &tmp_list));
+
+
+    TEST_PASS(NULL);
+}
+
+
+
+TEST(test_tlist_replace)
+{
+    DECLARE_TLIST_HEAD(tmp_list);
+
+    DECLARE_TMP_DATA(d1);
+    DECLARE_TMP_DATA(d2);
+    DECLARE_TMP_DATA(d3);
+    DECLARE_TMP_DATA(d4);
+
+
+    tlist_push_back(&d1.list, &tmp_list);
+    tlist_push_back(&d2.list, &tmp_list);       //[head] -> [d1] -> [d2]
+
+
+    tlist_replace_init(&d2.list, &d3.list, &tmp_list);  //[head] -> [d1] -> [d3]
+    TEST_ASSERT(list_empty(&d2.list));
+    TEST_ASSERT(tlist_last(&tmp_list) == &d3.list);
+    TEST_ASSERT(tail_is_valid(&tmp_list));
+
+    tlist_replace_init(&d1.list, &d4.list, &tmp_list);  //[head] -> [d4] -> [d3]
+    TEST_ASSERT(tlist_is_first(&d4.list, &tmp_list));
+    TEST_ASSERT(tlist_last(&tmp_list) == &d3.list);
+    TEST_ASSERT(tlist_size(&tmp_list) == 2);
+
+
+    TEST_PASS(NULL);
+}
+
+
+
+TEST(test_tlist_move)
+{
+    DECLARE_TLIST_HEAD(tmp_list);
+
+    DECLARE_TMP_DATA(d1);
+    DECLARE_TMP_DATA(d2);
+    DECLARE_TMP_DATA(d3);
+
+
+    tlist_push_back(&d1.list, &tmp_list);
+    tlist_push_back(&d2.list, &tmp_list);
+    tlist_push_back(&d3.list, &tmp_list);       //[head] -> [d1] -> [d2] -> [d3]
+
+
+    tlist_move_to_front(&d3.list, &tmp_list);   //[head] -> [d3] -> [d1] -> [d2]
+    TEST_ASSERT(tlist_is_first(&d3.list, &tmp_list));
+    TEST_ASSERT(tlist_is_last(&d2.list, &tmp_list));
+    TEST_ASSERT(tail_is_valid(&tmp_list));
+
+    tlist_move_to_back(&d3.list, &tmp_list);    //[head] -> [d1] -> [d2] -> [d3]
+    TEST_ASSERT(tlist_is_first(&d1.list, &tmp_list));
+    TEST_ASSERT(tlist_is_last(&d3.list, &tmp_list));
+    TEST_ASSERT(tail_is_valid(&tmp_list));
+
+    tlist_move_to_back(&d2.list, &tmp_list);    //[head] -> [d1] -> [d3] -> [d2]
+    TEST_ASSERT(tlist_is_first(&d1.list, &tmp_list));
+    TEST_ASSERT(tlist_is_last(&d2.list, &tmp_list));
+    TEST_ASSERT(tail_is_valid(&tmp_list));
+
+    tlist_move_to_back(&d2.list, &tmp_list);    //last node to back (no changes)
+    TEST_ASSERT(tlist_is_last(&d2.list, &tmp_list));
+    TEST_ASSERT(tlist_size(&tmp_list) == 3);
+
+
+    TEST_PASS(NULL);
+}
+
+
+
+TEST(test_tlist_rotate)
+{
+    DECLARE_TLIST_HEAD(tmp_list);
+
+    DECLARE_TMP_DATA(d1);
+    DECLARE_TMP_DATA(d2);
+    DECLARE_TMP_DATA(d3);
+
+
+    tlist_rotate_left(&tmp_list);               //empty list
+    tlist_rotate_right(&tmp_list);
+    TEST_ASSERT(tlist_empty(&tmp_list));
+
+
+    tlist_push_back(&d1.list, &tmp_list);
+    tlist_push_back(&d2.list, &tmp_list);
+    tlist_push_back(&d3.list, &tmp_list);       //[head] -> [d1] -> [d2] -> [d3]
+
+
+    tlist_rotate_left(&tmp_list);               //[head] -> [d2] -> [d3] -> [d1]
+    TEST_ASSERT(tlist_is_first(&d2.list, &tmp_list));
+    TEST_ASSERT(tlist_is_last(&d1.list, &tmp_list));
+    TEST_ASSERT(tail_is_valid(&tmp_list));
+
+
+    tlist_rotate_right(&tmp_list);              //[head] -> [d1] -> [d2] -> [d3]
+    TEST_ASSERT(tlist_is_first(&d1.list, &tmp_list));
+    TEST_ASSERT(tlist_is_last(&d3.list, &tmp_list));
+    TEST_ASSERT(tail_is_valid(&tmp_list));
+
+
+    tlist_rotate_right(&tmp_list);              //[head] -> [d3] -> [d1] -> [d2]
+    TEST_ASSERT(tlist_is_first(&d3.list, &tmp_list));
+    TEST_ASSERT(tlist_is_last(&d2.list, &tmp_list));
+    TEST_ASSERT(tail_is_valid(&tmp_list));
+
+
+    TEST_PASS(NULL);
+}
+
+
+
+TEST(test_tlist_splice_front)
+{
+    DECLARE_TLIST_HEAD(tmp_list1);
+    DECLARE_TLIST_HEAD(tmp_list2);
+
+    const int COUNT_NODES = 100;
+    int i;
+    struct tmp_data  nodes[COUNT_NODES];
+    struct tmp_data  *it;
+
+
+    tlist_splice_front(&tmp_list1, &tmp_list2);  //empty src
+    TEST_ASSERT(tlist_empty(&tmp_list2));
+
+
+    for(i=0; i < COUNT_NODES; i++)
+    {
+        nodes[i].data = i;
+        tlist_push_back(&nodes[i].list, i < COUNT_NODES/2 ? &tmp_list2 : &tmp_list1);
+    }
+
+
+    tlist_splice_front(&tmp_list1, &tmp_list2);  //[head] -> [50..99] -> [0..49]
+
+    TEST_ASSERT(tlist_empty(&tmp_list1));
+    TEST_ASSERT(tlist_last(&tmp_list1) == &tmp_list1.head);
+    TEST_ASSERT(tlist_size(&tmp_list2) == (size_t)COUNT_NODES);
+    TEST_ASSERT(tlist_last(&tmp_list2) == &nodes[COUNT_NODES/2 - 1].list);
+    TEST_ASSERT(tail_is_valid(&tmp_list2));
+
+
+    i=0;
+    tlist_data_citer(it, &tmp_list2, struct tmp_data, list)
+    {
+        TEST_ASSERT(it->data == (i + COUNT_NODES/2) % COUNT_NODES);
+        i++;
+    }
+
+
+    //to empty dest
+    tlist_splice_front(&tmp_list2, &tmp_list1);
+
+    TEST_ASSERT(tlist_empty(&tmp_list2));
+    TEST_ASSERT(tlist_size(&tmp_list1) == (size_t)COUNT_NODES);
+    TEST_ASSERT(tail_is_valid(&tmp_list1));
+
+
+    TEST_PASS(NULL);
+}
+
+
+
+TEST(test_tlist_splice_back)
+{
+    DECLARE_TLIST_HEAD(tmp_list1);
+    DECLARE_TLIST_HEAD(tmp_list2);
+
+    const int COUNT_NODES = 100;
+    int i;
+    struct tmp_data  nodes[COUNT_NODES];
+    struct tmp_data  *it;
+
+
+    for(i=0; i < COUNT_NODES; i++)
+    {
+        nodes[i].data = i;
+        tlist_push_back(&nodes[i].list, i < COUNT_NODES/2 ? &tmp_list2 : &tmp_list1);
+    }
+
+
+    tlist_splice_back(&tmp_list1, &tmp_list2);   //[head] -> [0..49] -> [50..99]
+
+    TEST_ASSERT(tlist_empty(&tmp_list1));
+    TEST_ASSERT(tlist_last(&tmp_list1) == &tmp_list1.head);
+    TEST_ASSERT(tlist_size(&tmp_list2) == (size_t)COUNT_NODES);
+    TEST_ASSERT(tlist_last(&tmp_list2) == &nodes[COUNT_NODES-1].list);
+    TEST_ASSERT(tail_is_valid(&tmp_list2));
+
+
+    i=0;
+    tlist_data_citer(it, &tmp_list2, struct tmp_data, list)
+    {
+        TEST_ASSERT(it->data == i);
+        i++;
+    }
+
+
+    //to empty dest
+    tlist_splice_back(&tmp_list2, &tmp_list1);
+
+    TEST_ASSERT(tlist_empty(&tmp_list2));
+    TEST_ASSERT(tlist_size(&tmp_list1) == (size_t)COUNT_NODES);
+    TEST_ASSERT(tail_is_valid(&tmp_list1));
+
+
+    TEST_PASS(NULL);
+}
+
+
+
+TEST(test_tlist_reverse)
+{
+    DECLARE_TLIST_HEAD(tmp_list);
+
+    const int COUNT_NODES = 100;
+    int i;
+    struct tmp_data  nodes[COUNT_NODES];
+    struct tmp_data  *it;
+
+
+    tlist_reverse(&tmp_list);                   //empty list
+    TEST_ASSERT(tlist_last(&tmp_list) == &tmp_list.head);
+
+
+    for(i=0; i < COUNT_NODES; i++)
+    {
+        nodes[i].data = i;
+        tlist_push_back(&nodes[i].list, &tmp_list);
+    }
+
+
+    tlist_reverse(&tmp_list);
+
+    TEST_ASSERT(tlist_last(&tmp_list) == &nodes[0].list);
+    TEST_ASSERT(tail_is_valid(&tmp_list));
+
+
+    i = COUNT_NODES-1;
+    tlist_data_citer(it, &tmp_list, struct tmp_data, list)
+    {
+        TEST_ASSERT(it->data == i);
+        i--;
+    }
+
+
+    TEST_PASS(NULL);
+}
+
+
+
+TEST(test_tlist_swap)
+{
+    DECLARE_TLIST_HEAD(tmp_list1);
+    DECLARE_TLIST_HEAD(tmp_list2);
+
+    DECLARE_TMP_DATA(d1);
+    DECLARE_TMP_DATA(d2);
+    DECLARE_TMP_DATA(d3);
+
+
+    tlist_push_back(&d1.list, &tmp_list1);
+    tlist_push_back(&d2.list, &tmp_list1);      //list1: [d1] -> [d2]
+    tlist_push_back(&d3.list, &tmp_list2);      //list2: [d3]
+
+
+    tlist_swap(&tmp_list1, &tmp_list2);
+
+    TEST_ASSERT(tlist_size(&tmp_list1) == 1);
+    TEST_ASSERT(tlist_size(&tmp_list2) == 2);
+    TEST_ASSERT(tlist_last(&tmp_list1) == &d3.list);
+    TEST_ASSERT(tlist_last(&tmp_list2) == &d2.list);
+    TEST_ASSERT(tail_is_valid(&tmp_list1));
+    TEST_ASSERT(tail_is_valid(&tmp_list2));
+
+
+    tlist_init_head(&tmp_list1);                //clear
+
+    tlist_swap(&tmp_list1, &tmp_list2);         //with empty list
+
+    TEST_ASSERT(tlist_empty(&tmp_list2));
+    TEST_ASSERT(tlist_last(&tmp_list2) == &tmp_list2.head);
+    TEST_ASSERT(tlist_last(&tmp_list1) == &d2.list);
+
+
+    TEST_PASS(NULL);
+}
+
+
+
+//---------------- Get Data from node ----------------
+
+
+
+TEST(test_tlist_data)
+{
+    DECLARE_TLIST_HEAD(tmp_list);
+
+    DECLARE_TMP_DATA(d1);
+    DECLARE_TMP_DATA(d2);
+
+
+    TEST_ASSERT(tlist_first_data_or_null(&tmp_list, struct tmp_data, list) == NULL);
+    TEST_ASSERT(tlist_last_data_or_null(&tmp_list, struct tmp_data, list) == NULL);
+
+
+    tlist_push_back(&d1.list, &tmp_list);
+    tlist_push_back(&d2.list, &tmp_list);
+
+    TEST_ASSERT(tlist_data(&d1.list, struct tmp_data, list) == &d1);
+    TEST_ASSERT(tlist_first_data(&tmp_list, struct tmp_data, list) == &d1);
+    TEST_ASSERT(tlist_last_data(&tmp_list, struct tmp_data, list) == &d2);
+    TEST_ASSERT(tlist_last_data_or_null(&tmp_list, struct tmp_data, list) == &d2);
+
+
+    TEST_PASS(NULL);
+}
+
+
+
+//---------------- Iterator ----------------
+
+
+
+TEST(test_tlist_iter)
+{
+    DECLARE_TLIST_HEAD(tmp_list);
+
+    const int COUNT_NODES = 100;
+    int i;
+    struct tmp_data  nodes[COUNT_NODES];
+    struct list_head *it, *tmp_it;
+    struct tmp_data  *it_data;
+
+
+    for(i=0; i < COUNT_NODES; i++)
+    {
+        nodes[i].data = i;
+        tlist_push_back(&nodes[i].list, &tmp_list);
+    }
+
+
+    i=0;
+    tlist_citer(it, &tmp_list)
+    {
+        TEST_ASSERT(it == &nodes[i].list);
+        i++;
+    }
+    TEST_ASSERT(i == COUNT_NODES);
+
+
+    //remove all odd nodes
+    tlist_data_iter(it_data, &tmp_list, tmp_it, struct tmp_data, list)
+    {
+        if( it_data->data & 1 )
+            tlist_del(&it_data->list, &tmp_list);
+    }
+
+    TEST_ASSERT(tlist_size(&tmp_list) == (size_t)COUNT_NODES/2);
+    TEST_ASSERT(tlist_last(&tmp_list) == &nodes[COUNT_NODES-2].list);
+
+
+    //remove all nodes
+    tlist_iter(it, tmp_it, &tmp_list)
+    {
+        tlist_del(it, &tmp_list);
+    }
+
+    TEST_ASSERT(tlist_empty(&tmp_list));
+    TEST_ASSERT(tlist_last(&tmp_list) == &tmp_list.head);
+
+
+    TEST_PASS(NULL);
+}
+
+
+
+//---------------- Algorithm ----------------
+
+
+
+int comp_less(const struct list_head *n1, const struct list_head *n2)
+{
+    struct tmp_data *d1 = tlist_data(n1, struct tmp_data, list);
+    struct tmp_data *d2 = tlist_data(n2, struct tmp_data, list);
+
+    return d1->data < d2->data;
+}
+
+
+
+int pred_equal(const struct list_head *node, void *data)
+{
+    struct tmp_data *d = tlist_data(node, struct tmp_data, list);
+
+    return d->data == *(int *)data;
+}
+
+
+
+TEST(test_tlist_algorithm)
+{
+    DECLARE_TLIST_HEAD(tmp_list);
+
+    const int COUNT_NODES = 100;
+    int i, key;
+    struct tmp_data  nodes[COUNT_NODES];
+    struct list_head *it, *res[2];
+
+
+    TEST_ASSERT(tlist_min(tlist_begin(&tmp_list), tlist_end(&tmp_list), comp_less) == tlist_end(&tmp_list));
+
+
+    for(i=0; i < COUNT_NODES; i++)
+    {
+        nodes[i].data = (i * 37) % COUNT_NODES;
+        tlist_push_back(&nodes[i].list, &tmp_list);
+    }
+
+
+    it = tlist_min(tlist_begin(&tmp_list), tlist_end(&tmp_list), comp_less);
+    TEST_ASSERT(it == &nodes[0].list);
+
+    it = tlist_max(tlist_begin(&tmp_list), tlist_end(&tmp_list), comp_less);
+    TEST_ASSERT(it == &nodes[27].list);              //(27 * 37) % 100 == 99
+
+    tlist_minmax(tlist_begin(&tmp_list), tlist_end(&tmp_list), comp_less, res);
+    TEST_ASSERT(res[0] == &nodes[0].list);
+    TEST_ASSERT(res[1] == &nodes[27].list);
+
+
+    key = 37;
+    TEST_ASSERT(tlist_find2(tlist_begin(&tmp_list), tlist_end(&tmp_list), pred_equal, &key) == &nodes[1].list);
+
+    key = COUNT_NODES;
+    TEST_ASSERT(tlist_find2(tlist_begin(&tmp_list), tlist_end(&tmp_list), pred_equal, &key) == tlist_end(&tmp_list));
+
+
+    TEST_PASS(NULL);
+}
+
+
+
+
+
+TEST(test_tlist_sort)
+{
+    DECLARE_TLIST_HEAD(tmp_list);
+
+    const int COUNT_NODES = 1000;
+    int i;
+    struct tmp_data  nodes[COUNT_NODES];
+    struct tmp_data  *it;
+
+
+    tlist_sort(&tmp_list, comp_less);             //empty list
+    TEST_ASSERT(tlist_last(&tmp_list) == &tmp_list.head);
+
+
+    for(i=0; i < COUNT_NODES; i++)
+    {
+        nodes[i].data = (i * 7919) % COUNT_NODES;
+        tlist_push_back(&nodes[i].list, &tmp_list);
+    }
+
+
+    tlist_sort(&tmp_list, comp_less);
+
+    TEST_ASSERT(tail_is_valid(&tmp_list));
+
+    it = tlist_last_data(&tmp_list, struct tmp_data, list);
+    TEST_ASSERT(it->data == COUNT_NODES-1);
+
+    i=0;
+    tlist_data_citer(it, &tmp_list, struct tmp_data, list)
+    {
+        TEST_ASSERT(it->data == i);
+        i++;
+    }
+    TEST_ASSERT(i == COUNT_NODES);
+
+
+    TEST_PASS(NULL);
+}
+
+
+
+ptest_func tests[] =
+{
+    test_tlist_empty,
+    test_tlist_is_first_last,
+    test_tlist_is_singular,
+    test_tlist_size,
+    test_tlist_prev,
+    test_tlist_push_pop,
+    test_tlist_del,
+    test_tlist_replace,
+    test_tlist_move,
+    test_tlist_rotate,
+    test_tlist_splice_front,
+    test_tlist_splice_back,
+    test_tlist_reverse,
+    test_tlist_swap,
+
+    //Get Data from node
+    test_tlist_data,
+
+    //Iterator
+    test_tlist_iter,
+
+    //Algorithm
+    test_tlist_algorithm,
+    test_tlist_sort,
+};
+
+
+
+MAIN_TESTS(tests)
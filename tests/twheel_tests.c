@@ -0,0 +1,329 @@
+#include "stest.h"
+#include "twheel.h"
+
+
+
+
+
+struct tmp_data
+{
+   int                 id;
+   int                 fired;
+   struct twheel_timer timer;
+};
+
+
+
+// take the expired timers: check that they expired in (prev_now, now], ret count or -1
+static int take_expired(struct twheel_t *tw, struct dqueue_t *expired, uint64_t prev_now)
+{
+    struct twheel_timer *timer;
+    struct tmp_data *d;
+    int count = 0;
+
+
+    while( !dqueue_empty(expired) )
+    {
+        timer = dqueue_first_data(expired, struct twheel_timer, list);
+        d     = twheel_data(timer, struct tmp_data, timer);
+        dqueue_pop_front(expired);
+
+        if( timer->expires <= prev_now || timer->expires > twheel_now(tw) )
+            return -1;
+
+        if( twheel_pending(tw, timer) || twheel_cancel(tw, timer) != -1 )
+            return -1;
+
+        d->fired++;
+        count++;
+    }
+
+    return count;
+}
+
+
+
+
+
+TEST(test_twheel_init)
+{
+    struct twheel_t tmp_tw;
+    struct twheel_timer timer;
+
+    DECLARE_DQUEUE(expired);
+
+    twheel_init(&tmp_tw, 100);
+    twheel_init_timer(&timer);
+
+
+    TEST_ASSERT(twheel_empty(&tmp_tw));
+    TEST_ASSERT(twheel_size(&tmp_tw) == 0);
+    TEST_ASSERT(twheel_now(&tmp_tw) == 100);
+    TEST_ASSERT(!twheel_pending(&tmp_tw, &timer));
+    TEST_ASSERT(twheel_cancel(&tmp_tw, &timer) == -1);
+
+    TEST_ASSERT(twheel_advance(&tmp_tw, 1000000, &expired) == 0);  //empty wheel: jump
+    TEST_ASSERT(twheel_now(&tmp_tw) == 1000000);
+    TEST_ASSERT(twheel_advance(&tmp_tw, 5, &expired) == 0);        //the time does not go back
+    TEST_ASSERT(twheel_now(&tmp_tw) == 1000000);
+    TEST_ASSERT(twheel_tick(&tmp_tw, &expired) == 0);
+    TEST_ASSERT(twheel_now(&tmp_tw) == 1000001);
+
+
+    TEST_PASS(NULL);
+}
+
+
+
+TEST(test_twheel_expire)
+{
+    const int SIZE = 2000;
+
+    struct twheel_t tmp_tw;
+    struct tmp_data items[SIZE];
+    uint64_t prev_now;
+
+    DECLARE_DQUEUE(expired);
+
+    unsigned int seed = 1;
+    int count = 0;
+
+    twheel_init(&tmp_tw, 12345);
+
+
+    for(int i = 0; i < SIZE; i++)
+    {
+        seed = seed * 1103515245 + 12345;
+        items[i].id    = i;
+        items[i].fired = 0;
+        twheel_init_timer(&items[i].timer);
+
+        //every level: up to 2^6, 2^12, 2^18, 2^24 ticks
+        uint64_t delta = 1 + (seed >> 8) % ((uint64_t)1 << (6 * (1 + i % 4)));
+
+        TEST_ASSERT(twheel_add(&tmp_tw, &items[i].timer, twheel_now(&tmp_tw) + delta) == 0);
+        TEST_ASSERT(twheel_pending(&tmp_tw, &items[i].timer));
+    }
+
+    TEST_ASSERT(twheel_size(&tmp_tw) == (size_t)SIZE);
+    TEST_ASSERT(twheel_add(&tmp_tw, &items[0].timer, 0) == -1);  //pending
+
+
+    //advance by random steps
+    while( !twheel_empty(&tmp_tw) )
+    {
+        seed     = seed * 1103515245 + 12345;
+        prev_now = twheel_now(&tmp_tw);
+
+        size_t n = twheel_advance(&tmp_tw, prev_now + 1 + (seed >> 16) % 5000, &expired);
+
+        TEST_ASSERT(dqueue_size(&expired) == n);
+        TEST_ASSERT(take_expired(&tmp_tw, &expired, prev_now) == (int)n);
+        count += (int)n;
+
+        for(int i = 0; i < SIZE; i += 97)
+        {
+            if( items[i].fired )
+            {
+                TEST_ASSERT(items[i].timer.expires <= twheel_now(&tmp_tw));
+            }
+            else
+            {
+                TEST_ASSERT(items[i].timer.expires > twheel_now(&tmp_tw));
+            }
+        }
+    }
+
+    TEST_ASSERT(count == SIZE);
+
+    for(int i = 0; i < SIZE; i++)
+        TEST_ASSERT(items[i].fired == 1);
+
+
+    TEST_PASS(NULL);
+}
+
+
+
+TEST(test_twheel_tick)
+{
+    const int SIZE = 300;
+
+    struct twheel_t tmp_tw;
+    struct tmp_data items[SIZE];
+
+    DECLARE_DQUEUE(expired);
+
+    unsigned int seed = 3;
+
+    twheel_init(&tmp_tw, 0);
+
+
+    for(int i = 0; i < SIZE; i++)
+    {
+        seed = seed * 1103515245 + 12345;
+        items[i].fired = 0;
+        twheel_init_timer(&items[i].timer);
+        twheel_add(&tmp_tw, &items[i].timer, 1 + (seed >> 16) % 10000);
+    }
+
+    //every timer expires exactly on its tick
+    for(uint64_t now = 1; now <= 10000; now++)
+    {
+        size_t n = twheel_tick(&tmp_tw, &expired);
+        size_t must = 0;
+
+        for(int i = 0; i < SIZE; i++)
+            if( items[i].timer.expires == now )
+                must++;
+
+        TEST_ASSERT(twheel_now(&tmp_tw) == now);
+        TEST_ASSERT(n == must);
+        TEST_ASSERT(take_expired(&tmp_tw, &expired, now - 1) == (int)n);
+    }
+
+    TEST_ASSERT(twheel_empty(&tmp_tw));
+
+
+    TEST_PASS(NULL);
+}
+
+
+
+TEST(test_twheel_far)
+{
+    struct twheel_t tmp_tw;
+    struct tmp_data items[4];
+
+    DECLARE_DQUEUE(expired);
+
+    twheel_init(&tmp_tw, 7);
+
+
+    for(int i = 0; i < 4; i++)
+    {
+        items[i].fired = 0;
+        twheel_init_timer(&items[i].timer);
+    }
+
+    //the last level and after it (TWHEEL_MAX_DELTA)
+    twheel_add(&tmp_tw, &items[0].timer, (uint64_t)1 << 30);
+    twheel_add(&tmp_tw, &items[1].timer, ((uint64_t)1 << 35) + 3);
+    twheel_add(&tmp_tw, &items[2].timer, ((uint64_t)1 << 40) + 5);
+    twheel_add(&tmp_tw, &items[3].timer, ((uint64_t)1 << 45) + 11);
+
+    TEST_ASSERT(twheel_advance(&tmp_tw, ((uint64_t)1 << 30) - 1, &expired) == 0);
+    TEST_ASSERT(twheel_advance(&tmp_tw, (uint64_t)1 << 30, &expired) == 1);
+    TEST_ASSERT(take_expired(&tmp_tw, &expired, ((uint64_t)1 << 30) - 1) == 1);
+
+    TEST_ASSERT(twheel_advance(&tmp_tw, ((uint64_t)1 << 40) + 4, &expired) == 1);
+    TEST_ASSERT(take_expired(&tmp_tw, &expired, 0) == 1);
+    TEST_ASSERT(items[1].fired == 1);
+
+    TEST_ASSERT(twheel_advance(&tmp_tw, ((uint64_t)1 << 40) + 5, &expired) == 1);
+    TEST_ASSERT(take_expired(&tmp_tw, &expired, ((uint64_t)1 << 40) + 4) == 1);
+    TEST_ASSERT(items[2].fired == 1);
+
+    TEST_ASSERT(twheel_advance(&tmp_tw, ((uint64_t)1 << 45) + 10, &expired) == 0);
+    TEST_ASSERT(twheel_pending(&tmp_tw, &items[3].timer));
+    TEST_ASSERT(twheel_tick(&tmp_tw, &expired) == 1);
+    TEST_ASSERT(take_expired(&tmp_tw, &expired, ((uint64_t)1 << 45) + 10) == 1);
+    TEST_ASSERT(twheel_empty(&tmp_tw));
+
+
+    TEST_PASS(NULL);
+}
+
+
+
+TEST(test_twheel_cancel_mod)
+{
+    const int SIZE = 1000;
+
+    struct twheel_t tmp_tw;
+    struct tmp_data items[SIZE];
+    int cancelled[SIZE];
+
+    DECLARE_DQUEUE(expired);
+
+    unsigned int seed = 5;
+
+    twheel_init(&tmp_tw, 1000);
+
+
+    for(int i = 0; i < SIZE; i++)
+    {
+        seed = seed * 1103515245 + 12345;
+        items[i].fired = 0;
+        twheel_init_timer(&items[i].timer);
+        twheel_add(&tmp_tw, &items[i].timer, 1000 + 1 + (seed >> 16) % 100000);
+    }
+
+    TEST_ASSERT(twheel_advance(&tmp_tw, 1000 + 20000, &expired) == (size_t)take_expired(&tmp_tw, &expired, 1000));
+
+
+    //cancel: the expired timers are not pending
+    for(int i = 0; i < SIZE; i++)
+        cancelled[i] = 0;
+
+    for(int i = 0; i < SIZE; i += 2)
+    {
+        if( items[i].fired )
+        {
+            TEST_ASSERT(twheel_cancel(&tmp_tw, &items[i].timer) == -1);
+            continue;
+        }
+
+        TEST_ASSERT(twheel_cancel(&tmp_tw, &items[i].timer) == 0);
+        TEST_ASSERT(!twheel_pending(&tmp_tw, &items[i].timer));
+        TEST_ASSERT(twheel_cancel(&tmp_tw, &items[i].timer) == -1);
+        cancelled[i] = 1;
+    }
+
+
+    //mod: pending, expired and cancelled timers, the past expires on the next tick
+    uint64_t now = twheel_now(&tmp_tw);
+
+    twheel_mod(&tmp_tw, &items[1].timer, now + 500);
+    twheel_mod(&tmp_tw, &items[2].timer, 3);
+    TEST_ASSERT(items[2].timer.expires == now + 1);
+    TEST_ASSERT(twheel_pending(&tmp_tw, &items[2].timer));
+
+    int fired1 = items[1].fired, fired2 = items[2].fired;
+
+    TEST_ASSERT(twheel_tick(&tmp_tw, &expired) >= 1);
+    take_expired(&tmp_tw, &expired, now);
+    TEST_ASSERT(items[2].fired == fired2 + 1);
+
+    twheel_advance(&tmp_tw, now + 500, &expired);
+    take_expired(&tmp_tw, &expired, now + 1);
+    TEST_ASSERT(items[1].fired == fired1 + 1);
+
+
+    twheel_advance(&tmp_tw, UINT64_MAX / 2, &expired);
+    take_expired(&tmp_tw, &expired, now + 500);
+    TEST_ASSERT(twheel_empty(&tmp_tw));
+
+    for(int i = 3; i < SIZE; i++)
+        TEST_ASSERT(items[i].fired == !cancelled[i]);
+
+
+    TEST_PASS(NULL);
+}
+
+
+
+ptest_func tests[] =
+{
+    test_twheel_init,
+    test_twheel_expire,
+    test_twheel_tick,
+    test_twheel_far,
+    test_twheel_cancel_mod,
+};
+
+
+
+
+
+MAIN_TESTS(tests)